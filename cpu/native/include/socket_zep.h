@@ -13,6 +13,13 @@
  *
  * @see @ref net_zep for protocol definitions
  *
+ * With the `ack_req` option of the interface set, frames to a single
+ * destination request an acknowledgement. The device then waits for a ZEP ACK
+ * with the sequence number of the frame, as sent by `dist/tools/zep_dispatch`
+ * on behalf of the destination, and retransmits the frame up to `retrans`
+ * times. Frames received while waiting are dropped, like by a radio waiting
+ * for an ACK.
+ *
  * @{
  *
  * @file
@@ -34,6 +41,22 @@ extern "C" {
 /* 127 - 25 as in at86rf2xx */
 #define SOCKET_ZEP_FRAME_PAYLOAD_LEN    (102)   /**< maximum possible payload size */
 
+/**
+ * @brief   Time to wait for the ACK of a frame, in microseconds
+ *
+ * The whole native instance blocks while waiting.
+ */
+#ifndef SOCKET_ZEP_ACK_TIMEOUT_US
+#define SOCKET_ZEP_ACK_TIMEOUT_US       (2000U)
+#endif
+
+/**
+ * @brief   Default maximum number of retransmissions (macMaxFrameRetries)
+ */
+#ifndef SOCKET_ZEP_RETRANS_DEFAULT
+#define SOCKET_ZEP_RETRANS_DEFAULT      (3U)
+#endif
+
 /**
  * @brief   ZEP device state
  */
@@ -42,6 +65,8 @@ typedef struct {
     int sock_fd;                    /**< socket fd */
     netdev_event_t last_event;      /**< event triggered */
     uint32_t seq;                   /**< ZEP sequence number */
+    uint8_t retrans;                /**< maximum number of retransmissions */
+    uint8_t tx_retries;             /**< retransmissions of the last frame */
     /**
      * @brief   Receive buffer
      */
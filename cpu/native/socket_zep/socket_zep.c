@@ -28,6 +28,7 @@
 #include "checksum/ucrc16.h"
 #include "native_internal.h"
 #include "random.h"
+#include "timex.h"
 
 #include "socket_zep.h"
 
@@ -92,33 +93,90 @@ static size_t _prep_vector(socket_zep_t *dev, const iolist_t *iolist,
     return bytes;
 }
 
+static inline bool _ack_req(socket_zep_t *dev, const iolist_t *iolist)
+{
+    /* the MAC header comes first */
+    return (dev->netdev.flags & NETDEV_IEEE802154_ACK_REQ) &&
+           (iolist != NULL) && (iolist->iol_len > 0) &&
+           (((uint8_t *)iolist->iol_base)[0] & IEEE802154_FCF_ACK_REQ);
+}
+
+/* waits for the ACK of the last frame sent, dropping any other frame */
+static bool _wait_ack(socket_zep_t *dev)
+{
+    zep_v2_ack_hdr_t *ack = (zep_v2_ack_hdr_t *)dev->rcv_buf;
+    struct timeval now, end;
+    bool acked = false;
+
+    _native_syscall_enter();
+    real_gettimeofday(&end, NULL);
+    end.tv_usec += SOCKET_ZEP_ACK_TIMEOUT_US;
+    end.tv_sec += end.tv_usec / US_PER_SEC;
+    end.tv_usec %= US_PER_SEC;
+    while (!acked) {
+        struct timeval t;
+        fd_set rfds;
+        ssize_t size;
+
+        real_gettimeofday(&now, NULL);
+        if (!timercmp(&now, &end, <)) {
+            break;
+        }
+        timersub(&end, &now, &t);
+        FD_ZERO(&rfds);
+        FD_SET(dev->sock_fd, &rfds);
+        if (real_select(dev->sock_fd + 1, &rfds, NULL, NULL, &t) != 1) {
+            break;
+        }
+        size = real_read(dev->sock_fd, dev->rcv_buf, sizeof(dev->rcv_buf));
+        acked = (size == (ssize_t)sizeof(zep_v2_ack_hdr_t)) &&
+                (ack->hdr.preamble[0] == 'E') && (ack->hdr.preamble[1] == 'X') &&
+                (ack->hdr.version == 2) && (ack->type == ZEP_V2_TYPE_ACK) &&
+                (byteorder_ntohl(ack->seq) == dev->seq);
+    }
+    _native_syscall_leave();
+    return acked;
+}
+
 static int _send(netdev_t *netdev, const iolist_t *iolist)
 {
     socket_zep_t *dev = (socket_zep_t *)netdev;
     unsigned n = iolist_count(iolist);
     struct iovec v[n + 2];
     size_t bytes;
+    bool acked = true;
     int res;
 
     assert((dev != NULL) && (dev->sock_fd != 0));
     bytes = _prep_vector(dev, iolist, n, v);
     DEBUG("socket_zep::send(%p, %p, %u)\n", (void *)netdev, (void *)iolist, n);
-    /* simulate TX_STARTED interrupt */
+    /* the TX events are reported right away, like netdev_tap does, so they
+     * don't overwrite the RX_COMPLETE of a pending interrupt */
     if (netdev->event_callback) {
-        dev->last_event = NETDEV_EVENT_TX_STARTED;
-        netdev->event_callback(netdev, NETDEV_EVENT_ISR);
-        thread_yield();
+        netdev->event_callback(netdev, NETDEV_EVENT_TX_STARTED);
     }
-    res = writev(dev->sock_fd, v, n + 2);
-    if (res < 0) {
-        DEBUG("socket_zep::send: error writing packet: %s\n", strerror(errno));
-        return res;
+    dev->tx_retries = 0;
+    while (1) {
+        res = writev(dev->sock_fd, v, n + 2);
+        if (res < 0) {
+            DEBUG("socket_zep::send: error writing packet: %s\n",
+                  strerror(errno));
+            dev->seq++;
+            return res;
+        }
+        if (!_ack_req(dev, iolist) || _wait_ack(dev)) {
+            break;
+        }
+        if (dev->tx_retries == dev->retrans) {
+            acked = false;
+            break;
+        }
+        dev->tx_retries++;
     }
-    /* simulate TX_COMPLETE interrupt */
+    dev->seq++;
     if (netdev->event_callback) {
-        dev->last_event = NETDEV_EVENT_TX_COMPLETE;
-        netdev->event_callback(netdev, NETDEV_EVENT_ISR);
-        thread_yield();
+        netdev->event_callback(netdev, (acked) ? NETDEV_EVENT_TX_COMPLETE
+                                               : NETDEV_EVENT_TX_NOACK);
     }
 #ifdef MODULE_NETSTATS_L2
     netdev->stats.tx_bytes += bytes;
@@ -208,8 +266,8 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
                     void *payload = &dev->rcv_buf[sizeof(zep_v2_data_hdr_t)];
 
                     if (zep->type != ZEP_V2_TYPE_DATA) {
+                        /* ACKs only count while waiting for one in _send() */
                         DEBUG("socket_zep::recv: unexpect ZEP type\n");
-                        /* don't support ACK frames for now*/
                         return -1;
                     }
                     if (((sizeof(zep_v2_data_hdr_t) + zep->length) != (unsigned)size) ||
@@ -302,6 +360,7 @@ static int _init(netdev_t *netdev)
     dev->netdev.proto = GNRC_NETTYPE_UNDEF;
 #endif
     dev->seq = random_uint32();
+    dev->retrans = SOCKET_ZEP_RETRANS_DEFAULT;
 
     return 0;
 }
@@ -320,6 +379,23 @@ static int _get(netdev_t *netdev, netopt_t opt, void *value, size_t max_len)
             }
             *v = SOCKET_ZEP_FRAME_PAYLOAD_LEN;
             return sizeof(uint16_t);
+        case NETOPT_RETRANS:
+            assert(value != NULL);
+            if (max_len < sizeof(uint8_t)) {
+                return -EOVERFLOW;
+            }
+            *((uint8_t *)value) = dev->retrans;
+            return sizeof(uint8_t);
+        case NETOPT_TX_RETRIES_NEEDED:
+            assert(value != NULL);
+            if (!(dev->netdev.flags & NETDEV_IEEE802154_ACK_REQ)) {
+                return -ENOTSUP;
+            }
+            if (max_len < sizeof(uint8_t)) {
+                return -EOVERFLOW;
+            }
+            *((uint8_t *)value) = dev->tx_retries;
+            return sizeof(uint8_t);
         default:
             return netdev_ieee802154_get(&dev->netdev, opt, value, max_len);
     }
@@ -328,9 +404,21 @@ static int _get(netdev_t *netdev, netopt_t opt, void *value, size_t max_len)
 static int _set(netdev_t *netdev, netopt_t opt, const void *value,
                 size_t value_len)
 {
+    socket_zep_t *dev = (socket_zep_t *)netdev;
+
     assert(netdev != NULL);
-    return netdev_ieee802154_set((netdev_ieee802154_t *)netdev, opt,
-                                  value, value_len);
+    switch (opt) {
+        case NETOPT_RETRANS:
+            assert(value != NULL);
+            if (value_len != sizeof(uint8_t)) {
+                return -EOVERFLOW;
+            }
+            dev->retrans = *((const uint8_t *)value);
+            return sizeof(uint8_t);
+        default:
+            return netdev_ieee802154_set((netdev_ieee802154_t *)netdev, opt,
+                                          value, value_len);
+    }
 }
 
 static const netdev_driver_t socket_zep_driver = {
@@ -0,0 +1,339 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""Runs an RPL network of native instances connected by zep_dispatch.
+
+Node 0 becomes the DODAG root. The script measures the time until every
+node has joined the DODAG and until the root has a route to every node,
+lets every other node ping the root, and
+prints the control overhead, the packet loss, the round-trip times, the
+retransmissions and the packet buffer usage of each node. The firmware is
+tests/gnrc_rpl_sim, or any application with its `simstats` shell command.
+With --compare, the scenario runs once for each of several builds of the
+firmware, e.g. with OF0 and with MRHOF, and their results are compared.
+"""
+
+import argparse
+import json
+import os
+import re
+import signal
+import subprocess
+import sys
+import time
+
+import pexpect
+
+TOOL_DIR = os.path.dirname(os.path.abspath(__file__))
+DISPATCHER = os.path.join(TOOL_DIR, "zep_dispatch")
+INFINITE_RANK = 0xffff
+
+SIMSTATS = re.compile(r"simstats: (iface=[^\r\n]*)\r?\n")
+PING_STATS = re.compile(r"(\d+) packets transmitted, (\d+) received")
+PING_RTT = re.compile(r"rtt min/avg/max = ([\d.]+)/([\d.]+)/([\d.]+) ms")
+HOST_ROUTE = re.compile(r"([0-9a-f:]+)/128 via ")
+DISPATCH_STATS = re.compile(r"node (\d+): tx (\d+), retx (\d+), rx (\d+), "
+                            r"lost (\d+), late (\d+)")
+
+
+class Node:
+    def __init__(self, nid, args):
+        self.id = nid
+        self.stats = {}
+        self.ping = None
+        zep = "[::1]:%d,[::1]:%d" % (args.base_port + nid, args.port)
+        self.child = pexpect.spawnu(args.elf, ["-z", zep],
+                                    timeout=args.timeout,
+                                    codec_errors="replace")
+        if args.log:
+            self.child.logfile_read = open("%s.%d" % (args.log, nid), "w")
+
+    def cmd(self, line):
+        self.child.sendline(line)
+
+    def simstats(self):
+        self.cmd("simstats")
+        self.child.expect(SIMSTATS)
+        now = time.monotonic()
+        stats = {}
+        for field in self.child.match.group(1).split():
+            key, value = field.split("=", 1)
+            stats[key] = int(value)
+        stats["wall"] = now
+        self.stats = stats
+        return stats
+
+    def host_routes(self):
+        """Returns the destinations of the host routes of the node"""
+        self.cmd("nib route")
+        # simstats marks the end of the routes
+        self.simstats()
+        return set(HOST_ROUTE.findall(self.child.before))
+
+    def joined_at(self):
+        """Returns the time the node joined, on the clock of this script"""
+        if self.stats.get("joined_ms", -1) < 0:
+            return None
+        return (self.stats["wall"] -
+                (self.stats["uptime_ms"] - self.stats["joined_ms"]) / 1000)
+
+    def stop(self):
+        self.child.terminate(force=True)
+
+
+def start_dispatcher(args):
+    if not os.path.exists(DISPATCHER):
+        subprocess.check_call(["make", "-C", TOOL_DIR])
+    cmd = [DISPATCHER, "-b", str(args.base_port), "-s", str(args.seed)]
+    if args.topology:
+        cmd += ["-t", args.topology]
+    cmd += ["::1", str(args.port)]
+    return subprocess.Popen(cmd, stdout=subprocess.PIPE,
+                            universal_newlines=True)
+
+
+def stop_dispatcher(dispatcher):
+    dispatcher.send_signal(signal.SIGTERM)
+    out, _ = dispatcher.communicate(timeout=5)
+    links = {}
+    for m in DISPATCH_STATS.finditer(out):
+        links[int(m.group(1))] = dict(zip(("tx", "retx", "rx", "lost", "late"),
+                                          map(int, m.groups()[1:])))
+    return links
+
+
+def wait_joined(nodes, t0, timeout):
+    pending = list(nodes)
+    while pending:
+        for node in list(pending):
+            stats = node.simstats()
+            if stats["rank"] != INFINITE_RANK and stats["joined_ms"] >= 0:
+                pending.remove(node)
+        if pending and (time.monotonic() - t0) > timeout:
+            return False
+        time.sleep(0.2)
+    return True
+
+
+def wait_routes(root, count, t0, timeout):
+    """Waits until the DAOs gave the root a route to count nodes"""
+    while len(root.host_routes()) < count:
+        if (time.monotonic() - t0) > timeout:
+            return None
+        time.sleep(0.2)
+    return time.monotonic()
+
+
+def ping_root(nodes, root_addr, args):
+    for node in nodes:
+        node.cmd("ping6 %d %s %d %d" % (args.ping_count, root_addr,
+                                        args.ping_size, args.ping_delay))
+    pending = list(nodes)
+    deadline = time.monotonic() + args.timeout + \
+        (args.ping_count * args.ping_delay) / 1000
+    while pending and time.monotonic() < deadline:
+        for node in list(pending):
+            res = node.child.expect([PING_STATS, pexpect.TIMEOUT],
+                                    timeout=0.1)
+            if res != 0:
+                continue
+            sent, received = map(int, node.child.match.groups())
+            node.ping = {"sent": sent, "received": received, "rtt": None}
+            if received:
+                node.child.expect(PING_RTT)
+                node.ping["rtt"] = tuple(map(float, node.child.match.groups()))
+            pending.remove(node)
+    for node in pending:
+        node.ping = {"sent": args.ping_count, "received": 0, "rtt": None}
+
+
+def run(args):
+    """Runs the scenario and returns its results as a dictionary"""
+    root_addr = args.prefix + "1"
+    dispatcher = start_dispatcher(args)
+    nodes = []
+    try:
+        nodes = [Node(i, args) for i in range(args.nodes)]
+        for node in nodes:
+            iface = node.simstats()["iface"]
+            if args.ack:
+                node.cmd("ifconfig %d ack_req" % iface)
+            node.cmd("rpl init %d" % iface)
+        root = nodes[0]
+        root.cmd("ifconfig %d add %s/64" % (root.stats["iface"], root_addr))
+        root.cmd("rpl root 1 %s" % root_addr)
+        t0 = time.monotonic()
+        converged = wait_joined(nodes, t0, args.timeout)
+        joined = [node.joined_at() for node in nodes]
+        routed = None
+        if converged:
+            # pings before the DAOs arrived would not find their way back
+            routed = wait_routes(root, len(nodes) - 1, t0, args.timeout)
+        if converged and args.duration:
+            time.sleep(args.duration)
+        if converged and args.ping_count:
+            ping_root(nodes[1:], root_addr, args)
+        for node in nodes:
+            node.simstats()
+    finally:
+        for node in nodes:
+            node.stop()
+        links = stop_dispatcher(dispatcher)
+
+    results = {"nodes": [], "converged": converged,
+               "convergence_ms": None, "routes_ms": None}
+    if converged:
+        results["convergence_ms"] = round((max(joined) - t0) * 1000)
+    if routed is not None:
+        results["routes_ms"] = round((routed - t0) * 1000)
+    for node, at in zip(nodes, joined):
+        res = dict(node.stats)
+        del res["wall"]
+        res["id"] = node.id
+        res["join_ms"] = round((at - t0) * 1000) if at is not None else None
+        res["ping"] = node.ping
+        res["frames"] = links.get(node.id)
+        results["nodes"].append(res)
+    return results
+
+
+def print_results(results):
+    nodes = results["nodes"]
+    if results["converged"]:
+        print("converged after %d ms" % results["convergence_ms"])
+        if results["routes_ms"] is None:
+            print("root lacks routes to some nodes")
+        else:
+            print("root has routes to all nodes after %d ms" %
+                  results["routes_ms"])
+    else:
+        print("not converged, %d of %d nodes joined" %
+              (sum(n["join_ms"] is not None for n in nodes), len(nodes)))
+    print("%4s %6s %7s %5s %5s %5s %7s %9s %9s %7s %7s %7s" %
+          ("node", "rank", "join_ms", "dio", "dis", "dao", "ctrl_B",
+           "pdr", "rtt_ms", "pktbuf", "frm_rx", "retx"))
+    for n in nodes:
+        ping = n["ping"]
+        frames = n["frames"]
+        pdr = rtt = "-"
+        if ping:
+            pdr = "%d/%d" % (ping["received"], ping["sent"])
+            if ping["rtt"]:
+                rtt = "%.1f" % ping["rtt"][1]
+        print("%4d %6d %7s %5d %5d %5d %7d %9s %9s %7d %7s %7s" %
+              (n["id"], n["rank"], n["join_ms"], n["dio_tx"], n["dis_tx"],
+               n["dao_tx"], n["control_bytes"], pdr, rtt, n["pktbuf_max"],
+               frames["rx"] if frames else "-",
+               frames["retx"] if frames else "-"))
+    sent = sum(n["ping"]["sent"] for n in nodes if n["ping"])
+    received = sum(n["ping"]["received"] for n in nodes if n["ping"])
+    print("control messages: %d DIO, %d DIS, %d DAO, %d bytes" %
+          (sum(n["dio_tx"] for n in nodes), sum(n["dis_tx"] for n in nodes),
+           sum(n["dao_tx"] for n in nodes),
+           sum(n["control_bytes"] for n in nodes)))
+    if "dio_suppressed" in nodes[0]:
+        print("trickle: %d DIOs suppressed, %d resets" %
+              (sum(n["dio_suppressed"] for n in nodes),
+               sum(n["trickle_resets"] for n in nodes)))
+    if sent:
+        print("ping: %d of %d delivered (%.1f %%)" %
+              (received, sent, 100 * received / sent))
+    tx, retx = _frames(nodes)
+    print("frames: %d sent, %d of them retransmissions" % (tx, retx))
+
+
+def _frames(nodes):
+    frames = [n["frames"] for n in nodes if n["frames"]]
+    return (sum(f["tx"] for f in frames), sum(f["retx"] for f in frames))
+
+
+def compare(args):
+    """Runs the scenario with each firmware of --compare"""
+    results = {}
+    for spec in args.compare:
+        label, args.elf = spec.split("=", 1)
+        results[label] = run(args)
+        print("== %s" % label)
+        print_results(results[label])
+    return results
+
+
+def print_comparison(results):
+    print("%-10s %9s %9s %9s %7s %7s %9s %7s" %
+          ("firmware", "conv_ms", "routes_ms", "pdr", "pdr_%", "rtt_ms",
+           "frames", "retx"))
+    for label, res in results.items():
+        pings = [n["ping"] for n in res["nodes"] if n["ping"]]
+        sent = sum(p["sent"] for p in pings)
+        received = sum(p["received"] for p in pings)
+        rtts = [p["rtt"][1] for p in pings if p["rtt"]]
+        tx, retx = _frames(res["nodes"])
+        print("%-10s %9s %9s %9s %7s %7s %9d %7d" %
+              (label, res["convergence_ms"], res["routes_ms"],
+               "%d/%d" % (received, sent),
+               "%.1f" % (100 * received / sent) if sent else "-",
+               "%.1f" % (sum(rtts) / len(rtts)) if rtts else "-", tx, retx))
+
+
+def parse_args(argv=None):
+    p = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    p.add_argument("--elf",
+                   help="native firmware of the nodes")
+    p.add_argument("--compare", nargs="+", metavar="LABEL=ELF",
+                   help="run the scenario with each of these firmwares "
+                        "instead, e.g. of0=<elf> mrhof=<elf>")
+    p.add_argument("--nodes", type=int, default=5)
+    p.add_argument("--topology",
+                   help="link file for zep_dispatch, full mesh without")
+    p.add_argument("--port", type=int, default=17754,
+                   help="port of the dispatcher")
+    p.add_argument("--base-port", type=int, default=17800,
+                   help="node n sends from port <base port> + n")
+    p.add_argument("--seed", type=int, default=1,
+                   help="seed of the losses of the dispatcher")
+    p.add_argument("--prefix", default="2001:db8::",
+                   help="prefix of the DODAG")
+    p.add_argument("--duration", type=float, default=0,
+                   help="seconds to run after convergence, before the pings")
+    p.add_argument("--ping-count", type=int, default=20)
+    p.add_argument("--ping-size", type=int, default=16)
+    p.add_argument("--ping-delay", type=int, default=500,
+                   help="ms between two pings")
+    p.add_argument("--timeout", type=float, default=60,
+                   help="seconds to wait for convergence and for replies")
+    p.add_argument("--log", help="write the output of node n to <log>.n")
+    p.add_argument("--ack", action="store_true",
+                   help="request link layer ACKs, so lost frames are "
+                        "retransmitted")
+    p.add_argument("--json", help="write the results to this file")
+    args = p.parse_args(argv)
+    if not args.elf and not args.compare:
+        p.error("--elf or --compare is required")
+    if args.compare and any("=" not in spec for spec in args.compare):
+        p.error("--compare takes LABEL=ELF")
+    return args
+
+
+def main():
+    args = parse_args()
+    if args.compare:
+        results = compare(args)
+        print_comparison(results)
+        converged = all(res["converged"] for res in results.values())
+    else:
+        results = run(args)
+        print_results(results)
+        converged = results["converged"]
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump(results, f, indent=2)
+    return 0 if converged else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,510 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/*
+ * ZEP dispatcher: connects the socket_zep interfaces of RIOT native
+ * instances like a radio medium. Each frame a node sends is passed on to
+ * the nodes it has a link to, after the delay of the link and unless the
+ * loss rate of the link drops it. A frame that requests an ACK and reaches
+ * its destination is acknowledged to the sender right away, unless the loss
+ * rate of the link back drops the ACK.
+ */
+
+#include <errno.h>
+#include <netdb.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+
+#define NODES_MAX       (256)
+#define QUEUE_SIZE      (4096)
+#define FRAME_MAX       (256)
+#define LOSS_SCALE      (10000)     /* loss in 1/100 % */
+
+/* offset and value of the fields of a ZEPv2 data header used here */
+#define ZEP_HDR_LEN     (32)
+#define ZEP_TYPE_OFF    (3)
+#define ZEP_TYPE_DATA   (1)
+#define ZEP_TYPE_ACK    (2)
+#define ZEP_LQI_OFF     (8)
+#define ZEP_SEQ_OFF     (17)
+#define ZEP_ACK_LEN     (8)
+
+/* fields of the IEEE 802.15.4 MAC header used here */
+#define FCF_ACK_REQ     (0x20)
+#define FCF_PAN_COMP    (0x40)
+#define L2ADDR_MAX      (8)
+
+typedef struct {
+    bool up;            /* frames pass */
+    uint16_t loss;      /* in 1/100 % */
+    uint32_t delay_us;
+} link_t;
+
+typedef struct {
+    struct sockaddr_in6 addr;
+    uint8_t l2addr[L2ADDR_MAX]; /* source address of the frames of the node */
+    uint8_t l2addr_len;
+    uint8_t last_seq[4];    /* ZEP sequence number of the last frame sent */
+    bool delivered;         /* the last frame reached the node it acks */
+    unsigned long tx;       /* frames sent by the node */
+    unsigned long retx;     /* retransmissions among them */
+    unsigned long rx;       /* frames passed on to the node */
+    unsigned long lost;     /* frames to the node dropped by the links */
+    unsigned long late;     /* frames to the node dropped, queue full */
+} node_t;
+
+typedef struct {
+    uint64_t due_us;
+    uint16_t node;
+    uint16_t len;
+    uint8_t frame[FRAME_MAX];
+} pending_t;
+
+static node_t _nodes[NODES_MAX];
+static unsigned _nodes_numof;
+static link_t _links[NODES_MAX][NODES_MAX];
+static bool _topology;
+static int _base_port = -1;
+static pending_t _queue[QUEUE_SIZE];
+static unsigned _queue_len;
+static volatile sig_atomic_t _print_stats;
+static volatile sig_atomic_t _quit;
+
+static void usage(void)
+{
+    fprintf(stderr, "Usage: zep_dispatch [-t <topology>] [-b <base port>] "
+                    "[-s <seed>] [<address>] [<port>]\n");
+    fprintf(stderr, "  -t  links between nodes, all nodes are connected "
+                    "without loss by default\n");
+    fprintf(stderr, "  -b  number the nodes by their port, "
+                    "node n sends from port <base port> + n\n");
+    fprintf(stderr, "  -s  seed of the random losses\n");
+    fprintf(stderr, "Sending SIGUSR1 prints the statistics of the nodes, "
+                    "they are also printed on exit.\n");
+}
+
+static uint64_t _now_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000) + (ts.tv_nsec / 1000);
+}
+
+static void _on_signal(int sig)
+{
+    if (sig == SIGUSR1) {
+        _print_stats = 1;
+    }
+    else {
+        _quit = 1;
+    }
+}
+
+static void _set_link(unsigned a, unsigned b, double loss, double delay_ms)
+{
+    _links[a][b].up = true;
+    _links[a][b].loss = (uint16_t)(loss * (LOSS_SCALE / 100));
+    _links[a][b].delay_us = (uint32_t)(delay_ms * 1000);
+}
+
+/*
+ * Reads the links from a file with one link per line:
+ *
+ *     <node a> <node b> <loss in %> [<delay in ms>]
+ *     <node a> > <node b> <loss in %> [<delay in ms>]
+ *
+ * The first form is a link in both directions, the second from a to b only.
+ */
+static int _read_topology(const char *path)
+{
+    char line[128];
+    unsigned lineno = 0;
+    FILE *f = fopen(path, "r");
+
+    if (f == NULL) {
+        fprintf(stderr, "unable to open %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+    while (fgets(line, sizeof(line), f) != NULL) {
+        unsigned a, b;
+        double loss, delay = 0;
+        char *hash = strchr(line, '#');
+        int n;
+
+        lineno++;
+        if (hash != NULL) {
+            *hash = '\0';
+        }
+        if (sscanf(line, " %u > %u %lf %lf", &a, &b, &loss, &delay) >= 3) {
+            n = 1;
+        }
+        else if (sscanf(line, " %u %u %lf %lf", &a, &b, &loss, &delay) >= 3) {
+            n = 2;
+        }
+        else if (strspn(line, " \t\r\n") == strlen(line)) {
+            continue;
+        }
+        else {
+            n = 0;
+        }
+        if ((n == 0) || (a >= NODES_MAX) || (b >= NODES_MAX) || (a == b) ||
+            (loss < 0) || (loss > 100) || (delay < 0)) {
+            fprintf(stderr, "%s:%u: invalid link\n", path, lineno);
+            fclose(f);
+            return -1;
+        }
+        _set_link(a, b, loss, delay);
+        if (n == 2) {
+            _set_link(b, a, loss, delay);
+        }
+    }
+    fclose(f);
+    _topology = true;
+    return 0;
+}
+
+/*
+ * Finds the node that sent from an address, or adds it.
+ */
+static int _get_node(const struct sockaddr_in6 *addr)
+{
+    int id;
+
+    for (unsigned i = 0; i < NODES_MAX; i++) {
+        if ((_nodes[i].addr.sin6_family == AF_INET6) &&
+            (_nodes[i].addr.sin6_port == addr->sin6_port) &&
+            (memcmp(&_nodes[i].addr.sin6_addr, &addr->sin6_addr,
+                    sizeof(addr->sin6_addr)) == 0)) {
+            return i;
+        }
+    }
+    if (_base_port >= 0) {
+        id = ntohs(addr->sin6_port) - _base_port;
+        if ((id < 0) || (id >= NODES_MAX)) {
+            return -1;
+        }
+    }
+    else if (_nodes_numof < NODES_MAX) {
+        id = _nodes_numof;
+    }
+    else {
+        return -1;
+    }
+    _nodes[id].addr = *addr;
+    _nodes_numof++;
+    if (!_topology) {
+        /* without topology, everyone hears everyone */
+        for (unsigned i = 0; i < NODES_MAX; i++) {
+            if (i != (unsigned)id) {
+                _set_link(id, i, 0, 0);
+                _set_link(i, id, 0, 0);
+            }
+        }
+    }
+    printf("node %d joined from port %u\n", id, ntohs(addr->sin6_port));
+    fflush(stdout);
+    return id;
+}
+
+static void _queue_swap(unsigned a, unsigned b)
+{
+    pending_t tmp = _queue[a];
+
+    _queue[a] = _queue[b];
+    _queue[b] = tmp;
+}
+
+static bool _queue_push(uint64_t due_us, unsigned node, const uint8_t *frame,
+                        size_t len)
+{
+    unsigned i = _queue_len;
+
+    if (_queue_len == QUEUE_SIZE) {
+        return false;
+    }
+    _queue[i].due_us = due_us;
+    _queue[i].node = node;
+    _queue[i].len = len;
+    memcpy(_queue[i].frame, frame, len);
+    _queue_len++;
+    /* min-heap on the due time */
+    while ((i > 0) && (_queue[(i - 1) / 2].due_us > _queue[i].due_us)) {
+        _queue_swap(i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+    return true;
+}
+
+static void _queue_pop(void)
+{
+    unsigned i = 0;
+
+    _queue[0] = _queue[--_queue_len];
+    while (1) {
+        unsigned l = (2 * i) + 1, r = l + 1, min = i;
+
+        if ((l < _queue_len) && (_queue[l].due_us < _queue[min].due_us)) {
+            min = l;
+        }
+        if ((r < _queue_len) && (_queue[r].due_us < _queue[min].due_us)) {
+            min = r;
+        }
+        if (min == i) {
+            break;
+        }
+        _queue_swap(i, min);
+        i = min;
+    }
+}
+
+static void _send(int sock, unsigned node, const uint8_t *frame, size_t len)
+{
+    if (sendto(sock, frame, len, 0, (struct sockaddr *)&_nodes[node].addr,
+               sizeof(_nodes[node].addr)) < 0) {
+        fprintf(stderr, "unable to send to node %u: %s\n", node,
+                strerror(errno));
+        return;
+    }
+    _nodes[node].rx++;
+}
+
+static inline uint8_t _addr_len(unsigned mode)
+{
+    /* none, reserved, short, long */
+    static const uint8_t lens[] = { 0, 0, 2, 8 };
+
+    return lens[mode & 0x3];
+}
+
+/*
+ * Learns the link layer address of a node from the MAC header of its frame
+ * and returns the node the frame requests an ACK from, or -1.
+ */
+static int _parse_mhr(unsigned src, const uint8_t *frame, size_t len)
+{
+    const uint8_t *mhr = &frame[ZEP_HDR_LEN];
+    uint8_t dst_len, src_len;
+    size_t dst_pos, src_pos;
+
+    /* frame control and sequence number */
+    if ((len - ZEP_HDR_LEN) < 3) {
+        return -1;
+    }
+    dst_len = _addr_len(mhr[1] >> 2);
+    src_len = _addr_len(mhr[1] >> 6);
+    dst_pos = 3 + ((dst_len > 0) ? 2 : 0);
+    src_pos = dst_pos + dst_len +
+              (((src_len > 0) && !(mhr[0] & FCF_PAN_COMP)) ? 2 : 0);
+    if ((len - ZEP_HDR_LEN) < (src_pos + src_len)) {
+        return -1;
+    }
+    if (src_len > 0) {
+        memcpy(_nodes[src].l2addr, &mhr[src_pos], src_len);
+        _nodes[src].l2addr_len = src_len;
+    }
+    if (!(mhr[0] & FCF_ACK_REQ) || (dst_len == 0)) {
+        return -1;
+    }
+    for (unsigned i = 0; i < NODES_MAX; i++) {
+        if ((_nodes[i].l2addr_len == dst_len) &&
+            (memcmp(_nodes[i].l2addr, &mhr[dst_pos], dst_len) == 0)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void _send_ack(int sock, unsigned node, const uint8_t *frame)
+{
+    uint8_t ack[ZEP_ACK_LEN] = { 'E', 'X', 2, ZEP_TYPE_ACK };
+
+    memcpy(&ack[4], &frame[ZEP_SEQ_OFF], 4);
+    if (sendto(sock, ack, sizeof(ack), 0, (struct sockaddr *)&_nodes[node].addr,
+               sizeof(_nodes[node].addr)) < 0) {
+        fprintf(stderr, "unable to send ACK to node %u: %s\n", node,
+                strerror(errno));
+    }
+}
+
+static void _dispatch(int sock, unsigned src, uint8_t *frame, size_t len)
+{
+    uint64_t now = _now_us();
+    int ack_from = _parse_mhr(src, frame, len);
+    bool acked = false, retx;
+
+    /* socket_zep repeats the sequence number when retransmitting */
+    retx = (_nodes[src].tx > 0) &&
+           (memcmp(_nodes[src].last_seq, &frame[ZEP_SEQ_OFF], 4) == 0);
+    if (retx) {
+        _nodes[src].retx++;
+    }
+    else {
+        _nodes[src].delivered = false;
+    }
+    memcpy(_nodes[src].last_seq, &frame[ZEP_SEQ_OFF], 4);
+    _nodes[src].tx++;
+    for (unsigned dst = 0; dst < NODES_MAX; dst++) {
+        link_t *link = &_links[src][dst];
+
+        if ((_nodes[dst].addr.sin6_family != AF_INET6) || !link->up) {
+            continue;
+        }
+        if ((unsigned)(random() % LOSS_SCALE) < link->loss) {
+            _nodes[dst].lost++;
+            continue;
+        }
+        if ((int)dst == ack_from) {
+            link_t *back = &_links[dst][src];
+
+            acked = back->up &&
+                    ((unsigned)(random() % LOSS_SCALE) >= back->loss);
+            if (retx && _nodes[src].delivered) {
+                /* only the ACK got lost, the MAC of the node drops the
+                 * duplicate */
+                continue;
+            }
+            _nodes[src].delivered = true;
+        }
+        /* the receiver sees the link quality as LQI */
+        frame[ZEP_LQI_OFF] = 255 - ((255U * link->loss) / LOSS_SCALE);
+        if (link->delay_us == 0) {
+            _send(sock, dst, frame, len);
+        }
+        else if (!_queue_push(now + link->delay_us, dst, frame, len)) {
+            _nodes[dst].late++;
+        }
+    }
+    if (acked) {
+        /* the sender blocks while waiting, so the ACK has no delay */
+        _send_ack(sock, src, frame);
+    }
+}
+
+static void _print_node_stats(void)
+{
+    for (unsigned i = 0; i < NODES_MAX; i++) {
+        if (_nodes[i].addr.sin6_family != AF_INET6) {
+            continue;
+        }
+        printf("node %u: tx %lu, retx %lu, rx %lu, lost %lu, late %lu\n", i,
+               _nodes[i].tx, _nodes[i].retx, _nodes[i].rx, _nodes[i].lost,
+               _nodes[i].late);
+    }
+    fflush(stdout);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *addr = "::1", *port = "17754";
+    struct addrinfo hints = { .ai_family = AF_INET6,
+                              .ai_socktype = SOCK_DGRAM,
+                              .ai_flags = AI_PASSIVE };
+    struct addrinfo *res;
+    struct sigaction sa = { .sa_handler = _on_signal };
+    struct pollfd pfd;
+    unsigned seed = time(NULL);
+    int c, sock;
+
+    while ((c = getopt(argc, argv, "t:b:s:h")) != -1) {
+        switch (c) {
+            case 't':
+                if (_read_topology(optarg) < 0) {
+                    return 1;
+                }
+                break;
+            case 'b':
+                _base_port = atoi(optarg);
+                break;
+            case 's':
+                seed = strtoul(optarg, NULL, 0);
+                break;
+            default:
+                usage();
+                return 1;
+        }
+    }
+    if (optind < argc) {
+        addr = argv[optind++];
+    }
+    if (optind < argc) {
+        port = argv[optind++];
+    }
+    srandom(seed);
+
+    if ((c = getaddrinfo(addr, port, &hints, &res)) != 0) {
+        fprintf(stderr, "invalid address %s: %s\n", addr, gai_strerror(c));
+        return 1;
+    }
+    sock = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+    if ((sock < 0) || (bind(sock, res->ai_addr, res->ai_addrlen) < 0)) {
+        fprintf(stderr, "unable to bind to [%s]:%s: %s\n", addr, port,
+                strerror(errno));
+        return 1;
+    }
+    freeaddrinfo(res);
+
+    sigaction(SIGUSR1, &sa, NULL);
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    printf("dispatching on [%s]:%s\n", addr, port);
+    fflush(stdout);
+
+    pfd.fd = sock;
+    pfd.events = POLLIN;
+    while (!_quit) {
+        int timeout = -1;
+        uint64_t now = _now_us();
+
+        while ((_queue_len > 0) && (_queue[0].due_us <= now)) {
+            _send(sock, _queue[0].node, _queue[0].frame, _queue[0].len);
+            _queue_pop();
+        }
+        if (_queue_len > 0) {
+            timeout = ((_queue[0].due_us - now) + 999) / 1000;
+        }
+        if (_print_stats) {
+            _print_stats = 0;
+            _print_node_stats();
+        }
+        if (poll(&pfd, 1, timeout) > 0) {
+            uint8_t frame[FRAME_MAX];
+            struct sockaddr_in6 src;
+            socklen_t src_len = sizeof(src);
+            ssize_t len = recvfrom(sock, frame, sizeof(frame), 0,
+                                   (struct sockaddr *)&src, &src_len);
+            int node;
+
+            if ((len < ZEP_HDR_LEN) || (memcmp(frame, "EX", 2) != 0) ||
+                (frame[2] != 2) || (frame[ZEP_TYPE_OFF] != ZEP_TYPE_DATA)) {
+                continue;
+            }
+            if ((node = _get_node(&src)) < 0) {
+                fprintf(stderr, "no node number for port %u\n",
+                        ntohs(src.sin6_port));
+                continue;
+            }
+            _dispatch(sock, node, frame, len);
+        }
+    }
+    _print_node_stats();
+    close(sock);
+    return 0;
+}
@@ -253,14 +253,14 @@ int gcoap_cli_cmd(int argc, char **argv)
             puts("gcoap_cli: msg send failed");
         }
         else {
-            /* send Observe notification for /cli/stats */
-            switch (gcoap_obs_init(&pdu, &buf[0], GCOAP_PDU_BUF_SIZE,
+            /* send Observe notification for /cli/stats to all observers */
+            switch (gcoap_obs_notify_init(&pdu, &buf[0], GCOAP_PDU_BUF_SIZE,
                     &_resources[0])) {
             case GCOAP_OBS_INIT_OK:
                 DEBUG("gcoap_cli: creating /cli/stats notification\n");
                 size_t payload_len = fmt_u16_dec((char *)pdu.payload, req_count);
                 len = gcoap_finish(&pdu, payload_len, COAP_FORMAT_TEXT);
-                gcoap_obs_send(&buf[0], len, &_resources[0]);
+                gcoap_obs_notify(&pdu, len, &_resources[0]);
                 break;
             case GCOAP_OBS_INIT_UNUSED:
                 DEBUG("gcoap_cli: no observer for /cli/stats\n");
@@ -72,6 +72,10 @@
 #include "net/gcoap.h"
 #endif
 
+#ifdef MODULE_NANOCOAP_CACHE
+#include "net/nanocoap_cache.h"
+#endif
+
 #ifdef MODULE_GNRC_IPV6_NIB
 #include "net/gnrc/ipv6/nib.h"
 #endif
@@ -141,6 +145,10 @@ void auto_init(void)
     extern void openthread_bootstrap(void);
     openthread_bootstrap();
 #endif
+#ifdef MODULE_NANOCOAP_CACHE
+    DEBUG("Auto init nanocoap cache.\n");
+    nanocoap_cache_init();
+#endif
 #ifdef MODULE_GCOAP
     DEBUG("Auto init gcoap module.\n");
     gcoap_init();
@@ -261,6 +269,11 @@ void auto_init(void)
     auto_init_sx127x();
 #endif
 
+#ifdef MODULE_GNRC_NETIF_LO
+    extern void auto_init_gnrc_netif_lo(void);
+    auto_init_gnrc_netif_lo();
+#endif
+
 #endif /* MODULE_AUTO_INIT_GNRC_NETIF */
 
 #ifdef MODULE_GNRC_UHCPC
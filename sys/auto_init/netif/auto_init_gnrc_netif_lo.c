@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ *
+ */
+
+/**
+ * @ingroup sys_auto_init_gnrc_netif
+ * @{
+ *
+ * @file
+ * @brief   Auto initialization for the GNRC loopback interface
+ */
+
+#ifdef MODULE_GNRC_NETIF_LO
+
+#include "log.h"
+#include "net/gnrc/netif/lo.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/**
+ * @brief   Define stack parameters for the loopback interface thread
+ */
+#define GNRC_NETIF_LO_MAC_STACKSIZE (GNRC_NETIF_LO_STACKSIZE + DEBUG_EXTRA_STACKSIZE)
+#ifndef GNRC_NETIF_LO_MAC_PRIO
+#define GNRC_NETIF_LO_MAC_PRIO      (GNRC_NETIF_PRIO)
+#endif
+
+static char _lo_stack[GNRC_NETIF_LO_MAC_STACKSIZE];
+
+void auto_init_gnrc_netif_lo(void)
+{
+    LOG_DEBUG("[auto_init_netif] initializing loopback interface\n");
+    gnrc_netif_lo_create(_lo_stack, GNRC_NETIF_LO_MAC_STACKSIZE,
+                         GNRC_NETIF_LO_MAC_PRIO, "lo");
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif /* MODULE_GNRC_NETIF_LO */
+/** @} */
@@ -45,9 +45,18 @@
  *
  * gcoap allows an application to specify a collection of request resource paths
  * it wants to be notified about. Create an array of resources (coap_resource_t
- * structs). Note that the elements must be ordered alphabetically with respect
- * to the resource path. Use gcoap_register_listener() at application startup
- * to pass in these resources, wrapped in a gcoap_listener_t.
+ * structs). Use gcoap_register_listener() at application startup to pass in
+ * these resources, wrapped in a gcoap_listener_t. gcoap adds them to an index
+ * over the resource paths, so requests are dispatched without comparing the
+ * path with every resource. A resource with @ref COAP_MATCH_SUBTREE in its
+ * methods also handles all paths below its own path, unless a more specific
+ * resource exists.
+ *
+ * If the resources of all listeners don't fit into the index of
+ * @ref NANOCOAP_RESOURCE_INDEX_SIZE slots, gcoap falls back to scanning the
+ * listeners. Only then the resources of each listener must be ordered
+ * alphabetically with respect to the resource path, and
+ * @ref COAP_MATCH_SUBTREE is ignored.
  *
  * gcoap itself defines a resource for `/.well-known/core` discovery, which
  * lists all of the registered paths.
@@ -129,8 +138,10 @@
  *
  * A CoAP client may register for Observe notifications for any resource that
  * an application has registered with gcoap. An application does not need to
- * take any action to support Observe client registration. However, gcoap
- * limits registration for a given resource to a _single_ observer.
+ * take any action to support Observe client registration. Any number of
+ * clients may observe a resource, up to GCOAP_OBS_CLIENTS_MAX clients and
+ * GCOAP_OBS_REGISTRATIONS_MAX registrations overall. Both tables are hashed,
+ * so they may be sized for many observers.
  *
  * An Observe notification is considered a response to the original client
  * registration request. So, the Observe server only needs to create and send
@@ -152,6 +163,15 @@
  *
  * Finally, call gcoap_obs_send() for the resource.
  *
+ * gcoap_obs_send() sends the notification to all observers of the resource.
+ * It copies the notification for each observer but the one
+ * gcoap_obs_init() wrote the token for, into a buffer of
+ * @ref GCOAP_PDU_BUF_SIZE on the stack. To avoid the copies, use
+ * gcoap_obs_notify_init() instead of gcoap_obs_init(), and gcoap_obs_notify()
+ * instead of gcoap_obs_send(). The notification then is encoded only once,
+ * and gcoap_obs_notify() writes just the token and message ID of each
+ * observer in front of the encoded options and payload before sending it.
+ *
  * ### Other considerations ###
  *
  * By default, the value for the Observe option in a notification is three
@@ -168,6 +188,30 @@
  * the Observe option value set to 1. The server does not support cancellation
  * via a reset (RST) response to a non-confirmable notification.
  *
+ * ## Blockwise Transfers ##
+ *
+ * gcoap supports transfers of representations larger than
+ * @ref GCOAP_PDU_BUF_SIZE in blocks, as defined by RFC 7959.
+ *
+ * A server resource handler replies with one block at a time by calling
+ * coap_block2_reply() with a generator (coap_blockwise_cb_t) for the
+ * representation. The generator is only asked for the requested block, so the
+ * representation never needs to be held in memory as a whole.
+ *
+ * A client fetches a representation with gcoap_block2_get(). It keeps up to
+ * @ref GCOAP_NSTART block requests in flight, so blocks may arrive out of
+ * order; the handler (gcoap_block_handler_t) receives each block with its
+ * offset. @ref GCOAP_NSTART defaults to NSTART of RFC 7252, which is 1, so
+ * by default blocks are requested one at a time. Raise it to pipeline block
+ * requests to servers that accept several outstanding requests.
+ *
+ * A client sends a representation with gcoap_block1_send(), which takes it
+ * block by block from a generator. Block1 requests are sent one at a time,
+ * as the server must receive them in order.
+ *
+ * Each block is requested non-confirmable. A block that times out ends the
+ * transfer.
+ *
  * ## Implementation Notes ##
  *
  * ### Building a packet ###
@@ -186,8 +230,16 @@
  * We take advantage of RIOT's asynchronous messaging by using an xtimer to wait
  * for a response, so the gcoap thread does not block while waiting. The user is
  * notified via the same callback, whether the message is received or the wait
- * times out. We track the response with an entry in the
- * `_coap_state.open_reqs` array.
+ * times out. We track the response with a memo from a pool of
+ * @ref GCOAP_REQ_WAITING_MAX entries. Open memos are kept in a hash table
+ * indexed by the request token, so a response is matched to its request
+ * without comparing it to every open request.
+ *
+ * A client may have at most @ref GCOAP_NSTART requests outstanding with the
+ * same server. gcoap_req_send2() queues further requests to that server, and
+ * gcoap sends them in order as earlier requests complete. Their response
+ * timeouts start only once they are sent. A queued request holds its memo and
+ * one of the @ref GCOAP_RESEND_BUFS_MAX buffers, also if non-confirmable.
  *
  * ## Implementation Status ##
  * gcoap includes server and client capability. Available features include:
@@ -232,6 +284,11 @@ extern "C" {
 
 /**
  * @brief  Size for module message queue
+ *
+ * Receives the timeouts of open requests, so it should not be much smaller
+ * than @ref GCOAP_REQ_WAITING_MAX. A timeout lost to a full queue is only
+ * handled once gcoap next scans the open requests, so it is delayed by up to
+ * @ref GCOAP_RECV_TIMEOUT.
  */
 #ifndef GCOAP_MSG_QUEUE_SIZE
 #define GCOAP_MSG_QUEUE_SIZE    (4)
@@ -275,11 +332,34 @@ extern "C" {
 
 /**
  * @brief   Maximum number of requests awaiting a response
+ *
+ * Size of the pool request memos are allocated from.
  */
 #ifndef GCOAP_REQ_WAITING_MAX
 #define GCOAP_REQ_WAITING_MAX   (2)
 #endif
 
+/**
+ * @brief   Number of buckets in the hash table of requests awaiting a
+ *          response
+ *
+ * @note    Must be a power of 2.
+ */
+#ifndef GCOAP_REQ_HASH_SIZE
+#define GCOAP_REQ_HASH_SIZE     (8)
+#endif
+
+/**
+ * @brief   Maximum number of requests awaiting a response from the same
+ *          server
+ *
+ * Defaults to NSTART of RFC 7252, section 4.7. Further requests to the
+ * server are queued until one of them completes.
+ */
+#ifndef GCOAP_NSTART
+#define GCOAP_NSTART            (COAP_NSTART)
+#endif
+
 /**
  * @brief   Maximum length in bytes for a token
  */
@@ -311,8 +391,29 @@ extern "C" {
 #define GCOAP_MEMO_RESP         (2)     /**< Got response */
 #define GCOAP_MEMO_TIMEOUT      (3)     /**< Timeout waiting for response */
 #define GCOAP_MEMO_ERR          (4)     /**< Error processing response packet */
+#define GCOAP_MEMO_QUEUED       (5)     /**< Request queued until fewer than
+                                             @ref GCOAP_NSTART requests to
+                                             its server are open */
 /** @} */
 
+/**
+ * @name    States of a blockwise transfer, see gcoap_block_handler_t
+ * @{
+ */
+#define GCOAP_BLOCK_NEXT        (0)     /**< Got a block; transfer continues */
+#define GCOAP_BLOCK_DONE        (1)     /**< Transfer complete */
+#define GCOAP_BLOCK_ERR         (2)     /**< Transfer failed */
+/** @} */
+
+/**
+ * @brief   Largest block size for blockwise transfers, as SZX value
+ *
+ * gcoap uses smaller blocks if these don't fit into @ref GCOAP_PDU_BUF_SIZE.
+ */
+#ifndef GCOAP_BLOCK_SZX
+#define GCOAP_BLOCK_SZX         (COAP_BLOCKWISE_SZX_1024)
+#endif
+
 /**
  * @brief   Value for send_limit in request memo when non-confirmable type
  */
@@ -348,18 +449,33 @@ extern "C" {
 #define GCOAP_MSG_TYPE_INTR     (0x1502)
 
 /**
- * @brief   Maximum number of Observe clients; use 2 if not defined
+ * @brief   Maximum number of Observe clients; use 8 if not defined
+ *
+ * Size of the pool Observe clients are allocated from.
  */
 #ifndef GCOAP_OBS_CLIENTS_MAX
-#define GCOAP_OBS_CLIENTS_MAX   (2)
+#define GCOAP_OBS_CLIENTS_MAX   (8)
 #endif
 
 /**
- * @brief   Maximum number of registrations for Observable resources; use 2 if
+ * @brief   Maximum number of registrations for Observable resources; use 8 if
  *          not defined
  */
 #ifndef GCOAP_OBS_REGISTRATIONS_MAX
-#define GCOAP_OBS_REGISTRATIONS_MAX     (2)
+#define GCOAP_OBS_REGISTRATIONS_MAX     (8)
+#endif
+
+/**
+ * @brief   Number of hash buckets for Observe clients and registrations
+ *
+ * Clients are hashed by endpoint, registrations by resource, so a
+ * notification only walks the registrations of its own bucket. Must be a
+ * power of 2. The default gives one bucket per entry of the default pools;
+ * keep it near @ref GCOAP_OBS_CLIENTS_MAX and
+ * @ref GCOAP_OBS_REGISTRATIONS_MAX when changing those.
+ */
+#ifndef GCOAP_OBS_HASH_SIZE
+#define GCOAP_OBS_HASH_SIZE     (8)
 #endif
 
 /**
@@ -424,9 +540,13 @@ extern "C" {
 
 /**
  * @brief   Count of PDU buffers available for resending confirmable messages
+ *
+ * Limits the confirmable requests in flight, and the requests queued for
+ * @ref GCOAP_NSTART. Defaults to one buffer per request memo, so every open
+ * request may be confirmable.
  */
 #ifndef GCOAP_RESEND_BUFS_MAX
-#define GCOAP_RESEND_BUFS_MAX      (1)
+#define GCOAP_RESEND_BUFS_MAX      (GCOAP_REQ_WAITING_MAX)
 #endif
 
 /**
@@ -434,7 +554,7 @@ extern "C" {
  */
 typedef struct gcoap_listener {
     coap_resource_t *resources;     /**< First element in the array of
-                                     *   resources; must order alphabetically */
+                                     *   resources */
     size_t resources_len;           /**< Length of array */
     struct gcoap_listener *next;    /**< Next listener in list */
 } gcoap_listener_t;
@@ -456,10 +576,65 @@ typedef struct {
     size_t pdu_len;                     /**< Length of pdu_buf */
 } gcoap_resend_t;
 
+/**
+ * @brief   Forward declaration of the state of a blockwise transfer
+ */
+typedef struct gcoap_block_xfer gcoap_block_xfer_t;
+
+/**
+ * @brief   Handler for a blockwise transfer
+ *
+ * For gcoap_block2_get(), called with @ref GCOAP_BLOCK_NEXT for each block
+ * received, in any order. The payload of @p pdu starts at @p offset within
+ * the representation. Called with @ref GCOAP_BLOCK_DONE and no @p pdu once
+ * all blocks were received.
+ *
+ * For gcoap_block1_send(), called with @ref GCOAP_BLOCK_DONE and the final
+ * response of the server once it received all blocks.
+ *
+ * Both call it with @ref GCOAP_BLOCK_ERR if the transfer failed. @p pdu is
+ * the error response, or NULL on a timeout or send error. After
+ * @ref GCOAP_BLOCK_DONE or @ref GCOAP_BLOCK_ERR, gcoap no longer uses
+ * @p xfer.
+ *
+ * @param[in] xfer      The transfer
+ * @param[in] state     A GCOAP_BLOCK... state
+ * @param[in] pdu       Response, may be NULL
+ * @param[in] offset    Offset of the payload of @p pdu
+ */
+typedef void (*gcoap_block_handler_t)(gcoap_block_xfer_t *xfer, unsigned state,
+                                      coap_pkt_t *pdu, size_t offset);
+
+/**
+ * @brief   State of a blockwise transfer
+ *
+ * Allocated by the application, all members are private to gcoap.
+ */
+struct gcoap_block_xfer {
+    sock_udp_ep_t remote;               /**< Server */
+    const char *path;                   /**< Path of the resource */
+    gcoap_block_handler_t handler;      /**< Handler for the transfer */
+    coap_blockwise_cb_t gen;            /**< Generator of a Block1 request
+                                             body */
+    void *arg;                          /**< Argument for handler and gen */
+    unsigned code;                      /**< Request code */
+    unsigned szx;                       /**< Block size */
+    uint32_t base;                      /**< Block2: first block missing;
+                                             Block1: block to send */
+    uint32_t next;                      /**< Block2: next block to request */
+    uint32_t last;                      /**< Block2: last block, UINT32_MAX
+                                             while unknown */
+    uint32_t received;                  /**< Block2: blocks received after
+                                             base, bit 0 is base */
+    unsigned inflight;                  /**< Requests awaiting a response */
+};
+
 /**
  * @brief   Memo to handle a response for a request
  */
-typedef struct {
+typedef struct gcoap_request_memo {
+    struct gcoap_request_memo *next;    /**< Next memo in the same bucket of
+                                             the hash table of open requests */
     unsigned state;                     /**< State of this memo, a GCOAP_MEMO... */
     int send_limit;                     /**< Remaining resends, 0 if none;
                                              GCOAP_SEND_LIMIT_NON if non-confirmable */
@@ -471,14 +646,21 @@ typedef struct {
                                              supports resending message */
     sock_udp_ep_t remote_ep;            /**< Remote endpoint */
     gcoap_resp_handler_t resp_handler;  /**< Callback for the response */
+    gcoap_block_xfer_t *block_xfer;     /**< Blockwise transfer the request
+                                             belongs to, if any */
     xtimer_t response_timer;            /**< Limits wait for response */
-    msg_t timeout_msg;                  /**< For response timer */
+    uint16_t timeout_gen;               /**< Generation of response_timer,
+                                             tags its timeout messages */
+    volatile bool timeout_lost;         /**< Timeout of response_timer was
+                                             lost to a full message queue */
 } gcoap_request_memo_t;
 
 /**
  * @brief   Memo for Observe registration and notifications
  */
-typedef struct {
+typedef struct gcoap_observe_memo {
+    struct gcoap_observe_memo *next;    /**< Next registration in the same
+                                             hash bucket */
     sock_udp_ep_t *observer;            /**< Client endpoint; unused if null */
     coap_resource_t *resource;          /**< Entity being observed */
     uint8_t token[GCOAP_TOKENLEN_MAX];  /**< Client token for notifications */
@@ -565,7 +747,10 @@ static inline ssize_t gcoap_request(coap_pkt_t *pdu, uint8_t *buf, size_t len,
  * @param[in] remote        Destination for the packet
  * @param[in] resp_handler  Callback when response received, may be NULL
  *
- * @return  length of the packet
+ * If @ref GCOAP_NSTART requests to @p remote are awaiting a response, the
+ * request is queued and sent once one of them completes.
+ *
+ * @return  length of the packet, also if queued
  * @return  0 if cannot send
  */
 size_t gcoap_req_send2(const uint8_t *buf, size_t len,
@@ -589,6 +774,59 @@ size_t gcoap_req_send2(const uint8_t *buf, size_t len,
 size_t gcoap_req_send(const uint8_t *buf, size_t len, const ipv6_addr_t *addr,
                       uint16_t port, gcoap_resp_handler_t resp_handler);
 
+/**
+ * @brief   Fetches a representation blockwise (Block2)
+ *
+ * Requests block 0 with a GET request and, once the server confirmed the
+ * block size, up to @ref GCOAP_NSTART further blocks at a time.
+ *
+ * @param[out] xfer     State of the transfer, must stay valid until
+ *                      @p handler reports its end
+ * @param[in] remote    Server
+ * @param[in] path      Resource path, *must* start with '/' and stay valid
+ *                      like @p xfer
+ * @param[in] handler   Handler for the blocks
+ * @param[in] arg       Argument for @p handler, see gcoap_block_xfer_arg()
+ *
+ * @return  0 if the first block was requested
+ * @return  -ENOMEM if the request could not be sent
+ */
+int gcoap_block2_get(gcoap_block_xfer_t *xfer, const sock_udp_ep_t *remote,
+                     const char *path, gcoap_block_handler_t handler,
+                     void *arg);
+
+/**
+ * @brief   Sends a representation blockwise (Block1)
+ *
+ * @param[out] xfer     State of the transfer, must stay valid until
+ *                      @p handler reports its end
+ * @param[in] remote    Server
+ * @param[in] path      Resource path, *must* start with '/' and stay valid
+ *                      like @p xfer
+ * @param[in] code      Request code: COAP_METHOD_[POST|PUT]
+ * @param[in] gen       Generator of the representation
+ * @param[in] handler   Handler for the final response
+ * @param[in] arg       Argument for @p gen and @p handler
+ *
+ * @return  0 if the first block was sent
+ * @return  -ENOMEM if the request could not be sent
+ */
+int gcoap_block1_send(gcoap_block_xfer_t *xfer, const sock_udp_ep_t *remote,
+                      const char *path, unsigned code, coap_blockwise_cb_t gen,
+                      gcoap_block_handler_t handler, void *arg);
+
+/**
+ * @brief   Returns the argument given for a blockwise transfer
+ *
+ * @param[in] xfer      The transfer
+ *
+ * @return  The argument given to gcoap_block2_get() or gcoap_block1_send()
+ */
+static inline void *gcoap_block_xfer_arg(const gcoap_block_xfer_t *xfer)
+{
+    return xfer->arg;
+}
+
 /**
  * @brief   Initializes a CoAP response packet on a buffer
  *
@@ -625,9 +863,11 @@ static inline ssize_t gcoap_response(coap_pkt_t *pdu, uint8_t *buf,
 
 /**
  * @brief   Initializes a CoAP Observe notification packet on a buffer, for the
- *          observer registered for a resource
+ *          observers registered for a resource
  *
- * First verifies that an observer has been registered for the resource.
+ * First verifies that an observer has been registered for the resource, and
+ * writes the token of one of them. gcoap_obs_send() sends the notification
+ * to all of them.
  *
  * @param[out] pdu      Notification metadata
  * @param[out] buf      Buffer containing the PDU
@@ -643,26 +883,70 @@ int gcoap_obs_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
 
 /**
  * @brief   Sends a buffer containing a CoAP Observe notification to the
- *          observer registered for a resource
+ *          observers registered for a resource
  *
- * Assumes a single observer for a resource.
+ * Sends @p buf to the observer gcoap_obs_init() wrote the token for, and a
+ * copy with their own token and message ID to all other observers of the
+ * resource. Observers for which the copy would exceed
+ * @ref GCOAP_PDU_BUF_SIZE are skipped. gcoap_obs_notify() reaches all
+ * observers without copying.
  *
  * @param[in] buf Buffer containing the PDU
  * @param[in] len Length of the buffer
  * @param[in] resource Resource to send
  *
- * @return  length of the packet
+ * @return  length of the packet, if sent to at least one observer
  * @return  0 if cannot send
  */
 size_t gcoap_obs_send(const uint8_t *buf, size_t len,
                       const coap_resource_t *resource);
 
+/**
+ * @brief   Initializes a CoAP Observe notification packet on a buffer, for
+ *          all observers registered for a resource
+ *
+ * Like gcoap_obs_init(), but leaves room for the token of any observer in
+ * front of the header. So @p pdu's header does not start at @p buf, and the
+ * packet must be finished with gcoap_finish() and sent with
+ * gcoap_obs_notify().
+ *
+ * @param[out] pdu      Notification metadata
+ * @param[out] buf      Buffer containing the PDU
+ * @param[in] len       Length of the buffer
+ * @param[in] resource  Resource for the notification
+ *
+ * @return  GCOAP_OBS_INIT_OK     on success
+ * @return  GCOAP_OBS_INIT_ERR    on error
+ * @return  GCOAP_OBS_INIT_UNUSED if no observer for resource
+ */
+int gcoap_obs_notify_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                          const coap_resource_t *resource);
+
+/**
+ * @brief   Sends a CoAP Observe notification to all observers registered for
+ *          a resource
+ *
+ * For each observer, writes its token and a new message ID in front of the
+ * options and payload encoded in @p pdu, and sends the result. The header
+ * of @p pdu is overwritten by this.
+ *
+ * @param[in] pdu       Notification, from gcoap_obs_notify_init() and
+ *                      gcoap_finish()
+ * @param[in] len       Length of the notification, as returned by
+ *                      gcoap_finish()
+ * @param[in] resource  Resource for the notification
+ *
+ * @return  count of observers the notification was sent to
+ */
+size_t gcoap_obs_notify(coap_pkt_t *pdu, size_t len,
+                        const coap_resource_t *resource);
+
 /**
  * @brief   Provides important operational statistics
  *
  * Useful for monitoring.
  *
- * @return  count of unanswered requests
+ * @return  count of unanswered requests, including queued ones
  */
 uint8_t gcoap_op_state(void);
 
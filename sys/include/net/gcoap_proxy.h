@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gcoap
+ *
+ * @{
+ *
+ * @file
+ * @brief       Caching CoAP proxy for gcoap
+ *
+ * With the `gcoap_proxy` module, gcoap forwards GET requests to other
+ * servers and caches their responses in the @ref nanocoap_cache.h
+ * "nanocoap cache", for as long as their Max-Age allows.
+ *
+ * - As forward proxy, gcoap serves requests with a Proxy-Uri option of the
+ *   form `coap://[<IPv6 address>]:<port>/<path>?<query>`.
+ * - As reverse proxy, gcoap serves requests for the paths of the routes
+ *   added with gcoap_proxy_add_route(), and forwards them to the upstream
+ *   server of the route, with the same path.
+ *
+ * A request that is not answered from the cache is sent upstream with
+ * gcoap_req_send2(). Identical requests arriving meanwhile wait for the same
+ * response instead of being sent upstream again. Confirmable requests are
+ * acknowledged at once, and all waiting clients get the response as a
+ * separate, non-confirmable message. When a cached response with an ETag
+ * has gone stale, the proxy asks upstream to validate it instead of
+ * fetching it again. Responses from the cache carry the remaining freshness
+ * of the entry as their Max-Age.
+ *
+ * Only GET requests are proxied. The Observe option is not forwarded.
+ */
+
+#ifndef NET_GCOAP_PROXY_H
+#define NET_GCOAP_PROXY_H
+
+#include <stdint.h>
+
+#include "net/gcoap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximum number of requests sent upstream and awaiting a response
+ */
+#ifndef GCOAP_PROXY_PENDING_MAX
+#define GCOAP_PROXY_PENDING_MAX     (4)
+#endif
+
+/**
+ * @brief   Maximum number of clients waiting for the same upstream response
+ */
+#ifndef GCOAP_PROXY_WAITING_MAX
+#define GCOAP_PROXY_WAITING_MAX     (4)
+#endif
+
+/**
+ * @brief   Reverse proxy route
+ */
+typedef struct gcoap_proxy_route {
+    struct gcoap_proxy_route *next;     /**< Next route */
+    const char *path;                   /**< Path prefix of the requests */
+    sock_udp_ep_t upstream;             /**< Server to forward them to */
+} gcoap_proxy_route_t;
+
+/**
+ * @brief   Proxy statistics
+ */
+typedef struct {
+    uint32_t requests;                  /**< Requests proxied */
+    uint32_t hits;                      /**< Answered from the cache */
+    uint32_t coalesced;                 /**< Joined a request already sent
+                                             upstream */
+    uint32_t fetches;                   /**< Requests sent upstream */
+    uint32_t revalidated;               /**< Stale responses validated by
+                                             upstream */
+} gcoap_proxy_stats_t;
+
+/**
+ * @brief   Adds a reverse proxy route
+ *
+ * Requests for @p route's path, or a path below it, are forwarded to its
+ * upstream server. Routes are matched in the order they were added, before
+ * the resources of gcoap listeners. May be called from any thread, also
+ * while gcoap serves requests.
+ *
+ * @param[in] route     route to add; must stay valid
+ */
+void gcoap_proxy_add_route(gcoap_proxy_route_t *route);
+
+/**
+ * @brief   Reads the proxy statistics
+ *
+ * @param[out] stats    statistics since boot
+ */
+void gcoap_proxy_get_stats(gcoap_proxy_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GCOAP_PROXY_H */
+/** @} */
@@ -45,6 +45,9 @@
 #include "net/gnrc/netif/mac.h"
 #endif
 #include "net/netdev.h"
+#ifdef MODULE_NETSTATS_NEIGHBOR
+#include "net/netstats/neighbor.h"
+#endif
 #include "rmutex.h"
 
 #ifdef __cplusplus
@@ -93,6 +96,14 @@ typedef struct {
 #endif
 #if defined(MODULE_GNRC_SIXLOWPAN) || DOXYGEN
     gnrc_netif_6lo_t sixlo;                 /**< 6Lo component */
+#endif
+#if defined(MODULE_NETSTATS_NEIGHBOR) || DOXYGEN
+    /**
+     * @brief   Link quality of the neighbors of the interface
+     *
+     * @note    Only available with module `netstats_neighbor`
+     */
+    netstats_nb_table_t neighbors;
 #endif
     uint8_t cur_hl;                         /**< Current hop-limit for out-going packets */
     uint8_t device_type;                    /**< Device type */
@@ -32,10 +32,17 @@ extern "C" {
  *
  * @note    Intentionally not calling it `GNRC_NETIF_NUMOF` to not require
  *          rewrites throughout the stack.
+ *
+ * The loopback interface of `gnrc_netif_lo` takes a slot of its own, so the
+ * default accounts for it.
  */
 #ifndef GNRC_NETIF_NUMOF
+#ifdef MODULE_GNRC_NETIF_LO
+#define GNRC_NETIF_NUMOF            (2)
+#else
 #define GNRC_NETIF_NUMOF            (1)
 #endif
+#endif
 
 /**
  * @brief   Default priority for network interface threads
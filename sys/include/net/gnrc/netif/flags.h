@@ -128,6 +128,20 @@ enum {
  *          packet
  */
 #define GNRC_NETIF_FLAGS_MAC_RX_STARTED            (0x00008000U)
+
+/**
+ * @brief   Device calculates upper layer checksums of outgoing packets
+ *
+ * @see @ref NETOPT_CSUM_OFFLOAD_TX
+ */
+#define GNRC_NETIF_FLAGS_CSUM_OFFLOAD_TX           (0x00010000U)
+
+/**
+ * @brief   Device verifies upper layer checksums of incoming packets
+ *
+ * @see @ref NETOPT_CSUM_OFFLOAD_RX
+ */
+#define GNRC_NETIF_FLAGS_CSUM_OFFLOAD_RX           (0x00020000U)
 /** @} */
 
 #ifdef __cplusplus
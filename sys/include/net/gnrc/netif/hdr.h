@@ -70,6 +70,16 @@ extern "C" {
  *          this flag the same way it does @ref GNRC_NETIF_HDR_FLAGS_BROADCAST.
  */
 #define GNRC_NETIF_HDR_FLAGS_MULTICAST  (0x40)
+
+/**
+ * @brief   Upper layer checksums of the received packet are already verified.
+ *
+ * @details Set for packets received over an interface that offloads checksum
+ *          verification (see @ref NETOPT_CSUM_OFFLOAD) and for packets that
+ *          never left the host. Upper layer protocols must not calculate or
+ *          check the checksum of such packets.
+ */
+#define GNRC_NETIF_HDR_FLAGS_CSUM_VALID (0x20)
 /**
  * @}
  */
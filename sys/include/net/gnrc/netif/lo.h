@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup net_gnrc_netif
+ * @{
+ *
+ * @file
+ * @brief   Loopback interface for @ref net_gnrc_netif
+ *
+ * The loopback interface hands packets sent over it back to the network layer
+ * as received packets. The packet snips are only re-ordered into receive
+ * order, so neither payload nor headers are copied, unless they are shared
+ * with another thread. Upper layer checksums are neither calculated nor
+ * checked for packets over the loopback interface.
+ *
+ * The interface is assigned the loopback address `::1`. Multicast is not
+ * supported.
+ *
+ * Enable with `USEMODULE += gnrc_netif_lo`, which pulls in
+ * `auto_init_gnrc_netif` to create the interface. The interface takes one of
+ * the @ref GNRC_NETIF_NUMOF slots; the default is raised by one for it, but
+ * applications that set @ref GNRC_NETIF_NUMOF themselves need to count it.
+ */
+#ifndef NET_GNRC_NETIF_LO_H
+#define NET_GNRC_NETIF_LO_H
+
+#include "net/gnrc/netif.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Default stack size for the loopback interface's thread
+ */
+#ifndef GNRC_NETIF_LO_STACKSIZE
+#define GNRC_NETIF_LO_STACKSIZE     (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief   Creates the loopback network interface
+ *
+ * @param[in] stack     The stack for the network interface's thread.
+ * @param[in] stacksize Size of @p stack.
+ * @param[in] priority  Priority for the network interface's thread.
+ * @param[in] name      Name for the network interface. May be NULL.
+ *
+ * @see @ref gnrc_netif_create()
+ *
+ * @return  The network interface on success.
+ * @return  NULL, on error.
+ */
+gnrc_netif_t *gnrc_netif_lo_create(char *stack, int stacksize, char priority,
+                                   char *name);
+
+/**
+ * @brief   Gets the loopback network interface
+ *
+ * @return  The loopback network interface.
+ * @return  NULL, if it was not created (yet).
+ */
+gnrc_netif_t *gnrc_netif_lo_get(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_NETIF_LO_H */
+/** @} */
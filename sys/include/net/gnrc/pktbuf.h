@@ -284,6 +284,17 @@ gnrc_pktsnip_t *gnrc_pktbuf_duplicate_upto(gnrc_pktsnip_t *pkt, gnrc_nettype_t t
  * @details Statistics include maximum number of reserved bytes.
  */
 void gnrc_pktbuf_stats(void);
+
+/**
+ * @brief   Returns the high-water mark of the packet buffer
+ *
+ * @note    Only available with DEVELHELP defined.
+ *
+ * @return  position of the last byte of the packet buffer that was ever
+ *          allocated
+ * @return  0, if the implementation does not keep track of it
+ */
+size_t gnrc_pktbuf_get_max_used(void);
 #endif
 
 /* for testing */
@@ -29,6 +29,12 @@
  *   USEMODULE += auto_init_gnrc_rpl
  *   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  *
+ * - Adapt the trickle parameters of DIOs to the number of neighbors that
+ *   send DIOs in the DODAG, see trickle_adapt()
+ *   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ {.mk}
+ *   USEMODULE += gnrc_rpl_trickle_adapt
+ *   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
  * Auto-Initialization
  * -------------------
  *
@@ -193,12 +199,20 @@ extern "C" {
 /**
  * @brief   Number of implemented Objective Functions
  */
+#ifdef MODULE_GNRC_RPL_MRHOF
+#define GNRC_RPL_IMPLEMENTED_OFS_NUMOF (2)
+#else
 #define GNRC_RPL_IMPLEMENTED_OFS_NUMOF (1)
+#endif
 
 /**
  * @brief   Default Objective Code Point (OF0)
+ *
+ * Set to @ref GNRC_RPL_MRHOF_OCP to use MRHOF, with module `gnrc_rpl_mrhof`.
  */
+#ifndef GNRC_RPL_DEFAULT_OCP
 #define GNRC_RPL_DEFAULT_OCP (0)
+#endif
 
 /**
  * @brief   Default Instance ID
@@ -280,6 +294,18 @@ static inline bool GNRC_RPL_COUNTER_GREATER_THAN(uint8_t A, uint8_t B)
 #endif
 /** @} */
 
+/**
+ * @brief   Number of trickle intervals a DIO sender is counted as neighbor
+ *          by gnrc_rpl_trickle_adapt, at least
+ *
+ * The senders heard are kept in two generations; every this many intervals,
+ * the older generation is dropped. A sender is thus forgotten after one to
+ * two times this many intervals without a DIO from it.
+ */
+#ifndef GNRC_RPL_TRICKLE_ADAPT_INTERVALS
+#define GNRC_RPL_TRICKLE_ADAPT_INTERVALS (4U)
+#endif
+
 /**
  * @name Default parent and route entry lifetime
  * default lifetime will be multiplied by the lifetime unit to obtain the resulting lifetime
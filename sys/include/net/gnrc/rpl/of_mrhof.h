@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_rpl_mrhof Minimum Rank with Hysteresis Objective Function
+ * @ingroup     net_gnrc_rpl
+ * @brief       Implementation of MRHOF with the ETX metric
+ * @see <a href="https://tools.ietf.org/html/rfc6719">
+ *          RFC 6719
+ *      </a>
+ *
+ * MRHOF prefers the parent with the lowest path cost, the rank of the parent
+ * plus the ETX of the link to it, and only switches to another parent if that
+ * lowers the path cost by at least @ref GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD.
+ * The ETX of each link comes from the @ref net_netstats_neighbor "neighbor
+ * statistics" of the interface of the DODAG, read for all parents whenever
+ * they are sorted, i.e. on every DIO from any parent.
+ *
+ * The DODAG root selects the objective function: set
+ * @ref GNRC_RPL_DEFAULT_OCP to @ref GNRC_RPL_MRHOF_OCP on the root to use
+ * MRHOF. DIO messages do not carry a metric container; each node's rank is its
+ * path cost, which is at least its parent's rank plus the minimum hop rank
+ * increase.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Definitions for MRHOF
+ */
+#ifndef NET_GNRC_RPL_OF_MRHOF_H
+#define NET_GNRC_RPL_OF_MRHOF_H
+
+#include "net/gnrc/rpl/structs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Objective Code Point of MRHOF
+ */
+#define GNRC_RPL_MRHOF_OCP                      (1)
+
+/**
+ * @brief   Routing metric type of ETX, in gnrc_rpl_parent_t::link_metric_type
+ *
+ * gnrc_rpl_parent_t::link_metric then holds the ETX in units of
+ * 1 / @ref NETSTATS_NB_ETX_DIVISOR.
+ */
+#define GNRC_RPL_MRHOF_METRIC_ETX               (7)
+
+/**
+ * @brief   Largest ETX of a link to a parent, ETX 4
+ *
+ * Parents with a worse link are only chosen if there is no other.
+ */
+#ifndef GNRC_RPL_MRHOF_MAX_LINK_METRIC
+#define GNRC_RPL_MRHOF_MAX_LINK_METRIC          (512)
+#endif
+
+/**
+ * @brief   Largest path cost of a parent
+ *
+ * Parents with a higher path cost are never chosen; if there is no other,
+ * the node has no rank.
+ */
+#ifndef GNRC_RPL_MRHOF_MAX_PATH_COST
+#define GNRC_RPL_MRHOF_MAX_PATH_COST            (32768U)
+#endif
+
+/**
+ * @brief   Path cost by which another parent must be better to be switched
+ *          to, ETX 1.5
+ */
+#ifndef GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD
+#define GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD  (192)
+#endif
+
+/**
+ * @brief   Returns the MRHOF objective function
+ *
+ * @return  MRHOF
+ */
+gnrc_rpl_of_t *gnrc_rpl_get_of_mrhof(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_RPL_OF_MRHOF_H */
+/** @} */
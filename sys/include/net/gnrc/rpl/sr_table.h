@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_rpl_sr_table RPL source route table
+ * @ingroup     net_gnrc_rpl
+ * @brief       DAO parent graph of a non-storing mode root
+ * @see <a href="https://tools.ietf.org/html/rfc6550#section-9.7">
+ *          RFC 6550, section 9.7
+ *      </a>
+ *
+ * In non-storing mode, every node reports its parent to the DODAG root in
+ * the Transit Information option of its DAOs. The root keeps these reports
+ * in this table, one entry per target, each pointing to the entry of the
+ * target's parent by index. The source route to a target is the chain of
+ * parents up to the root, so it is found in O(depth).
+ *
+ * gnrc_rpl_sr_table_get_srh() builds the RPL source routing header
+ * (RFC 6554) for a target, with the prefixes shared with the first hop
+ * elided. The last headers built are cached per target, until the graph
+ * changes or one of the reports on the route expires.
+ *
+ * @note    This module is a building block and has to be selected
+ *          explicitly (`USEMODULE += gnrc_rpl_sr_table`). With it, a
+ *          non-storing mode root only fills the table: @ref net_gnrc_ipv6
+ *          does not insert source routing headers into the packets it sends
+ *          or forwards, so the root can't source route to its nodes yet.
+ *          Code that sends to nodes below the root has to insert the header
+ *          returned by gnrc_rpl_sr_table_get_srh() itself, and encapsulate
+ *          packets it did not originate (RFC 6554, section 4.1).
+ *          Also, RIOT nodes report their parents in storing mode only, so
+ *          the table is filled by the DAOs of other RPL implementations.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Source route table definitions
+ */
+#ifndef NET_GNRC_RPL_SR_TABLE_H
+#define NET_GNRC_RPL_SR_TABLE_H
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "net/ipv6/addr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of targets in the table
+ */
+#ifndef GNRC_RPL_SR_TABLE_SIZE
+#define GNRC_RPL_SR_TABLE_SIZE          (32U)
+#endif
+
+/**
+ * @brief   Longest source route, in hops from the root
+ */
+#ifndef GNRC_RPL_SR_TABLE_MAX_DEPTH
+#define GNRC_RPL_SR_TABLE_MAX_DEPTH     (16U)
+#endif
+
+/**
+ * @brief   Number of source routing headers cached
+ */
+#ifndef GNRC_RPL_SR_TABLE_CACHE_SIZE
+#define GNRC_RPL_SR_TABLE_CACHE_SIZE    (8U)
+#endif
+
+/**
+ * @brief   Size of a cached source routing header; longer headers are
+ *          built anew for every packet
+ */
+#ifndef GNRC_RPL_SR_TABLE_CACHE_SRH_LEN
+#define GNRC_RPL_SR_TABLE_CACHE_SRH_LEN (72U)
+#endif
+
+/**
+ * @brief   Empties the table
+ *
+ * @param[in] root  address of the DODAG root, the DODAG ID
+ */
+void gnrc_rpl_sr_table_init(const ipv6_addr_t *root);
+
+/**
+ * @brief   Adds or refreshes the parent of a target, as reported in a DAO
+ *
+ * @param[in] target    the target
+ * @param[in] parent    parent of @p target
+ * @param[in] lifetime  lifetime of the report in seconds, 0 to remove it
+ *
+ * @return  0 on success
+ * @return  -EINVAL if @p target is the root or @p parent
+ * @return  -ENOMEM if the table is full
+ */
+int gnrc_rpl_sr_table_add(const ipv6_addr_t *target, const ipv6_addr_t *parent,
+                          uint32_t lifetime);
+
+/**
+ * @brief   Removes the report of a target
+ *
+ * The entry is kept for as long as other targets have it as parent.
+ *
+ * @param[in] target    the target
+ */
+void gnrc_rpl_sr_table_del(const ipv6_addr_t *target);
+
+/**
+ * @brief   Builds the source routing header to a target
+ *
+ * gnrc_rpl_srh_t::nh of the header is left 0 for the caller to fill in.
+ *
+ * @param[in] target    the target
+ * @param[out] next_hop first hop of the route, the destination of the
+ *                      packet once the header is inserted
+ * @param[out] buf      buffer for the header
+ * @param[in] len       length of @p buf
+ *
+ * @return  length of the header in @p buf
+ * @return  0 if @p target is a child of the root and needs no header
+ * @return  -ENOENT if @p target is not in the table
+ * @return  -EHOSTUNREACH if the report of a node on the route is missing
+ *          or expired
+ * @return  -ELOOP if the route has a loop or is longer than
+ *          @ref GNRC_RPL_SR_TABLE_MAX_DEPTH
+ * @return  -ENOBUFS if @p len is too small
+ */
+ssize_t gnrc_rpl_sr_table_get_srh(const ipv6_addr_t *target,
+                                  ipv6_addr_t *next_hop, void *buf, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_RPL_SR_TABLE_H */
+/** @} */
@@ -283,6 +283,9 @@ typedef struct {
     void (*parent_state_callback)(gnrc_rpl_parent_t *, int, int); /**< retrieves the state of a parent*/
     void (*init)(void);  /**< OF specific init function */
     void (*process_dio)(void);  /**< DIO processing callback (acc. to OF0 spec, chpt 5) */
+    void (*update_parent)(gnrc_rpl_parent_t *); /**< updates the link metric of
+                                                     a parent, before the parents
+                                                     are sorted */
 } gnrc_rpl_of_t;
 
 /**
@@ -311,6 +314,13 @@ struct gnrc_rpl_dodag {
                                          (see @ref GNRC_RPL_REQ_DIO_OPTS "DIO Options") */
     evtimer_msg_event_t dao_event;  /**< DAO TX events (see @ref GNRC_RPL_MSG_TYPE_DODAG_DAO_TX) */
     trickle_t trickle;              /**< trickle representation */
+#ifdef MODULE_GNRC_RPL_TRICKLE_ADAPT
+    uint32_t dio_senders[2];        /**< hashes of the DIO senders heard, one
+                                         bit each; in the current and the
+                                         previous generation */
+    uint8_t dio_senders_age;        /**< trickle intervals of the current
+                                         generation of dio_senders */
+#endif
 };
 
 struct gnrc_rpl_instance {
@@ -14,6 +14,22 @@
  * @see <a href="https://tools.ietf.org/html/rfc4944#section-5.3">
  *          RFC 4944, section 5.3
  *      </a>
+ *
+ * Selective fragment recovery
+ * ===========================
+ *
+ * @experimental With the pseudo-module `gnrc_sixlowpan_frag_sfr`, which is
+ * off by default, the receiver of a datagram acknowledges its last fragment
+ * with a bitmap of the fragments it has, and the sender repeats the missing
+ * ones.
+ *
+ * @warning This is not the selective fragment recovery of RFC 8931 and does
+ *          not interoperate with it. Fragments keep the RFC 4944 format, but
+ *          the acknowledgment uses @ref SIXLOWPAN_SFR_ACK_DISP, a dispatch
+ *          RFC 4944 reserves for future use. Other implementations drop
+ *          it, or might misinterpret it once the dispatch is assigned. Only
+ *          enable the module in networks where all nodes run RIOT with it.
+ *
  * @{
  *
  * @file
@@ -30,9 +46,11 @@
 
 #include "byteorder.h"
 #include "kernel_types.h"
+#include "msg.h"
 #include "net/gnrc/pkt.h"
 #include "net/ieee802154.h"
 #include "net/sixlowpan.h"
+#include "timex.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -43,7 +61,10 @@ extern "C" {
  * @{
  */
 /**
- * @brief   Message type for passing one 6LoWPAN fragment down the network stack
+ * @brief   Message type for passing the next 6LoWPAN fragment down the network
+ *          stack
+ *
+ * Only used when fragments are paced (see @ref GNRC_SIXLOWPAN_FRAG_PACING_US)
  */
 #define GNRC_SIXLOWPAN_MSG_FRAG_SND         (0x0225)
 
@@ -51,6 +72,118 @@ extern "C" {
  * @brief   Message type for triggering garbage collection reassembly buffer
  */
 #define GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF     (0x0226)
+
+/**
+ * @brief   Message type for an expired selective fragment recovery
+ *          acknowledgment timeout
+ */
+#define GNRC_SIXLOWPAN_MSG_FRAG_SFR_TIMEOUT (0x0227)
+/** @} */
+
+/**
+ * @name    Compile time configuration
+ * @{
+ */
+/**
+ * @brief   Number of datagrams that can be reassembled at the same time
+ *
+ * @note    A slot only takes packet buffer space while it is in use, so it
+ *          is cheap to raise this value.
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_RBUF_SIZE
+#define GNRC_SIXLOWPAN_FRAG_RBUF_SIZE       (4U)
+#endif
+
+/**
+ * @brief   Timeout for reassembly in microseconds
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_RBUF_TIMEOUT_US
+#define GNRC_SIXLOWPAN_FRAG_RBUF_TIMEOUT_US (3U * US_PER_SEC)
+#endif
+
+/**
+ * @brief   Time in microseconds between sending two fragments of a datagram
+ *
+ * With the default of 0 all fragments of a datagram are handed to the
+ * interface at once. A gap between fragments gives slow links and
+ * forwarders with small queues time to keep up.
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_PACING_US
+#define GNRC_SIXLOWPAN_FRAG_PACING_US       (0U)
+#endif
+
+/**
+ * @brief   Time in microseconds the sender waits for an acknowledgment
+ *          after the last fragment of a datagram, before it sends the last
+ *          fragment again
+ *
+ * @note    Only used with module `gnrc_sixlowpan_frag_sfr`.
+ */
+#ifndef GNRC_SIXLOWPAN_SFR_ACK_TIMEOUT_US
+#define GNRC_SIXLOWPAN_SFR_ACK_TIMEOUT_US   (100U * US_PER_MS)
+#endif
+
+/**
+ * @brief   Maximum number of recovery rounds for a datagram
+ *
+ * A round is started either by an acknowledgment that reports missing
+ * fragments or by an expired @ref GNRC_SIXLOWPAN_SFR_ACK_TIMEOUT_US. The
+ * datagram is dropped after the last round.
+ *
+ * A peer that never sent an acknowledgment gets a single round. If it stays
+ * silent, it is assumed to not support selective fragment recovery and later
+ * datagrams to it are released right after their last fragment.
+ *
+ * @note    Only used with module `gnrc_sixlowpan_frag_sfr`.
+ */
+#ifndef GNRC_SIXLOWPAN_SFR_RETRIES
+#define GNRC_SIXLOWPAN_SFR_RETRIES          (4U)
+#endif
+
+/**
+ * @brief   Number of sent datagrams that can wait for their acknowledgment
+ *          at the same time
+ *
+ * A datagram waits for its acknowledgment outside of the fragmentation
+ * buffer, so the next datagram can be fragmented meanwhile. If all slots are
+ * taken, further datagrams are released after their last fragment without
+ * recovery.
+ *
+ * @note    Only used with module `gnrc_sixlowpan_frag_sfr`.
+ */
+#ifndef GNRC_SIXLOWPAN_SFR_DATAGRAMS_NUMOF
+#define GNRC_SIXLOWPAN_SFR_DATAGRAMS_NUMOF  (2U)
+#endif
+
+/**
+ * @brief   Number of peers the sender remembers whether they acknowledge
+ *          datagrams
+ *
+ * @note    Only used with module `gnrc_sixlowpan_frag_sfr`.
+ */
+#ifndef GNRC_SIXLOWPAN_SFR_PEERS_NUMOF
+#define GNRC_SIXLOWPAN_SFR_PEERS_NUMOF      (4U)
+#endif
+
+/**
+ * @brief   Number of datagrams that can be forwarded fragment by fragment at
+ *          the same time
+ *
+ * @note    Only used with module `gnrc_sixlowpan_frag_vrb`.
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_VRB_SIZE
+#define GNRC_SIXLOWPAN_FRAG_VRB_SIZE        (16U)
+#endif
+
+/**
+ * @brief   Time in microseconds a virtual reassembly buffer entry is kept
+ *          after the last fragment of its datagram was forwarded
+ *
+ * @note    Only used with module `gnrc_sixlowpan_frag_vrb`.
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT_US
+#define GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT_US  (GNRC_SIXLOWPAN_FRAG_RBUF_TIMEOUT_US)
+#endif
 /** @} */
 
 /**
@@ -92,6 +225,7 @@ typedef struct {
     uint16_t offset;        /**< Offset of the Nth fragment from the beginning of the
                              *   payload datagram */
     kernel_pid_t pid;       /**< PID of the interface */
+    uint16_t tag;           /**< Tag of the datagram */
 } gnrc_sixlowpan_msg_frag_t;
 
 /**
@@ -105,6 +239,11 @@ gnrc_sixlowpan_msg_frag_t *gnrc_sixlowpan_msg_frag_get(void);
 /**
  * @brief   Sends a packet fragmented
  *
+ * All fragments are handed to the interface at once, unless
+ * @ref GNRC_SIXLOWPAN_FRAG_PACING_US is set. If the packet is not kept for
+ * recovery and none of its snips is shared, each fragment takes its payload
+ * directly from the packet instead of a copy.
+ *
  * @pre `ctx != NULL`
  * @pre gnrc_sixlowpan_msg_frag_t::pkt of @p ctx is equal to @p pkt or
  *      `pkt == NULL`.
@@ -133,6 +272,41 @@ void gnrc_sixlowpan_frag_recv(gnrc_pktsnip_t *pkt, void *ctx, unsigned page);
  */
 void gnrc_sixlowpan_frag_gc_rbuf(void);
 
+/**
+ * @brief   Generates a new datagram tag
+ *
+ * All datagrams a node fragments, whether it originates or forwards them,
+ * share the same tag space.
+ *
+ * @return  A new datagram tag.
+ */
+uint16_t gnrc_sixlowpan_frag_next_tag(void);
+
+#if defined(MODULE_GNRC_SIXLOWPAN_FRAG_SFR) || defined(DOXYGEN)
+/**
+ * @brief   Handles a selective fragment recovery acknowledgment
+ *
+ * Releases the datagram that is waiting for the acknowledgment if it was
+ * received completely, and sends the fragments the receiver misses
+ * otherwise.
+ *
+ * @param[in] pkt       The packet containing the acknowledgment.
+ * @param[in] ctx       Context for the packet. May be NULL.
+ * @param[in] page      Current 6Lo dispatch parsing page.
+ */
+void gnrc_sixlowpan_frag_sfr_recv_ack(gnrc_pktsnip_t *pkt, void *ctx,
+                                      unsigned page);
+
+/**
+ * @brief   Handles an expired acknowledgment timeout
+ *
+ * @param[in] msg   The @ref GNRC_SIXLOWPAN_MSG_FRAG_SFR_TIMEOUT message.
+ *                  Messages of timeouts that were overtaken by an
+ *                  acknowledgment are ignored.
+ */
+void gnrc_sixlowpan_frag_sfr_timeout(msg_t *msg);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
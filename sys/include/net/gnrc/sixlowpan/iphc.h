@@ -34,6 +34,11 @@ extern "C" {
  *
  * @pre (dec_hdr != NULL) && (*dec_hdr != NULL) && ((*dec_hdr)->size >= sizeof(gnrc_ipv6_hdr_t))
  *
+ * If @p datagram_size is 0 and @p dec_hdr has exactly the size of an IPv6
+ * and an UDP header, a compressed UDP header is decompressed into the space
+ * behind the IPv6 header instead of a newly allocated snip. Reserved space
+ * that is not needed is released again.
+ *
  * @param[out] dec_hdr      A pre-allocated IPv6 header. Will not be inserted into
  *                          @p pkt. May change due to next headers being added in NHC.
  * @param[in] pkt           A received 6LoWPAN IPHC frame. IPHC dispatch will not
@@ -53,6 +58,10 @@ size_t gnrc_sixlowpan_iphc_decode(gnrc_pktsnip_t **dec_hdr, gnrc_pktsnip_t *pkt,
 /**
  * @brief   Compresses a 6LoWPAN for IPHC.
  *
+ * The compressed header replaces the IPv6 header in its own buffer, so no
+ * additional packet buffer space is needed. Only if the IPv6 header snip is
+ * shared with other users, the dispatch is allocated separately.
+ *
  * @param[in,out] pkt   A 6LoWPAN frame with an uncompressed IPv6 header to
  *                      send. Will be translated to an 6LoWPAN IPHC frame.
  *
@@ -93,7 +93,8 @@ int gnrc_tcp_open_active(gnrc_tcp_tcb_t *tcb,  uint8_t address_family,
  * @pre if local_port is not zero.
  *
  * @note Blocks until a connection has been established (incomming connection request
- *       to @p local_port) or an error occured.
+ *       to @p local_port) or an error occured. Connection requests are ignored
+ *       while no receive buffer is available, see GNRC_TCP_RCV_BUFFERS.
  *
  * @param[in,out] tcb              TCB holding the connection information.
  * @param[in]     address_family   Address family of @p local_addr.
@@ -108,12 +109,94 @@ int gnrc_tcp_open_active(gnrc_tcp_tcb_t *tcb,  uint8_t address_family,
  *            -EINVAL if @p address_family is not the same the address_family used in TCB.
  *                    or @p target_addr is invalid.
  *            -EISCONN if TCB is already in use.
- *            -ENOMEM if the receive buffer for the TCB could not be allocated.
- *            Hint: Increase "GNRC_TCP_RCV_BUFFERS".
  */
 int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, uint8_t address_family,
                           const char *local_addr, uint16_t local_port);
 
+/**
+ * @brief Initialize a TCB queue.
+ *
+ * @pre @p queue must not be NULL.
+ *
+ * @param[out] queue   TCB queue to initialize.
+ */
+void gnrc_tcp_tcb_queue_init(gnrc_tcp_tcb_queue_t *queue);
+
+/**
+ * @brief Listen for incoming connections with a backlog of TCBs.
+ *
+ * @pre gnrc_tcp_tcb_queue_init() must have been successfully called.
+ * @pre @p queue must not be NULL.
+ * @pre @p tcbs must not be NULL.
+ * @pre @p tcbs_len must not be zero.
+ * @pre if local_addr is not NULL, local_addr must be assigned to a network interface.
+ * @pre @p local_port must not be zero.
+ *
+ * @note Does not block. Every TCB in @p tcbs is initialized and put into
+ *       LISTEN state, so up to @p tcbs_len connections can be established
+ *       concurrently. Receive buffers are only allocated once a connection
+ *       request arrives. Established connections are retrieved with
+ *       gnrc_tcp_accept().
+ *
+ * @param[in,out] queue            TCB queue to listen on.
+ * @param[in]     tcbs             Array of TCBs holding the connections.
+ * @param[in]     tcbs_len         Number of TCBs in @p tcbs.
+ * @param[in]     address_family   Address family of @p local_addr.
+ *                                 If local_addr == NULL, address_family is ignored.
+ * @param[in]     local_addr       If not NULL the connections are bound to @p local_addr.
+ *                                 If NULL a connection request to all local ip
+ *                                 addresses is valied.
+ * @param[in]     local_port       Port number to listen on.
+ *
+ * @returns   Zero on success.
+ *            -EAFNOSUPPORT if local_addr != NULL and @p address_family is not supported.
+ *            -EINVAL if @p local_addr is invalid.
+ *            -EISCONN if @p queue is already listening.
+ *            -EADDRINUSE if another TCB is already listening on @p local_port.
+ */
+int gnrc_tcp_listen(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t *tcbs, size_t tcbs_len,
+                    uint8_t address_family, const char *local_addr, uint16_t local_port);
+
+/**
+ * @brief Accept an established connection from a listening TCB queue.
+ *
+ * @pre gnrc_tcp_listen() must have been successfully called on @p queue.
+ * @pre @p queue must not be NULL.
+ * @pre @p tcb must not be NULL.
+ *
+ * @note Each connection is returned only once. After gnrc_tcp_close() or
+ *       gnrc_tcp_abort() was called on an accepted TCB, it is put back into
+ *       LISTEN state by a following call of this function.
+ *
+ * @param[in,out] queue                      TCB queue to accept a connection from.
+ * @param[out]    tcb                        The TCB of the accepted connection.
+ * @param[in]     user_timeout_duration_us   Timeout for accept in microseconds.
+ *                                           If zero and no connection is established,
+ *                                           the function returns immediately.
+ *                                           If not zero the function blocks until
+ *                                           a connection is established or
+ *                                           @p user_timeout_duration_us microseconds passed.
+ *
+ * @returns   Zero on success.
+ *            -EINVAL if @p queue is not listening or stopped listening while waiting.
+ *            -EAGAIN if user_timeout_duration_us is zero and no connection is established.
+ *            -ETIMEDOUT if @p user_timeout_duration_us expired.
+ */
+int gnrc_tcp_accept(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t **tcb,
+                    const uint32_t user_timeout_duration_us);
+
+/**
+ * @brief Stop listening on a TCB queue.
+ *
+ * @pre @p queue must not be NULL.
+ *
+ * @note Connections that have not been accepted are aborted. Accepted
+ *       connections stay open and must be closed by the user.
+ *
+ * @param[in,out] queue   TCB queue to stop listening on.
+ */
+void gnrc_tcp_stop_listen(gnrc_tcp_tcb_queue_t *queue);
+
 /**
  * @brief Transmit data to connected peer.
  *
@@ -122,6 +205,9 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, uint8_t address_family,
  * @pre @p data must not be NULL.
  *
  * @note Blocks until up to @p len bytes were transmitted or an error occured.
+ *       Transmitted data is kept for retransmission until the peer
+ *       acknowledges it, the function does not wait for acknowledgments
+ *       unless the send window or the retransmission queue is full.
  *
  * @param[in,out] tcb                        TCB holding the connection information.
  * @param[in]     data                       Pointer to the data that should be transmitted.
@@ -139,6 +225,35 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, uint8_t address_family,
 ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                       const uint32_t user_timeout_duration_us);
 
+/**
+ * @brief Transmit a packet to connected peer without copying its payload.
+ *
+ * @pre gnrc_tcp_tcb_init() must have been successfully called.
+ * @pre @p tcb must not be NULL.
+ * @pre @p pkt must not be NULL and must not be shared.
+ *
+ * @note Blocks until all of @p pkt was transmitted or an error occured.
+ *       Every snip of @p pkt becomes the payload of its own segment. Snips
+ *       larger than a segment are split with gnrc_pktbuf_mark(), which may
+ *       copy, so snips should not exceed GNRC_TCP_MSS.
+ *
+ * @param[in,out] tcb                        TCB holding the connection information.
+ * @param[in]     pkt                        Payload chain to transmit. Consumed by the call,
+ *                                           parts that could not be transmitted are released.
+ * @param[in]     user_timeout_duration_us   If not zero and @p pkt was not completely
+ *                                           transmitted the function returns after
+ *                                           user_timeout_duration_us.
+ *                                           If zero, no timeout will be triggered.
+ *
+ * @returns   The number of transmitted bytes.
+ *            -ENOTCONN if connection is not established.
+ *            -ECONNRESET if connection was resetted by the peer.
+ *            -ECONNABORTED if the connection was aborted.
+ *            -ETIMEDOUT if @p user_timeout_duration_us expired.
+ */
+ssize_t gnrc_tcp_send_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt,
+                          const uint32_t user_timeout_duration_us);
+
 /**
  * @brief Receive Data from the peer.
  *
@@ -169,6 +284,53 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
 ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
                       const uint32_t user_timeout_duration_us);
 
+/**
+ * @brief Receive data from the peer as packet.
+ *
+ * @pre gnrc_tcp_tcb_init() must have been successfully called.
+ * @pre @p tcb must not be NULL.
+ * @pre @p pkt must not be NULL.
+ *
+ * @note Function blocks if user_timeout_duration_us is not zero. With
+ *       GNRC_TCP_RCV_QUEUE_SIZE > 0 received segments are returned without
+ *       copying. The payload is in the first snip of @p pkt, further snips
+ *       hold protocol headers. A returned packet keeps its share of the receive
+ *       window until it is released with gnrc_tcp_recv_pkt_release().
+ *       With GNRC_TCP_RCV_QUEUE_SIZE of 0, the default, received data is
+ *       copied into a new packet instead.
+ *
+ * @param[in,out] tcb                        TCB holding the connection information.
+ * @param[out]    pkt                        The received packet, payload first.
+ * @param[in]     user_timeout_duration_us   Timeout for receive in microseconds.
+ *                                           If zero and no data is available, the function
+ *                                           returns immediately. If not zero the function
+ *                                           blocks until data is available or
+ *                                           @p user_timeout_duration_us microseconds passed.
+ *
+ * @returns   The number of bytes in the payload of @p pkt.
+ *            -ENOTCONN if connection is not established.
+ *            -EAGAIN if  user_timeout_duration_us is zero and no data is available.
+ *            -ECONNRESET if connection was resetted by the peer.
+ *            -ECONNABORTED if the connection was aborted.
+ *            -ETIMEDOUT if @p user_timeout_duration_us expired.
+ *            -ENOMEM if buffered data could not be put into a packet.
+ */
+ssize_t gnrc_tcp_recv_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **pkt,
+                          const uint32_t user_timeout_duration_us);
+
+/**
+ * @brief Release a packet returned by gnrc_tcp_recv_pkt().
+ *
+ * @pre @p tcb must not be NULL.
+ * @pre @p pkt must not be NULL.
+ *
+ * @note Reopens the receive window, if @p pkt was held by the connection.
+ *
+ * @param[in,out] tcb   TCB @p pkt was received on.
+ * @param[in]     pkt   Packet to release.
+ */
+void gnrc_tcp_recv_pkt_release(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt);
+
 /**
  * @brief Close a TCP connection.
  *
@@ -68,17 +68,59 @@ extern "C" {
 #endif
 
 /**
- * @brief Number of preallocated receive buffers
+ * @brief Size of the receive buffer pool in multiples of GNRC_TCP_RCV_BUF_SIZE
  */
 #ifndef GNRC_TCP_RCV_BUFFERS
 #define GNRC_TCP_RCV_BUFFERS (1U)
 #endif
 
 /**
- * @brief Default receive buffer size
+ * @brief Maximum receive buffer size of a connection
+ *
+ * Values above GNRC_TCP_DEFAULT_WINDOW allow the receive window to grow.
  */
 #ifndef GNRC_TCP_RCV_BUF_SIZE
-#define GNRC_TCP_RCV_BUF_SIZE (GNRC_TCP_DEFAULT_WINDOW)
+#define GNRC_TCP_RCV_BUF_SIZE (GNRC_TCP_MSS * GNRC_TCP_MSS_MULTIPLICATOR)
+#endif
+
+/**
+ * @brief Allocation granularity of receive buffers
+ *
+ * A connection gets a receive buffer of GNRC_TCP_DEFAULT_WINDOW, rounded up to
+ * whole blocks, when it is synchronized. Once the peer used the whole receive
+ * window several times, the buffer grows, up to GNRC_TCP_RCV_BUF_SIZE, as long
+ * as the pool has free blocks left.
+ */
+#ifndef GNRC_TCP_RCV_BUF_BLOCK_SIZE
+#define GNRC_TCP_RCV_BUF_BLOCK_SIZE (GNRC_TCP_MSS)
+#endif
+
+/**
+ * @brief Number of received segments a connection keeps in the packet buffer
+ *
+ * Received segments are queued as they are, instead of being copied into the
+ * receive buffer, so gnrc_tcp_recv_pkt() can hand them to the application
+ * without copying. Queued payload still counts against the receive window. If
+ * zero, the default, all received data is copied into the receive buffer, and
+ * gnrc_tcp_recv_pkt() copies it once more into a new packet. Set it to the
+ * number of segments in the receive window to receive without copying.
+ */
+#ifndef GNRC_TCP_RCV_QUEUE_SIZE
+#define GNRC_TCP_RCV_QUEUE_SIZE (0U)
+#endif
+
+/**
+ * @brief Maximum number of unacknowledged data segments in flight
+ *
+ * Together with the peers receive window this limits how much data is sent
+ * without waiting for an acknowledgment. Every segment in flight stays in the
+ * packet buffer until it is acknowledged, so larger values need a larger
+ * GNRC_PKTBUF_SIZE. A value of 1 results in stop-and-wait behavior. Fast
+ * retransmit needs three duplicate acknowledgments and thus a value of at
+ * least 4, smaller values leave loss recovery to the retransmission timer.
+ */
+#ifndef GNRC_TCP_RETRANSMIT_QUEUE_SIZE
+#define GNRC_TCP_RETRANSMIT_QUEUE_SIZE (4U)
 #endif
 
 /**
@@ -70,22 +70,48 @@ typedef struct _transmission_control_block {
     uint32_t irs;          /**< Initial received sequence number */
     uint16_t mss;          /**< The peers MSS */
     uint32_t rtt_start;    /**< Timer value for rtt estimation */
+    uint32_t rtt_seq;      /**< AckNo. completing the current rtt measurement */
     int32_t rtt_var;       /**< Round trip time variance */
     int32_t srtt;          /**< Smoothed round trip time */
     int32_t rto;           /**< Retransmission timeout duration */
     uint8_t retries;       /**< Number of retransmissions */
+    uint32_t cwnd;         /**< Congestion window */
+    uint32_t ssthresh;     /**< Slow start threshold */
+    uint32_t recover;      /**< Highest SeqNo. sent when loss recovery started */
+    uint8_t dup_acks;      /**< Number of consecutive duplicate acknowledgments */
     xtimer_t tim_tout;     /**< Timer struct for timeouts */
     msg_t msg_tout;        /**< Message, sent on timeouts */
-    gnrc_pktsnip_t *pkt_retransmit;   /**< Pointer to packet in "retransmit queue" */
+    /** Unacknowledged segments, oldest first. The extra slot is kept for SYN and FIN */
+    gnrc_pktsnip_t *retransmit_queue[GNRC_TCP_RETRANSMIT_QUEUE_SIZE + 1];
+    uint8_t retransmit_queue_len;   /**< Number of segments in retransmit_queue */
     msg_t mbox_raw[GNRC_TCP_TCB_MBOX_SIZE];   /**< Msg queue for mbox */
     mbox_t mbox;             /**< TCB mbox for synchronization */
     uint8_t *rcv_buf_raw;    /**< Pointer to the receive buffer */
     ringbuffer_t rcv_buf;    /**< Receive buffer data structure */
+    uint8_t rcv_wnd_fills;   /**< Times the peer used the whole receive window */
+#if GNRC_TCP_RCV_QUEUE_SIZE > 0
+    gnrc_pktsnip_t *rcv_queue[GNRC_TCP_RCV_QUEUE_SIZE];  /**< Received segments, oldest first */
+    uint8_t rcv_queue_len;   /**< Number of segments in rcv_queue */
+    uint16_t rcv_queue_off;  /**< Bytes already read from the first segment in rcv_queue */
+    uint16_t rcv_pkt_bytes;  /**< Payload held in received segments, queued or passed to user */
+#endif
     mutex_t fsm_lock;        /**< Mutex for FSM access synchronization */
     mutex_t function_lock;   /**< Mutex for function call synchronization */
+    struct _gnrc_tcp_tcb_queue *queue;          /**< Listen queue, the TCB belongs to */
     struct _transmission_control_block *next;   /**< Pointer next TCB */
 } gnrc_tcp_tcb_t;
 
+/**
+ * @brief Queue of TCBs listening on the same port.
+ */
+typedef struct _gnrc_tcp_tcb_queue {
+    mutex_t lock;            /**< Mutex for access synchronization */
+    gnrc_tcp_tcb_t *tcbs;    /**< Array of TCBs that accept connections */
+    size_t tcbs_len;         /**< Number of TCBs in tcbs */
+    msg_t mbox_raw[GNRC_TCP_TCB_MBOX_SIZE];   /**< Msg queue for mbox */
+    mbox_t mbox;             /**< Queue mbox, notified on new connections */
+} gnrc_tcp_tcb_queue_t;
+
 #ifdef __cplusplus
 }
 #endif
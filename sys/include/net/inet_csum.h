@@ -73,6 +73,58 @@ static inline uint16_t inet_csum(uint16_t sum, const uint8_t *buf, uint16_t len)
     return inet_csum_slice(sum, buf, len, 0);
 }
 
+/**
+ * @brief   Incrementally updates a checksum field after a part of its domain
+ *          was changed.
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc1624">
+ *          RFC 1624
+ *      </a>
+ *
+ * @details Allows to update the checksum of a header or payload when fields
+ *          of it are rewritten (e.g. addresses on translation) without
+ *          recalculating the checksum over the whole domain.
+ *          @p old_data and @p new_data must start at the same, even offset
+ *          within the checksum domain.
+ *
+ * @param[in] csum      The checksum as found in the checksum field (i.e.
+ *                      normalized) in host byte-order.
+ * @param[in] old_data  The original data.
+ * @param[in] new_data  The data replacing @p old_data.
+ * @param[in] len       Length of @p old_data and @p new_data in byte.
+ *
+ * @return  The new (normalized) checksum in host byte-order.
+ */
+uint16_t inet_csum_update(uint16_t csum, const uint8_t *old_data,
+                          const uint8_t *new_data, size_t len);
+
+/**
+ * @brief   Incrementally updates a checksum field after a single 16-bit word
+ *          of its domain was changed.
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc1624">
+ *          RFC 1624
+ *      </a>
+ *
+ * @param[in] csum      The checksum as found in the checksum field (i.e.
+ *                      normalized) in host byte-order.
+ * @param[in] old_word  The original 16-bit word in host byte-order.
+ * @param[in] new_word  The 16-bit word replacing @p old_word in host
+ *                      byte-order.
+ *
+ * @return  The new (normalized) checksum in host byte-order.
+ */
+static inline uint16_t inet_csum_update16(uint16_t csum, uint16_t old_word,
+                                          uint16_t new_word)
+{
+    /* RFC 1624, eqn. 3: HC' = ~(~HC + ~m + m') */
+    uint32_t sum = (uint16_t)~csum + (uint16_t)~old_word + new_word;
+
+    sum = (sum & 0xffff) + (sum >> 16);
+    sum = (sum & 0xffff) + (sum >> 16);
+    return (uint16_t)~sum;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -52,6 +52,20 @@ extern "C" {
 #define NANOCOAP_URI_MAX        (64)
 /** @} */
 
+/**
+ * @brief   Number of slots of a resource index (coap_resource_index_t)
+ *
+ * Must be a power of 2. The index is most efficient if at most three
+ * quarters of the slots are used, so the default suits up to 12 resources.
+ * If there are more resources than slots, lookups fall back to scanning the
+ * resources, which must then be ordered alphabetically by path, and
+ * @ref COAP_MATCH_SUBTREE is ignored. Applications with many resources
+ * should enlarge the index, e.g. to 128 slots for up to 96 resources.
+ */
+#ifndef NANOCOAP_RESOURCE_INDEX_SIZE
+#define NANOCOAP_RESOURCE_INDEX_SIZE    (16U)
+#endif
+
 #ifdef MODULE_GCOAP
 #define NANOCOAP_URL_MAX        NANOCOAP_URI_MAX
 #define NANOCOAP_QS_MAX         (64)
@@ -62,14 +76,31 @@ extern "C" {
  * @{
  */
 #define COAP_OPT_URI_HOST       (3)
+#define COAP_OPT_ETAG           (4)
 #define COAP_OPT_OBSERVE        (6)
+#define COAP_OPT_URI_PORT       (7)
 #define COAP_OPT_URI_PATH       (11)
 #define COAP_OPT_CONTENT_FORMAT (12)
+#define COAP_OPT_MAX_AGE        (14)
 #define COAP_OPT_URI_QUERY      (15)
 #define COAP_OPT_BLOCK2         (23)
 #define COAP_OPT_BLOCK1         (27)
+#define COAP_OPT_PROXY_URI      (35)
+#define COAP_OPT_PROXY_SCHEME   (39)
 /** @} */
 
+/**
+ * @brief   Maximum length of an ETag option value
+ */
+#define COAP_ETAG_LENGTH_MAX    (8U)
+
+/**
+ * @brief   Tests if an option is excluded from the cache key of a request
+ *
+ * See RFC 7252, section 5.4.6.
+ */
+#define COAP_OPT_IS_NO_CACHE_KEY(num)   (((num) & 0x1e) == 0x1c)
+
 /**
  * @name    CoAP packet types
  * @{
@@ -107,6 +138,8 @@ extern "C" {
 #define COAP_POST               (0x2)
 #define COAP_PUT                (0x4)
 #define COAP_DELETE             (0x8)
+#define COAP_MATCH_SUBTREE      (0x8000) /**< resource also handles all paths
+                                          *   below its own path */
 /** @} */
 
 /**
@@ -223,6 +256,8 @@ extern "C" {
 #define COAP_BLOCKWISE_MORE_OFF (3)
 #define COAP_BLOCKWISE_SZX_MASK (0x07)
 #define COAP_BLOCKWISE_SZX_MAX  (7)
+/** @brief  largest SZX value for a regular (not BERT) block, 1024 bytes */
+#define COAP_BLOCKWISE_SZX_1024 (6)
 /** @} */
 
 /**
@@ -249,6 +284,9 @@ typedef struct __attribute__((packed)) {
 
 /**
  * @brief   CoAP option array entry
+ *
+ * The option array of a coap_pkt_t holds one entry for each option number in
+ * the packet, for the first option with that number, in ascending order.
  */
 typedef struct {
     uint16_t opt_num;           /**< full CoAP option number    */
@@ -264,6 +302,9 @@ typedef struct {
     uint8_t *payload;                           /**< pointer to payload      */
     uint16_t payload_len;                       /**< length of payload       */
     uint16_t options_len;                       /**< length of options array */
+    uint32_t options_map;                       /**< bit n set if option n
+                                                     (< 32) is in options
+                                                     array; indexes it   */
     coap_optpos_t options[NANOCOAP_NOPTS_MAX];  /**< option offset array     */
 #ifdef MODULE_GCOAP
     uint8_t url[NANOCOAP_URI_MAX];              /**< parsed request URL      */
@@ -288,8 +329,24 @@ typedef struct {
     void *context;                  /**< ptr to user defined context data   */
 } coap_resource_t;
 
+/**
+ * @brief   Hash table over the paths of a set of resources
+ *
+ * Resources are found in constant time instead of comparing the request path
+ * with each of them. Resources flagged with @ref COAP_MATCH_SUBTREE are found
+ * by looking up each ancestor of the request path, so the most specific one
+ * wins.
+ */
+typedef struct {
+    const coap_resource_t *slots[NANOCOAP_RESOURCE_INDEX_SIZE]; /**< open addressing
+                                                                 *   slots */
+    unsigned numof;                 /**< number of used slots               */
+} coap_resource_index_t;
+
 /**
  * @brief   Block1 helper struct
+ *
+ * Also used for the Block2 option, see coap_get_block2().
  */
 typedef struct {
     size_t offset;                  /**< offset of received data            */
@@ -299,8 +356,32 @@ typedef struct {
                                           1 for more blocks coming          */
 } coap_block1_t;
 
+/**
+ * @brief   Generator for a representation that is transferred blockwise
+ *
+ * Writes the part of the representation starting at @p offset to @p buf.
+ * The representation is never needed as a whole, so it may be produced on
+ * the fly, e.g. read from flash.
+ *
+ * @param[in]   ctx         context of the generator
+ * @param[in]   offset      offset of the part within the representation
+ * @param[out]  buf         buffer to write the part to
+ * @param[in]   len         size of @p buf
+ *
+ * @returns     number of bytes written to @p buf, less than @p len only at
+ *              the end of the representation
+ * @returns     <0 on error
+ */
+typedef ssize_t (*coap_blockwise_cb_t)(void *ctx, size_t offset, uint8_t *buf,
+                                       size_t len);
+
 /**
  * @brief   Global CoAP resource list
+ *
+ * coap_handle_req() builds a resource index (coap_resource_index_t) over the
+ * list on the first request. Only if the list has more entries than
+ * @ref NANOCOAP_RESOURCE_INDEX_SIZE, it must be ordered alphabetically with
+ * respect to the resource path, and @ref COAP_MATCH_SUBTREE is ignored.
  */
 extern const coap_resource_t coap_resources[];
 
@@ -309,6 +390,45 @@ extern const coap_resource_t coap_resources[];
  */
 extern const unsigned coap_resources_numof;
 
+/**
+ * @brief   Initializes an empty resource index
+ *
+ * @param[out] index    resource index to initialize
+ */
+void coap_resource_index_init(coap_resource_index_t *index);
+
+/**
+ * @brief   Adds a resource to a resource index
+ *
+ * Several resources may share a path if they allow different methods.
+ *
+ * @param[in,out] index     resource index to add to
+ * @param[in] resource      resource to add. Must stay valid as long as
+ *                          @p index is used.
+ *
+ * @returns     0 on success
+ * @returns     -ENOSPC if @p index is full
+ */
+int coap_resource_index_add(coap_resource_index_t *index,
+                            const coap_resource_t *resource);
+
+/**
+ * @brief   Finds the resource for a request path in a resource index
+ *
+ * @param[in] index         resource index to search
+ * @param[in] path          request path
+ * @param[in] method_flag   method of the request, see coap_method2flag()
+ * @param[out] resource     the resource found
+ *
+ * @returns     0 if a resource was found
+ * @returns     -ENOENT if no resource matches @p path
+ * @returns     -EPERM if resources match @p path, but none of them allows
+ *              @p method_flag
+ */
+int coap_resource_index_find(const coap_resource_index_t *index,
+                             const char *path, unsigned method_flag,
+                             const coap_resource_t **resource);
+
 /**
  * @brief   Parse a CoAP PDU
  *
@@ -449,6 +569,20 @@ size_t coap_put_option(uint8_t *buf, uint16_t lastonum, uint16_t onum, uint8_t *
  */
 size_t coap_put_option_ct(uint8_t *buf, uint16_t lastonum, uint16_t content_type);
 
+/**
+ * @brief   Insert a uint option into buffer
+ *
+ * @param[out]  buf         buffer to write to
+ * @param[in]   lastonum    number of previous option (for delta calculation),
+ *                          or 0 if first option
+ * @param[in]   onum        number of option
+ * @param[in]   value       value to set, encoded with as few bytes as possible
+ *
+ * @returns     amount of bytes written to @p buf
+ */
+size_t coap_put_option_uint(uint8_t *buf, uint16_t lastonum, uint16_t onum,
+                            uint32_t value);
+
 /**
  * @brief   Insert URI encoded option into buffer
  *
@@ -528,6 +662,57 @@ size_t coap_put_option_block1(uint8_t *buf, uint16_t lastonum, unsigned blknum,
  */
 size_t coap_put_block1_ok(uint8_t *pkt_pos, coap_block1_t *block1, uint16_t lastonum);
 
+/**
+ * @brief    Block2 option getter
+ *
+ * Like coap_get_block1(), for the Block2 option.
+ *
+ * @param[in]   pkt     pkt to work on
+ * @param[out]  block2  ptr to preallocated coap_block1_t structure
+ *
+ * @returns     0 if block2 option not present
+ * @returns     1 if structure has been filled
+ */
+int coap_get_block2(coap_pkt_t *pkt, coap_block1_t *block2);
+
+/**
+ * @brief   Insert block2 option into buffer
+ *
+ * @param[out]  buf         buffer to write to
+ * @param[in]   lastonum    number of previous option (for delta calculation),
+ *                          must be < 23
+ * @param[in]   blknum      block number
+ * @param[in]   szx         SXZ value
+ * @param[in]   more        more flag (1 or 0)
+ *
+ * @returns     amount of bytes written to @p buf
+ */
+size_t coap_put_option_block2(uint8_t *buf, uint16_t lastonum, unsigned blknum, unsigned szx, int more);
+
+/**
+ * @brief   Create a reply with one block of a representation (RFC 7959)
+ *
+ * Replies with the block of the representation requested by the Block2
+ * option of @p pkt, or with the first block if the request has none. Only
+ * this block is taken from @p cb. The block size is the requested one, unless
+ * the block does not fit into @p buf, in which case a smaller one is used.
+ *
+ * Can be used as the whole body of a resource handler, in nanocoap as well as
+ * in gcoap.
+ *
+ * @param[in]   pkt         request to reply to
+ * @param[out]  buf         buffer to write reply to, may hold @p pkt
+ * @param[in]   len         size of @p buf
+ * @param[in]   ct          content type of the representation
+ * @param[in]   cb          generator of the representation
+ * @param[in]   ctx         context passed to @p cb
+ *
+ * @returns     size of reply packet on success
+ * @returns     <0 on error
+ */
+ssize_t coap_block2_reply(coap_pkt_t *pkt, uint8_t *buf, size_t len,
+                          unsigned ct, coap_blockwise_cb_t cb, void *ctx);
+
 /**
  * @brief   Encode the given string as option(s) into pkt
  *
@@ -574,6 +759,65 @@ ssize_t coap_opt_add_uint(coap_pkt_t *pkt, uint16_t optnum, uint32_t value);
  */
 ssize_t coap_opt_finish(coap_pkt_t *pkt, uint16_t flags);
 
+/**
+ * @brief   Find an option in a parsed packet
+ *
+ * Options numbered below 32 are found in constant time through the packet's
+ * option index, higher numbers by a scan of the few options above them.
+ *
+ * @param[in]   pkt     packet to work on
+ * @param[in]   opt_num option number to look for
+ *
+ * @returns     pointer to the first option with number @p opt_num
+ * @returns     NULL if @p pkt has no such option
+ */
+uint8_t *coap_find_option(coap_pkt_t *pkt, unsigned opt_num);
+
+/**
+ * @brief   Get the value of a uint option from packet
+ *
+ * @param[in]   pkt     packet to work on
+ * @param[in]   opt_num option number to look for
+ * @param[out]  target  value of the option
+ *
+ * @returns     0 on success
+ * @returns     -ENOSPC if the option is longer than 4 bytes
+ * @returns     -EBADMSG if the option's length is invalid
+ * @returns     -1 if @p pkt has no such option
+ */
+int coap_get_option_uint(coap_pkt_t *pkt, unsigned opt_num, uint32_t *target);
+
+/**
+ * @brief   Get the value of an option as an opaque array of bytes
+ *
+ * @param[in]   pkt     packet to work on
+ * @param[in]   opt_num option number to look for
+ * @param[out]  value   start of the option value, within @p pkt
+ *
+ * @returns     length of the option value
+ * @returns     -EBADMSG if the option's length is invalid
+ * @returns     -ENOENT if @p pkt has no such option
+ */
+ssize_t coap_opt_get_opaque(coap_pkt_t *pkt, unsigned opt_num, uint8_t **value);
+
+/**
+ * @brief   Iterates over the options of a parsed packet
+ *
+ * Unlike coap_find_option(), also reads repeated options.
+ *
+ * @param[in]     pkt       packet to work on
+ * @param[in,out] opt       iterator state; on return, opt_num is the number
+ *                          of the option read
+ * @param[out]    value     start of the option value
+ * @param[in]     init_opt  true to read the first option of @p pkt
+ *
+ * @returns     length of the option value
+ * @returns     -ENOENT if there are no more options
+ * @returns     -EBADMSG if the option is malformed
+ */
+ssize_t coap_opt_get_next(coap_pkt_t *pkt, coap_optpos_t *opt,
+                          uint8_t **value, bool init_opt);
+
 /**
  * @brief   Get content type from packet
  *
@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_nanocoap
+ *
+ * @{
+ *
+ * @file
+ * @brief       nanocoap response cache
+ *
+ * Stores responses by the cache key of the request they answer (RFC 7252,
+ * section 5.6), for the time given by their Max-Age option. The cache has
+ * NANOCOAP_CACHE_ENTRIES entries of fixed size; when all are in use, the
+ * least recently used entry is replaced.
+ *
+ * The cache is not thread-safe. Use it from a single thread, like the
+ * gcoap thread does for the gcoap proxy.
+ */
+
+#ifndef NET_NANOCOAP_CACHE_H
+#define NET_NANOCOAP_CACHE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "net/nanocoap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of cache entries
+ */
+#ifndef NANOCOAP_CACHE_ENTRIES
+#define NANOCOAP_CACHE_ENTRIES          (8)
+#endif
+
+/**
+ * @brief   Maximum length of the options and payload of a cached response
+ */
+#ifndef NANOCOAP_CACHE_RESPONSE_SIZE
+#define NANOCOAP_CACHE_RESPONSE_SIZE    (128)
+#endif
+
+/**
+ * @brief   Length of a cache key; a truncated SHA-256 digest
+ */
+#define NANOCOAP_CACHE_KEY_LENGTH       (16)
+
+/**
+ * @brief   Max-Age of a response without Max-Age option, in seconds
+ */
+#define NANOCOAP_CACHE_MAX_AGE_DEFAULT  (60U)
+
+/**
+ * @brief   Cache entry
+ */
+typedef struct nanocoap_cache_entry {
+    struct nanocoap_cache_entry *next;  /**< Next entry, in order of use */
+    uint8_t cache_key[NANOCOAP_CACHE_KEY_LENGTH];
+                                        /**< Cache key of the request */
+    uint32_t max_age;                   /**< Time the entry becomes stale, in
+                                             seconds of
+                                             nanocoap_cache_now() */
+    uint8_t code;                       /**< Code of the response */
+    uint8_t etag_len;                   /**< Length of etag, 0 if none */
+    uint8_t etag[COAP_ETAG_LENGTH_MAX]; /**< ETag of the response */
+    uint16_t response_len;              /**< Length of response_buf */
+    uint8_t response_buf[NANOCOAP_CACHE_RESPONSE_SIZE];
+                                        /**< Options and payload of the
+                                             response, without header and
+                                             token */
+} nanocoap_cache_entry_t;
+
+/**
+ * @brief   Empties the cache
+ */
+void nanocoap_cache_init(void);
+
+/**
+ * @brief   Returns the current time of the cache, in seconds
+ */
+uint32_t nanocoap_cache_now(void);
+
+/**
+ * @brief   Generates the cache key of a request
+ *
+ * The key covers the request method and all options except the NoCacheKey
+ * ones, but not the token or the message ID.
+ *
+ * @param[in]  req          parsed request
+ * @param[out] cache_key    cache key, NANOCOAP_CACHE_KEY_LENGTH bytes
+ */
+void nanocoap_cache_key_generate(coap_pkt_t *req, uint8_t *cache_key);
+
+/**
+ * @brief   Looks up the cached response for a cache key
+ *
+ * Marks the entry as used most recently. The entry may be stale, see
+ * nanocoap_cache_entry_is_stale().
+ *
+ * @param[in] cache_key     cache key of the request
+ *
+ * @return  cache entry
+ * @return  NULL if no response is cached for @p cache_key
+ */
+nanocoap_cache_entry_t *nanocoap_cache_key_lookup(const uint8_t *cache_key);
+
+/**
+ * @brief   Caches a response
+ *
+ * Replaces the entry for @p cache_key, or else takes an unused entry, or
+ * else the least recently used one.
+ *
+ * @param[in] cache_key     cache key of the request
+ * @param[in] resp          parsed response
+ *
+ * @return  cache entry
+ * @return  NULL if @p resp is too large for an entry
+ */
+nanocoap_cache_entry_t *nanocoap_cache_add_by_key(const uint8_t *cache_key,
+                                                  coap_pkt_t *resp);
+
+/**
+ * @brief   Makes an entry fresh again, with the Max-Age of a response
+ *
+ * For a 2.03 (Valid) response to a request carrying the entry's ETag.
+ *
+ * @param[in,out] ce        cache entry
+ * @param[in]     resp      parsed response
+ */
+void nanocoap_cache_refresh(nanocoap_cache_entry_t *ce, coap_pkt_t *resp);
+
+/**
+ * @brief   Removes an entry from the cache
+ *
+ * @param[in] ce            cache entry
+ */
+void nanocoap_cache_del(nanocoap_cache_entry_t *ce);
+
+/**
+ * @brief   Tests if a cache entry is stale
+ *
+ * @param[in] ce            cache entry
+ * @param[in] now           current time, from nanocoap_cache_now()
+ *
+ * @return  true if the Max-Age of the entry has passed
+ */
+static inline bool nanocoap_cache_entry_is_stale(const nanocoap_cache_entry_t *ce,
+                                                 uint32_t now)
+{
+    return (int32_t)(ce->max_age - now) <= 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_NANOCOAP_CACHE_H */
+/** @} */
@@ -554,6 +554,20 @@ typedef enum {
      */
     NETOPT_PHY_BUSY,
 
+    /**
+     * @brief   (uint8_t) upper layer checksum offload capabilities of the
+     *          device
+     *
+     * Bit field of @ref netopt_csum_offload_t. Read-only.
+     *
+     * With @ref NETOPT_CSUM_OFFLOAD_TX the device calculates the checksums of
+     * upper layer protocols (UDP, TCP, ICMPv6) of outgoing packets itself,
+     * with @ref NETOPT_CSUM_OFFLOAD_RX it only passes up incoming packets
+     * whose upper layer checksums are valid (or, e.g. for virtual links,
+     * can not have been corrupted in transit).
+     */
+    NETOPT_CSUM_OFFLOAD,
+
     /* add more options if needed */
 
     /**
@@ -596,6 +610,16 @@ typedef enum {
     /* add other states if needed */
 } netopt_state_t;
 
+/**
+ * @brief   Flags to be used with @ref NETOPT_CSUM_OFFLOAD
+ */
+typedef enum {
+    NETOPT_CSUM_OFFLOAD_TX = 0x01,  /**< checksums of outgoing packets are
+                                     *   calculated by the device */
+    NETOPT_CSUM_OFFLOAD_RX = 0x02,  /**< checksums of incoming packets are
+                                     *   verified by the device */
+} netopt_csum_offload_t;
+
 /**
  * @brief   Option parameter to be used with @ref NETOPT_RF_TESTMODE
  */
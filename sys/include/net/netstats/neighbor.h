@@ -0,0 +1,193 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_netstats_neighbor Link quality of neighbors
+ * @ingroup     net_netstats
+ * @brief       Estimates the link quality to neighbors from link layer events
+ *
+ * Every network interface keeps a table of its neighbors, by link layer
+ * address. For each neighbor, the table holds the expected transmission
+ * count (ETX) of the link, and the RSSI and LQI of the last frame received
+ * from it.
+ *
+ * The ETX is a moving average of the number of transmissions a frame to the
+ * neighbor took, as reported by the device when the transmission completes.
+ * A frame that was never acknowledged counts as
+ * @ref NETSTATS_NB_ETX_NOACK_PENALTY transmissions. Until the first
+ * transmission, the ETX is estimated from the LQI of the frames received from
+ * the neighbor, if the device reports one.
+ *
+ * Like in RFC 6551, the ETX is a fixed point number, in units of
+ * 1 / @ref NETSTATS_NB_ETX_DIVISOR.
+ *
+ * @{
+ * @file
+ * @brief       Neighbor link statistics definitions
+ */
+
+#ifndef NET_NETSTATS_NEIGHBOR_H
+#define NET_NETSTATS_NEIGHBOR_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of neighbors in the table of each interface
+ */
+#ifndef NETSTATS_NB_SIZE
+#define NETSTATS_NB_SIZE                (8U)
+#endif
+
+/**
+ * @brief   Maximum length of a neighbor's link layer address
+ */
+#ifndef NETSTATS_NB_ADDR_MAXLEN
+#define NETSTATS_NB_ADDR_MAXLEN         (8U)
+#endif
+
+/**
+ * @brief   ETX of a perfect link; the fixed point divisor of all ETX values
+ */
+#define NETSTATS_NB_ETX_DIVISOR         (128U)
+
+/**
+ * @brief   ETX of a link without transmissions or LQI yet
+ */
+#ifndef NETSTATS_NB_ETX_INIT
+#define NETSTATS_NB_ETX_INIT            (2U * NETSTATS_NB_ETX_DIVISOR)
+#endif
+
+/**
+ * @brief   Transmissions counted for a frame that was never acknowledged
+ */
+#ifndef NETSTATS_NB_ETX_NOACK_PENALTY
+#define NETSTATS_NB_ETX_NOACK_PENALTY   (6U * NETSTATS_NB_ETX_DIVISOR)
+#endif
+
+/**
+ * @brief   Largest ETX, to which all estimates are capped
+ */
+#define NETSTATS_NB_ETX_MAX             (UINT16_MAX)
+
+/**
+ * @brief   Weight of a new transmission in the ETX average, in percent
+ */
+#ifndef NETSTATS_NB_EWMA_ALPHA
+#define NETSTATS_NB_EWMA_ALPHA          (15U)
+#endif
+
+/**
+ * @brief   Result of a transmission, for netstats_nb_update_tx()
+ */
+typedef enum {
+    NETSTATS_NB_SUCCESS,    /**< acknowledged */
+    NETSTATS_NB_NOACK,      /**< not acknowledged after all retries */
+    NETSTATS_NB_BUSY,       /**< not sent, the medium was busy */
+} netstats_nb_result_t;
+
+/**
+ * @brief   Statistics of a neighbor
+ */
+typedef struct {
+    uint8_t l2_addr[NETSTATS_NB_ADDR_MAXLEN];   /**< link layer address */
+    uint8_t l2_addr_len;    /**< length of l2_addr, 0 if the entry is unused */
+    uint8_t lqi;            /**< LQI of the last frame received */
+    int16_t rssi;           /**< RSSI of the last frame received, in dBm */
+    uint16_t etx;           /**< ETX of the link */
+    uint16_t tx_count;      /**< frames sent to the neighbor */
+    uint16_t tx_failed;     /**< frames not acknowledged */
+    uint16_t rx_count;      /**< frames received from the neighbor */
+    uint16_t last_used;     /**< value of netstats_nb_table_t::clock at the
+                                 last update */
+} netstats_nb_t;
+
+/**
+ * @brief   Neighbor table of an interface
+ */
+typedef struct {
+    netstats_nb_t entries[NETSTATS_NB_SIZE];    /**< neighbors */
+    netstats_nb_t *pending;     /**< neighbor the frame in transmission is
+                                     addressed to, or NULL */
+    uint16_t clock;             /**< counts updates, to replace the least
+                                     recently used entry */
+} netstats_nb_table_t;
+
+/**
+ * @brief   Empties a neighbor table
+ *
+ * @param[out] table    neighbor table
+ */
+void netstats_nb_init(netstats_nb_table_t *table);
+
+/**
+ * @brief   Finds the statistics of a neighbor
+ *
+ * @param[in] table     neighbor table
+ * @param[in] l2_addr   link layer address of the neighbor
+ * @param[in] len       length of @p l2_addr
+ *
+ * @return  statistics of the neighbor
+ * @return  NULL if the neighbor is not in @p table
+ */
+netstats_nb_t *netstats_nb_get(netstats_nb_table_t *table,
+                               const uint8_t *l2_addr, uint8_t len);
+
+/**
+ * @brief   Records the destination of the frame about to be sent
+ *
+ * The result of the transmission, passed to netstats_nb_update_tx(), is
+ * then counted for this neighbor. The neighbor is added to the table if
+ * needed, replacing the least recently used one.
+ *
+ * @param[in,out] table neighbor table
+ * @param[in] l2_addr   link layer address of the destination, or NULL for
+ *                      a broadcast or multicast frame
+ * @param[in] len       length of @p l2_addr
+ */
+void netstats_nb_record(netstats_nb_table_t *table, const uint8_t *l2_addr,
+                        uint8_t len);
+
+/**
+ * @brief   Counts the result of the transmission of the recorded frame
+ *
+ * @param[in,out] table neighbor table
+ * @param[in] result    result of the transmission
+ * @param[in] retries   retransmissions the frame needed
+ *
+ * @return  statistics of the neighbor the frame was sent to
+ * @return  NULL if no unicast frame was recorded
+ */
+netstats_nb_t *netstats_nb_update_tx(netstats_nb_table_t *table,
+                                     netstats_nb_result_t result,
+                                     uint8_t retries);
+
+/**
+ * @brief   Counts a frame received from a neighbor
+ *
+ * @param[in,out] table neighbor table
+ * @param[in] l2_addr   link layer address of the sender
+ * @param[in] len       length of @p l2_addr
+ * @param[in] rssi      RSSI of the frame, in dBm
+ * @param[in] lqi       LQI of the frame, 0 if the device does not report it
+ *
+ * @return  statistics of the neighbor
+ */
+netstats_nb_t *netstats_nb_update_rx(netstats_nb_table_t *table,
+                                     const uint8_t *l2_addr, uint8_t len,
+                                     int16_t rssi, uint8_t lqi);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_NETSTATS_NEIGHBOR_H */
+/** @} */
@@ -141,6 +141,69 @@ static inline bool sixlowpan_frag_is(sixlowpan_frag_t *hdr)
 }
 /** @} */
 
+/**
+ * @name    6LoWPAN selective fragment recovery acknowledgment definitions
+ *
+ * The acknowledgment refers to the fragments of an RFC 4944 datagram: its
+ * bitmap has one bit per 8-octet unit of the uncompressed datagram. This is
+ * not the RFRAG-ACK of RFC 8931, so it uses a dispatch from the range
+ * RFC 4944 reserves for future use. Only peers using
+ * @ref net_gnrc_sixlowpan_frag with `gnrc_sixlowpan_frag_sfr` understand it,
+ * all others drop it.
+ *
+ * @warning Experimental and not interoperable: the dispatch is not assigned
+ *          by IANA and may be assigned to something else in the future.
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc4944#section-5.1">
+ *          RFC 4944, section 5.1
+ *      </a>
+ * @{
+ */
+#define SIXLOWPAN_SFR_ACK_DISP      (0x4f)      /**< dispatch for acknowledgments */
+
+/**
+ * @brief   Size of the acknowledgment bitmap for a datagram in bytes
+ *
+ * @param[in] size  Size of the uncompressed datagram.
+ */
+#define SIXLOWPAN_SFR_ACK_BITMAP_SIZE(size) ((((size) + 7U) / 8U + 7U) / 8U)
+
+/**
+ * @brief   Selective fragment recovery acknowledgment header
+ *
+ * @note    The header is followed by a bitmap of
+ *          @ref SIXLOWPAN_SFR_ACK_BITMAP_SIZE(disp_size) bytes. Bit `i % 8`
+ *          (least significant bit first) of byte `i / 8` is set, if the
+ *          8-octet unit starting at offset `8 * i` of the datagram was
+ *          received.
+ */
+typedef struct __attribute__((packed)) {
+    uint8_t disp;               /**< dispatch */
+    /**
+     * @brief   Size of the acknowledged datagram
+     *
+     * @details Same format as in sixlowpan_frag_t::disp_size, but the
+     *          dispatch bits are not set.
+     */
+    network_uint16_t disp_size;
+    network_uint16_t tag;       /**< tag of the acknowledged datagram */
+} sixlowpan_sfr_ack_t;
+
+/**
+ * @brief   Checks if a given frame is a selective fragment recovery
+ *          acknowledgment.
+ *
+ * @param[in] hdr   A 6LoWPAN frame.
+ *
+ * @return  true, if @p hdr is an acknowledgment.
+ * @return  false, if @p hdr is not an acknowledgment.
+ */
+static inline bool sixlowpan_sfr_ack_is(uint8_t *hdr)
+{
+    return (*hdr) == SIXLOWPAN_SFR_ACK_DISP;
+}
+/** @} */
+
 /**
  * @name    6LoWPAN IPHC dispatch definitions
  * @{
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_sock_async  Asynchronous sock API
+ * @ingroup     net_sock
+ *
+ * @brief       Get notified by a callback about events on a sock
+ *
+ * Instead of blocking a thread in `sock_*_recv()`, a callback is registered
+ * with a sock. It is called when a message was received or sent, after which
+ * the message can be fetched with a non-blocking `sock_*_recv()` (timeout 0).
+ *
+ * The callback runs in the context of the network stack, so it must not
+ * block. Most applications want to use @ref net_sock_async_event instead,
+ * which moves the callback to a thread handling an @ref sys_event
+ * "event queue". Many protocol clients can then share that thread.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Asynchronous sock API definitions
+ */
+#ifndef NET_SOCK_ASYNC_H
+#define NET_SOCK_ASYNC_H
+
+#include "net/sock/async_types.h"
+#ifdef MODULE_SOCK_IP
+#include "net/sock/ip.h"
+#endif
+#ifdef MODULE_SOCK_UDP
+#include "net/sock/udp.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(MODULE_SOCK_IP) || defined(DOXYGEN)
+/**
+ * @brief   Sets the event callback of a raw IPv4/IPv6 sock
+ *
+ * @pre `(sock != NULL)`
+ *
+ * @note    Must be called after sock_ip_create(). A later call replaces the
+ *          callback.
+ *
+ * @param[in] sock  A raw IPv4/IPv6 sock object.
+ * @param[in] cb    An event callback. May be NULL to unset it.
+ * @param[in] arg   Argument for @p cb.
+ */
+void sock_ip_set_cb(sock_ip_t *sock, sock_ip_cb_t cb, void *arg);
+
+#if defined(MODULE_SOCK_ASYNC_EVENT) || defined(DOXYGEN)
+/**
+ * @brief   Gets the asynchronous event context of a raw IPv4/IPv6 sock
+ *
+ * @pre `(sock != NULL)`
+ *
+ * @param[in] sock  A raw IPv4/IPv6 sock object.
+ *
+ * @return  The asynchronous event context of @p sock.
+ */
+sock_async_ctx_t *sock_ip_get_async_ctx(sock_ip_t *sock);
+#endif
+#endif
+
+#if defined(MODULE_SOCK_UDP) || defined(DOXYGEN)
+/**
+ * @brief   Sets the event callback of a UDP sock
+ *
+ * @pre `(sock != NULL)`
+ *
+ * @note    Must be called after sock_udp_create(). A later call replaces the
+ *          callback.
+ *
+ * @param[in] sock  A UDP sock object.
+ * @param[in] cb    An event callback. May be NULL to unset it.
+ * @param[in] arg   Argument for @p cb.
+ */
+void sock_udp_set_cb(sock_udp_t *sock, sock_udp_cb_t cb, void *arg);
+
+#if defined(MODULE_SOCK_ASYNC_EVENT) || defined(DOXYGEN)
+/**
+ * @brief   Gets the asynchronous event context of a UDP sock
+ *
+ * @pre `(sock != NULL)`
+ *
+ * @param[in] sock  A UDP sock object.
+ *
+ * @return  The asynchronous event context of @p sock.
+ */
+sock_async_ctx_t *sock_udp_get_async_ctx(sock_udp_t *sock);
+#endif
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_SOCK_ASYNC_H */
+/** @} */
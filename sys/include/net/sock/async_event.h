@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_sock_async_event    Asynchronous sock with event API
+ * @ingroup     net_sock_async
+ *
+ * @brief       Handle sock events on a thread serving an event queue
+ *
+ * Each sock gets a handler that is called on the thread running the given
+ * @ref sys_event "event queue", so several protocol clients can share one
+ * thread and stack:
+ *
+ * ~~~~~~~~~~~~~~~~~~~ {.c}
+ * static void _handler(sock_udp_t *sock, sock_async_flags_t flags, void *arg)
+ * {
+ *     if (flags & SOCK_ASYNC_MSG_RECV) {
+ *         res = sock_udp_recv(sock, buf, sizeof(buf), 0, &remote);
+ *         ...
+ *     }
+ * }
+ *
+ * event_queue_init(&queue);
+ * sock_udp_create(&sock, &local, NULL, 0);
+ * sock_udp_event_init(&sock, &queue, _handler, NULL);
+ * event_loop(&queue);
+ * ~~~~~~~~~~~~~~~~~~~
+ *
+ * Events that happen before the handler ran are merged into one call with
+ * all their flags set, so the handler should read until `sock_*_recv()`
+ * returns `-EAGAIN`.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Asynchronous sock with event API definitions
+ */
+#ifndef NET_SOCK_ASYNC_EVENT_H
+#define NET_SOCK_ASYNC_EVENT_H
+
+#include "event.h"
+#include "net/sock/async.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(MODULE_SOCK_IP) || defined(DOXYGEN)
+/**
+ * @brief   Makes a raw IPv4/IPv6 sock able to handle asynchronous events
+ *          using an event queue
+ *
+ * @pre `(sock != NULL) && (ev_queue != NULL) && (handler != NULL)`
+ *
+ * @param[in] sock          A raw IPv4/IPv6 sock object.
+ * @param[in] ev_queue      The queue the events on @p sock will be added to.
+ * @param[in] handler       The event handler function to call on an event
+ *                          on @p sock.
+ * @param[in] handler_arg   Argument provided to @p handler.
+ */
+void sock_ip_event_init(sock_ip_t *sock, event_queue_t *ev_queue,
+                        sock_ip_cb_t handler, void *handler_arg);
+#endif
+
+#if defined(MODULE_SOCK_UDP) || defined(DOXYGEN)
+/**
+ * @brief   Makes a UDP sock able to handle asynchronous events using an
+ *          event queue
+ *
+ * @pre `(sock != NULL) && (ev_queue != NULL) && (handler != NULL)`
+ *
+ * @param[in] sock          A UDP sock object.
+ * @param[in] ev_queue      The queue the events on @p sock will be added to.
+ * @param[in] handler       The event handler function to call on an event
+ *                          on @p sock.
+ * @param[in] handler_arg   Argument provided to @p handler.
+ */
+void sock_udp_event_init(sock_udp_t *sock, event_queue_t *ev_queue,
+                         sock_udp_cb_t handler, void *handler_arg);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_SOCK_ASYNC_EVENT_H */
+/** @} */
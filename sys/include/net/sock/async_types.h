@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_sock_async
+ * @{
+ *
+ * @file
+ * @brief       Types for the asynchronous sock API
+ *
+ * Kept apart from @ref net/sock/async.h so implementations can embed
+ * @ref sock_async_ctx_t in their sock types.
+ */
+#ifndef NET_SOCK_ASYNC_TYPES_H
+#define NET_SOCK_ASYNC_TYPES_H
+
+#ifdef MODULE_SOCK_ASYNC_EVENT
+#include "event.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct sock_ip;
+struct sock_udp;
+
+/**
+ * @brief   Flags for asynchronous sock events
+ */
+typedef enum {
+    SOCK_ASYNC_MSG_RECV = 0x01,     /**< a message was received */
+    SOCK_ASYNC_MSG_SENT = 0x02,     /**< a message was handed to the stack */
+} sock_async_flags_t;
+
+/**
+ * @brief   Event callback for a raw IPv4/IPv6 sock
+ *
+ * @param[in] sock  The sock the event happened on.
+ * @param[in] flags The event flags.
+ * @param[in] arg   Argument given on registration.
+ */
+typedef void (*sock_ip_cb_t)(struct sock_ip *sock, sock_async_flags_t flags,
+                             void *arg);
+
+/**
+ * @brief   Event callback for a UDP sock
+ *
+ * @param[in] sock  The sock the event happened on.
+ * @param[in] flags The event flags.
+ * @param[in] arg   Argument given on registration.
+ */
+typedef void (*sock_udp_cb_t)(struct sock_udp *sock, sock_async_flags_t flags,
+                              void *arg);
+
+/**
+ * @brief   Callback of any sock type
+ */
+typedef union {
+    /**
+     * @brief   Type-less callback for implementation-internal use
+     */
+    void (*generic)(void *sock, sock_async_flags_t flags, void *arg);
+    sock_ip_cb_t ip;                /**< raw IPv4/IPv6 sock callback */
+    sock_udp_cb_t udp;              /**< UDP sock callback */
+} sock_async_cb_t;
+
+#if defined(MODULE_SOCK_ASYNC_EVENT) || defined(DOXYGEN)
+/**
+ * @brief   Event posted by @ref net_sock_async_event to its event queue
+ *
+ * @note    Only available with module `sock_async_event`
+ */
+typedef struct {
+    event_t super;                  /**< event structure that gets extended */
+    event_queue_t *queue;           /**< queue to post the event to */
+    void *sock;                     /**< sock the event happened on */
+    sock_async_cb_t cb;             /**< handler called on the event thread */
+    void *cb_arg;                   /**< argument for sock_event_t::cb */
+    sock_async_flags_t type;        /**< flags collected since last handled */
+} sock_event_t;
+
+/**
+ * @brief   Per-sock storage for the asynchronous sock API
+ *
+ * @note    Only available with module `sock_async_event`
+ */
+typedef struct {
+    sock_event_t event;             /**< the event of the sock */
+} sock_async_ctx_t;
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_SOCK_ASYNC_TYPES_H */
+/** @} */
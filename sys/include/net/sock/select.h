@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_sock_select sock readiness notification
+ * @ingroup     net_sock
+ *
+ * @brief       Wait on multiple socks from a single thread
+ *
+ * A thread can register itself with any number of socks. Whenever data
+ * arrives at one of them, @ref SOCK_SELECT_THREAD_FLAG is set for the
+ * registered thread, which then checks which of its socks are readable:
+ *
+ * ~~~~~~~~~~~~~~~~~~~ {.c}
+ * thread_t *me = (thread_t *)sched_active_thread;
+ *
+ * for (unsigned i = 0; i < SOCKS_NUMOF; i++) {
+ *     sock_udp_notify(&socks[i], me);
+ * }
+ * while (1) {
+ *     thread_flags_clear(SOCK_SELECT_THREAD_FLAG);
+ *     for (unsigned i = 0; i < SOCKS_NUMOF; i++) {
+ *         if (sock_udp_readable(&socks[i])) {
+ *             res = sock_udp_recv(&socks[i], buf, sizeof(buf), 0, &remote);
+ *             ...
+ *         }
+ *     }
+ *     thread_flags_wait_any(SOCK_SELECT_THREAD_FLAG);
+ * }
+ * ~~~~~~~~~~~~~~~~~~~
+ *
+ * Since the flag is cleared *before* the socks are checked, data that
+ * arrives while checking is never missed.
+ *
+ * @{
+ *
+ * @file
+ * @brief       sock readiness notification definitions
+ */
+#ifndef NET_SOCK_SELECT_H
+#define NET_SOCK_SELECT_H
+
+#include <stdbool.h>
+
+#include "thread.h"
+
+#ifdef MODULE_SOCK_IP
+#include "net/sock/ip.h"
+#endif
+#ifdef MODULE_SOCK_UDP
+#include "net/sock/udp.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Thread flag set for a registered thread when one of its socks
+ *          becomes readable
+ */
+#ifndef SOCK_SELECT_THREAD_FLAG
+#define SOCK_SELECT_THREAD_FLAG     (1u << 13)
+#endif
+
+#if defined(MODULE_SOCK_IP) || defined(DOXYGEN)
+/**
+ * @brief   Registers a thread to be notified when data arrives at a raw IPv4/
+ *          IPv6 sock
+ *
+ * @pre `(sock != NULL)`
+ *
+ * @note    Only one thread can be registered per sock. A later registration
+ *          replaces the earlier one.
+ *
+ * @param[in] sock      A raw IPv4/IPv6 sock object.
+ * @param[in] thread    The thread to notify with @ref SOCK_SELECT_THREAD_FLAG.
+ *                      May be NULL to remove the registration.
+ */
+void sock_ip_notify(sock_ip_t *sock, thread_t *thread);
+
+/**
+ * @brief   Checks if a raw IPv4/IPv6 sock has data available
+ *
+ * @pre `(sock != NULL)`
+ *
+ * @param[in] sock  A raw IPv4/IPv6 sock object.
+ *
+ * @return  true, if sock_ip_recv() would not block on @p sock.
+ * @return  false, otherwise.
+ */
+bool sock_ip_readable(sock_ip_t *sock);
+#endif
+
+#if defined(MODULE_SOCK_UDP) || defined(DOXYGEN)
+/**
+ * @brief   Registers a thread to be notified when data arrives at a UDP sock
+ *
+ * @pre `(sock != NULL)`
+ *
+ * @note    Only one thread can be registered per sock. A later registration
+ *          replaces the earlier one.
+ *
+ * @param[in] sock      A UDP sock object.
+ * @param[in] thread    The thread to notify with @ref SOCK_SELECT_THREAD_FLAG.
+ *                      May be NULL to remove the registration.
+ */
+void sock_udp_notify(sock_udp_t *sock, thread_t *thread);
+
+/**
+ * @brief   Checks if a UDP sock has data available
+ *
+ * @pre `(sock != NULL)`
+ *
+ * @param[in] sock  A UDP sock object.
+ *
+ * @return  true, if sock_udp_recv() would not block on @p sock.
+ * @return  false, otherwise.
+ */
+bool sock_udp_readable(sock_udp_t *sock);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_SOCK_SELECT_H */
+/** @} */
@@ -289,6 +289,28 @@ typedef struct _sock_tl_ep sock_udp_ep_t;   /**< An end point for a UDP sock obj
  */
 typedef struct sock_udp sock_udp_t;
 
+/**
+ * @brief   Descriptor for a single datagram of sock_udp_recv_batch() or
+ *          sock_udp_send_batch()
+ */
+typedef struct {
+    void *data;                 /**< payload of the datagram */
+    /**
+     * @brief   length of sock_udp_msg_t::data
+     *
+     * For sock_udp_recv_batch() the maximum space available at
+     * sock_udp_msg_t::data, which is replaced by the number of bytes received.
+     */
+    size_t len;
+    /**
+     * @brief   remote end point of the datagram
+     *
+     * May be `NULL`, if it is not required by the application on receive or
+     * if the remote end point of the sock should be used on send.
+     */
+    sock_udp_ep_t *remote;
+} sock_udp_msg_t;
+
 /**
  * @brief   Creates a new UDP sock object
  *
@@ -402,6 +424,97 @@ int sock_udp_get_remote(sock_udp_t *sock, sock_udp_ep_t *ep);
 ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
                       uint32_t timeout, sock_udp_ep_t *remote);
 
+/**
+ * @brief   Receives a UDP message from a remote end point without copying it
+ *
+ * @pre `(sock != NULL) && (data != NULL) && (buf_ctx != NULL)`
+ *
+ * Instead of copying the received payload into a buffer of the application,
+ * @p data is pointed to the payload in the buffer of the network stack.
+ * The buffer stays reserved until the function is called again with the
+ * returned @p buf_ctx, so the application can process the payload in place.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * void *data, *ctx = NULL;
+ * ssize_t res;
+ *
+ * while ((res = sock_udp_recv_buf(&sock, &data, &ctx, timeout, NULL)) > 0) {
+ *     process(data, res);
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @param[in] sock          A UDP sock object.
+ * @param[out] data         Pointer to the received payload.
+ *                          Only valid until the next call with @p buf_ctx.
+ * @param[in,out] buf_ctx   Stack-internal buffer context. Must point to
+ *                          `NULL` to receive a new message. If it points to
+ *                          the context returned by a previous call, that
+ *                          buffer is released.
+ * @param[in] timeout       Timeout for receive in microseconds.
+ *                          If 0 and no data is available, the function
+ *                          returns immediately.
+ *                          May be @ref SOCK_NO_TIMEOUT for no timeout (wait
+ *                          until data is available).
+ * @param[out] remote       Remote end point of the received data.
+ *                          May be `NULL`, if it is not required by the
+ *                          application.
+ *
+ * @note    Function blocks if no packet is currently waiting.
+ *
+ * @return  The number of bytes received on success. The payload may be
+ *          handed out in several parts, so the function should be called
+ *          again with @p buf_ctx until it returns 0.
+ * @return  0, if @p buf_ctx was released and no further data is left.
+ * @return  -EADDRNOTAVAIL, if local of @p sock is not given.
+ * @return  -EAGAIN, if @p timeout is `0` and no data is available.
+ * @return  -EINVAL, if @p remote is invalid or @p sock is not properly
+ *          initialized (or closed while sock_udp_recv_buf() blocks).
+ * @return  -ENOMEM, if no memory was available to receive @p data.
+ * @return  -EPROTO, if source address of received packet did not equal
+ *          the remote of @p sock.
+ * @return  -ETIMEDOUT, if @p timeout expired.
+ */
+ssize_t sock_udp_recv_buf(sock_udp_t *sock, void **data, void **buf_ctx,
+                          uint32_t timeout, sock_udp_ep_t *remote);
+
+/**
+ * @brief   Receives several UDP messages in one call
+ *
+ * @pre `(sock != NULL) && (msgs != NULL) && (num > 0)`
+ * @pre `(msgs[i].data != NULL) && (msgs[i].len > 0)` for all `i < num`
+ *
+ * Waits with @p timeout for the first message like sock_udp_recv(). All
+ * further messages are only taken if they were already received by the
+ * sock, so the function does not block for them.
+ *
+ * @param[in] sock      A UDP sock object.
+ * @param[in,out] msgs  Descriptors of the messages to receive. On return
+ *                      sock_udp_msg_t::len and sock_udp_msg_t::remote
+ *                      (if not `NULL`) of the first messages are set to the
+ *                      received length and the remote end point.
+ * @param[in] num       Number of descriptors in @p msgs.
+ * @param[in] timeout   Timeout for the first message in microseconds.
+ *                      May be 0 or @ref SOCK_NO_TIMEOUT as for
+ *                      sock_udp_recv().
+ *
+ * Later messages from a remote other than the one of @p sock are dropped
+ * like sock_udp_recv() does and do not end the batch. If a later message
+ * does not fit into its descriptor, the batch ends before it and it is left
+ * to the next call, which then reports `-ENOBUFS` for it.
+ *
+ * @note    Stacks without an own implementation (everything but GNRC) get a
+ *          loop over sock_udp_recv() from module `sock_udp_batch`. It can
+ *          not leave a message that is too large to the next call, so it
+ *          drops it and ends the batch. Give all descriptors the size of the
+ *          largest expected message there.
+ *
+ * @return  The number of received messages on success.
+ * @return  The errors of sock_udp_recv(), if not even the first message could
+ *          be received.
+ */
+int sock_udp_recv_batch(sock_udp_t *sock, sock_udp_msg_t *msgs, unsigned num,
+                        uint32_t timeout);
+
 /**
  * @brief   Sends a UDP message to remote end point
  *
@@ -438,6 +551,29 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
 ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
                       const sock_udp_ep_t *remote);
 
+/**
+ * @brief   Sends several UDP messages in one call
+ *
+ * @pre `(msgs != NULL) && (num > 0)`
+ *
+ * @param[in] sock      A UDP sock object. May be `NULL` as for
+ *                      sock_udp_send().
+ * @param[in] msgs      Descriptors of the messages to send. Each message
+ *                      goes to its sock_udp_msg_t::remote or to the remote
+ *                      end point of @p sock if that is `NULL`.
+ * @param[in] num       Number of descriptors in @p msgs.
+ *
+ * An error on a later message ends the batch. The messages from that one on
+ * were not sent, so the caller can retry them with the next call, which
+ * then reports the error if it persists.
+ *
+ * @return  The number of sent messages on success.
+ * @return  The errors of sock_udp_send(), if not even the first message could
+ *          be sent.
+ */
+int sock_udp_send_batch(sock_udp_t *sock, const sock_udp_msg_t *msgs,
+                        unsigned num);
+
 #include "sock_types.h"
 
 #ifdef __cplusplus
@@ -16,6 +16,11 @@
  *
  * @see https://tools.ietf.org/html/rfc6206
  *
+ * The parameters of a running timer can be changed with
+ * trickle_set_params(), e.g. to scale them with the density of the network
+ * with trickle_adapt(). Each timer counts its transmissions, suppressions
+ * and resets in trickle_t::stats.
+ *
  * @{
  *
  * @file
@@ -35,6 +40,22 @@
 #include "xtimer.h"
 #include "thread.h"
 
+/**
+ * @brief   Number of neighbors for which trickle_adapt() keeps the
+ *          configured parameters
+ */
+#ifndef TRICKLE_ADAPT_DENSITY
+#define TRICKLE_ADAPT_DENSITY       (4U)
+#endif
+
+/**
+ * @brief   Maximum number of halvings of Imin by trickle_adapt() in sparse
+ *          networks
+ */
+#ifndef TRICKLE_ADAPT_SPARSE_SHIFT
+#define TRICKLE_ADAPT_SPARSE_SHIFT  (2U)
+#endif
+
 /**
  * @brief Trickle callback function with arguments
  */
@@ -43,6 +64,17 @@ typedef struct {
     void *args;                 /**< callback function arguments */
 } trickle_callback_t;
 
+/**
+ * @brief statistics of a trickle timer
+ */
+typedef struct {
+    uint32_t transmissions;         /**< intervals the callback was called in */
+    uint32_t suppressions;          /**< intervals the callback was suppressed
+                                         in, as k consistent messages were
+                                         heard */
+    uint32_t resets;                /**< resets of the timer */
+} trickle_stats_t;
+
 /**
  * @brief all state variables of a trickle timer
  */
@@ -61,12 +93,12 @@ typedef struct {
     msg_t msg;                      /**< the msg_t to use for intervals */
     xtimer_t msg_timer;             /**< xtimer to send a msg_t to the target
                                          thread for a new interval */
+    trickle_stats_t stats;          /**< statistics since trickle_start() */
 } trickle_t;
 
 /**
  * @brief resets the trickle timer
  *
- * @pre `trickle->I > trickle->Imin`
  * @see https://tools.ietf.org/html/rfc6206#section-4.2, number 6
  *
  * @param[in] trickle   the trickle timer
@@ -89,6 +121,56 @@ void trickle_reset_timer(trickle_t *trickle);
 void trickle_start(kernel_pid_t pid, trickle_t *trickle, uint16_t msg_type,
                    uint32_t Imin, uint8_t Imax, uint8_t k);
 
+/**
+ * @brief changes the parameters of the trickle timer
+ *
+ * The current interval runs to its end, the following intervals are
+ * within the new bounds. @p k applies from the end of the current interval
+ * on.
+ *
+ * @pre `Imin > 0`
+ * @pre `(Imin << Imax) < (UINT32_MAX / 2)` to avoid overflow of uint32_t
+ *
+ * @param[in] trickle               trickle timer
+ * @param[in] Imin                  minimum interval in ms
+ * @param[in] Imax                  maximum interval in doublings of @p Imin
+ * @param[in] k                     redundancy constant
+ */
+void trickle_set_params(trickle_t *trickle, uint32_t Imin, uint8_t Imax,
+                        uint8_t k);
+
+/**
+ * @brief adapts the parameters of the trickle timer to the number of
+ *        neighbors
+ *
+ * With more than @ref TRICKLE_ADAPT_DENSITY neighbors, Imin is doubled and
+ * Imax decreased by one for each doubling of the neighbors, which keeps the
+ * maximum interval, and k is scaled down with the number of neighbors, to
+ * no less than 1. Nodes that start or reset at the same time thus spread
+ * their first transmissions over a longer interval, and suppress each
+ * other sooner.
+ *
+ * With fewer neighbors, Imin is halved for each halving of the neighbors,
+ * at most @ref TRICKLE_ADAPT_SPARSE_SHIFT times, for faster repairs where
+ * few nodes could relay them.
+ *
+ * The parameters are computed from the configured ones every time, so the
+ * function can be called whenever the number of neighbors is updated.
+ *
+ * @pre `Imin > 0`
+ * @pre `(Imin << Imax) < (UINT32_MAX / 2)` to avoid overflow of uint32_t
+ *
+ * @param[in] trickle               trickle timer
+ * @param[in] Imin                  configured minimum interval in ms
+ * @param[in] Imax                  configured maximum interval in doublings
+ *                                  of @p Imin
+ * @param[in] k                     configured redundancy constant, 0 for
+ *                                  infinity, which is kept
+ * @param[in] neighbors             number of neighbors
+ */
+void trickle_adapt(trickle_t *trickle, uint32_t Imin, uint8_t Imax, uint8_t k,
+                   unsigned neighbors);
+
 /**
  * @brief stops the trickle timer
  *
@@ -23,11 +23,15 @@
 #include <stdatomic.h>
 
 #include "assert.h"
+#include "kernel_defines.h"
+#include "memarray.h"
 #include "net/gcoap.h"
 #include "mutex.h"
 #include "random.h"
 #include "thread.h"
 
+#include "gcoap_internal.h"
+
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
@@ -45,16 +49,65 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
                                                          sock_udp_ep_t *remote);
 static ssize_t _finish_pdu(coap_pkt_t *pdu, uint8_t *buf, size_t len);
 static void _expire_request(gcoap_request_memo_t *memo);
+static void _handle_timeout(gcoap_request_memo_t *memo);
+static void _timeout_cb(void *arg);
+static void _set_timeout(gcoap_request_memo_t *memo, uint32_t timeout);
 static bool _endpoints_equal(const sock_udp_ep_t *ep1, const sock_udp_ep_t *ep2);
 static void _find_req_memo(gcoap_request_memo_t **memo_ptr, coap_pkt_t *pdu,
                            const sock_udp_ep_t *remote);
+static coap_hdr_t *_req_memo_hdr(gcoap_request_memo_t *memo);
+static gcoap_request_memo_t **_req_memo_bucket(const uint8_t *token,
+                                               unsigned token_len);
+static void _add_req_memo(gcoap_request_memo_t *memo);
+static void _release_req_memo(gcoap_request_memo_t *memo);
+static unsigned _count_req_memos(const sock_udp_ep_t *remote);
+static uint8_t *_alloc_resend_buf(const uint8_t *buf);
+static bool _queue_req_memo(gcoap_request_memo_t *memo, const uint8_t *buf,
+                            size_t len);
+static bool _is_queued(const sock_udp_ep_t *remote);
+static void _send_queued(void);
+static size_t _req_send(const uint8_t *buf, size_t len,
+                        const sock_udp_ep_t *remote,
+                        gcoap_resp_handler_t resp_handler,
+                        gcoap_block_xfer_t *block_xfer);
+static unsigned _block_szx(size_t overhead);
+static int _block_req_send(gcoap_block_xfer_t *xfer, uint32_t blknum);
+static void _block_resp(gcoap_block_xfer_t *xfer, coap_pkt_t *pdu);
+static void _block2_resp(gcoap_block_xfer_t *xfer, coap_pkt_t *pdu);
+static void _block_end(gcoap_block_xfer_t *xfer, unsigned state,
+                       coap_pkt_t *pdu);
 static int _find_resource(coap_pkt_t *pdu, coap_resource_t **resource_ptr,
                                             gcoap_listener_t **listener_ptr);
-static int _find_observer(sock_udp_ep_t **observer, sock_udp_ep_t *remote);
-static int _find_obs_memo(gcoap_observe_memo_t **memo, sock_udp_ep_t *remote,
-                                                       coap_pkt_t *pdu);
-static void _find_obs_memo_resource(gcoap_observe_memo_t **memo,
-                                   const coap_resource_t *resource);
+static int _scan_resources(coap_pkt_t *pdu, coap_resource_t **resource_ptr,
+                           gcoap_listener_t **listener_ptr);
+static void _index_listener(gcoap_listener_t *listener);
+static void _obs_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                      uint8_t *token, unsigned token_len);
+
+/* Observe client, chained in its bucket of _coap_state.observers_tab */
+typedef struct gcoap_observer {
+    struct gcoap_observer *next;        /* Next client in the same bucket */
+    sock_udp_ep_t ep;                   /* Client endpoint */
+    unsigned memos_numof;               /* Count of its registrations */
+} gcoap_observer_t;
+
+static gcoap_observer_t **_observer_bucket(const sock_udp_ep_t *remote);
+static gcoap_observe_memo_t **_obs_memo_bucket(const coap_resource_t *resource);
+static gcoap_observer_t *_find_observer(const sock_udp_ep_t *remote);
+static gcoap_observe_memo_t *_find_obs_memo(const gcoap_observer_t *observer,
+                                            const coap_resource_t *resource,
+                                            coap_pkt_t *pdu);
+static gcoap_observe_memo_t *_find_obs_memo_token(const gcoap_observer_t *observer,
+                                                  coap_pkt_t *pdu);
+static gcoap_observe_memo_t *_find_obs_memo_resource(const coap_resource_t *resource);
+static gcoap_observe_memo_t *_add_obs_memo(gcoap_observer_t *observer,
+                                           const sock_udp_ep_t *remote,
+                                           coap_resource_t *resource);
+static void _release_obs_memo(gcoap_observe_memo_t *memo);
+
+/* Block2 requests in flight; limited by the bitmap of received blocks. With
+ * the default GCOAP_NSTART of 1 blocks are not pipelined. */
+#define GCOAP_BLOCK_WINDOW  ((GCOAP_NSTART < 32) ? GCOAP_NSTART : 32)
 
 /* Internal variables */
 const coap_resource_t _default_resources[] = {
@@ -71,16 +124,34 @@ static gcoap_listener_t _default_listener = {
 typedef struct {
     mutex_t lock;                       /* Shares state attributes safely */
     gcoap_listener_t *listeners;        /* List of registered listeners */
-    gcoap_request_memo_t open_reqs[GCOAP_REQ_WAITING_MAX];
-                                        /* Storage for open requests; if first
-                                           byte of an entry is zero, the entry
-                                           is available */
+    coap_resource_index_t index;        /* Index over the resources of all
+                                           listeners */
+    bool index_full;                    /* Index too small, scan listeners
+                                           instead */
+    memarray_t req_pool;                /* Pool of request memos */
+    gcoap_request_memo_t req_memos[GCOAP_REQ_WAITING_MAX];
+                                        /* Storage for req_pool */
+    gcoap_request_memo_t *open_reqs[GCOAP_REQ_HASH_SIZE];
+                                        /* Open requests, hashed by token */
+    unsigned open_reqs_numof;           /* Count of open requests */
+    gcoap_request_memo_t *queued_reqs;  /* Requests waiting for GCOAP_NSTART,
+                                           in the order to send them */
+    unsigned queued_reqs_numof;         /* Count of queued requests */
+    volatile bool timeouts_lost;        /* A memo has timeout_lost set */
     atomic_uint next_message_id;        /* Next message ID to use */
-    sock_udp_ep_t observers[GCOAP_OBS_CLIENTS_MAX];
-                                        /* Observe clients; allows reuse for
-                                           observe memos */
+    memarray_t observer_pool;           /* Pool of Observe clients; allows
+                                           reuse for observe memos */
+    gcoap_observer_t observers[GCOAP_OBS_CLIENTS_MAX];
+                                        /* Storage for observer_pool */
+    gcoap_observer_t *observers_tab[GCOAP_OBS_HASH_SIZE];
+                                        /* Observe clients, hashed by
+                                           endpoint */
+    memarray_t obs_memo_pool;           /* Pool of observe memos */
     gcoap_observe_memo_t observe_memos[GCOAP_OBS_REGISTRATIONS_MAX];
-                                        /* Observed resource registrations */
+                                        /* Storage for obs_memo_pool */
+    gcoap_observe_memo_t *obs_memos_tab[GCOAP_OBS_HASH_SIZE];
+                                        /* Observed resource registrations,
+                                           hashed by resource */
     uint8_t resend_bufs[GCOAP_RESEND_BUFS_MAX][GCOAP_PDU_BUF_SIZE];
                                         /* Buffers for PDU for request resends;
                                            if first byte of an entry is zero,
@@ -123,32 +194,14 @@ static void *_event_loop(void *arg)
         if (res > 0) {
             switch (msg_rcvd.type) {
             case GCOAP_MSG_TYPE_TIMEOUT: {
-                gcoap_request_memo_t *memo = (gcoap_request_memo_t *)msg_rcvd.content.ptr;
-
-                /* no retries remaining */
-                if ((memo->send_limit == GCOAP_SEND_LIMIT_NON)
-                        || (memo->send_limit == 0)) {
-                    _expire_request(memo);
-                }
-                /* reduce retries remaining, double timeout and resend */
-                else {
-                    memo->send_limit--;
-                    unsigned i        = COAP_MAX_RETRANSMIT - memo->send_limit;
-                    uint32_t timeout  = ((uint32_t)COAP_ACK_TIMEOUT << i) * US_PER_SEC;
-                    uint32_t variance = ((uint32_t)COAP_ACK_VARIANCE << i) * US_PER_SEC;
-                    timeout = random_uint32_range(timeout, timeout + variance);
-
-                    ssize_t bytes = sock_udp_send(&_sock, memo->msg.data.pdu_buf,
-                                                  memo->msg.data.pdu_len,
-                                                  &memo->remote_ep);
-                    if (bytes > 0) {
-                        xtimer_set_msg(&memo->response_timer, timeout,
-                                       &memo->timeout_msg, _pid);
-                    }
-                    else {
-                        DEBUG("gcoap: sock resend failed: %d\n", (int)bytes);
-                        _expire_request(memo);
-                    }
+                gcoap_request_memo_t *memo =
+                    &_coap_state.req_memos[msg_rcvd.content.value >> 16];
+
+                /* ignore the timeout if the timer was stopped or restarted
+                 * since, also if the memo was released and reused */
+                if ((memo->state == GCOAP_MEMO_WAIT) &&
+                    (memo->timeout_gen == (msg_rcvd.content.value & 0xffff))) {
+                    _handle_timeout(memo);
                 }
                 break;
             }
@@ -156,6 +209,22 @@ static void *_event_loop(void *arg)
                 break;
             }
         }
+        if (_coap_state.queued_reqs != NULL) {
+            _send_queued();
+        }
+        if (_coap_state.timeouts_lost) {
+            /* clear before the scan, so a timeout lost meanwhile is seen on
+             * the next round */
+            _coap_state.timeouts_lost = false;
+            for (unsigned i = 0; i < GCOAP_REQ_WAITING_MAX; i++) {
+                gcoap_request_memo_t *memo = &_coap_state.req_memos[i];
+
+                if ((memo->state == GCOAP_MEMO_WAIT) && memo->timeout_lost) {
+                    memo->timeout_lost = false;
+                    _handle_timeout(memo);
+                }
+            }
+        }
 
         _listen(&_sock);
     }
@@ -224,21 +293,32 @@ static void _listen(sock_udp_t *sock)
     case COAP_CLASS_SUCCESS:
     case COAP_CLASS_CLIENT_FAILURE:
     case COAP_CLASS_SERVER_FAILURE:
+        mutex_lock(&_coap_state.lock);
         _find_req_memo(&memo, &pdu, &remote);
+        mutex_unlock(&_coap_state.lock);
         if (memo) {
             switch (coap_get_type(&pdu)) {
             case COAP_TYPE_NON:
             case COAP_TYPE_ACK:
                 xtimer_remove(&memo->response_timer);
+                if (memo->block_xfer) {
+                    gcoap_block_xfer_t *xfer = memo->block_xfer;
+
+                    /* release first, so the next block may be requested */
+                    mutex_lock(&_coap_state.lock);
+                    _release_req_memo(memo);
+                    mutex_unlock(&_coap_state.lock);
+                    _block_resp(xfer, &pdu);
+                    break;
+                }
                 memo->state = GCOAP_MEMO_RESP;
                 if (memo->resp_handler) {
                     memo->resp_handler(memo->state, &pdu, &remote);
                 }
 
-                if (memo->send_limit >= 0) {        /* if confirmable */
-                    *memo->msg.data.pdu_buf = 0;    /* clear resend PDU buffer */
-                }
-                memo->state = GCOAP_MEMO_UNUSED;
+                mutex_lock(&_coap_state.lock);
+                _release_req_memo(memo);
+                mutex_unlock(&_coap_state.lock);
                 break;
             case COAP_TYPE_CON:
                 DEBUG("gcoap: separate CON response not handled yet\n");
@@ -269,9 +349,15 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
 {
     coap_resource_t *resource  = NULL;
     gcoap_listener_t *listener = NULL;
-    sock_udp_ep_t *observer    = NULL;
+    gcoap_observer_t *observer = NULL;
     gcoap_observe_memo_t *memo = NULL;
-    gcoap_observe_memo_t *resource_memo = NULL;
+
+#ifdef MODULE_GCOAP_PROXY
+    ssize_t proxy_len = gcoap_proxy_handle_req(pdu, buf, len, remote);
+    if (proxy_len >= 0) {
+        return proxy_len;
+    }
+#endif
 
     switch (_find_resource(pdu, &resource, &listener)) {
         case GCOAP_RESOURCE_WRONG_METHOD:
@@ -279,58 +365,35 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
         case GCOAP_RESOURCE_NO_PATH:
             return gcoap_response(pdu, buf, len, COAP_CODE_PATH_NOT_FOUND);
         case GCOAP_RESOURCE_FOUND:
-            /* find observe registration for resource */
-            _find_obs_memo_resource(&resource_memo, resource);
             break;
     }
 
     if (coap_get_observe(pdu) == COAP_OBS_REGISTER) {
-        /* lookup remote+token */
-        int empty_slot = _find_obs_memo(&memo, remote, pdu);
+        mutex_lock(&_coap_state.lock);
+        observer = _find_observer(remote);
         /* validate re-registration request */
-        if (resource_memo != NULL) {
-            if (memo != NULL) {
-                if (memo != resource_memo) {
-                    /* reject token already used for a different resource */
-                    memo = NULL;
-                    coap_clear_observe(pdu);
-                    DEBUG("gcoap: can't change resource for token\n");
-                }
-                /* otherwise OK to re-register resource with the same token */
+        if (observer != NULL) {
+            /* lookup remote+token for resource */
+            memo = _find_obs_memo(observer, resource, pdu);
+            if ((memo == NULL) && (_find_obs_memo_token(observer, pdu) != NULL)) {
+                /* reject token already used for a different resource */
+                coap_clear_observe(pdu);
+                DEBUG("gcoap: can't change resource for token\n");
             }
-            else if (_endpoints_equal(remote, resource_memo->observer)) {
+            else if (memo == NULL) {
                 /* accept new token for resource */
-                memo = resource_memo;
+                memo = _find_obs_memo(observer, resource, NULL);
             }
         }
         /* initialize new registration request */
         if ((memo == NULL) && coap_has_observe(pdu)) {
-            /* verify resource not already registerered (for another endpoint) */
-            if ((empty_slot >= 0) && (resource_memo == NULL)) {
-                int obs_slot = _find_observer(&observer, remote);
-                /* cache new observer */
-                if (observer == NULL) {
-                    if (obs_slot >= 0) {
-                        observer = &_coap_state.observers[obs_slot];
-                        memcpy(observer, remote, sizeof(sock_udp_ep_t));
-                    } else {
-                        DEBUG("gcoap: can't register observer\n");
-                    }
-                }
-                if (observer != NULL) {
-                    memo = &_coap_state.observe_memos[empty_slot];
-                    memo->observer = observer;
-                }
-            }
+            memo = _add_obs_memo(observer, remote, resource);
             if (memo == NULL) {
                 coap_clear_observe(pdu);
-                DEBUG("gcoap: can't register observe memo\n");
             }
         }
         /* finish registration */
         if (memo != NULL) {
-            /* resource may be assigned here if it is not already registered */
-            memo->resource = resource;
             memo->token_len = coap_get_token_len(pdu);
             if (memo->token_len) {
                 memcpy(&memo->token[0], pdu->token, memo->token_len);
@@ -340,22 +403,20 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
             uint32_t now       = xtimer_now_usec();
             pdu->observe_value = (now >> GCOAP_OBS_TICK_EXPONENT) & 0xFFFFFF;
         }
+        mutex_unlock(&_coap_state.lock);
 
     } else if (coap_get_observe(pdu) == COAP_OBS_DEREGISTER) {
-        _find_obs_memo(&memo, remote, pdu);
+        mutex_lock(&_coap_state.lock);
+        observer = _find_observer(remote);
+        if (observer != NULL) {
+            memo = _find_obs_memo(observer, resource, pdu);
+        }
         /* clear memo, and clear observer if no other memos */
         if (memo != NULL) {
             DEBUG("gcoap: Deregistering observer for: %s\n", memo->resource->path);
-            memo->observer = NULL;
-            memo           = NULL;
-            _find_obs_memo(&memo, remote, NULL);
-            if (memo == NULL) {
-                _find_observer(&observer, remote);
-                if (observer != NULL) {
-                    observer->family = AF_UNSPEC;
-                }
-            }
+            _release_obs_memo(memo);
         }
+        mutex_unlock(&_coap_state.lock);
         coap_clear_observe(pdu);
 
     } else if (coap_has_observe(pdu)) {
@@ -373,17 +434,30 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
 }
 
 /*
- * Searches listener registrations for the resource matching the path in a PDU.
- *
- * param[out] resource_ptr -- found resource
- * param[out] listener_ptr -- listener for found resource
- * return `GCOAP_RESOURCE_FOUND` if the resource was found,
- *        `GCOAP_RESOURCE_WRONG_METHOD` if a resource was found but the method
- *        code didn't match and `GCOAP_RESOURCE_NO_PATH` if no matching
- *        resource was found.
+ * Adds the resources of a listener to the resource index. If the index is
+ * too small, resources are looked up by scanning the listeners instead. The
+ * caller must hold _coap_state.lock.
  */
-static int _find_resource(coap_pkt_t *pdu, coap_resource_t **resource_ptr,
-                                            gcoap_listener_t **listener_ptr)
+static void _index_listener(gcoap_listener_t *listener)
+{
+    for (size_t i = 0; i < listener->resources_len; i++) {
+        if (coap_resource_index_add(&_coap_state.index,
+                                    &listener->resources[i]) < 0) {
+            DEBUG("gcoap: resource index full, increase "
+                  "NANOCOAP_RESOURCE_INDEX_SIZE\n");
+            _coap_state.index_full = true;
+            return;
+        }
+    }
+}
+
+/*
+ * Fallback for _find_resource() if the resource index is full. Requires the
+ * resources of each listener to be ordered alphabetically and does not
+ * support COAP_MATCH_SUBTREE.
+ */
+static int _scan_resources(coap_pkt_t *pdu, coap_resource_t **resource_ptr,
+                           gcoap_listener_t **listener_ptr)
 {
     int ret = GCOAP_RESOURCE_NO_PATH;
     unsigned method_flag = coap_method2flag(coap_get_code_detail(pdu));
@@ -422,6 +496,56 @@ static int _find_resource(coap_pkt_t *pdu, coap_resource_t **resource_ptr,
     return ret;
 }
 
+/*
+ * Searches listener registrations for the resource matching the path in a PDU.
+ *
+ * param[out] resource_ptr -- found resource
+ * param[out] listener_ptr -- listener for found resource
+ * return `GCOAP_RESOURCE_FOUND` if the resource was found,
+ *        `GCOAP_RESOURCE_WRONG_METHOD` if a resource was found but the method
+ *        code didn't match and `GCOAP_RESOURCE_NO_PATH` if no matching
+ *        resource was found.
+ */
+static int _find_resource(coap_pkt_t *pdu, coap_resource_t **resource_ptr,
+                                            gcoap_listener_t **listener_ptr)
+{
+    unsigned method_flag = coap_method2flag(coap_get_code_detail(pdu));
+    const coap_resource_t *resource;
+    int ret = GCOAP_RESOURCE_NO_PATH;
+
+    /* listeners may be registered from other threads meanwhile */
+    mutex_lock(&_coap_state.lock);
+    if (_coap_state.index_full) {
+        ret = _scan_resources(pdu, resource_ptr, listener_ptr);
+        mutex_unlock(&_coap_state.lock);
+        return ret;
+    }
+    switch (coap_resource_index_find(&_coap_state.index, (char *)&pdu->url[0],
+                                     method_flag, &resource)) {
+        case 0:
+            break;
+        case -EPERM:
+            mutex_unlock(&_coap_state.lock);
+            return GCOAP_RESOURCE_WRONG_METHOD;
+        default:
+            mutex_unlock(&_coap_state.lock);
+            return GCOAP_RESOURCE_NO_PATH;
+    }
+    /* find the listener the resource belongs to */
+    for (gcoap_listener_t *listener = _coap_state.listeners; listener != NULL;
+         listener = listener->next) {
+        if ((resource >= listener->resources) &&
+            (resource < (listener->resources + listener->resources_len))) {
+            *resource_ptr = (coap_resource_t *)resource;
+            *listener_ptr = listener;
+            ret = GCOAP_RESOURCE_FOUND;
+            break;
+        }
+    }
+    mutex_unlock(&_coap_state.lock);
+    return ret;
+}
+
 /*
  * Finishes handling a PDU -- write options and reposition payload.
  *
@@ -447,7 +571,8 @@ static ssize_t _finish_pdu(coap_pkt_t *pdu, uint8_t *buf, size_t len)
 
 /*
  * Finds the memo for an outstanding request within the _coap_state.open_reqs
- * array. Matches on remote endpoint and token.
+ * hash table. Matches on remote endpoint and token. The caller must hold
+ * _coap_state.lock.
  *
  * memo_ptr[out] -- Registered request memo, or NULL if not found
  * src_pdu[in] -- PDU for token to match
@@ -462,17 +587,9 @@ static void _find_req_memo(gcoap_request_memo_t **memo_ptr, coap_pkt_t *src_pdu,
     coap_pkt_t *memo_pdu = &memo_pdu_data;
     unsigned cmplen      = coap_get_token_len(src_pdu);
 
-    for (int i = 0; i < GCOAP_REQ_WAITING_MAX; i++) {
-        if (_coap_state.open_reqs[i].state == GCOAP_MEMO_UNUSED)
-            continue;
-
-        gcoap_request_memo_t *memo = &_coap_state.open_reqs[i];
-        if (memo->send_limit == GCOAP_SEND_LIMIT_NON) {
-            memo_pdu->hdr = (coap_hdr_t *) &memo->msg.hdr_buf[0];
-        }
-        else {
-            memo_pdu->hdr = (coap_hdr_t *) memo->msg.data.pdu_buf;
-        }
+    for (gcoap_request_memo_t *memo = *_req_memo_bucket(src_pdu->token, cmplen);
+         memo != NULL; memo = memo->next) {
+        memo_pdu->hdr = _req_memo_hdr(memo);
 
         if (coap_get_token_len(memo_pdu) == cmplen) {
             memo_pdu->token = &memo_pdu->hdr->data[0];
@@ -485,27 +602,511 @@ static void _find_req_memo(gcoap_request_memo_t **memo_ptr, coap_pkt_t *src_pdu,
     }
 }
 
+/* Returns the header of the request a memo was created for. */
+static coap_hdr_t *_req_memo_hdr(gcoap_request_memo_t *memo)
+{
+    if (memo->send_limit == GCOAP_SEND_LIMIT_NON) {
+        return (coap_hdr_t *)&memo->msg.hdr_buf[0];
+    }
+    return (coap_hdr_t *)memo->msg.data.pdu_buf;
+}
+
+/* Returns the bucket of the open requests hash table for a token. */
+static gcoap_request_memo_t **_req_memo_bucket(const uint8_t *token,
+                                               unsigned token_len)
+{
+    /* tokens are random, so folding them is good enough */
+    unsigned hash = token_len;
+
+    for (unsigned i = 0; i < token_len; i++) {
+        hash = (hash * 31) + token[i];
+    }
+    return &_coap_state.open_reqs[hash & (GCOAP_REQ_HASH_SIZE - 1)];
+}
+
+/*
+ * Adds a memo to the open requests. The caller must hold _coap_state.lock.
+ */
+static void _add_req_memo(gcoap_request_memo_t *memo)
+{
+    coap_pkt_t req;
+    gcoap_request_memo_t **bucket;
+
+    req.hdr = _req_memo_hdr(memo);
+    bucket = _req_memo_bucket(&req.hdr->data[0], coap_get_token_len(&req));
+    memo->next = *bucket;
+    *bucket = memo;
+    _coap_state.open_reqs_numof++;
+}
+
+/*
+ * Removes a memo from the open or the queued requests and returns it, and its
+ * resend buffer, to their pools. The caller must hold _coap_state.lock.
+ */
+static void _release_req_memo(gcoap_request_memo_t *memo)
+{
+    gcoap_request_memo_t **list;
+    unsigned *numof;
+
+    if (memo->state == GCOAP_MEMO_QUEUED) {
+        list = &_coap_state.queued_reqs;
+        numof = &_coap_state.queued_reqs_numof;
+    }
+    else {
+        coap_pkt_t req;
+
+        req.hdr = _req_memo_hdr(memo);
+        list = _req_memo_bucket(&req.hdr->data[0], coap_get_token_len(&req));
+        numof = &_coap_state.open_reqs_numof;
+    }
+    while (*list != NULL) {
+        if (*list == memo) {
+            *list = memo->next;
+            (*numof)--;
+            break;
+        }
+        list = &(*list)->next;
+    }
+    /* a queued request keeps its PDU in a resend buffer */
+    if ((memo->state == GCOAP_MEMO_QUEUED) ||
+        (memo->send_limit != GCOAP_SEND_LIMIT_NON)) {
+        *memo->msg.data.pdu_buf = 0;    /* clear resend buffer */
+    }
+    /* invalidate timeouts still queued for the memo */
+    memo->timeout_gen++;
+    memo->timeout_lost = false;
+    memo->state = GCOAP_MEMO_UNUSED;
+    memarray_free(&_coap_state.req_pool, memo);
+}
+
+/*
+ * Counts the open requests to a remote endpoint. The caller must hold
+ * _coap_state.lock.
+ */
+static unsigned _count_req_memos(const sock_udp_ep_t *remote)
+{
+    unsigned count = 0;
+
+    for (unsigned i = 0; i < GCOAP_REQ_HASH_SIZE; i++) {
+        for (gcoap_request_memo_t *memo = _coap_state.open_reqs[i];
+             memo != NULL; memo = memo->next) {
+            if (_endpoints_equal(&memo->remote_ep, remote)) {
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+/*
+ * Copies a PDU into a free resend buffer and returns the buffer, or NULL if
+ * all are in use. The caller must hold _coap_state.lock.
+ */
+static uint8_t *_alloc_resend_buf(const uint8_t *buf)
+{
+    for (int i = 0; i < GCOAP_RESEND_BUFS_MAX; i++) {
+        if (!_coap_state.resend_bufs[i][0]) {
+            memcpy(&_coap_state.resend_bufs[i][0], buf, GCOAP_PDU_BUF_SIZE);
+            return &_coap_state.resend_bufs[i][0];
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Queues a request to a server with GCOAP_NSTART requests open, or with
+ * requests queued already, so they are sent in order. The PDU is kept in a
+ * resend buffer until the request is sent. Returns false if no resend buffer
+ * is free. The caller must hold _coap_state.lock.
+ */
+static bool _queue_req_memo(gcoap_request_memo_t *memo, const uint8_t *buf,
+                            size_t len)
+{
+    gcoap_request_memo_t **tail = &_coap_state.queued_reqs;
+
+    memo->msg.data.pdu_buf = _alloc_resend_buf(buf);
+    if (memo->msg.data.pdu_buf == NULL) {
+        return false;
+    }
+    memo->msg.data.pdu_len = len;
+    memo->state = GCOAP_MEMO_QUEUED;
+    while (*tail != NULL) {
+        tail = &(*tail)->next;
+    }
+    memo->next = NULL;
+    *tail = memo;
+    _coap_state.queued_reqs_numof++;
+    return true;
+}
+
+/* Returns true if a request to a remote endpoint is queued. The caller must
+ * hold _coap_state.lock. */
+static bool _is_queued(const sock_udp_ep_t *remote)
+{
+    for (gcoap_request_memo_t *memo = _coap_state.queued_reqs; memo != NULL;
+         memo = memo->next) {
+        if (_endpoints_equal(&memo->remote_ep, remote)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Sends the queued requests whose server has fewer than GCOAP_NSTART
+ * requests open, in the order they were queued. Runs on the gcoap thread.
+ * If the send fails, the response timer expires the request as usual.
+ */
+static void _send_queued(void)
+{
+    gcoap_request_memo_t **prev;
+
+    mutex_lock(&_coap_state.lock);
+    prev = &_coap_state.queued_reqs;
+    while (*prev != NULL) {
+        gcoap_request_memo_t *memo = *prev;
+        uint8_t *pdu_buf = memo->msg.data.pdu_buf;
+        size_t pdu_len = memo->msg.data.pdu_len;
+        uint32_t timeout;
+
+        if (_count_req_memos(&memo->remote_ep) >= GCOAP_NSTART) {
+            prev = &memo->next;
+            continue;
+        }
+        *prev = memo->next;
+        _coap_state.queued_reqs_numof--;
+        memo->state = GCOAP_MEMO_WAIT;
+        if (((*pdu_buf & 0x30) >> 4) == COAP_TYPE_CON) {
+            memo->send_limit  = COAP_MAX_RETRANSMIT;
+            timeout           = (uint32_t)COAP_ACK_TIMEOUT * US_PER_SEC;
+            uint32_t variance = (uint32_t)COAP_ACK_VARIANCE * US_PER_SEC;
+            timeout = random_uint32_range(timeout, timeout + variance);
+        }
+        else {
+            /* keep the header only; the buffer is freed once sent */
+            memo->send_limit = GCOAP_SEND_LIMIT_NON;
+            memcpy(&memo->msg.hdr_buf[0], pdu_buf, GCOAP_HEADER_MAXLEN);
+            timeout = GCOAP_NON_TIMEOUT;
+        }
+        _add_req_memo(memo);
+        if (timeout > 0) {
+            _set_timeout(memo, timeout);
+        }
+        mutex_unlock(&_coap_state.lock);
+
+        ssize_t res = sock_udp_send(&_sock, pdu_buf, pdu_len,
+                                    &memo->remote_ep);
+
+        mutex_lock(&_coap_state.lock);
+        if (memo->send_limit == GCOAP_SEND_LIMIT_NON) {
+            *pdu_buf = 0;   /* clear resend buffer */
+        }
+        if (res <= 0) {
+            DEBUG("gcoap: sock send of queued request failed: %d\n",
+                  (int)res);
+            /* without a response timer, nothing would expire the request */
+            if (timeout == 0) {
+                _release_req_memo(memo);
+            }
+        }
+        /* the queue may have changed meanwhile */
+        prev = &_coap_state.queued_reqs;
+    }
+    mutex_unlock(&_coap_state.lock);
+}
+
+/*
+ * Returns the largest block size up to GCOAP_BLOCK_SZX that fits into a PDU
+ * buffer along with overhead bytes.
+ */
+static unsigned _block_szx(size_t overhead)
+{
+    unsigned szx = GCOAP_BLOCK_SZX;
+
+    while ((szx > 0) && ((overhead + (16U << szx)) > GCOAP_PDU_BUF_SIZE)) {
+        szx--;
+    }
+    return szx;
+}
+
+/*
+ * Sends the request for a block of a transfer: a GET with Block2 option, or
+ * the block of the body with Block1 option.
+ */
+static int _block_req_send(gcoap_block_xfer_t *xfer, uint32_t blknum)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+    uint8_t *bufpos;
+    uint16_t lastonum = 0;
+    size_t blksize = 16U << xfer->szx;
+
+    if (gcoap_req_init(&pdu, buf, sizeof(buf), xfer->code, xfer->path) < 0) {
+        return -ENOMEM;
+    }
+    bufpos = buf + coap_get_total_hdr_len(&pdu);
+    if (strlen(xfer->path) > 1) {
+        bufpos += coap_put_option_uri(bufpos, 0, xfer->path,
+                                      COAP_OPT_URI_PATH);
+        lastonum = COAP_OPT_URI_PATH;
+    }
+    if (xfer->gen == NULL) {
+        bufpos += coap_put_option_block2(bufpos, lastonum, blknum, xfer->szx,
+                                         0);
+    }
+    else {
+        /* leave room for the Block1 option of up to 5 bytes and the
+         * payload marker; one more byte than the block tells if it is the
+         * last one */
+        uint8_t *payload = bufpos + 5 + 1;
+        ssize_t res;
+        int more;
+
+        if ((size_t)((payload + blksize + 1) - buf) > sizeof(buf)) {
+            return -ENOMEM;
+        }
+        res = xfer->gen(xfer->arg, (size_t)blknum << (xfer->szx + 4), payload,
+                        blksize + 1);
+        if (res < 0) {
+            return -ENOMEM;
+        }
+        more = ((size_t)res > blksize);
+        if (more) {
+            res = blksize;
+        }
+        bufpos += coap_put_option_block1(bufpos, lastonum, blknum, xfer->szx,
+                                         more);
+        if (res > 0) {
+            *bufpos++ = GCOAP_PAYLOAD_MARKER;
+            memmove(bufpos, payload, res);
+            bufpos += res;
+        }
+    }
+    /* the response may be handled before _req_send() returns */
+    xfer->inflight++;
+    if (_req_send(buf, bufpos - buf, &xfer->remote, NULL, xfer) == 0) {
+        xfer->inflight--;
+        return -ENOMEM;
+    }
+    return 0;
+}
+
+/*
+ * Ends a transfer: drops its requests still in flight and notifies the
+ * handler.
+ */
+static void _block_end(gcoap_block_xfer_t *xfer, unsigned state,
+                       coap_pkt_t *pdu)
+{
+    mutex_lock(&_coap_state.lock);
+    for (unsigned i = 0; i < GCOAP_REQ_HASH_SIZE; i++) {
+        gcoap_request_memo_t *memo = _coap_state.open_reqs[i];
+
+        while (memo != NULL) {
+            /* releasing the memo overwrites next */
+            gcoap_request_memo_t *next = memo->next;
+
+            if (memo->block_xfer == xfer) {
+                xtimer_remove(&memo->response_timer);
+                _release_req_memo(memo);
+            }
+            memo = next;
+        }
+    }
+    for (gcoap_request_memo_t *memo = _coap_state.queued_reqs; memo != NULL;) {
+        gcoap_request_memo_t *next = memo->next;
+
+        if (memo->block_xfer == xfer) {
+            _release_req_memo(memo);
+        }
+        memo = next;
+    }
+    mutex_unlock(&_coap_state.lock);
+    xfer->inflight = 0;
+    xfer->handler(xfer, state, pdu, 0);
+}
+
+/* Handles the response to a request of a transfer. */
+static void _block_resp(gcoap_block_xfer_t *xfer, coap_pkt_t *pdu)
+{
+    coap_block1_t block1;
+
+    xfer->inflight--;
+    if (xfer->gen == NULL) {
+        _block2_resp(xfer, pdu);
+        return;
+    }
+    if (coap_get_code_class(pdu) != COAP_CLASS_SUCCESS) {
+        _block_end(xfer, GCOAP_BLOCK_ERR, pdu);
+        return;
+    }
+    if (coap_get_code_raw(pdu) != COAP_CODE_231) {
+        /* final response */
+        _block_end(xfer, GCOAP_BLOCK_DONE, pdu);
+        return;
+    }
+    /* continue with the next block, in the size the server asks for */
+    if (coap_get_block1(pdu, &block1) && (block1.szx < xfer->szx)) {
+        size_t offset = (size_t)(xfer->base + 1) << (xfer->szx + 4);
+
+        xfer->szx = block1.szx;
+        xfer->base = offset >> (xfer->szx + 4);
+    }
+    else {
+        xfer->base++;
+    }
+    if (_block_req_send(xfer, xfer->base) < 0) {
+        _block_end(xfer, GCOAP_BLOCK_ERR, NULL);
+    }
+}
+
+/* Handles the response to a Block2 request of a transfer. */
+static void _block2_resp(gcoap_block_xfer_t *xfer, coap_pkt_t *pdu)
+{
+    coap_block1_t block2;
+    uint32_t blknum;
+
+    if (coap_get_code_class(pdu) != COAP_CLASS_SUCCESS) {
+        if (xfer->last == UINT32_MAX) {
+            _block_end(xfer, GCOAP_BLOCK_ERR, pdu);
+        }
+        /* else a request for a block past the end */
+        return;
+    }
+    if (!coap_get_block2(pdu, &block2)) {
+        /* the server sent the representation as a whole */
+        xfer->handler(xfer, GCOAP_BLOCK_NEXT, pdu, 0);
+        _block_end(xfer, GCOAP_BLOCK_DONE, NULL);
+        return;
+    }
+    if ((xfer->next == 1) && (block2.szx < xfer->szx)) {
+        /* only block 0 was requested so far, switch to the server's size */
+        xfer->szx = block2.szx;
+    }
+    blknum = block2.offset >> (xfer->szx + 4);
+    if (!block2.more) {
+        uint32_t last = ((pdu->payload_len > 0) || (blknum == 0))
+                        ? blknum : blknum - 1;
+
+        if (last < xfer->last) {
+            xfer->last = last;
+        }
+    }
+    if ((blknum >= xfer->base) && ((blknum - xfer->base) < 32) &&
+        !(xfer->received & (1UL << (blknum - xfer->base)))) {
+        xfer->received |= (1UL << (blknum - xfer->base));
+        if (pdu->payload_len > 0) {
+            xfer->handler(xfer, GCOAP_BLOCK_NEXT, pdu, block2.offset);
+        }
+    }
+    while (xfer->received & 1) {
+        xfer->received >>= 1;
+        xfer->base++;
+    }
+    if (xfer->base > xfer->last) {
+        _block_end(xfer, GCOAP_BLOCK_DONE, NULL);
+        return;
+    }
+    while ((xfer->inflight < GCOAP_BLOCK_WINDOW) &&
+           (xfer->next <= xfer->last) &&
+           ((xfer->next - xfer->base) < 32)) {
+        if (_block_req_send(xfer, xfer->next) < 0) {
+            break;
+        }
+        xfer->next++;
+    }
+    if (xfer->inflight == 0) {
+        /* no response is pending that could make progress */
+        _block_end(xfer, GCOAP_BLOCK_ERR, NULL);
+    }
+}
+
+/*
+ * Handles the expiry of the response timer of a request: resends a
+ * confirmable request with doubled timeout, or expires the request if no
+ * retries remain.
+ */
+static void _handle_timeout(gcoap_request_memo_t *memo)
+{
+    /* no retries remaining */
+    if ((memo->send_limit == GCOAP_SEND_LIMIT_NON)
+            || (memo->send_limit == 0)) {
+        _expire_request(memo);
+        return;
+    }
+    /* reduce retries remaining, double timeout and resend */
+    memo->send_limit--;
+    unsigned i        = COAP_MAX_RETRANSMIT - memo->send_limit;
+    uint32_t timeout  = ((uint32_t)COAP_ACK_TIMEOUT << i) * US_PER_SEC;
+    uint32_t variance = ((uint32_t)COAP_ACK_VARIANCE << i) * US_PER_SEC;
+    timeout = random_uint32_range(timeout, timeout + variance);
+
+    ssize_t bytes = sock_udp_send(&_sock, memo->msg.data.pdu_buf,
+                                  memo->msg.data.pdu_len,
+                                  &memo->remote_ep);
+    if (bytes > 0) {
+        _set_timeout(memo, timeout);
+    }
+    else {
+        DEBUG("gcoap: sock resend failed: %d\n", (int)bytes);
+        _expire_request(memo);
+    }
+}
+
+/*
+ * Response timer callback, in interrupt context. Sends the timeout to the
+ * gcoap thread, tagged with the index of the memo and the generation of its
+ * timer. If the queue is full, the memo is marked for the gcoap thread to
+ * find instead.
+ */
+static void _timeout_cb(void *arg)
+{
+    gcoap_request_memo_t *memo = arg;
+    msg_t msg;
+
+    msg.type = GCOAP_MSG_TYPE_TIMEOUT;
+    msg.content.value = ((uint32_t)(memo - _coap_state.req_memos) << 16) |
+                        memo->timeout_gen;
+    if (msg_send_int(&msg, _pid) <= 0) {
+        memo->timeout_lost = true;
+        _coap_state.timeouts_lost = true;
+    }
+}
+
+/* Starts the response timer of a memo, invalidating earlier timeouts. */
+static void _set_timeout(gcoap_request_memo_t *memo, uint32_t timeout)
+{
+    memo->timeout_gen++;
+    memo->timeout_lost = false;
+    memo->response_timer.callback = _timeout_cb;
+    memo->response_timer.arg = memo;
+    xtimer_set(&memo->response_timer, timeout);
+}
+
 /* Calls handler callback on receipt of a timeout message. */
 static void _expire_request(gcoap_request_memo_t *memo)
 {
     DEBUG("coap: received timeout message\n");
-    if (memo->state == GCOAP_MEMO_WAIT) {
+    if ((memo->state == GCOAP_MEMO_WAIT) && (memo->block_xfer != NULL)) {
+        gcoap_block_xfer_t *xfer = memo->block_xfer;
+
+        mutex_lock(&_coap_state.lock);
+        _release_req_memo(memo);
+        mutex_unlock(&_coap_state.lock);
+        xfer->inflight--;
+        _block_end(xfer, GCOAP_BLOCK_ERR, NULL);
+    }
+    else if (memo->state == GCOAP_MEMO_WAIT) {
         memo->state = GCOAP_MEMO_TIMEOUT;
         /* Pass response to handler */
         if (memo->resp_handler) {
             coap_pkt_t req;
-            if (memo->send_limit == GCOAP_SEND_LIMIT_NON) {
-                req.hdr = (coap_hdr_t *)&memo->msg.hdr_buf[0];   /* for reference */
-            }
-            else {
-                req.hdr = (coap_hdr_t *)memo->msg.data.pdu_buf;
-            }
+            req.hdr = _req_memo_hdr(memo);  /* for reference */
             memo->resp_handler(memo->state, &req, NULL);
         }
-        if (memo->send_limit != GCOAP_SEND_LIMIT_NON) {
-            *memo->msg.data.pdu_buf = 0;    /* clear resend buffer */
-        }
-        memo->state = GCOAP_MEMO_UNUSED;
+        mutex_lock(&_coap_state.lock);
+        _release_req_memo(memo);
+        mutex_unlock(&_coap_state.lock);
     }
     else {
         /* Response already handled; timeout must have fired while response */
@@ -609,96 +1210,225 @@ static bool _endpoints_equal(const sock_udp_ep_t *ep1, const sock_udp_ep_t *ep2)
     return false;
 }
 
+/* Returns the bucket of the Observe clients hash table for an endpoint. */
+static gcoap_observer_t **_observer_bucket(const sock_udp_ep_t *remote)
+{
+    const uint8_t *addr = (const uint8_t *)&remote->addr;
+    unsigned addr_len = (remote->family == AF_INET6) ? 16 : 4;
+    unsigned hash = remote->port;
+
+    for (unsigned i = 0; i < addr_len; i++) {
+        hash = (hash * 31) + addr[i];
+    }
+    return &_coap_state.observers_tab[hash & (GCOAP_OBS_HASH_SIZE - 1)];
+}
+
+/* Returns the bucket of the observe memos hash table for a resource. */
+static gcoap_observe_memo_t **_obs_memo_bucket(const coap_resource_t *resource)
+{
+    /* resources of a listener are adjacent, so they get adjacent buckets */
+    uintptr_t hash = (uintptr_t)resource / sizeof(coap_resource_t);
+
+    return &_coap_state.obs_memos_tab[hash & (GCOAP_OBS_HASH_SIZE - 1)];
+}
+
 /*
- * Find registered observer for a remote address and port.
+ * Find registered observer for a remote address and port. The caller must
+ * hold _coap_state.lock.
  *
- * observer[out] -- Registered observer, or NULL if not found
  * remote[in] -- Endpoint to match
  *
- * return Index of empty slot, suitable for registering new observer; or -1
- *        if no empty slots. Undefined if observer found.
+ * return Registered observer, or NULL if not found
  */
-static int _find_observer(sock_udp_ep_t **observer, sock_udp_ep_t *remote)
+static gcoap_observer_t *_find_observer(const sock_udp_ep_t *remote)
 {
-    int empty_slot = -1;
-    *observer      = NULL;
-    for (unsigned i = 0; i < GCOAP_OBS_CLIENTS_MAX; i++) {
-
-        if (_coap_state.observers[i].family == AF_UNSPEC) {
-            empty_slot = i;
-        }
-        else if (_endpoints_equal(&_coap_state.observers[i], remote)) {
-            *observer = &_coap_state.observers[i];
-            break;
+    for (gcoap_observer_t *observer = *_observer_bucket(remote);
+         observer != NULL; observer = observer->next) {
+        if (_endpoints_equal(&observer->ep, remote)) {
+            return observer;
         }
     }
-    return empty_slot;
+    return NULL;
+}
+
+/* Returns true if an observe memo holds the (non-empty) token of a PDU. */
+static bool _obs_memo_token_equal(const gcoap_observe_memo_t *memo,
+                                  coap_pkt_t *pdu)
+{
+    unsigned cmplen = memo->token_len;
+
+    return (cmplen != 0) && (cmplen == coap_get_token_len(pdu))
+           && (memcmp(&memo->token[0], &pdu->token[0], cmplen) == 0);
 }
 
 /*
- * Find registered observe memo for a remote address and token.
+ * Find registered observe memo of an observer for a resource. The caller
+ * must hold _coap_state.lock.
  *
- * memo[out] -- Registered observe memo, or NULL if not found
- * remote[in] -- Endpoint for address to match
- * pdu[in] -- PDU for token to match, or NULL to match only on remote address
+ * observer[in] -- Observer to match
+ * resource[in] -- Resource to match
+ * pdu[in] -- PDU for token to match, or NULL to match any token
  *
- * return Index of empty slot, suitable for registering new memo; or -1 if no
- *        empty slots. Undefined if memo found.
+ * return Registered observe memo, or NULL if not found
  */
-static int _find_obs_memo(gcoap_observe_memo_t **memo, sock_udp_ep_t *remote,
-                                                       coap_pkt_t *pdu)
+static gcoap_observe_memo_t *_find_obs_memo(const gcoap_observer_t *observer,
+                                            const coap_resource_t *resource,
+                                            coap_pkt_t *pdu)
 {
-    int empty_slot = -1;
-    *memo          = NULL;
-
-    sock_udp_ep_t *remote_observer = NULL;
-    _find_observer(&remote_observer, remote);
-
-    for (unsigned i = 0; i < GCOAP_OBS_REGISTRATIONS_MAX; i++) {
-        if (_coap_state.observe_memos[i].observer == NULL) {
-            empty_slot = i;
-            continue;
+    for (gcoap_observe_memo_t *memo = *_obs_memo_bucket(resource);
+         memo != NULL; memo = memo->next) {
+        if ((memo->resource == resource) && (memo->observer == &observer->ep)
+                && ((pdu == NULL) || _obs_memo_token_equal(memo, pdu))) {
+            return memo;
         }
+    }
+    return NULL;
+}
 
-        if (_coap_state.observe_memos[i].observer == remote_observer) {
-            if (pdu == NULL) {
-                *memo = &_coap_state.observe_memos[i];
-                break;
-            }
-
-            if (_coap_state.observe_memos[i].token_len == coap_get_token_len(pdu)) {
-                unsigned cmplen = _coap_state.observe_memos[i].token_len;
-                if (cmplen &&
-                        memcmp(&_coap_state.observe_memos[i].token[0], &pdu->token[0],
-                                                                       cmplen) == 0) {
-                    *memo = &_coap_state.observe_memos[i];
-                    break;
-                }
+/*
+ * Find registered observe memo of an observer for any resource, by token.
+ * Walks all buckets, so used only for registration. The caller must hold
+ * _coap_state.lock.
+ *
+ * observer[in] -- Observer to match
+ * pdu[in] -- PDU for token to match
+ *
+ * return Registered observe memo, or NULL if not found
+ */
+static gcoap_observe_memo_t *_find_obs_memo_token(const gcoap_observer_t *observer,
+                                                  coap_pkt_t *pdu)
+{
+    for (unsigned i = 0; i < GCOAP_OBS_HASH_SIZE; i++) {
+        for (gcoap_observe_memo_t *memo = _coap_state.obs_memos_tab[i];
+             memo != NULL; memo = memo->next) {
+            if ((memo->observer == &observer->ep)
+                    && _obs_memo_token_equal(memo, pdu)) {
+                return memo;
             }
         }
     }
-    return empty_slot;
+    return NULL;
 }
 
 /*
- * Find registered observe memo for a resource.
+ * Find first registered observe memo for a resource. The caller must hold
+ * _coap_state.lock.
  *
- * memo[out] -- Registered observe memo, or NULL if not found
  * resource[in] -- Resource to match
+ *
+ * return Registered observe memo, or NULL if not found
+ */
+static gcoap_observe_memo_t *_find_obs_memo_resource(const coap_resource_t *resource)
+{
+    for (gcoap_observe_memo_t *memo = *_obs_memo_bucket(resource);
+         memo != NULL; memo = memo->next) {
+        if (memo->resource == resource) {
+            return memo;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Registers a resource for an observer, allocating the memo and, if
+ * observer is NULL, a new observer for remote from their pools. The caller
+ * must hold _coap_state.lock.
+ *
+ * return New observe memo, or NULL if a pool is exhausted
  */
-static void _find_obs_memo_resource(gcoap_observe_memo_t **memo,
-                                   const coap_resource_t *resource)
+static gcoap_observe_memo_t *_add_obs_memo(gcoap_observer_t *observer,
+                                           const sock_udp_ep_t *remote,
+                                           coap_resource_t *resource)
 {
-    *memo = NULL;
-    for (int i = 0; i < GCOAP_OBS_REGISTRATIONS_MAX; i++) {
-        if (_coap_state.observe_memos[i].observer != NULL
-                && _coap_state.observe_memos[i].resource == resource) {
-            *memo = &_coap_state.observe_memos[i];
+    gcoap_observe_memo_t *memo = memarray_alloc(&_coap_state.obs_memo_pool);
+    gcoap_observe_memo_t **bucket;
+
+    if (memo == NULL) {
+        DEBUG("gcoap: can't register observe memo\n");
+        return NULL;
+    }
+    /* cache new observer */
+    if (observer == NULL) {
+        gcoap_observer_t **observer_bucket = _observer_bucket(remote);
+
+        observer = memarray_alloc(&_coap_state.observer_pool);
+        if (observer == NULL) {
+            DEBUG("gcoap: can't register observer\n");
+            memarray_free(&_coap_state.obs_memo_pool, memo);
+            return NULL;
+        }
+        memcpy(&observer->ep, remote, sizeof(sock_udp_ep_t));
+        observer->memos_numof = 0;
+        observer->next = *observer_bucket;
+        *observer_bucket = observer;
+    }
+    observer->memos_numof++;
+
+    memo->observer = &observer->ep;
+    memo->resource = resource;
+    bucket = _obs_memo_bucket(resource);
+    memo->next = *bucket;
+    *bucket = memo;
+    return memo;
+}
+
+/*
+ * Removes an observe memo and returns it to its pool, along with its
+ * observer if it has no other memos. The caller must hold _coap_state.lock.
+ */
+static void _release_obs_memo(gcoap_observe_memo_t *memo)
+{
+    gcoap_observer_t *observer = container_of(memo->observer,
+                                              gcoap_observer_t, ep);
+    gcoap_observe_memo_t **bucket = _obs_memo_bucket(memo->resource);
+
+    while (*bucket != NULL) {
+        if (*bucket == memo) {
+            *bucket = memo->next;
             break;
         }
+        bucket = &(*bucket)->next;
+    }
+    memo->observer = NULL;
+    memarray_free(&_coap_state.obs_memo_pool, memo);
+
+    if (--observer->memos_numof == 0) {
+        gcoap_observer_t **observer_bucket = _observer_bucket(&observer->ep);
+
+        while (*observer_bucket != NULL) {
+            if (*observer_bucket == observer) {
+                *observer_bucket = observer->next;
+                break;
+            }
+            observer_bucket = &(*observer_bucket)->next;
+        }
+        observer->ep.family = AF_UNSPEC;
+        memarray_free(&_coap_state.observer_pool, observer);
     }
 }
 
+/*
+ * Initializes an Observe notification on a buffer, with the given token.
+ */
+static void _obs_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                      uint8_t *token, unsigned token_len)
+{
+    uint16_t msgid = (uint16_t)atomic_fetch_add(&_coap_state.next_message_id, 1);
+    uint32_t now   = xtimer_now_usec();
+
+    pdu->hdr = (coap_hdr_t *)buf;
+    coap_build_hdr(pdu->hdr, COAP_TYPE_NON, token, token_len,
+                   COAP_CODE_CONTENT, msgid);
+    pdu->observe_value = (now >> GCOAP_OBS_TICK_EXPONENT) & 0xFFFFFF;
+
+    /* Reserve some space between the header and payload to write options later */
+    pdu->payload       = buf + coap_get_total_hdr_len(pdu) + GCOAP_OBS_OPTIONS_BUF;
+    /* Payload length really zero at this point, but we set this to the available
+     * length in the buffer. Allows us to reconstruct buffer length later. */
+    pdu->payload_len   = len - (pdu->payload - buf);
+    pdu->content_type  = COAP_FORMAT_NONE;
+}
+
 /*
  * gcoap interface functions
  */
@@ -708,14 +1438,25 @@ kernel_pid_t gcoap_init(void)
     if (_pid != KERNEL_PID_UNDEF) {
         return -EEXIST;
     }
+    /* index the resources of gcoap itself before any request may arrive */
+    _index_listener(&_default_listener);
     _pid = thread_create(_msg_stack, sizeof(_msg_stack), THREAD_PRIORITY_MAIN - 1,
                             THREAD_CREATE_STACKTEST, _event_loop, NULL, "coap");
 
     mutex_init(&_coap_state.lock);
     /* Blank lists so we know if an entry is available. */
+    memarray_init(&_coap_state.req_pool, _coap_state.req_memos,
+                  sizeof(gcoap_request_memo_t), GCOAP_REQ_WAITING_MAX);
     memset(&_coap_state.open_reqs[0], 0, sizeof(_coap_state.open_reqs));
-    memset(&_coap_state.observers[0], 0, sizeof(_coap_state.observers));
-    memset(&_coap_state.observe_memos[0], 0, sizeof(_coap_state.observe_memos));
+    _coap_state.open_reqs_numof = 0;
+    _coap_state.queued_reqs = NULL;
+    _coap_state.queued_reqs_numof = 0;
+    memarray_init(&_coap_state.observer_pool, _coap_state.observers,
+                  sizeof(gcoap_observer_t), GCOAP_OBS_CLIENTS_MAX);
+    memset(&_coap_state.observers_tab[0], 0, sizeof(_coap_state.observers_tab));
+    memarray_init(&_coap_state.obs_memo_pool, _coap_state.observe_memos,
+                  sizeof(gcoap_observe_memo_t), GCOAP_OBS_REGISTRATIONS_MAX);
+    memset(&_coap_state.obs_memos_tab[0], 0, sizeof(_coap_state.obs_memos_tab));
     memset(&_coap_state.resend_bufs[0], 0, sizeof(_coap_state.resend_bufs));
     /* randomize initial value */
     atomic_init(&_coap_state.next_message_id, (unsigned)random_uint32());
@@ -725,6 +1466,7 @@ kernel_pid_t gcoap_init(void)
 
 void gcoap_register_listener(gcoap_listener_t *listener)
 {
+    mutex_lock(&_coap_state.lock);
     /* Add the listener to the end of the linked list. */
     gcoap_listener_t *_last = _coap_state.listeners;
     while (_last->next) {
@@ -733,6 +1475,9 @@ void gcoap_register_listener(gcoap_listener_t *listener)
 
     listener->next = NULL;
     _last->next = listener;
+
+    _index_listener(listener);
+    mutex_unlock(&_coap_state.lock);
 }
 
 int gcoap_req_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
@@ -809,46 +1554,60 @@ size_t gcoap_req_send(const uint8_t *buf, size_t len, const ipv6_addr_t *addr,
 size_t gcoap_req_send2(const uint8_t *buf, size_t len,
                        const sock_udp_ep_t *remote,
                        gcoap_resp_handler_t resp_handler)
+{
+    return _req_send(buf, len, remote, resp_handler, NULL);
+}
+
+/*
+ * Sends a request and tracks it for the response, for gcoap_req_send2() and
+ * for blockwise transfers.
+ */
+static size_t _req_send(const uint8_t *buf, size_t len,
+                        const sock_udp_ep_t *remote,
+                        gcoap_resp_handler_t resp_handler,
+                        gcoap_block_xfer_t *block_xfer)
 {
     gcoap_request_memo_t *memo = NULL;
     unsigned msg_type  = (*buf & 0x30) >> 4;
     uint32_t timeout   = 0;
+    bool wake_up       = false;
 
     assert(remote != NULL);
 
     /* Only allocate memory if necessary (i.e. if user is interested in the
      * response or request is confirmable) */
-    if ((resp_handler != NULL) || (msg_type == COAP_TYPE_CON)) {
+    if ((resp_handler != NULL) || (block_xfer != NULL)
+            || (msg_type == COAP_TYPE_CON)) {
         mutex_lock(&_coap_state.lock);
-        /* Find empty slot in list of open requests. */
-        for (int i = 0; i < GCOAP_REQ_WAITING_MAX; i++) {
-            if (_coap_state.open_reqs[i].state == GCOAP_MEMO_UNUSED) {
-                memo = &_coap_state.open_reqs[i];
-                memo->state = GCOAP_MEMO_WAIT;
-                break;
-            }
-        }
+        memo = memarray_alloc(&_coap_state.req_pool);
         if (!memo) {
             mutex_unlock(&_coap_state.lock);
             DEBUG("gcoap: dropping request; no space for response tracking\n");
             return 0;
         }
-
+        memo->state = GCOAP_MEMO_WAIT;
         memo->resp_handler = resp_handler;
+        memo->block_xfer = block_xfer;
         memcpy(&memo->remote_ep, remote, sizeof(sock_udp_ep_t));
 
+        if ((_count_req_memos(remote) >= GCOAP_NSTART) || _is_queued(remote)) {
+            /* the gcoap thread sends it once a request to remote completes */
+            if (!_queue_req_memo(memo, buf, len)) {
+                memarray_free(&_coap_state.req_pool, memo);
+                mutex_unlock(&_coap_state.lock);
+                DEBUG("gcoap: dropping request; no buffer to queue it\n");
+                return 0;
+            }
+            mutex_unlock(&_coap_state.lock);
+            DEBUG("gcoap: NSTART reached for remote; request queued\n");
+            return len;
+        }
+
         switch (msg_type) {
         case COAP_TYPE_CON:
             /* copy buf to resend_bufs record */
-            memo->msg.data.pdu_buf = NULL;
-            for (int i = 0; i < GCOAP_RESEND_BUFS_MAX; i++) {
-                if (!_coap_state.resend_bufs[i][0]) {
-                    memo->msg.data.pdu_buf = &_coap_state.resend_bufs[i][0];
-                    memcpy(memo->msg.data.pdu_buf, buf, GCOAP_PDU_BUF_SIZE);
-                    memo->msg.data.pdu_len = len;
-                    break;
-                }
-            }
+            memo->msg.data.pdu_buf = _alloc_resend_buf(buf);
+            memo->msg.data.pdu_len = len;
             if (memo->msg.data.pdu_buf) {
                 memo->send_limit  = COAP_MAX_RETRANSMIT;
                 timeout           = (uint32_t)COAP_ACK_TIMEOUT * US_PER_SEC;
@@ -871,51 +1630,96 @@ size_t gcoap_req_send2(const uint8_t *buf, size_t len,
             DEBUG("gcoap: illegal msg type %u\n", msg_type);
             break;
         }
-        mutex_unlock(&_coap_state.lock);
         if (memo->state == GCOAP_MEMO_UNUSED) {
+            memarray_free(&_coap_state.req_pool, memo);
+            mutex_unlock(&_coap_state.lock);
             return 0;
         }
+        /* Track the request before sending it; the response may be handled
+         * before sock_udp_send() returns. */
+        _add_req_memo(memo);
+        /* gcoap blocks indefinitely in _listen() only while there are no
+         * open requests */
+        wake_up = (_coap_state.open_reqs_numof == 1);
+        /* timeout may be zero for non-confirmable */
+        if (timeout > 0) {
+            /* start response wait timer on the gcoap thread */
+            _set_timeout(memo, timeout);
+        }
+        mutex_unlock(&_coap_state.lock);
     }
 
-    /* Memos complete; send msg and start timer */
     ssize_t res = sock_udp_send(&_sock, buf, len, remote);
 
-    /* timeout may be zero for non-confirmable */
-    if ((memo != NULL) && (res > 0) && (timeout > 0)) {
+    if ((res > 0) && wake_up) {
         /* We assume gcoap_req_send2() is called on some thread other than
-         * gcoap's. First, put a message in the mbox for the sock udp object,
-         * which will interrupt listening on the gcoap thread. (When there are
-         * no outstanding requests, gcoap blocks indefinitely in _listen() at
-         * sock_udp_recv().) While the message sent here is outstanding, the
+         * gcoap's. Put a message in the mbox for the sock udp object, which
+         * will interrupt listening on the gcoap thread. (When there are no
+         * outstanding requests, gcoap blocks indefinitely in _listen() at
+         * sock_udp_recv().) While the request is outstanding, the
          * sock_udp_recv() call will be set to a short timeout so the request
-         * timer below, also on the gcoap thread, is processed in a timely
-         * manner. */
+         * timer, also on the gcoap thread, is processed in a timely manner.
+         * If the mbox is full, gcoap is woken up anyway. */
         msg_t mbox_msg;
         mbox_msg.type          = GCOAP_MSG_TYPE_INTR;
         mbox_msg.content.value = 0;
-        if (mbox_try_put(&_sock.reg.mbox, &mbox_msg)) {
-            /* start response wait timer on the gcoap thread */
-            memo->timeout_msg.type        = GCOAP_MSG_TYPE_TIMEOUT;
-            memo->timeout_msg.content.ptr = (char *)memo;
-            xtimer_set_msg(&memo->response_timer, timeout, &memo->timeout_msg, _pid);
-        }
-        else {
-            res = 0;
-            DEBUG("gcoap: can't wake up mbox; no timeout for msg\n");
+        if (!mbox_try_put(&_sock.reg.mbox, &mbox_msg)) {
+            DEBUG("gcoap: mbox full; not interrupting listener\n");
         }
     }
     if (res <= 0) {
         if (memo != NULL) {
-            if (msg_type == COAP_TYPE_CON) {
-                *memo->msg.data.pdu_buf = 0;    /* clear resend buffer */
-            }
-            memo->state = GCOAP_MEMO_UNUSED;
+            xtimer_remove(&memo->response_timer);
+            mutex_lock(&_coap_state.lock);
+            _release_req_memo(memo);
+            mutex_unlock(&_coap_state.lock);
         }
         DEBUG("gcoap: sock send failed: %d\n", (int)res);
     }
     return (size_t)((res > 0) ? res : 0);
 }
 
+int gcoap_block2_get(gcoap_block_xfer_t *xfer, const sock_udp_ep_t *remote,
+                     const char *path, gcoap_block_handler_t handler,
+                     void *arg)
+{
+    assert((path != NULL) && (path[0] == '/') && (handler != NULL));
+
+    memset(xfer, 0, sizeof(gcoap_block_xfer_t));
+    memcpy(&xfer->remote, remote, sizeof(sock_udp_ep_t));
+    xfer->path = path;
+    xfer->handler = handler;
+    xfer->arg = arg;
+    xfer->code = COAP_METHOD_GET;
+    /* the response holds header, Content-Format, Block2 and payload marker */
+    xfer->szx = _block_szx(GCOAP_HEADER_MAXLEN + 3 + 4 + 1);
+    xfer->last = UINT32_MAX;
+    /* request further blocks only once the server confirmed the size */
+    xfer->next = 1;
+    return _block_req_send(xfer, 0);
+}
+
+int gcoap_block1_send(gcoap_block_xfer_t *xfer, const sock_udp_ep_t *remote,
+                      const char *path, unsigned code, coap_blockwise_cb_t gen,
+                      gcoap_block_handler_t handler, void *arg)
+{
+    assert((path != NULL) && (path[0] == '/') && (gen != NULL) &&
+           (handler != NULL));
+
+    memset(xfer, 0, sizeof(gcoap_block_xfer_t));
+    memcpy(&xfer->remote, remote, sizeof(sock_udp_ep_t));
+    xfer->path = path;
+    xfer->handler = handler;
+    xfer->gen = gen;
+    xfer->arg = arg;
+    xfer->code = code;
+    /* the request holds header, Uri-Path (each option header replaces a '/'
+     * and takes at most two bytes), Block1, payload marker and one byte to
+     * find the last block */
+    xfer->szx = _block_szx(GCOAP_HEADER_MAXLEN + (2 * strlen(path)) + 4 + 1 + 1);
+    return _block_req_send(xfer, 0);
+}
+
 int gcoap_resp_init(coap_pkt_t *pdu, uint8_t *buf, size_t len, unsigned code)
 {
     if (coap_get_type(pdu) == COAP_TYPE_CON) {
@@ -938,63 +1742,154 @@ int gcoap_obs_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
 {
     gcoap_observe_memo_t *memo = NULL;
 
-    _find_obs_memo_resource(&memo, resource);
-    if (memo == NULL) {
-        /* Unique return value to specify there is not an observer */
-        return GCOAP_OBS_INIT_UNUSED;
+    if (len < (GCOAP_HEADER_MAXLEN + GCOAP_OBS_OPTIONS_BUF)) {
+        return GCOAP_OBS_INIT_ERR;
     }
 
-    pdu->hdr       = (coap_hdr_t *)buf;
-    uint16_t msgid = (uint16_t)atomic_fetch_add(&_coap_state.next_message_id, 1);
-    ssize_t hdrlen = coap_build_hdr(pdu->hdr, COAP_TYPE_NON, &memo->token[0],
-                                    memo->token_len, COAP_CODE_CONTENT, msgid);
-
-    if (hdrlen > 0) {
-        uint32_t now       = xtimer_now_usec();
-        pdu->observe_value = (now >> GCOAP_OBS_TICK_EXPONENT) & 0xFFFFFF;
-
-        /* Reserve some space between the header and payload to write options later */
-        pdu->payload       = buf + coap_get_total_hdr_len(pdu) + GCOAP_OBS_OPTIONS_BUF;
-        /* Payload length really zero at this point, but we set this to the available
-         * length in the buffer. Allows us to reconstruct buffer length later. */
-        pdu->payload_len   = len - (pdu->payload - buf);
-        pdu->content_type  = COAP_FORMAT_NONE;
-
-        return GCOAP_OBS_INIT_OK;
+    mutex_lock(&_coap_state.lock);
+    memo = _find_obs_memo_resource(resource);
+    if (memo != NULL) {
+        _obs_init(pdu, buf, len, &memo->token[0], memo->token_len);
     }
-    else {
-        /* reason for negative hdrlen is not defined, so we also are vague */
-        return GCOAP_OBS_INIT_ERR;
+    mutex_unlock(&_coap_state.lock);
+
+    if (memo == NULL) {
+        /* Unique return value to specify there is not an observer */
+        return GCOAP_OBS_INIT_UNUSED;
     }
+    return GCOAP_OBS_INIT_OK;
 }
 
 size_t gcoap_obs_send(const uint8_t *buf, size_t len,
                       const coap_resource_t *resource)
 {
-    gcoap_observe_memo_t *memo = NULL;
+    /* gcoap_obs_init() wrote the token of one observer, the others get a
+     * copy with their own token and message ID */
+    uint8_t notif[GCOAP_PDU_BUF_SIZE];
+    const coap_hdr_t *hdr = (const coap_hdr_t *)buf;
+    unsigned token_len    = hdr->ver_t_tkl & 0xf;
+    const uint8_t *body   = &hdr->data[token_len];
+    size_t body_len       = len - (body - buf);
+    size_t count          = 0;
+
+    mutex_lock(&_coap_state.lock);
+    for (gcoap_observe_memo_t *memo = *_obs_memo_bucket(resource);
+         memo != NULL; memo = memo->next) {
+        ssize_t bytes;
+
+        if (memo->resource != resource) {
+            continue;
+        }
+        if ((memo->token_len == token_len) &&
+            (memcmp(&memo->token[0], &hdr->data[0], token_len) == 0)) {
+            bytes = sock_udp_send(&_sock, buf, len, memo->observer);
+        }
+        else if ((sizeof(coap_hdr_t) + memo->token_len + body_len) >
+                 sizeof(notif)) {
+            DEBUG("gcoap: notification too large to copy for observer\n");
+            continue;
+        }
+        else {
+            uint16_t msgid  = (uint16_t)atomic_fetch_add(&_coap_state.next_message_id, 1);
+            ssize_t hdr_len = coap_build_hdr((coap_hdr_t *)notif, COAP_TYPE_NON,
+                                             &memo->token[0], memo->token_len,
+                                             hdr->code, msgid);
+
+            memcpy(&notif[hdr_len], body, body_len);
+            bytes = sock_udp_send(&_sock, notif, hdr_len + body_len,
+                                  memo->observer);
+        }
+        if (bytes > 0) {
+            count++;
+        }
+        else {
+            DEBUG("gcoap: send notification failed: %d\n", (int)bytes);
+        }
+    }
+    mutex_unlock(&_coap_state.lock);
 
-    _find_obs_memo_resource(&memo, resource);
+    return (count > 0) ? len : 0;
+}
+
+int gcoap_obs_notify_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                          const coap_resource_t *resource)
+{
+    gcoap_observe_memo_t *memo = NULL;
 
-    if (memo) {
-        ssize_t bytes = sock_udp_send(&_sock, buf, len, memo->observer);
-        return (size_t)((bytes > 0) ? bytes : 0);
+    if (len < (GCOAP_HEADER_MAXLEN + GCOAP_OBS_OPTIONS_BUF)) {
+        return GCOAP_OBS_INIT_ERR;
     }
-    else {
-        return 0;
+
+    mutex_lock(&_coap_state.lock);
+    memo = _find_obs_memo_resource(resource);
+    mutex_unlock(&_coap_state.lock);
+
+    if (memo == NULL) {
+        /* Unique return value to specify there is not an observer */
+        return GCOAP_OBS_INIT_UNUSED;
     }
+    /* gcoap_obs_notify() writes the token of each observer in front of the
+     * options, so leave room for the longest one before the header */
+    _obs_init(pdu, buf + GCOAP_TOKENLEN_MAX, len - GCOAP_TOKENLEN_MAX, NULL, 0);
+    return GCOAP_OBS_INIT_OK;
 }
 
-uint8_t gcoap_op_state(void)
+size_t gcoap_obs_notify(coap_pkt_t *pdu, size_t len,
+                        const coap_resource_t *resource)
 {
-    uint8_t count = 0;
-    for (int i = 0; i < GCOAP_REQ_WAITING_MAX; i++) {
-        if (_coap_state.open_reqs[i].state != GCOAP_MEMO_UNUSED) {
+    /* options and payload, shared by all notifications */
+    uint8_t *body   = pdu->hdr->data;
+    size_t body_len = len - sizeof(coap_hdr_t);
+    unsigned code   = coap_get_code_raw(pdu);
+    size_t count    = 0;
+
+    assert(coap_get_token_len(pdu) == 0);
+
+    mutex_lock(&_coap_state.lock);
+    for (gcoap_observe_memo_t *memo = *_obs_memo_bucket(resource);
+         memo != NULL; memo = memo->next) {
+        if (memo->resource != resource) {
+            continue;
+        }
+
+        coap_hdr_t *hdr = (coap_hdr_t *)(body - sizeof(coap_hdr_t)
+                                         - memo->token_len);
+        uint16_t msgid  = (uint16_t)atomic_fetch_add(&_coap_state.next_message_id, 1);
+        ssize_t hdr_len = coap_build_hdr(hdr, COAP_TYPE_NON, &memo->token[0],
+                                         memo->token_len, code, msgid);
+        ssize_t bytes   = sock_udp_send(&_sock, hdr, hdr_len + body_len,
+                                        memo->observer);
+        if (bytes > 0) {
             count++;
         }
+        else {
+            DEBUG("gcoap: send notification failed: %d\n", (int)bytes);
+        }
     }
+    mutex_unlock(&_coap_state.lock);
+
     return count;
 }
 
+uint16_t gcoap_next_msgid(void)
+{
+    return (uint16_t)atomic_fetch_add(&_coap_state.next_message_id, 1);
+}
+
+ssize_t gcoap_sock_send(const uint8_t *buf, size_t len,
+                        const sock_udp_ep_t *remote)
+{
+    return sock_udp_send(&_sock, buf, len, remote);
+}
+
+uint8_t gcoap_op_state(void)
+{
+    unsigned count = _coap_state.open_reqs_numof +
+                     _coap_state.queued_reqs_numof;
+
+    return (count > UINT8_MAX) ? UINT8_MAX : (uint8_t)count;
+}
+
 int gcoap_get_resource_list(void *buf, size_t maxlen, uint8_t cf)
 {
     (void)cf; /* only used in the assert below. */
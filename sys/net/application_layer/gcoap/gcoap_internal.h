@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gcoap
+ * @{
+ *
+ * @file
+ * @brief       Interface between gcoap and its submodules
+ *
+ * @}
+ */
+
+#ifndef GCOAP_INTERNAL_H
+#define GCOAP_INTERNAL_H
+
+#include <stdint.h>
+
+#include "net/gcoap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Returns the next message ID to use
+ */
+uint16_t gcoap_next_msgid(void);
+
+/**
+ * @brief   Sends a message from the gcoap socket
+ *
+ * @return  length of the message, or < 0 on error
+ */
+ssize_t gcoap_sock_send(const uint8_t *buf, size_t len,
+                        const sock_udp_ep_t *remote);
+
+#ifdef MODULE_GCOAP_PROXY
+/**
+ * @brief   Handles a request if it is for the proxy
+ *
+ * Runs on the gcoap thread, before the request is matched with the
+ * resources of the listeners.
+ *
+ * @return  length of the response in @p buf, 0 if there is no response yet
+ * @return  -ENOENT if the request is not for the proxy
+ */
+ssize_t gcoap_proxy_handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                               const sock_udp_ep_t *remote);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GCOAP_INTERNAL_H */
@@ -0,0 +1,597 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gcoap
+ * @{
+ *
+ * @file
+ * @brief       Caching CoAP proxy for gcoap
+ *
+ * Runs on the gcoap thread: requests arrive through _handle_req() in gcoap.c,
+ * and upstream responses through the response handler of gcoap_req_send2().
+ * The cache and the fetches therefore need no locking. Only the routes may
+ * be added by other threads at any time, so they are guarded by a mutex.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "net/gcoap_proxy.h"
+#include "net/ipv6/addr.h"
+#include "mutex.h"
+#include "net/nanocoap_cache.h"
+#include "random.h"
+
+#include "gcoap_internal.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/* Length of the tokens of upstream requests */
+#define TOKEN_LEN           (4U)
+
+/* Longest option header, with extended delta and length */
+#define OPT_HDR_MAXLEN      (5U)
+
+/* Client waiting for an upstream response */
+typedef struct {
+    sock_udp_ep_t remote;
+    uint8_t token[GCOAP_TOKENLEN_MAX];
+    uint8_t token_len;
+} _client_t;
+
+/* Request sent upstream */
+typedef struct {
+    bool in_use;
+    bool revalidate;                    /* carries the ETag of a stale entry */
+    uint8_t cache_key[NANOCOAP_CACHE_KEY_LENGTH];
+    uint8_t token[TOKEN_LEN];
+    unsigned clients_numof;
+    _client_t clients[GCOAP_PROXY_WAITING_MAX];
+} _fetch_t;
+
+static void _resp_handler(unsigned req_state, coap_pkt_t *pdu,
+                          sock_udp_ep_t *remote);
+
+static gcoap_proxy_route_t *_routes;
+static mutex_t _routes_lock = MUTEX_INIT;
+static gcoap_proxy_stats_t _stats;
+static _fetch_t _fetches[GCOAP_PROXY_PENDING_MAX];
+
+/* Upstream request; _req_send() copies up to GCOAP_PDU_BUF_SIZE bytes of it,
+ * so it is free again for _put_cached_body() as soon as it is sent */
+static uint8_t _req_buf[GCOAP_PDU_BUF_SIZE];
+/* Upstream response body, with room for the header of any client in front */
+static uint8_t _resp_buf[GCOAP_HEADER_MAXLEN + GCOAP_PDU_BUF_SIZE];
+
+/* Uri-Path and Uri-Query of a forward proxy request, from its Proxy-Uri; each
+ * with a leading separator, as coap_put_option_uri() expects */
+static char _path[NANOCOAP_URI_MAX];
+static char _query[NANOCOAP_URI_MAX];
+
+/*
+ * Copies a part of a Proxy-Uri to a buffer, after the given separator.
+ */
+static int _copy_uri_part(char *dst, char separator, const char *src,
+                          size_t len)
+{
+    if ((len + 2) > NANOCOAP_URI_MAX) {
+        return -ENOSPC;
+    }
+    dst[0] = separator;
+    memcpy(&dst[1], src, len);
+    dst[len + 1] = '\0';
+    return 0;
+}
+
+/*
+ * Parses a Proxy-Uri of the form coap://[<IPv6 address>]:<port>/<path>?<query>
+ * into the upstream endpoint, _path and _query.
+ */
+static int _parse_proxy_uri(const uint8_t *uri, size_t uri_len,
+                            sock_udp_ep_t *upstream)
+{
+    static const char scheme[] = "coap://[";
+    const char *pos = (const char *)uri;
+    const char *end = pos + uri_len;
+    const char *addr_end, *query;
+    char addr[IPV6_ADDR_MAX_STR_LEN];
+
+    if ((uri_len < (sizeof(scheme) - 1)) ||
+        (memcmp(pos, scheme, sizeof(scheme) - 1) != 0)) {
+        return -EINVAL;
+    }
+    pos += sizeof(scheme) - 1;
+
+    addr_end = memchr(pos, ']', end - pos);
+    if ((addr_end == NULL) || ((size_t)(addr_end - pos) >= sizeof(addr))) {
+        return -EINVAL;
+    }
+    memcpy(addr, pos, addr_end - pos);
+    addr[addr_end - pos] = '\0';
+    if (ipv6_addr_from_str((ipv6_addr_t *)&upstream->addr.ipv6, addr) == NULL) {
+        return -EINVAL;
+    }
+    upstream->family = AF_INET6;
+    upstream->netif  = SOCK_ADDR_ANY_NETIF;
+    upstream->port   = COAP_PORT;
+    pos = addr_end + 1;
+
+    if ((pos < end) && (*pos == ':')) {
+        const char *digits = ++pos;
+        uint32_t port = 0;
+
+        while ((pos < end) && (*pos >= '0') && (*pos <= '9')) {
+            port = (port * 10) + (*pos - '0');
+            if (port > UINT16_MAX) {
+                return -EINVAL;
+            }
+            pos++;
+        }
+        if (pos == digits) {
+            return -EINVAL;
+        }
+        upstream->port = port;
+    }
+
+    query = memchr(pos, '?', end - pos);
+    if (query == NULL) {
+        query = end;
+    }
+    if ((pos < query) && (*pos != '/')) {
+        return -EINVAL;
+    }
+    _path[0]  = '\0';
+    _query[0] = '\0';
+    if ((pos < query) && (_copy_uri_part(_path, '/', pos + 1,
+                                         query - (pos + 1)) < 0)) {
+        return -EINVAL;
+    }
+    if ((query < end) && (_copy_uri_part(_query, '&', query + 1,
+                                         end - (query + 1)) < 0)) {
+        return -EINVAL;
+    }
+    return 0;
+}
+
+/*
+ * Finds the route of a path and copies its upstream endpoint.
+ */
+static bool _find_route(const char *path, sock_udp_ep_t *upstream)
+{
+    bool found = false;
+
+    mutex_lock(&_routes_lock);
+    for (gcoap_proxy_route_t *route = _routes; route != NULL;
+         route = route->next) {
+        size_t len = strlen(route->path);
+
+        if ((strncmp(path, route->path, len) == 0) &&
+            ((path[len] == '\0') || (path[len] == '/'))) {
+            *upstream = route->upstream;
+            found = true;
+            break;
+        }
+    }
+    mutex_unlock(&_routes_lock);
+    return found;
+}
+
+static _fetch_t *_find_fetch_key(const uint8_t *cache_key)
+{
+    for (unsigned i = 0; i < GCOAP_PROXY_PENDING_MAX; i++) {
+        if (_fetches[i].in_use &&
+            (memcmp(_fetches[i].cache_key, cache_key,
+                    NANOCOAP_CACHE_KEY_LENGTH) == 0)) {
+            return &_fetches[i];
+        }
+    }
+    return NULL;
+}
+
+static _fetch_t *_find_fetch_token(const uint8_t *token)
+{
+    for (unsigned i = 0; i < GCOAP_PROXY_PENDING_MAX; i++) {
+        if (_fetches[i].in_use &&
+            (memcmp(_fetches[i].token, token, TOKEN_LEN) == 0)) {
+            return &_fetches[i];
+        }
+    }
+    return NULL;
+}
+
+static _fetch_t *_alloc_fetch(void)
+{
+    for (unsigned i = 0; i < GCOAP_PROXY_PENDING_MAX; i++) {
+        if (!_fetches[i].in_use) {
+            memset(&_fetches[i], 0, sizeof(_fetches[i]));
+            _fetches[i].in_use = true;
+            return &_fetches[i];
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Returns true if a client option must not be forwarded upstream.
+ */
+static bool _skip_opt(unsigned opt_num, bool forward)
+{
+    switch (opt_num) {
+        case COAP_OPT_ETAG:
+        case COAP_OPT_OBSERVE:
+        case COAP_OPT_PROXY_URI:
+        case COAP_OPT_PROXY_SCHEME:
+            return true;
+        case COAP_OPT_URI_HOST:
+        case COAP_OPT_URI_PORT:
+        case COAP_OPT_URI_PATH:
+        case COAP_OPT_URI_QUERY:
+            return forward;
+        default:
+            return false;
+    }
+}
+
+/*
+ * Writes the options the proxy adds itself, which are numbered below
+ * @p opt_num, and which have not been written yet.
+ */
+static uint8_t *_put_added_opts(uint8_t *pos, uint16_t *lastonum,
+                                unsigned opt_num, nanocoap_cache_entry_t *ce,
+                                bool forward)
+{
+    if (ce && (*lastonum < COAP_OPT_ETAG) && (opt_num > COAP_OPT_ETAG)) {
+        pos += coap_put_option(pos, *lastonum, COAP_OPT_ETAG, ce->etag,
+                               ce->etag_len);
+        *lastonum = COAP_OPT_ETAG;
+    }
+    if (!forward) {
+        return pos;
+    }
+    /* an empty path or query adds no option, and must not change lastonum */
+    if ((*lastonum < COAP_OPT_URI_PATH) && (opt_num > COAP_OPT_URI_PATH)) {
+        size_t len = coap_put_option_uri(pos, *lastonum, _path,
+                                         COAP_OPT_URI_PATH);
+        if (len > 0) {
+            pos += len;
+            *lastonum = COAP_OPT_URI_PATH;
+        }
+    }
+    if ((*lastonum < COAP_OPT_URI_QUERY) && (opt_num > COAP_OPT_URI_QUERY)) {
+        size_t len = coap_put_option_uri(pos, *lastonum, _query,
+                                         COAP_OPT_URI_QUERY);
+        if (len > 0) {
+            pos += len;
+            *lastonum = COAP_OPT_URI_QUERY;
+        }
+    }
+    return pos;
+}
+
+/*
+ * Builds the upstream request for a client request in _req_buf. @p ce is the
+ * stale cache entry to revalidate, or NULL.
+ *
+ * return length of the request, or -ENOSPC if it does not fit
+ */
+static ssize_t _build_req(coap_pkt_t *pdu, _fetch_t *fetch,
+                          nanocoap_cache_entry_t *ce, bool forward)
+{
+    uint8_t *pos = _req_buf;
+    uint16_t lastonum = 0;
+    size_t reserved = 0;
+    coap_optpos_t opt;
+    uint8_t *value;
+    ssize_t len;
+
+    random_bytes(fetch->token, TOKEN_LEN);
+    pos += coap_build_hdr((coap_hdr_t *)_req_buf, COAP_TYPE_NON, fetch->token,
+                          TOKEN_LEN, COAP_METHOD_GET, gcoap_next_msgid());
+
+    /* leave room for the added options; each Uri-Path or Uri-Query segment
+     * costs at most two bytes more than its leading separator */
+    if (ce) {
+        reserved += OPT_HDR_MAXLEN + ce->etag_len;
+    }
+    if (forward) {
+        reserved += (2 * strlen(_path)) + (2 * strlen(_query));
+    }
+    if (((pos - _req_buf) + reserved) > sizeof(_req_buf)) {
+        return -ENOSPC;
+    }
+
+    for (len = coap_opt_get_next(pdu, &opt, &value, true); len >= 0;
+         len = coap_opt_get_next(pdu, &opt, &value, false)) {
+        if (_skip_opt(opt.opt_num, forward)) {
+            continue;
+        }
+        pos = _put_added_opts(pos, &lastonum, opt.opt_num, ce, forward);
+        if (((pos - _req_buf) + OPT_HDR_MAXLEN + len + reserved) >
+            sizeof(_req_buf)) {
+            return -ENOSPC;
+        }
+        pos += coap_put_option(pos, lastonum, opt.opt_num, value, len);
+        lastonum = opt.opt_num;
+    }
+    pos = _put_added_opts(pos, &lastonum, UINT16_MAX, ce, forward);
+    return pos - _req_buf;
+}
+
+/*
+ * Writes the body of a cached response, options and payload, to @p dst, with
+ * Max-Age set to the remaining freshness of the entry. The entry is parsed in
+ * _req_buf.
+ *
+ * return length of the body, or -ENOSPC if it does not fit
+ */
+static ssize_t _put_cached_body(uint8_t *dst, size_t len,
+                                nanocoap_cache_entry_t *ce)
+{
+    uint32_t now = nanocoap_cache_now();
+    uint32_t max_age = (ce->max_age > now) ? (ce->max_age - now) : 0;
+    uint8_t *pos = dst;
+    uint16_t lastonum = 0;
+    coap_pkt_t cached;
+    coap_optpos_t opt;
+    uint8_t *value;
+    ssize_t hdr_len, opt_len;
+
+    /* the body grows by at most the Max-Age option, if it had none */
+    if ((ce->response_len + OPT_HDR_MAXLEN + sizeof(max_age)) > len) {
+        return -ENOSPC;
+    }
+    hdr_len = coap_build_hdr((coap_hdr_t *)_req_buf, COAP_TYPE_NON, NULL, 0,
+                             ce->code, 0);
+    if (((size_t)hdr_len + ce->response_len) > sizeof(_req_buf)) {
+        return -ENOSPC;
+    }
+    memcpy(_req_buf + hdr_len, ce->response_buf, ce->response_len);
+    if (coap_parse(&cached, _req_buf, hdr_len + ce->response_len) < 0) {
+        return -EBADMSG;
+    }
+
+    for (opt_len = coap_opt_get_next(&cached, &opt, &value, true);
+         opt_len >= 0;
+         opt_len = coap_opt_get_next(&cached, &opt, &value, false)) {
+        if (opt.opt_num == COAP_OPT_MAX_AGE) {
+            continue;
+        }
+        if ((lastonum < COAP_OPT_MAX_AGE) && (opt.opt_num > COAP_OPT_MAX_AGE)) {
+            pos += coap_put_option_uint(pos, lastonum, COAP_OPT_MAX_AGE,
+                                        max_age);
+            lastonum = COAP_OPT_MAX_AGE;
+        }
+        pos += coap_put_option(pos, lastonum, opt.opt_num, value, opt_len);
+        lastonum = opt.opt_num;
+    }
+    if (lastonum < COAP_OPT_MAX_AGE) {
+        pos += coap_put_option_uint(pos, lastonum, COAP_OPT_MAX_AGE, max_age);
+    }
+    if (cached.payload_len > 0) {
+        *pos++ = 0xFF;
+        memcpy(pos, cached.payload, cached.payload_len);
+        pos += cached.payload_len;
+    }
+    return pos - dst;
+}
+
+/*
+ * Sends a response to all clients of a fetch. The body, options and payload,
+ * must already be in _resp_buf, at offset GCOAP_HEADER_MAXLEN.
+ */
+static void _reply(_fetch_t *fetch, unsigned code, size_t body_len)
+{
+    uint8_t *body = &_resp_buf[GCOAP_HEADER_MAXLEN];
+
+    for (unsigned i = 0; i < fetch->clients_numof; i++) {
+        _client_t *client = &fetch->clients[i];
+        coap_hdr_t *hdr = (coap_hdr_t *)(body - sizeof(coap_hdr_t)
+                                         - client->token_len);
+        ssize_t hdr_len = coap_build_hdr(hdr, COAP_TYPE_NON, client->token,
+                                         client->token_len, code,
+                                         gcoap_next_msgid());
+        ssize_t bytes = gcoap_sock_send((uint8_t *)hdr, hdr_len + body_len,
+                                        &client->remote);
+        if (bytes <= 0) {
+            DEBUG("gcoap_proxy: send response failed: %d\n", (int)bytes);
+        }
+    }
+}
+
+static void _resp_handler(unsigned req_state, coap_pkt_t *pdu,
+                          sock_udp_ep_t *remote)
+{
+    (void)remote;
+    /* on timeout, only the header of the request is available */
+    _fetch_t *fetch = _find_fetch_token(pdu->hdr->data);
+    nanocoap_cache_entry_t *ce;
+
+    if (fetch == NULL) {
+        return;
+    }
+
+    if (req_state != GCOAP_MEMO_RESP) {
+        DEBUG("gcoap_proxy: no response from upstream\n");
+        _reply(fetch, COAP_CODE_GATEWAY_TIMEOUT, 0);
+    }
+    else if (coap_get_code_raw(pdu) == COAP_CODE_VALID) {
+        ssize_t body_len = -ENOENT;
+
+        ce = fetch->revalidate ? nanocoap_cache_key_lookup(fetch->cache_key)
+                               : NULL;
+        if (ce) {
+            nanocoap_cache_refresh(ce, pdu);
+            _stats.revalidated++;
+            body_len = _put_cached_body(&_resp_buf[GCOAP_HEADER_MAXLEN],
+                                        GCOAP_PDU_BUF_SIZE, ce);
+        }
+        if (body_len >= 0) {
+            _reply(fetch, ce->code, body_len);
+        }
+        else {
+            _reply(fetch, COAP_CODE_BAD_GATEWAY, 0);
+        }
+    }
+    else {
+        uint8_t *body = pdu->hdr->data + coap_get_token_len(pdu);
+        size_t body_len = (pdu->payload + pdu->payload_len) - body;
+
+        if (coap_get_code_raw(pdu) == COAP_CODE_CONTENT) {
+            nanocoap_cache_add_by_key(fetch->cache_key, pdu);
+        }
+        memcpy(&_resp_buf[GCOAP_HEADER_MAXLEN], body, body_len);
+        _reply(fetch, coap_get_code_raw(pdu), body_len);
+    }
+    fetch->in_use = false;
+}
+
+/*
+ * Answers a request from a fresh cache entry.
+ */
+static ssize_t _cached_resp(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                            nanocoap_cache_entry_t *ce)
+{
+    uint8_t token[GCOAP_TOKENLEN_MAX];
+    unsigned token_len = coap_get_token_len(pdu);
+    unsigned type = COAP_TYPE_NON;
+    uint16_t msgid;
+    ssize_t hdr_len, body_len;
+
+    if ((sizeof(coap_hdr_t) + token_len) > len) {
+        return -ENOSPC;
+    }
+    body_len = _put_cached_body(buf + sizeof(coap_hdr_t) + token_len,
+                                len - sizeof(coap_hdr_t) - token_len, ce);
+    if (body_len < 0) {
+        return gcoap_response(pdu, buf, len, COAP_CODE_INTERNAL_SERVER_ERROR);
+    }
+    if (coap_get_type(pdu) == COAP_TYPE_CON) {
+        type  = COAP_TYPE_ACK;
+        msgid = coap_get_id(pdu);
+    }
+    else {
+        msgid = gcoap_next_msgid();
+    }
+    /* the header is rebuilt over the request in buf */
+    memcpy(token, pdu->token, token_len);
+    hdr_len = coap_build_hdr((coap_hdr_t *)buf, type, token, token_len,
+                             ce->code, msgid);
+    return hdr_len + body_len;
+}
+
+ssize_t gcoap_proxy_handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                               const sock_udp_ep_t *remote)
+{
+    sock_udp_ep_t upstream;
+    uint8_t cache_key[NANOCOAP_CACHE_KEY_LENGTH];
+    nanocoap_cache_entry_t *ce;
+    _fetch_t *fetch;
+    _client_t *client;
+    uint8_t *proxy_uri;
+    ssize_t res = coap_opt_get_opaque(pdu, COAP_OPT_PROXY_URI, &proxy_uri);
+    bool forward = (res >= 0);
+
+    if (coap_find_option(pdu, COAP_OPT_PROXY_SCHEME) != NULL) {
+        DEBUG("gcoap_proxy: Proxy-Scheme not supported\n");
+        return gcoap_response(pdu, buf, len, COAP_CODE_PROXYING_NOT_SUPPORTED);
+    }
+    if (forward) {
+        if (_parse_proxy_uri(proxy_uri, res, &upstream) < 0) {
+            DEBUG("gcoap_proxy: unsupported Proxy-Uri\n");
+            return gcoap_response(pdu, buf, len,
+                                  COAP_CODE_PROXYING_NOT_SUPPORTED);
+        }
+    }
+    else {
+        if (!_find_route((char *)&pdu->url[0], &upstream)) {
+            return -ENOENT;
+        }
+    }
+
+    _stats.requests++;
+    if (coap_get_code_raw(pdu) != COAP_METHOD_GET) {
+        return gcoap_response(pdu, buf, len, COAP_CODE_METHOD_NOT_ALLOWED);
+    }
+
+    nanocoap_cache_key_generate(pdu, cache_key);
+    ce = nanocoap_cache_key_lookup(cache_key);
+    if (ce && !nanocoap_cache_entry_is_stale(ce, nanocoap_cache_now())) {
+        _stats.hits++;
+        return _cached_resp(pdu, buf, len, ce);
+    }
+
+    fetch = _find_fetch_key(cache_key);
+    if (fetch) {
+        if (fetch->clients_numof == GCOAP_PROXY_WAITING_MAX) {
+            DEBUG("gcoap_proxy: too many clients waiting\n");
+            return gcoap_response(pdu, buf, len,
+                                  COAP_CODE_SERVICE_UNAVAILABLE);
+        }
+        _stats.coalesced++;
+    }
+    else {
+        fetch = _alloc_fetch();
+        if (fetch == NULL) {
+            DEBUG("gcoap_proxy: too many requests upstream\n");
+            return gcoap_response(pdu, buf, len,
+                                  COAP_CODE_SERVICE_UNAVAILABLE);
+        }
+        memcpy(fetch->cache_key, cache_key, NANOCOAP_CACHE_KEY_LENGTH);
+        if (ce && (ce->etag_len == 0)) {
+            /* nothing to revalidate with */
+            nanocoap_cache_del(ce);
+            ce = NULL;
+        }
+        fetch->revalidate = (ce != NULL);
+
+        res = _build_req(pdu, fetch, ce, forward);
+        if ((res < 0) || (gcoap_req_send2(_req_buf, res, &upstream,
+                                          _resp_handler) == 0)) {
+            DEBUG("gcoap_proxy: sending upstream failed\n");
+            fetch->in_use = false;
+            return gcoap_response(pdu, buf, len,
+                                  COAP_CODE_SERVICE_UNAVAILABLE);
+        }
+        _stats.fetches++;
+    }
+
+    client = &fetch->clients[fetch->clients_numof++];
+    client->remote    = *remote;
+    client->token_len = coap_get_token_len(pdu);
+    memcpy(client->token, pdu->token, client->token_len);
+
+    /* the response follows separately */
+    if (coap_get_type(pdu) == COAP_TYPE_CON) {
+        return coap_build_hdr((coap_hdr_t *)buf, COAP_TYPE_ACK, NULL, 0,
+                              COAP_CODE_EMPTY, coap_get_id(pdu));
+    }
+    return 0;
+}
+
+void gcoap_proxy_add_route(gcoap_proxy_route_t *route)
+{
+    gcoap_proxy_route_t **last = &_routes;
+
+    mutex_lock(&_routes_lock);
+    while (*last != NULL) {
+        last = &(*last)->next;
+    }
+    route->next = NULL;
+    *last = route;
+    mutex_unlock(&_routes_lock);
+}
+
+void gcoap_proxy_get_stats(gcoap_proxy_stats_t *stats)
+{
+    *stats = _stats;
+}
@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_nanocoap
+ * @{
+ *
+ * @file
+ * @brief       nanocoap response cache
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "hashes/sha256.h"
+#include "net/nanocoap_cache.h"
+#include "xtimer.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+static nanocoap_cache_entry_t _entries[NANOCOAP_CACHE_ENTRIES];
+static nanocoap_cache_entry_t *_used;   /* most recently used first */
+static nanocoap_cache_entry_t *_free;
+
+void nanocoap_cache_init(void)
+{
+    _used = NULL;
+    _free = NULL;
+    for (unsigned i = 0; i < NANOCOAP_CACHE_ENTRIES; i++) {
+        _entries[i].next = _free;
+        _free = &_entries[i];
+    }
+}
+
+uint32_t nanocoap_cache_now(void)
+{
+    return (uint32_t)(xtimer_now_usec64() / US_PER_SEC);
+}
+
+void nanocoap_cache_key_generate(coap_pkt_t *req, uint8_t *cache_key)
+{
+    sha256_context_t ctx;
+    uint8_t digest[SHA256_DIGEST_LENGTH];
+    uint8_t code = coap_get_code_raw(req);
+    coap_optpos_t opt;
+    uint8_t *value;
+    ssize_t len;
+
+    sha256_init(&ctx);
+    sha256_update(&ctx, &code, sizeof(code));
+    for (len = coap_opt_get_next(req, &opt, &value, true); len >= 0;
+         len = coap_opt_get_next(req, &opt, &value, false)) {
+        if (COAP_OPT_IS_NO_CACHE_KEY(opt.opt_num)) {
+            continue;
+        }
+        uint16_t num_len[2] = { opt.opt_num, (uint16_t)len };
+
+        sha256_update(&ctx, num_len, sizeof(num_len));
+        sha256_update(&ctx, value, len);
+    }
+    sha256_final(&ctx, digest);
+    memcpy(cache_key, digest, NANOCOAP_CACHE_KEY_LENGTH);
+}
+
+nanocoap_cache_entry_t *nanocoap_cache_key_lookup(const uint8_t *cache_key)
+{
+    for (nanocoap_cache_entry_t **prev = &_used; *prev != NULL;
+         prev = &(*prev)->next) {
+        nanocoap_cache_entry_t *ce = *prev;
+
+        if (memcmp(ce->cache_key, cache_key, NANOCOAP_CACHE_KEY_LENGTH) == 0) {
+            /* move to the front */
+            *prev = ce->next;
+            ce->next = _used;
+            _used = ce;
+            return ce;
+        }
+    }
+    return NULL;
+}
+
+/* Returns the Max-Age of a response as point in time. */
+static uint32_t _max_age(coap_pkt_t *resp)
+{
+    uint32_t max_age;
+
+    if (coap_get_option_uint(resp, COAP_OPT_MAX_AGE, &max_age) != 0) {
+        max_age = NANOCOAP_CACHE_MAX_AGE_DEFAULT;
+    }
+    return nanocoap_cache_now() + max_age;
+}
+
+nanocoap_cache_entry_t *nanocoap_cache_add_by_key(const uint8_t *cache_key,
+                                                  coap_pkt_t *resp)
+{
+    uint8_t *body = resp->hdr->data + coap_get_token_len(resp);
+    size_t body_len = (resp->payload + resp->payload_len) - body;
+    nanocoap_cache_entry_t *ce;
+    coap_optpos_t opt;
+    uint8_t *value;
+    ssize_t len;
+
+    if (body_len > NANOCOAP_CACHE_RESPONSE_SIZE) {
+        DEBUG("nanocoap_cache: response too large\n");
+        return NULL;
+    }
+
+    ce = nanocoap_cache_key_lookup(cache_key);
+    if (ce == NULL) {
+        if (_free != NULL) {
+            ce = _free;
+            _free = ce->next;
+        }
+        else {
+            /* evict the least recently used entry, at the end */
+            nanocoap_cache_entry_t **prev = &_used;
+
+            while ((*prev)->next != NULL) {
+                prev = &(*prev)->next;
+            }
+            ce = *prev;
+            *prev = NULL;
+        }
+        memcpy(ce->cache_key, cache_key, NANOCOAP_CACHE_KEY_LENGTH);
+        ce->next = _used;
+        _used = ce;
+    }
+
+    ce->code = coap_get_code_raw(resp);
+    ce->max_age = _max_age(resp);
+    ce->etag_len = 0;
+    for (len = coap_opt_get_next(resp, &opt, &value, true); len >= 0;
+         len = coap_opt_get_next(resp, &opt, &value, false)) {
+        if ((opt.opt_num == COAP_OPT_ETAG) &&
+            ((size_t)len <= COAP_ETAG_LENGTH_MAX)) {
+            memcpy(ce->etag, value, len);
+            ce->etag_len = len;
+            break;
+        }
+    }
+    memcpy(ce->response_buf, body, body_len);
+    ce->response_len = body_len;
+    return ce;
+}
+
+void nanocoap_cache_refresh(nanocoap_cache_entry_t *ce, coap_pkt_t *resp)
+{
+    ce->max_age = _max_age(resp);
+}
+
+void nanocoap_cache_del(nanocoap_cache_entry_t *ce)
+{
+    for (nanocoap_cache_entry_t **prev = &_used; *prev != NULL;
+         prev = &(*prev)->next) {
+        if (*prev == ce) {
+            *prev = ce->next;
+            ce->next = _free;
+            _free = ce;
+            return;
+        }
+    }
+}
@@ -20,16 +20,17 @@
 
 #include <assert.h>
 #include <errno.h>
+#include <stdatomic.h>
 #include <stdio.h>
 #include <string.h>
 
+#include "mutex.h"
 #include "net/nanocoap.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
 static int _decode_value(unsigned val, uint8_t **pkt_pos_ptr, uint8_t *pkt_end);
-int coap_get_option_uint(coap_pkt_t *pkt, unsigned opt_num, uint32_t *target);
 static uint32_t _decode_uint(uint8_t *pkt_pos, unsigned nbytes);
 static size_t _encode_uint(uint32_t *val);
 
@@ -70,6 +71,8 @@ int coap_parse(coap_pkt_t *pkt, uint8_t *buf, size_t len)
     unsigned option_count = 0;
     unsigned option_nr = 0;
 
+    pkt->options_map = 0;
+
     /* parse options */
     while (pkt_pos != pkt_end) {
         uint8_t *option_start = pkt_pos;
@@ -95,6 +98,13 @@ int coap_parse(coap_pkt_t *pkt, uint8_t *buf, size_t len)
             DEBUG("option count=%u nr=%u len=%i\n", option_count, option_nr, option_len);
 
             if (option_delta) {
+                if (option_count >= NANOCOAP_NOPTS_MAX) {
+                    DEBUG("nanocoap: max nr of options exceeded\n");
+                    return -ENOMEM;
+                }
+                if (option_nr < 32) {
+                    pkt->options_map |= ((uint32_t)1 << option_nr);
+                }
                 optpos->opt_num = option_nr;
                 optpos->offset = (uintptr_t)option_start - (uintptr_t)hdr;
                 DEBUG("optpos option_nr=%u %u\n", (unsigned)option_nr, (unsigned)optpos->offset);
@@ -135,9 +145,22 @@ int coap_parse(coap_pkt_t *pkt, uint8_t *buf, size_t len)
 
 uint8_t *coap_find_option(coap_pkt_t *pkt, unsigned opt_num)
 {
-    coap_optpos_t *optpos = pkt->options;
-    unsigned opt_count = pkt->options_len;
+    /* options below 32 come first; one entry per option number */
+    unsigned below_32 = __builtin_popcountl(pkt->options_map);
+    coap_optpos_t *optpos = &pkt->options[below_32];
+    unsigned opt_count = pkt->options_len - below_32;
+
+    if (opt_num < 32) {
+        uint32_t opt_bit = (uint32_t)1 << opt_num;
 
+        if (!(pkt->options_map & opt_bit)) {
+            return NULL;
+        }
+        /* the option's index is the number of smaller options present */
+        optpos = &pkt->options[__builtin_popcountl(pkt->options_map &
+                                                   (opt_bit - 1))];
+        return (uint8_t *)pkt->hdr + optpos->offset;
+    }
     while (opt_count--) {
         if (optpos->opt_num == opt_num) {
             return (uint8_t*)pkt->hdr + optpos->offset;
@@ -163,6 +186,37 @@ static uint8_t *_parse_option(coap_pkt_t *pkt, uint8_t *pkt_pos, uint16_t *delta
     return pkt_pos;
 }
 
+ssize_t coap_opt_get_next(coap_pkt_t *pkt, coap_optpos_t *opt,
+                          uint8_t **value, bool init_opt)
+{
+    uint8_t *pkt_pos;
+    uint16_t delta;
+    int opt_len;
+
+    if (init_opt) {
+        opt->opt_num = 0;
+        opt->offset = coap_get_total_hdr_len(pkt);
+    }
+    pkt_pos = (uint8_t *)pkt->hdr + opt->offset;
+    if ((pkt_pos >= pkt->payload) || (*pkt_pos == 0xFF)) {
+        return -ENOENT;
+    }
+    /* nibble 15 is reserved for the payload marker */
+    if (((*pkt_pos & 0xF0) == 0xF0) || ((*pkt_pos & 0x0F) == 0x0F)) {
+        return -EBADMSG;
+    }
+
+    pkt_pos = _parse_option(pkt, pkt_pos, &delta, &opt_len);
+    if ((opt_len < 0) || ((pkt_pos + opt_len) > pkt->payload)) {
+        DEBUG("nanocoap: invalid option length.\n");
+        return -EBADMSG;
+    }
+    *value = pkt_pos;
+    opt->opt_num += delta;
+    opt->offset = (pkt_pos + opt_len) - (uint8_t *)pkt->hdr;
+    return opt_len;
+}
+
 int coap_get_option_uint(coap_pkt_t *pkt, unsigned opt_num, uint32_t *target)
 {
     assert(target);
@@ -188,6 +242,23 @@ int coap_get_option_uint(coap_pkt_t *pkt, unsigned opt_num, uint32_t *target)
     return -1;
 }
 
+ssize_t coap_opt_get_opaque(coap_pkt_t *pkt, unsigned opt_num, uint8_t **value)
+{
+    uint8_t *opt_pos = coap_find_option(pkt, opt_num);
+    if (opt_pos) {
+        uint16_t delta;
+        int option_len = 0;
+        *value = _parse_option(pkt, opt_pos, &delta, &option_len);
+        if ((*value == NULL) || (option_len < 0) ||
+            ((*value + option_len) > pkt->payload)) {
+            DEBUG("nanocoap: discarding packet with invalid option length.\n");
+            return -EBADMSG;
+        }
+        return option_len;
+    }
+    return -ENOENT;
+}
+
 uint8_t *coap_iterate_option(coap_pkt_t *pkt, uint8_t **optpos, int *opt_len, int first)
 {
     uint8_t *data_start;
@@ -279,8 +350,92 @@ int coap_get_blockopt(coap_pkt_t *pkt, uint16_t option, uint32_t *blknum, unsign
     return (blkopt & 0x8) ? 1 : 0;
 }
 
+/* FNV-1a over the first len characters of path */
+static unsigned _path_hash(const char *path, size_t len)
+{
+    uint32_t hash = 2166136261U;
+
+    for (size_t i = 0; i < len; i++) {
+        hash ^= (uint8_t)path[i];
+        hash *= 16777619U;
+    }
+    return hash & (NANOCOAP_RESOURCE_INDEX_SIZE - 1);
+}
+
+void coap_resource_index_init(coap_resource_index_t *index)
+{
+    memset(index, 0, sizeof(coap_resource_index_t));
+}
+
+int coap_resource_index_add(coap_resource_index_t *index,
+                            const coap_resource_t *resource)
+{
+    unsigned i = _path_hash(resource->path, strlen(resource->path));
+
+    if (index->numof >= NANOCOAP_RESOURCE_INDEX_SIZE) {
+        return -ENOSPC;
+    }
+    while (index->slots[i] != NULL) {
+        i = (i + 1) & (NANOCOAP_RESOURCE_INDEX_SIZE - 1);
+    }
+    index->slots[i] = resource;
+    index->numof++;
+    return 0;
+}
+
+int coap_resource_index_find(const coap_resource_index_t *index,
+                             const char *path, unsigned method_flag,
+                             const coap_resource_t **resource)
+{
+    size_t len = strlen(path);
+    bool subtree = false;
+
+    while (len > 0) {
+        unsigned i = _path_hash(path, len);
+        bool wrong_method = false;
+
+        for (unsigned n = 0; (n < NANOCOAP_RESOURCE_INDEX_SIZE) &&
+                             (index->slots[i] != NULL); n++) {
+            const coap_resource_t *r = index->slots[i];
+
+            if ((strncmp(r->path, path, len) == 0) && (r->path[len] == '\0') &&
+                (!subtree || (r->methods & COAP_MATCH_SUBTREE))) {
+                if (r->methods & method_flag) {
+                    *resource = r;
+                    return 0;
+                }
+                wrong_method = true;
+            }
+            i = (i + 1) & (NANOCOAP_RESOURCE_INDEX_SIZE - 1);
+        }
+        if (wrong_method) {
+            /* the most specific path decides */
+            return -EPERM;
+        }
+        if (len == 1) {
+            /* root was the last ancestor */
+            break;
+        }
+        /* continue with the parent path */
+        while ((len > 0) && (path[len - 1] != '/')) {
+            len--;
+        }
+        if (len > 1) {
+            len--;
+        }
+        subtree = true;
+    }
+    return -ENOENT;
+}
+
 ssize_t coap_handle_req(coap_pkt_t *pkt, uint8_t *resp_buf, unsigned resp_buf_len)
 {
+    static coap_resource_index_t index;
+    static mutex_t index_lock = MUTEX_INIT;
+    /* 0: not built, 1: built, < 0: too small */
+    static atomic_int index_state = ATOMIC_VAR_INIT(0);
+    const coap_resource_t *resource;
+
     if (coap_get_code_class(pkt) != COAP_REQ) {
         DEBUG("coap_handle_req(): not a request.\n");
         return -EBADMSG;
@@ -302,8 +457,44 @@ ssize_t coap_handle_req(coap_pkt_t *pkt, uint8_t *resp_buf, unsigned resp_buf_le
 #endif
     DEBUG("nanocoap: URI path: \"%s\"\n", uri);
 
+    if (atomic_load(&index_state) == 0) {
+        /* coap_resources is fixed at compile time, so the index is only built
+         * once. Several server threads may handle requests, so only one of
+         * them builds it and it is only used once complete. */
+        mutex_lock(&index_lock);
+        if (atomic_load(&index_state) == 0) {
+            int state = 1;
+
+            coap_resource_index_init(&index);
+            for (unsigned i = 0; (i < coap_resources_numof) && (state > 0); i++) {
+                if (coap_resource_index_add(&index, &coap_resources[i]) < 0) {
+                    DEBUG("nanocoap: resource index too small\n");
+                    state = -1;
+                }
+            }
+            atomic_store(&index_state, state);
+        }
+        mutex_unlock(&index_lock);
+    }
+    if (atomic_load(&index_state) > 0) {
+        switch (coap_resource_index_find(&index, (char *)uri, method_flag,
+                                         &resource)) {
+            case 0:
+                return resource->handler(pkt, resp_buf, resp_buf_len,
+                                         resource->context);
+            case -EPERM:
+                return coap_build_reply(pkt, COAP_CODE_METHOD_NOT_ALLOWED,
+                                        resp_buf, resp_buf_len, 0);
+            default:
+                return coap_build_reply(pkt, COAP_CODE_404, resp_buf,
+                                        resp_buf_len, 0);
+        }
+    }
+
+    /* index too small, fall back to scanning the alphabetically sorted
+     * resources, which ignores COAP_MATCH_SUBTREE */
     for (unsigned i = 0; i < coap_resources_numof; i++) {
-        const coap_resource_t *resource = &coap_resources[i];
+        resource = &coap_resources[i];
         if (!(resource->methods & method_flag)) {
             continue;
         }
@@ -529,6 +720,13 @@ size_t coap_put_option_ct(uint8_t *buf, uint16_t lastonum, uint16_t content_type
     }
 }
 
+size_t coap_put_option_uint(uint8_t *buf, uint16_t lastonum, uint16_t onum,
+                            uint32_t value)
+{
+    size_t olen = _encode_uint(&value);
+    return coap_put_option(buf, lastonum, onum, (uint8_t *)&value, olen);
+}
+
 static size_t coap_put_option_block(uint8_t *buf, uint16_t lastonum, unsigned blknum, unsigned szx, int more, uint16_t option)
 {
     uint32_t blkopt = (blknum << 4) | szx | (more ? 0x8 : 0);
@@ -569,6 +767,89 @@ size_t coap_put_block1_ok(uint8_t *pkt_pos, coap_block1_t *block1, uint16_t last
     }
 }
 
+size_t coap_put_option_block2(uint8_t *buf, uint16_t lastonum, unsigned blknum, unsigned szx, int more)
+{
+    return coap_put_option_block(buf, lastonum, blknum, szx, more, COAP_OPT_BLOCK2);
+}
+
+int coap_get_block2(coap_pkt_t *pkt, coap_block1_t *block2)
+{
+    uint32_t blknum;
+    unsigned szx;
+    block2->more = coap_get_blockopt(pkt, COAP_OPT_BLOCK2, &blknum, &szx);
+    if (block2->more >= 0) {
+        block2->offset = blknum << (szx + 4);
+    }
+    else {
+        block2->offset = 0;
+    }
+
+    block2->blknum = blknum;
+    block2->szx = szx;
+
+    return (block2->more >= 0);
+}
+
+ssize_t coap_block2_reply(coap_pkt_t *pkt, uint8_t *buf, size_t len,
+                          unsigned ct, coap_blockwise_cb_t cb, void *ctx)
+{
+    /* at most 3 bytes Content-Format, 4 bytes Block2 and the payload marker */
+    const size_t opts_max = 3 + 4 + 1;
+    size_t hdr_len = coap_get_total_hdr_len(pkt);
+    coap_block1_t block2;
+    uint8_t *payload, *bufpos;
+    size_t blksize;
+    ssize_t res;
+    int more;
+
+    if (!coap_get_block2(pkt, &block2)) {
+        block2.szx = COAP_BLOCKWISE_SZX_1024;
+    }
+    else if (block2.szx > COAP_BLOCKWISE_SZX_1024) {
+        /* BERT is not supported */
+        return coap_build_reply(pkt, COAP_CODE_BAD_OPTION, buf, len, 0);
+    }
+    /* one more byte than the block tells if it is the last one */
+    while (((hdr_len + opts_max + (16U << block2.szx) + 1) > len) &&
+           (block2.szx > 0)) {
+        block2.szx--;
+    }
+    blksize = 16U << block2.szx;
+    if ((hdr_len + opts_max + blksize + 1) > len) {
+        return -ENOSPC;
+    }
+    block2.blknum = block2.offset >> (block2.szx + 4);
+
+    /* the options of the request are no longer needed from here on */
+    payload = buf + hdr_len + opts_max;
+    res = cb(ctx, block2.offset, payload, blksize + 1);
+    if (res < 0) {
+        DEBUG("nanocoap: block2 generator failed: %d\n", (int)res);
+        return coap_build_reply(pkt, COAP_CODE_INTERNAL_SERVER_ERROR, buf,
+                                len, 0);
+    }
+    more = ((size_t)res > blksize);
+    if (more) {
+        res = blksize;
+    }
+
+    bufpos = buf + hdr_len;
+    if (ct != COAP_FORMAT_NONE) {
+        bufpos += coap_put_option_ct(bufpos, 0, ct);
+    }
+    bufpos += coap_put_option_block2(bufpos, (ct != COAP_FORMAT_NONE)
+                                             ? COAP_OPT_CONTENT_FORMAT : 0,
+                                     block2.blknum, block2.szx, more);
+    if (res > 0) {
+        *bufpos++ = 0xff;
+        memmove(bufpos, payload, res);
+        bufpos += res;
+    }
+
+    return coap_build_reply(pkt, COAP_CODE_205, buf, len,
+                            bufpos - (buf + hdr_len));
+}
+
 size_t coap_put_option_uri(uint8_t *buf, uint16_t lastonum, const char *uri, uint16_t optnum)
 {
     char separator = (optnum == COAP_OPT_URI_PATH) ? '/' : '&';
@@ -608,8 +889,6 @@ size_t coap_put_option_uri(uint8_t *buf, uint16_t lastonum, const char *uri, uin
 static ssize_t _add_opt_pkt(coap_pkt_t *pkt, uint16_t optnum, uint8_t *val,
                             size_t val_len)
 {
-    assert(pkt->options_len < NANOCOAP_NOPTS_MAX);
-
     uint16_t lastonum = (pkt->options_len)
             ? pkt->options[pkt->options_len - 1].opt_num : 0;
     assert(optnum >= lastonum);
@@ -617,9 +896,16 @@ static ssize_t _add_opt_pkt(coap_pkt_t *pkt, uint16_t optnum, uint8_t *val,
     size_t optlen = coap_put_option(pkt->payload, lastonum, optnum, val, val_len);
     assert(pkt->payload_len > optlen);
 
-    pkt->options[pkt->options_len].opt_num = optnum;
-    pkt->options[pkt->options_len].offset = pkt->payload - (uint8_t *)pkt->hdr;
-    pkt->options_len++;
+    /* like coap_parse(), only track the first option of a number */
+    if ((pkt->options_len == 0) || (optnum != lastonum)) {
+        assert(pkt->options_len < NANOCOAP_NOPTS_MAX);
+        if (optnum < 32) {
+            pkt->options_map |= ((uint32_t)1 << optnum);
+        }
+        pkt->options[pkt->options_len].opt_num = optnum;
+        pkt->options[pkt->options_len].offset = pkt->payload - (uint8_t *)pkt->hdr;
+        pkt->options_len++;
+    }
     pkt->payload += optlen;
     pkt->payload_len -= optlen;
 
@@ -651,7 +937,8 @@ ssize_t coap_opt_add_string(coap_pkt_t *pkt, uint16_t optnum, const char *string
         part_len = (uint8_t *)uripos - part_start;
 
         if (part_len) {
-            if (pkt->options_len == NANOCOAP_NOPTS_MAX) {
+            if ((pkt->options_len == NANOCOAP_NOPTS_MAX) &&
+                (pkt->options[pkt->options_len - 1].opt_num != optnum)) {
                 return -ENOSPC;
             }
             write_len += _add_opt_pkt(pkt, optnum, part_start, part_len);
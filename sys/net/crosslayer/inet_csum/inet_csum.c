@@ -14,12 +14,43 @@
 
 #include <inttypes.h>
 #include <stdio.h>
+#include "byteorder.h"
 #include "od.h"
 #include "net/inet_csum.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+#if UINTPTR_MAX > 0xffff
+/* Sums up 4 byte-words in host byte-order into a 64-bit accumulator, so the
+ * carries don't need to be handled within the loop. The result is folded to
+ * 16 bit and converted to network byte-order, which yields the same one's
+ * complement sum (see RFC 1071, section 2 (B)).
+ * buf must be 4 byte-aligned. */
+static uint16_t _sum_words(const uint8_t *buf, uint16_t words)
+{
+    const uint32_t *ptr = (const uint32_t *)buf;
+    uint64_t acc = 0;
+
+    while (words >= 4) {
+        acc += ptr[0];
+        acc += ptr[1];
+        acc += ptr[2];
+        acc += ptr[3];
+        ptr += 4;
+        words -= 4;
+    }
+    while (words--) {
+        acc += *(ptr++);
+    }
+    acc = (acc & 0xffffffff) + (acc >> 32);
+    acc = (acc & 0xffffffff) + (acc >> 32);
+    acc = (acc & 0xffff) + (acc >> 16);
+    acc = (acc & 0xffff) + (acc >> 16);
+    return ntohs((uint16_t)acc);
+}
+#endif
+
 uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t accum_len)
 {
     uint32_t csum = sum;
@@ -44,6 +75,21 @@ uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t
         accum_len++;
     }
 
+#if UINTPTR_MAX > 0xffff
+    /* word-wise summation only pays off for longer buffers and can only be
+     * used if buf is aligned to 16-bit words */
+    if ((len >= 8) && !((uintptr_t)buf & 1)) {
+        if ((uintptr_t)buf & 2) {
+            csum += (uint16_t)(*buf << 8) + *(buf + 1);
+            buf += 2;
+            len -= 2;
+        }
+        csum += _sum_words(buf, len >> 2);
+        buf += len & ~3U;
+        len &= 3;
+    }
+#endif
+
     for (unsigned i = 0; i < (len >> 1); buf += 2, i++) {
         csum += (uint16_t)(*buf << 8) + *(buf + 1); /* group bytes by 16-byte words */
                                                     /* and add them */
@@ -62,4 +108,24 @@ uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t
     return csum;
 }
 
+uint16_t inet_csum_update(uint16_t csum, const uint8_t *old_data,
+                          const uint8_t *new_data, size_t len)
+{
+    /* RFC 1624, eqn. 3: HC' = ~(~HC + ~m + m') */
+    uint32_t sum = (uint16_t)~csum;
+
+    for (size_t i = 0; i < (len >> 1); i++, old_data += 2, new_data += 2) {
+        sum += (uint16_t)~((old_data[0] << 8) | old_data[1]);
+        sum += (uint16_t)((new_data[0] << 8) | new_data[1]);
+    }
+    if (len & 1) {
+        sum += (uint16_t)~(old_data[0] << 8);
+        sum += (uint16_t)(new_data[0] << 8);
+    }
+    while (sum >> 16) {
+        sum = (sum & 0xffff) + (sum >> 16);
+    }
+    return (uint16_t)~sum;
+}
+
 /** @} */
@@ -42,6 +42,11 @@ static gnrc_netif_t _netifs[GNRC_NETIF_NUMOF];
 static void _update_l2addr_from_dev(gnrc_netif_t *netif);
 static void *_gnrc_netif_thread(void *args);
 static void _event_cb(netdev_t *dev, netdev_event_t event);
+#ifdef MODULE_NETSTATS_NEIGHBOR
+static void _record_nb_tx(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt);
+static void _update_nb_rx(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt);
+static void _update_nb_tx(gnrc_netif_t *netif, netdev_event_t event);
+#endif
 
 gnrc_netif_t *gnrc_netif_create(char *stack, int stacksize, char priority,
                                 const char *name, netdev_t *netdev,
@@ -1166,6 +1171,25 @@ static void _update_l2addr_from_dev(gnrc_netif_t *netif)
     }
 }
 
+static void _init_csum_offload(gnrc_netif_t *netif)
+{
+    netdev_t *dev = netif->dev;
+    uint8_t offload;
+
+    if (dev->driver->get(dev, NETOPT_CSUM_OFFLOAD, &offload,
+                         sizeof(offload)) != sizeof(offload)) {
+        return;
+    }
+    /* 6LoWPAN compresses the checksum fields with the headers, so
+     * calculation can't be offloaded to the device */
+    if ((offload & NETOPT_CSUM_OFFLOAD_TX) && !gnrc_netif_is_6ln(netif)) {
+        netif->flags |= GNRC_NETIF_FLAGS_CSUM_OFFLOAD_TX;
+    }
+    if (offload & NETOPT_CSUM_OFFLOAD_RX) {
+        netif->flags |= GNRC_NETIF_FLAGS_CSUM_OFFLOAD_RX;
+    }
+}
+
 static void _init_from_device(gnrc_netif_t *netif)
 {
     int res;
@@ -1223,6 +1247,7 @@ static void _init_from_device(gnrc_netif_t *netif)
 #endif
             break;
     }
+    _init_csum_offload(netif);
     _update_l2addr_from_dev(netif);
 }
 
@@ -1249,6 +1274,9 @@ static void *_gnrc_netif_thread(void *args)
     dev->driver->init(dev);
     _init_from_device(netif);
     netif->cur_hl = GNRC_NETIF_DEFAULT_HL;
+#ifdef MODULE_NETSTATS_NEIGHBOR
+    netstats_nb_init(&netif->neighbors);
+#endif
 #ifdef MODULE_GNRC_IPV6_NIB
     gnrc_ipv6_nib_init_iface(netif);
 #endif
@@ -1269,6 +1297,9 @@ static void *_gnrc_netif_thread(void *args)
                 break;
             case GNRC_NETAPI_MSG_TYPE_SND:
                 DEBUG("gnrc_netif: GNRC_NETDEV_MSG_TYPE_SND received\n");
+#ifdef MODULE_NETSTATS_NEIGHBOR
+                _record_nb_tx(netif, msg.content.ptr);
+#endif
                 res = netif->ops->send(netif, msg.content.ptr);
                 if (res < 0) {
                     DEBUG("gnrc_netif: error sending packet %p (code: %u)\n",
@@ -1332,6 +1363,71 @@ static void _pass_on_packet(gnrc_pktsnip_t *pkt)
     }
 }
 
+#ifdef MODULE_NETSTATS_NEIGHBOR
+/*
+ * Records the destination of a packet about to be sent, so the result of the
+ * transmission is counted for the neighbor.
+ */
+static void _record_nb_tx(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+{
+    gnrc_netif_hdr_t *hdr = pkt->data;
+
+    if ((pkt->type != GNRC_NETTYPE_NETIF) || (hdr->dst_l2addr_len == 0) ||
+        (hdr->dst_l2addr_len > NETSTATS_NB_ADDR_MAXLEN) ||
+        (hdr->flags & (GNRC_NETIF_HDR_FLAGS_BROADCAST |
+                       GNRC_NETIF_HDR_FLAGS_MULTICAST))) {
+        netstats_nb_record(&netif->neighbors, NULL, 0);
+        return;
+    }
+    netstats_nb_record(&netif->neighbors, gnrc_netif_hdr_get_dst_addr(hdr),
+                       hdr->dst_l2addr_len);
+}
+
+static void _update_nb_rx(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *snip = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_NETIF);
+    gnrc_netif_hdr_t *hdr;
+
+    if (snip == NULL) {
+        return;
+    }
+    hdr = snip->data;
+    if ((hdr->src_l2addr_len > 0) &&
+        (hdr->src_l2addr_len <= NETSTATS_NB_ADDR_MAXLEN)) {
+        netstats_nb_update_rx(&netif->neighbors,
+                              gnrc_netif_hdr_get_src_addr(hdr),
+                              hdr->src_l2addr_len, hdr->rssi, hdr->lqi);
+    }
+}
+
+static void _update_nb_tx(gnrc_netif_t *netif, netdev_event_t event)
+{
+    netdev_t *dev = netif->dev;
+    uint8_t retries = 0;
+
+    switch (event) {
+        case NETDEV_EVENT_TX_COMPLETE:
+        case NETDEV_EVENT_TX_COMPLETE_DATA_PENDING:
+            /* devices without retransmissions report -ENOTSUP */
+            if (dev->driver->get(dev, NETOPT_TX_RETRIES_NEEDED, &retries,
+                                 sizeof(retries)) < 0) {
+                retries = 0;
+            }
+            netstats_nb_update_tx(&netif->neighbors, NETSTATS_NB_SUCCESS,
+                                  retries);
+            break;
+        case NETDEV_EVENT_TX_NOACK:
+            netstats_nb_update_tx(&netif->neighbors, NETSTATS_NB_NOACK, 0);
+            break;
+        case NETDEV_EVENT_TX_MEDIUM_BUSY:
+            netstats_nb_update_tx(&netif->neighbors, NETSTATS_NB_BUSY, 0);
+            break;
+        default:
+            break;
+    }
+}
+#endif
+
 static void _event_cb(netdev_t *dev, netdev_event_t event)
 {
     gnrc_netif_t *netif = (gnrc_netif_t *) dev->context;
@@ -1346,11 +1442,27 @@ static void _event_cb(netdev_t *dev, netdev_event_t event)
     }
     else {
         DEBUG("gnrc_netif: event triggered -> %i\n", event);
+#ifdef MODULE_NETSTATS_NEIGHBOR
+        _update_nb_tx(netif, event);
+#endif
         switch (event) {
             case NETDEV_EVENT_RX_COMPLETE: {
                     gnrc_pktsnip_t *pkt = netif->ops->recv(netif);
 
                     if (pkt) {
+                        if (netif->flags & GNRC_NETIF_FLAGS_CSUM_OFFLOAD_RX) {
+                            gnrc_pktsnip_t *hdr = gnrc_pktsnip_search_type(
+                                    pkt, GNRC_NETTYPE_NETIF
+                                );
+
+                            if (hdr != NULL) {
+                                ((gnrc_netif_hdr_t *)hdr->data)->flags |=
+                                    GNRC_NETIF_HDR_FLAGS_CSUM_VALID;
+                            }
+                        }
+#ifdef MODULE_NETSTATS_NEIGHBOR
+                        _update_nb_rx(netif, pkt);
+#endif
                         _pass_on_packet(pkt);
                     }
                 }
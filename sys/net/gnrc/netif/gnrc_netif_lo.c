@@ -0,0 +1,233 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/netif/internal.h"
+#include "net/gnrc/netif/lo.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/pktbuf.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#ifdef MODULE_GNRC_NETIF_LO
+
+static int _init(netdev_t *dev);
+static int _get(netdev_t *dev, netopt_t opt, void *value, size_t max_len);
+static int _set(netdev_t *dev, netopt_t opt, const void *value,
+                size_t value_len);
+static void _init_lo(gnrc_netif_t *netif);
+static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt);
+
+static const netdev_driver_t _lo_driver = {
+    .init = _init,
+    .get = _get,
+    .set = _set,
+};
+
+static const gnrc_netif_ops_t _lo_ops = {
+    .init = _init_lo,
+    .send = _send,
+    .get = gnrc_netif_get_from_netdev,
+    .set = gnrc_netif_set_from_netdev,
+};
+
+static netdev_t _lo_dev = { .driver = &_lo_driver };
+static gnrc_netif_t *_lo = NULL;
+
+gnrc_netif_t *gnrc_netif_lo_create(char *stack, int stacksize, char priority,
+                                   char *name)
+{
+    _lo = gnrc_netif_create(stack, stacksize, priority, name, &_lo_dev,
+                            &_lo_ops);
+    return _lo;
+}
+
+gnrc_netif_t *gnrc_netif_lo_get(void)
+{
+    return _lo;
+}
+
+static int _init(netdev_t *dev)
+{
+    (void)dev;
+    return 0;
+}
+
+static int _get(netdev_t *dev, netopt_t opt, void *value, size_t max_len)
+{
+    (void)dev;
+    switch (opt) {
+        case NETOPT_DEVICE_TYPE:
+            assert(max_len == sizeof(uint16_t));
+            *((uint16_t *)value) = NETDEV_TYPE_UNKNOWN;
+            return sizeof(uint16_t);
+        case NETOPT_MAX_PACKET_SIZE:
+            assert(max_len == sizeof(uint16_t));
+            *((uint16_t *)value) = UINT16_MAX;
+            return sizeof(uint16_t);
+        case NETOPT_CSUM_OFFLOAD:
+            /* packets never leave the host */
+            assert(max_len >= sizeof(uint8_t));
+            *((uint8_t *)value) = NETOPT_CSUM_OFFLOAD_TX |
+                                  NETOPT_CSUM_OFFLOAD_RX;
+            return sizeof(uint8_t);
+        default:
+            return -ENOTSUP;
+    }
+}
+
+static int _set(netdev_t *dev, netopt_t opt, const void *value,
+                size_t value_len)
+{
+    (void)dev;
+    (void)opt;
+    (void)value;
+    (void)value_len;
+    return -ENOTSUP;
+}
+
+static void _init_lo(gnrc_netif_t *netif)
+{
+#ifdef MODULE_GNRC_IPV6
+    if (gnrc_netif_ipv6_addr_add_internal(netif, &ipv6_addr_loopback, 128U,
+                                          GNRC_NETIF_IPV6_ADDRS_FLAGS_STATE_VALID) < 0) {
+        DEBUG("gnrc_netif_lo: unable to add loopback address\n");
+    }
+#else
+    (void)netif;
+#endif
+}
+
+static inline bool _is_transport(const gnrc_pktsnip_t *pkt)
+{
+#ifdef MODULE_GNRC_UDP
+    if (pkt->type == GNRC_NETTYPE_UDP) {
+        return true;
+    }
+#endif
+#ifdef MODULE_GNRC_TCP
+    if (pkt->type == GNRC_NETTYPE_TCP) {
+        return true;
+    }
+#endif
+    (void)pkt;
+    return false;
+}
+
+/* Upper layers expect in receive direction either an unmarked payload or a
+ * marked transport layer header directly followed by the payload. Other
+ * packets (e.g. with extension headers or ICMPv6 options in separate snips)
+ * are flattened into a single snip after the IPv6 header. */
+static gnrc_pktsnip_t *_prepare_upper(gnrc_pktsnip_t *ipv6)
+{
+    gnrc_pktsnip_t *upper = ipv6->next, *flat;
+    uint8_t *data;
+
+    if ((upper == NULL) || (upper->next == NULL) ||
+        (_is_transport(upper) && (upper->next->next == NULL))) {
+        return ipv6;
+    }
+    flat = gnrc_pktbuf_add(NULL, NULL, gnrc_pkt_len(upper), GNRC_NETTYPE_UNDEF);
+    if (flat == NULL) {
+        return NULL;
+    }
+    data = flat->data;
+    for (gnrc_pktsnip_t *ptr = upper; ptr != NULL; ptr = ptr->next) {
+        memcpy(data, ptr->data, ptr->size);
+        data += ptr->size;
+    }
+    gnrc_pktbuf_release(upper);
+    ipv6->next = flat;
+    return ipv6;
+}
+
+static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *reversed_pkt, *ptr;
+    gnrc_netif_hdr_t *hdr;
+    int res;
+
+    assert(pkt->type == GNRC_NETTYPE_NETIF);
+    hdr = pkt->data;
+    if (hdr->flags & (GNRC_NETIF_HDR_FLAGS_BROADCAST |
+                      GNRC_NETIF_HDR_FLAGS_MULTICAST)) {
+        DEBUG("gnrc_netif_lo: multicast not supported, dropping packet\n");
+        gnrc_pktbuf_release(pkt);
+        return -ENOTSUP;
+    }
+    res = gnrc_pkt_len(pkt->next);
+    /* interface header is re-used for receive direction */
+    reversed_pkt = gnrc_pktbuf_start_write(pkt);
+    if (reversed_pkt == NULL) {
+        DEBUG("gnrc_netif_lo: unable to get write access to packet\n");
+        gnrc_pktbuf_release(pkt);
+        return -ENOBUFS;
+    }
+    ptr = gnrc_pktbuf_start_write(reversed_pkt->next);
+    if (ptr == NULL) {
+        DEBUG("gnrc_netif_lo: unable to get write access to packet\n");
+        gnrc_pktbuf_release(reversed_pkt);
+        return -ENOBUFS;
+    }
+    reversed_pkt->next = NULL;
+    if (_prepare_upper(ptr) == NULL) {
+        DEBUG("gnrc_netif_lo: unable to flatten packet\n");
+        gnrc_pktbuf_release(reversed_pkt);
+        gnrc_pktbuf_release(ptr);
+        return -ENOBUFS;
+    }
+    hdr = reversed_pkt->data;
+    hdr->if_pid = netif->pid;
+    hdr->flags = GNRC_NETIF_HDR_FLAGS_CSUM_VALID;
+    /* reverse packet snip list order; snips are only duplicated if they are
+     * shared with another thread */
+    while (ptr != NULL) {
+        gnrc_pktsnip_t *next = gnrc_pktbuf_start_write(ptr);
+
+        if (next == NULL) {
+            DEBUG("gnrc_netif_lo: unable to get write access to packet\n");
+            gnrc_pktbuf_release(reversed_pkt);
+            gnrc_pktbuf_release(ptr);
+            return -ENOBUFS;
+        }
+        ptr = next;
+        next = ptr->next;
+        ptr->next = reversed_pkt;
+        reversed_pkt = ptr;
+        ptr = next;
+    }
+#ifdef MODULE_NETSTATS_L2
+    netif->dev->stats.tx_unicast_count++;
+    netif->dev->stats.tx_bytes += res;
+    netif->dev->stats.rx_count++;
+    netif->dev->stats.rx_bytes += res;
+#endif
+    if (!gnrc_netapi_dispatch_receive(GNRC_NETTYPE_IPV6,
+                                      GNRC_NETREG_DEMUX_CTX_ALL,
+                                      reversed_pkt)) {
+        DEBUG("gnrc_netif_lo: no one interested in packet\n");
+        gnrc_pktbuf_release(reversed_pkt);
+    }
+    return res;
+}
+#else   /* MODULE_GNRC_NETIF_LO */
+typedef int dont_be_pedantic;
+#endif  /* MODULE_GNRC_NETIF_LO */
+
+/** @} */
@@ -29,6 +29,7 @@
 
 #include "net/gnrc/ipv6/nib.h"
 #include "net/gnrc/netif/internal.h"
+#include "net/gnrc/netif/lo.h"
 #include "net/gnrc/ipv6/whitelist.h"
 #include "net/gnrc/ipv6/blacklist.h"
 
@@ -135,9 +136,10 @@ void gnrc_ipv6_demux(gnrc_netif_t *netif, gnrc_pktsnip_t *current,
             break;
         default:
             (void)netif;
-#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
+#if defined(MODULE_GNRC_SIXLOWPAN_IPHC_NHC) || defined(MODULE_GNRC_NETIF_LO)
             /* second statement is true for small 6LoWPAN NHC decompressed frames
-             * since in this case it looks like
+             * and packets from the loopback interface since in this case it
+             * looks like
              *
              * * GNRC_NETTYPE_UNDEF <- pkt
              * v
@@ -362,7 +364,8 @@ static gnrc_pktsnip_t *_create_netif_hdr(uint8_t *dst_l2addr,
         DEBUG("ipv6: copy old interface header flags\n");
         gnrc_netif_hdr_t *netif_new = netif_hdr->data, *netif_old = pkt->data;
         netif_new->flags = netif_old->flags & \
-                           ~(GNRC_NETIF_HDR_FLAGS_BROADCAST | GNRC_NETIF_HDR_FLAGS_MULTICAST);
+                           ~(GNRC_NETIF_HDR_FLAGS_BROADCAST | GNRC_NETIF_HDR_FLAGS_MULTICAST |
+                             GNRC_NETIF_HDR_FLAGS_CSUM_VALID);
         DEBUG("ipv6: removed old interface header\n");
         pkt = gnrc_pktbuf_remove_snip(pkt, pkt);
     }
@@ -389,8 +392,10 @@ static void _send_unicast(gnrc_netif_t *netif, uint8_t *dst_l2addr,
     _send_to_iface(netif, pkt);
 }
 
+/* csum: calculate upper layer checksum; not needed if packet stays on the
+ * host or the interface offloads the checksum calculation */
 static int _fill_ipv6_hdr(gnrc_netif_t *netif, gnrc_pktsnip_t *ipv6,
-                          gnrc_pktsnip_t *payload)
+                          gnrc_pktsnip_t *payload, bool csum)
 {
     int res;
     ipv6_hdr_t *hdr = ipv6->data;
@@ -437,6 +442,12 @@ static int _fill_ipv6_hdr(gnrc_netif_t *netif, gnrc_pktsnip_t *ipv6,
         }
     }
 
+    if (!csum || ((netif != NULL) &&
+                  (netif->flags & GNRC_NETIF_FLAGS_CSUM_OFFLOAD_TX))) {
+        DEBUG("ipv6: skip checksum calculation for upper header.\n");
+        return 0;
+    }
+
     DEBUG("ipv6: calculate checksum for upper header.\n");
 
     if ((res = gnrc_netreg_calc_csum(payload, ipv6)) < 0) {
@@ -514,7 +525,7 @@ static void _send_multicast(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt,
                     ptr = ptr->next;
                 }
 
-                if (_fill_ipv6_hdr(netif, ipv6, tmp) < 0) {
+                if (_fill_ipv6_hdr(netif, ipv6, tmp, true) < 0) {
                     /* error on filling up header */
                     gnrc_pktbuf_release(ipv6);
                     return;
@@ -530,7 +541,7 @@ static void _send_multicast(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt,
     }
     else {
         if (prep_hdr) {
-            if (_fill_ipv6_hdr(netif, ipv6, payload) < 0) {
+            if (_fill_ipv6_hdr(netif, ipv6, payload, true) < 0) {
                 /* error on filling up header */
                 gnrc_pktbuf_release(pkt);
                 return;
@@ -551,7 +562,7 @@ static void _send_multicast(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt,
     }
 
     if (prep_hdr) {
-        if (_fill_ipv6_hdr(netif, ipv6, payload) < 0) {
+        if (_fill_ipv6_hdr(netif, ipv6, payload, true) < 0) {
             /* error on filling up header */
             gnrc_pktbuf_release(pkt);
             return;
@@ -614,11 +625,33 @@ static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
         if (ipv6_addr_is_loopback(&hdr->dst) ||    /* dst is loopback address */
                 /* or dst registered to a local interface */
                 (tmp_netif != NULL)) {
+#ifdef MODULE_GNRC_NETIF_LO
+            gnrc_netif_t *lo = gnrc_netif_lo_get();
+
+            if (lo != NULL) {
+                if (prep_hdr) {
+                    if (_fill_ipv6_hdr(tmp_netif, ipv6, payload, false) < 0) {
+                        /* error on filling up header */
+                        gnrc_pktbuf_release(pkt);
+                        return;
+                    }
+                }
+                DEBUG("ipv6: packet is addressed to myself => loopback interface\n");
+                if ((pkt = _create_netif_hdr(NULL, 0, pkt)) == NULL) {
+                    return;
+                }
+#ifdef MODULE_NETSTATS_IPV6
+                lo->ipv6.stats.tx_unicast_count++;
+#endif
+                _send_to_iface(lo, pkt);
+                return;
+            }
+#endif  /* MODULE_GNRC_NETIF_LO */
             uint8_t *rcv_data;
-            gnrc_pktsnip_t *ptr = ipv6, *rcv_pkt;
+            gnrc_pktsnip_t *ptr = ipv6, *rcv_pkt, *netif_hdr;
 
             if (prep_hdr) {
-                if (_fill_ipv6_hdr(tmp_netif, ipv6, payload) < 0) {
+                if (_fill_ipv6_hdr(tmp_netif, ipv6, payload, false) < 0) {
                     /* error on filling up header */
                     gnrc_pktbuf_release(pkt);
                     return;
@@ -634,6 +667,21 @@ static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
                 return;
             }
 
+            /* packet never leaves the host, so checksums were not
+             * calculated and don't need to be checked */
+            netif_hdr = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
+            if (netif_hdr == NULL) {
+                DEBUG("ipv6: error on generating loopback packet\n");
+                gnrc_pktbuf_release(rcv_pkt);
+                gnrc_pktbuf_release(pkt);
+                return;
+            }
+            ((gnrc_netif_hdr_t *)netif_hdr->data)->if_pid =
+                (tmp_netif != NULL) ? tmp_netif->pid : KERNEL_PID_UNDEF;
+            ((gnrc_netif_hdr_t *)netif_hdr->data)->flags =
+                GNRC_NETIF_HDR_FLAGS_CSUM_VALID;
+            rcv_pkt->next = netif_hdr;
+
             rcv_data = rcv_pkt->data;
 
             /* "reverse" packet (by making it one snip as if received from NIC) */
@@ -663,7 +711,7 @@ static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
             netif = gnrc_netif_get_by_pid(gnrc_ipv6_nib_nc_get_iface(&nce));
             assert(netif != NULL);
             if (prep_hdr) {
-                if (_fill_ipv6_hdr(netif, ipv6, payload) < 0) {
+                if (_fill_ipv6_hdr(netif, ipv6, payload, true) < 0) {
                     /* error on filling up header */
                     gnrc_pktbuf_release(pkt);
                     return;
@@ -692,6 +740,71 @@ static inline bool _pkt_not_for_me(gnrc_netif_t **netif, ipv6_hdr_t *hdr)
     }
 }
 
+#ifdef MODULE_GNRC_IPV6_ROUTER
+static inline bool _is_exclusive(gnrc_pktsnip_t *pkt)
+{
+    for (; pkt != NULL; pkt = pkt->next) {
+        if (pkt->users > 1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Forwarding fast path: if the received packet is exclusively owned by this
+ * thread and consists of just payload, IPv6 header, and interface header, it
+ * is relinked into sending order in place and handed to the egress interface,
+ * re-using the received interface header. Neither the payload nor the IPv6
+ * header are copied, and no new interface header is allocated.
+ *
+ * Returns false if the fast path is not applicable; pkt is untouched then. */
+static bool _forward(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *ipv6,
+                     gnrc_pktsnip_t *netif_hdr)
+{
+    gnrc_ipv6_nib_nc_t nce;
+    gnrc_netif_hdr_t *hdr;
+    gnrc_netif_t *netif;
+
+    /* multicast needs the slow path's _send_multicast() */
+    if ((netif_hdr == NULL) || (pkt->next != ipv6) ||
+        (ipv6->next != netif_hdr) || (netif_hdr->next != NULL) ||
+        ipv6_addr_is_multicast(&((ipv6_hdr_t *)ipv6->data)->dst) ||
+        !_is_exclusive(pkt)) {
+        return false;
+    }
+    DEBUG("ipv6: forward packet to next hop (fast path)\n");
+    /* relink to sending order; the interface header is kept aside so the NIB
+     * can queue or release the IPv6 packet on its own */
+    ipv6->next = pkt;
+    pkt->next = NULL;
+    netif_hdr->next = NULL;
+    if (gnrc_ipv6_nib_get_next_hop_l2addr(&((ipv6_hdr_t *)ipv6->data)->dst,
+                                          NULL, ipv6, &nce) < 0) {
+        /* packet is released by NIB */
+        gnrc_pktbuf_release(netif_hdr);
+        return true;
+    }
+    netif = gnrc_netif_get_by_pid(gnrc_ipv6_nib_nc_get_iface(&nce));
+    assert(netif != NULL);
+    if (gnrc_pktbuf_realloc_data(netif_hdr, sizeof(gnrc_netif_hdr_t) +
+                                            nce.l2addr_len) != 0) {
+        DEBUG("ipv6: unable to resize interface header, dropping packet\n");
+        gnrc_pktbuf_release(netif_hdr);
+        gnrc_pktbuf_release(ipv6);
+        return true;
+    }
+    hdr = netif_hdr->data;
+    gnrc_netif_hdr_init(hdr, 0, nce.l2addr_len);
+    gnrc_netif_hdr_set_dst_addr(hdr, nce.l2addr, nce.l2addr_len);
+    netif_hdr->next = ipv6;
+#ifdef MODULE_NETSTATS_IPV6
+    netif->ipv6.stats.tx_unicast_count++;
+#endif
+    _send_to_iface(netif, netif_hdr);
+    return true;
+}
+#endif  /* MODULE_GNRC_IPV6_ROUTER */
+
 static void _receive(gnrc_pktsnip_t *pkt)
 {
     gnrc_netif_t *netif = NULL;
@@ -705,10 +818,12 @@ static void _receive(gnrc_pktsnip_t *pkt)
     if (netif_hdr != NULL) {
         netif = gnrc_netif_get_by_pid(((gnrc_netif_hdr_t *)netif_hdr->data)->if_pid);
 #ifdef MODULE_NETSTATS_IPV6
-        assert(netif != NULL);
-        netstats_t *stats = &netif->ipv6.stats;
-        stats->rx_count++;
-        stats->rx_bytes += (gnrc_pkt_len(pkt) - netif_hdr->size);
+        /* looped back packets might not have an interface */
+        if (netif != NULL) {
+            netstats_t *stats = &netif->ipv6.stats;
+            stats->rx_count++;
+            stats->rx_bytes += (gnrc_pkt_len(pkt) - netif_hdr->size);
+        }
 #endif
     }
 
@@ -833,6 +948,10 @@ static void _receive(gnrc_pktsnip_t *pkt)
         else if (--(hdr->hl) > 0) {  /* drop packets that *reach* Hop Limit 0 */
             gnrc_pktsnip_t *reversed_pkt = NULL, *ptr = pkt;
 
+            if (_forward(pkt, ipv6, netif_hdr)) {
+                return;
+            }
+
             DEBUG("ipv6: forward packet to next hop\n");
 
             /* pkt might not be writable yet, if header was given above */
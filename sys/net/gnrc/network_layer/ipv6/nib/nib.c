@@ -183,7 +183,12 @@ int gnrc_ipv6_nib_get_next_hop_l2addr(const ipv6_addr_t *dst,
     do {    /* XXX: hidden goto ;-) */
         _nib_onl_entry_t *node = _nib_onl_get(dst,
                                               (netif == NULL) ? 0 : netif->pid);
-        /* consider neighbor cache entries first */
+        /* consider neighbor cache entries first; an on-link entry that only
+         * serves as next hop of an off-link entry does not make dst a
+         * neighbor */
+        if ((node != NULL) && !(node->mode & _NC)) {
+            node = NULL;
+        }
         unsigned iface = (node == NULL) ? 0 : _nib_onl_get_if(node);
 
         if ((node != NULL) || _on_link(dst, &iface)) {
@@ -21,18 +21,21 @@
 #include "net/gnrc/netapi.h"
 #include "net/gnrc/netif/hdr.h"
 #include "net/gnrc/sixlowpan/frag.h"
-#include "net/gnrc/sixlowpan/internal.h"
 #include "net/gnrc/netif.h"
 #include "net/sixlowpan.h"
 #include "utlist.h"
+#include "xtimer.h"
 
 #include "rbuf.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+#include "vrb.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
 static gnrc_sixlowpan_msg_frag_t _fragment_msg = {
-        NULL, 0, 0, KERNEL_PID_UNDEF
+        NULL, 0, 0, KERNEL_PID_UNDEF, 0
     };
 
 #if ENABLE_DEBUG
@@ -42,6 +45,44 @@ static gnrc_sixlowpan_msg_frag_t _fragment_msg = {
 
 static uint16_t _tag;
 
+/* fragments of the datagram in _fragment_msg are cut off it without copying */
+static bool _cut;
+
+#if GNRC_SIXLOWPAN_FRAG_PACING_US
+static xtimer_t _pacing_timer;
+static msg_t _pacing_msg = {
+    .type = GNRC_SIXLOWPAN_MSG_FRAG_SND,
+    .content = { .ptr = &_fragment_msg },
+};
+#endif
+
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+/**
+ * @brief   Selective fragment recovery state of a sent datagram
+ */
+typedef struct {
+    gnrc_sixlowpan_msg_frag_t msg;      /**< the datagram, msg.pkt is NULL if
+                                         *   the slot is free */
+    BITFIELD(acked, RBUF_UNITS_MAX);    /**< units the receiver reported */
+    xtimer_t timer;                     /**< acknowledgment timeout */
+    msg_t timer_msg;                    /**< acknowledgment timeout message */
+    uint8_t retries;                    /**< recovery rounds started */
+} _sfr_t;
+
+/**
+ * @brief   Whether a peer acknowledges datagrams
+ */
+typedef struct {
+    uint8_t addr[IEEE802154_LONG_ADDRESS_LEN];  /**< link-layer address */
+    uint8_t addr_len;                   /**< length of addr, 0 if unused */
+    bool acks;                          /**< the peer acknowledged a datagram */
+} _sfr_peer_t;
+
+static _sfr_t _sfr[GNRC_SIXLOWPAN_SFR_DATAGRAMS_NUMOF];
+static _sfr_peer_t _sfr_peers[GNRC_SIXLOWPAN_SFR_PEERS_NUMOF];
+static unsigned _sfr_peers_next;
+#endif
+
 static inline uint16_t _floor8(uint16_t length)
 {
     return length & 0xf8U;
@@ -52,11 +93,110 @@ static inline size_t _min(size_t a, size_t b)
     return (a < b) ? a : b;
 }
 
-static gnrc_pktsnip_t *_build_frag_pkt(gnrc_pktsnip_t *pkt, size_t payload_len,
-                                       size_t size)
+static inline uint16_t _1st_frag_max_size(gnrc_netif_t *iface, size_t payload_len,
+                                          size_t datagram_size)
+{
+    int payload_diff = (datagram_size - payload_len);
+
+    /* virtually add payload_diff to flooring to account for offset (must be divisable by 8)
+     * in uncompressed datagram */
+    return _floor8(iface->sixlo.max_frag_size + payload_diff -
+                   sizeof(sixlowpan_frag_t)) - payload_diff;
+}
+
+static inline uint16_t _nth_frag_max_size(gnrc_netif_t *iface)
+{
+    /* since dispatches aren't supposed to go into subsequent fragments, we need not account
+     * for payload difference as for the first fragment */
+    return _floor8(iface->sixlo.max_frag_size - sizeof(sixlowpan_frag_n_t));
+}
+
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+/* the recovery state fragment_msg belongs to or NULL */
+static inline _sfr_t *_sfr_get(gnrc_sixlowpan_msg_frag_t *fragment_msg)
+{
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_SFR_DATAGRAMS_NUMOF; i++) {
+        if (fragment_msg == &_sfr[i].msg) {
+            return &_sfr[i];
+        }
+    }
+    return NULL;
+}
+
+/* a slot to keep a datagram in until it is acknowledged or NULL */
+static _sfr_t *_sfr_alloc(void)
+{
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_SFR_DATAGRAMS_NUMOF; i++) {
+        if (_sfr[i].msg.pkt == NULL) {
+            return &_sfr[i];
+        }
+    }
+    return NULL;
+}
+
+static _sfr_peer_t *_sfr_peer_get(const uint8_t *addr, size_t addr_len)
+{
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_SFR_PEERS_NUMOF; i++) {
+        if ((_sfr_peers[i].addr_len == addr_len) &&
+            (memcmp(_sfr_peers[i].addr, addr, addr_len) == 0)) {
+            return &_sfr_peers[i];
+        }
+    }
+    return NULL;
+}
+
+/* remembers whether a peer acknowledges, replacing peers round robin */
+static void _sfr_peer_set(const uint8_t *addr, size_t addr_len, bool acks)
+{
+    _sfr_peer_t *peer = _sfr_peer_get(addr, addr_len);
+
+    if (addr_len > sizeof(peer->addr)) {
+        return;
+    }
+    if (peer == NULL) {
+        peer = &_sfr_peers[_sfr_peers_next];
+        _sfr_peers_next = (_sfr_peers_next + 1) % GNRC_SIXLOWPAN_SFR_PEERS_NUMOF;
+        memcpy(peer->addr, addr, addr_len);
+        peer->addr_len = addr_len;
+    }
+    peer->acks = acks;
+}
+
+/* checks if the destination of pkt acknowledges its fragments */
+static inline bool _sfr_expects_ack(gnrc_pktsnip_t *pkt)
+{
+    gnrc_netif_hdr_t *hdr = pkt->data;
+    _sfr_peer_t *peer;
+
+    if (hdr->flags & (GNRC_NETIF_HDR_FLAGS_BROADCAST |
+                      GNRC_NETIF_HDR_FLAGS_MULTICAST)) {
+        return false;
+    }
+    peer = _sfr_peer_get(gnrc_netif_hdr_get_dst_addr(hdr), hdr->dst_l2addr_len);
+    return (peer == NULL) || peer->acks;
+}
+#endif
+
+static inline bool _recovering(gnrc_sixlowpan_msg_frag_t *fragment_msg)
+{
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    return _sfr_get(fragment_msg) != NULL;
+#else
+    (void)fragment_msg;
+    return false;
+#endif
+}
+
+static void _frag_msg_release(gnrc_sixlowpan_msg_frag_t *fragment_msg)
+{
+    gnrc_pktbuf_release(fragment_msg->pkt);
+    fragment_msg->pkt = NULL;
+}
+
+static gnrc_pktsnip_t *_build_netif_hdr(gnrc_pktsnip_t *pkt)
 {
     gnrc_netif_hdr_t *hdr = pkt->data, *new_hdr;
-    gnrc_pktsnip_t *netif, *frag;
+    gnrc_pktsnip_t *netif;
 
     netif = gnrc_netif_hdr_build(gnrc_netif_hdr_get_src_addr(hdr), hdr->src_l2addr_len,
                                  gnrc_netif_hdr_get_dst_addr(hdr), hdr->dst_l2addr_len);
@@ -71,6 +211,19 @@ static gnrc_pktsnip_t *_build_frag_pkt(gnrc_pktsnip_t *pkt, size_t payload_len,
     new_hdr->flags = hdr->flags;
     new_hdr->rssi = hdr->rssi;
     new_hdr->lqi = hdr->lqi;
+    return netif;
+}
+
+static gnrc_pktsnip_t *_build_frag_pkt(gnrc_pktsnip_t *pkt, size_t payload_len,
+                                       size_t size)
+{
+    gnrc_pktsnip_t *netif, *frag;
+
+    netif = _build_netif_hdr(pkt);
+
+    if (netif == NULL) {
+        return NULL;
+    }
 
     frag = gnrc_pktbuf_add(NULL, NULL, _min(size, payload_len),
                            GNRC_NETTYPE_SIXLOWPAN);
@@ -86,25 +239,120 @@ static gnrc_pktsnip_t *_build_frag_pkt(gnrc_pktsnip_t *pkt, size_t payload_len,
     return frag;
 }
 
+/* checks if the fragments of pkt can be cut off it instead of being copied */
+static bool _can_cut(gnrc_pktsnip_t *pkt)
+{
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    /* datagram is needed for recovery until it is acknowledged */
+    if (_sfr_expects_ack(pkt)) {
+        return false;
+    }
+#endif
+    for (pkt = pkt->next; pkt != NULL; pkt = pkt->next) {
+        if (pkt->users > 1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* detaches the first size bytes of the datagram behind pkt. Only a snip
+ * the fragment boundary falls into is split, the data stays where it is */
+static gnrc_pktsnip_t *_cut_payload(gnrc_pktsnip_t *pkt, size_t size)
+{
+    gnrc_pktsnip_t *payload = pkt->next, *last = NULL, *snip = payload;
+    size_t len = 0;
+
+    assert((payload != NULL) && (size > 0));
+    while ((snip != NULL) && ((len + snip->size) <= size)) {
+        len += snip->size;
+        last = snip;
+        snip = snip->next;
+    }
+    if ((snip != NULL) && (len < size)) {
+        gnrc_pktsnip_t *front = gnrc_pktbuf_mark(snip, size - len, snip->type);
+        void *data;
+
+        if (front == NULL) {
+            DEBUG("6lo frag: error splitting payload\n");
+            return NULL;
+        }
+        /* the marked front part is put behind snip => swap contents to keep
+         * the order of the datagram */
+        data = front->data;
+        front->data = snip->data;
+        snip->data = data;
+        front->size = snip->size;
+        snip->size = size - len;
+        last = snip;
+        snip = front;
+    }
+    last->next = NULL;
+    pkt->next = snip;
+    return payload;
+}
+
+static gnrc_pktsnip_t *_cut_frag_pkt(gnrc_pktsnip_t *pkt, size_t hdr_size,
+                                     size_t size)
+{
+    gnrc_pktsnip_t *netif, *frag, *payload;
+
+    if ((payload = _cut_payload(pkt, size)) == NULL) {
+        return NULL;
+    }
+    frag = gnrc_pktbuf_add(payload, NULL, hdr_size, GNRC_NETTYPE_SIXLOWPAN);
+    if (frag == NULL) {
+        DEBUG("6lo frag: error allocating fragment header\n");
+        gnrc_pktbuf_release(payload);
+        return NULL;
+    }
+    netif = _build_netif_hdr(pkt);
+    if (netif == NULL) {
+        gnrc_pktbuf_release(frag);
+        return NULL;
+    }
+    LL_PREPEND(frag, netif);
+
+    return frag;
+}
+
+/* hands a fragment to the interface. In contrast to gnrc_netapi_send() this
+ * blocks while the interface's message queue is full, so a whole datagram
+ * can be handed down at once without fragments being dropped */
+static void _send_frag(gnrc_pktsnip_t *frag)
+{
+    gnrc_netif_hdr_t *hdr = frag->data;
+    msg_t msg = { .type = GNRC_NETAPI_MSG_TYPE_SND, .content = { .ptr = frag } };
+
+    if (msg_send(&msg, hdr->if_pid) < 1) {
+        DEBUG("6lo frag: unable to send %p over interface %u\n", (void *)frag,
+              hdr->if_pid);
+        gnrc_pktbuf_release(frag);
+    }
+}
+
 static uint16_t _send_1st_fragment(gnrc_netif_t *iface, gnrc_pktsnip_t *pkt,
-                                   size_t payload_len, size_t datagram_size)
+                                   size_t payload_len, size_t datagram_size,
+                                   uint16_t tag, bool cut)
 {
     gnrc_pktsnip_t *frag;
     uint16_t local_offset = 0;
     /* payload_len: actual size of the packet vs
      * datagram_size: size of the uncompressed IPv6 packet */
-    int payload_diff = (datagram_size - payload_len);
-    /* virtually add payload_diff to flooring to account for offset (must be divisable by 8)
-     * in uncompressed datagram */
-    uint16_t max_frag_size = _floor8(iface->sixlo.max_frag_size + payload_diff -
-                                     sizeof(sixlowpan_frag_t)) - payload_diff;
+    uint16_t max_frag_size = _1st_frag_max_size(iface, payload_len, datagram_size);
     sixlowpan_frag_t *hdr;
     uint8_t *data;
 
     DEBUG("6lo frag: determined max_frag_size = %" PRIu16 "\n", max_frag_size);
 
-    frag = _build_frag_pkt(pkt, payload_len,
-                           max_frag_size + sizeof(sixlowpan_frag_t));
+    if (cut) {
+        local_offset = _min(max_frag_size, payload_len);
+        frag = _cut_frag_pkt(pkt, sizeof(sixlowpan_frag_t), local_offset);
+    }
+    else {
+        frag = _build_frag_pkt(pkt, payload_len,
+                               max_frag_size + sizeof(sixlowpan_frag_t));
+    }
 
     if (frag == NULL) {
         return 0;
@@ -115,9 +363,9 @@ static uint16_t _send_1st_fragment(gnrc_netif_t *iface, gnrc_pktsnip_t *pkt,
 
     hdr->disp_size = byteorder_htons((uint16_t)datagram_size);
     hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
-    hdr->tag = byteorder_htons(_tag);
+    hdr->tag = byteorder_htons(tag);
 
-    pkt = pkt->next;    /* don't copy netif header */
+    pkt = (cut) ? NULL : pkt->next;     /* don't copy netif header */
 
     while (pkt != NULL) {
         size_t clen = _min(max_frag_size - local_offset, pkt->size);
@@ -134,28 +382,33 @@ static uint16_t _send_1st_fragment(gnrc_netif_t *iface, gnrc_pktsnip_t *pkt,
 
     DEBUG("6lo frag: send first fragment (datagram size: %u, "
           "datagram tag: %" PRIu16 ", fragment size: %" PRIu16 ")\n",
-          (unsigned int)datagram_size, _tag, local_offset);
-    gnrc_sixlowpan_dispatch_send(frag, NULL, 0);
+          (unsigned int)datagram_size, tag, local_offset);
+    _send_frag(frag);
     return local_offset;
 }
 
 static uint16_t _send_nth_fragment(gnrc_netif_t *iface, gnrc_pktsnip_t *pkt,
                                    size_t payload_len, size_t datagram_size,
-                                   uint16_t offset)
+                                   uint16_t offset, uint16_t tag, bool cut)
 {
     gnrc_pktsnip_t *frag;
-    /* since dispatches aren't supposed to go into subsequent fragments, we need not account
-     * for payload difference as for the first fragment */
-    uint16_t max_frag_size = _floor8(iface->sixlo.max_frag_size - sizeof(sixlowpan_frag_n_t));
+    uint16_t max_frag_size = _nth_frag_max_size(iface);
     uint16_t local_offset = 0, offset_count = 0;
     sixlowpan_frag_n_t *hdr;
     uint8_t *data;
 
     DEBUG("6lo frag: determined max_frag_size = %" PRIu16 "\n", max_frag_size);
 
-    frag = _build_frag_pkt(pkt,
-                           payload_len - offset + sizeof(sixlowpan_frag_n_t),
-                           max_frag_size + sizeof(sixlowpan_frag_n_t));
+    if (cut) {
+        /* the datagram behind pkt starts at offset */
+        local_offset = _min(max_frag_size, payload_len - offset);
+        frag = _cut_frag_pkt(pkt, sizeof(sixlowpan_frag_n_t), local_offset);
+    }
+    else {
+        frag = _build_frag_pkt(pkt,
+                               payload_len - offset + sizeof(sixlowpan_frag_n_t),
+                               max_frag_size + sizeof(sixlowpan_frag_n_t));
+    }
 
     if (frag == NULL) {
         return 0;
@@ -167,10 +420,10 @@ static uint16_t _send_nth_fragment(gnrc_netif_t *iface, gnrc_pktsnip_t *pkt,
     /* XXX: truncation of datagram_size > 4095 may happen here */
     hdr->disp_size = byteorder_htons((uint16_t)datagram_size);
     hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_N_DISP;
-    hdr->tag = byteorder_htons(_tag);
+    hdr->tag = byteorder_htons(tag);
     /* don't mention payload diff in offset */
     hdr->offset = (uint8_t)((offset + (datagram_size - payload_len)) >> 3);
-    pkt = pkt->next;    /* don't copy netif header */
+    pkt = (cut) ? NULL : pkt->next;     /* don't copy netif header */
 
     while ((pkt != NULL) && (offset_count != offset)) {   /* go to offset */
         offset_count += (uint16_t)pkt->size;
@@ -189,7 +442,7 @@ static uint16_t _send_nth_fragment(gnrc_netif_t *iface, gnrc_pktsnip_t *pkt,
         pkt = pkt->next;
     }
 
-    if (local_offset < max_frag_size) { /* copy other packet snips */
+    if ((pkt != NULL) && (local_offset < max_frag_size)) { /* copy other packet snips */
         while (pkt != NULL) {
             size_t clen = _min(max_frag_size - local_offset, pkt->size);
 
@@ -207,12 +460,98 @@ static uint16_t _send_nth_fragment(gnrc_netif_t *iface, gnrc_pktsnip_t *pkt,
     DEBUG("6lo frag: send subsequent fragment (datagram size: %u, "
           "datagram tag: %" PRIu16 ", offset: %" PRIu8 " (%u bytes), "
           "fragment size: %" PRIu16 ")\n",
-          (unsigned int)datagram_size, _tag, hdr->offset, hdr->offset << 3,
+          (unsigned int)datagram_size, tag, hdr->offset, hdr->offset << 3,
           local_offset);
-    gnrc_sixlowpan_dispatch_send(frag, NULL, 0);
+    _send_frag(frag);
     return local_offset;
 }
 
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+/* checks if the receiver reported all units in [start, end) */
+static bool _sfr_acked(_sfr_t *sfr, size_t start, size_t end)
+{
+    for (size_t i = start / 8; i <= ((end - 1) / 8); i++) {
+        if (!bf_isset(sfr->acked, i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* advances the datagram of sfr to the next fragment the receiver misses */
+static void _sfr_skip_acked(gnrc_netif_t *iface, _sfr_t *sfr,
+                            size_t payload_len)
+{
+    gnrc_sixlowpan_msg_frag_t *fragment_msg = &sfr->msg;
+    /* offsets in the uncompressed datagram differ by the compressed header
+     * bytes */
+    size_t payload_diff = fragment_msg->datagram_size - payload_len;
+
+    while (fragment_msg->offset < payload_len) {
+        size_t start = (fragment_msg->offset == 0) ? 0 :
+                       (fragment_msg->offset + payload_diff);
+        size_t size = (fragment_msg->offset == 0) ?
+                      _1st_frag_max_size(iface, payload_len,
+                                         fragment_msg->datagram_size) :
+                      _nth_frag_max_size(iface);
+
+        size = _min(size, payload_len - fragment_msg->offset);
+        /* the last fragment is always sent, it requests the next
+         * acknowledgment */
+        if (((fragment_msg->offset + size) >= payload_len) ||
+            !_sfr_acked(sfr, start, fragment_msg->offset + size + payload_diff)) {
+            return;
+        }
+        fragment_msg->offset += size;
+    }
+}
+
+/* identifies the current round of sfr in its timeout message */
+static inline uint32_t _sfr_round(const _sfr_t *sfr)
+{
+    return ((uint32_t)sfr->retries << 16) | sfr->msg.tag;
+}
+
+/* keeps the datagram until it is acknowledged, returns false if no
+ * acknowledgment is expected or all slots are taken */
+static bool _sfr_wait_for_ack(gnrc_sixlowpan_msg_frag_t *fragment_msg)
+{
+    _sfr_t *sfr = _sfr_get(fragment_msg);
+
+    if (sfr == NULL) {
+        if (!_sfr_expects_ack(fragment_msg->pkt) ||
+            ((sfr = _sfr_alloc()) == NULL)) {
+            return false;
+        }
+        /* the datagram waits outside of fragment_msg, which is free for the
+         * next datagram then */
+        sfr->msg = *fragment_msg;
+        sfr->retries = 0;
+        fragment_msg->pkt = NULL;
+    }
+    sfr->timer_msg.type = GNRC_SIXLOWPAN_MSG_FRAG_SFR_TIMEOUT;
+    sfr->timer_msg.content.value = _sfr_round(sfr);
+    xtimer_set_msg(&sfr->timer, GNRC_SIXLOWPAN_SFR_ACK_TIMEOUT_US,
+                   &sfr->timer_msg, sched_active_pid);
+    return true;
+}
+
+/* sends the fragments missing in sfr->acked */
+static void _sfr_recover(_sfr_t *sfr)
+{
+    if (++sfr->retries > GNRC_SIXLOWPAN_SFR_RETRIES) {
+        DEBUG("6lo frag: datagram %" PRIu16 " not acknowledged, dropping\n",
+              sfr->msg.tag);
+        _frag_msg_release(&sfr->msg);
+        return;
+    }
+    DEBUG("6lo frag: recovering datagram %" PRIu16 " (round %u)\n",
+          sfr->msg.tag, (unsigned)sfr->retries);
+    sfr->msg.offset = 0;
+    gnrc_sixlowpan_frag_send(NULL, &sfr->msg, 0);
+}
+#endif
+
 gnrc_sixlowpan_msg_frag_t *gnrc_sixlowpan_msg_frag_get(void)
 {
     return (_fragment_msg.pkt == NULL) ? &_fragment_msg : NULL;
@@ -227,7 +566,9 @@ void gnrc_sixlowpan_frag_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
     /* payload_len: actual size of the packet vs
      * datagram_size: size of the uncompressed IPv6 packet */
     size_t payload_len = gnrc_pkt_len(fragment_msg->pkt->next);
-    msg_t msg;
+    /* fragments missing at the receiver are sent again from a recovery slot */
+    bool recovering = _recovering(fragment_msg);
+    bool cut;
 
     assert((fragment_msg->pkt == pkt) || (pkt == NULL));
     (void)page;
@@ -236,57 +577,74 @@ void gnrc_sixlowpan_frag_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
     if (iface == NULL) {
         DEBUG("6lo frag: iface == NULL, expect segmentation fault.\n");
         /* remove original packet from packet buffer */
-        gnrc_pktbuf_release(fragment_msg->pkt);
         /* 6LoWPAN free for next fragmentation */
-        fragment_msg->pkt = NULL;
+        _frag_msg_release(fragment_msg);
         return;
     }
 #endif
-
-    /* Check weater to send the first or an Nth fragment */
     if (fragment_msg->offset == 0) {
-        /* increment tag for successive, fragmented datagrams */
-        _tag++;
-        if ((res = _send_1st_fragment(iface, fragment_msg->pkt, payload_len, fragment_msg->datagram_size)) == 0) {
-            /* error sending first fragment */
-            DEBUG("6lo frag: error sending 1st fragment\n");
-            gnrc_pktbuf_release(fragment_msg->pkt);
-            fragment_msg->pkt = NULL;
-            return;
+        /* increment tag for successive, fragmented datagrams, fragments
+         * sent again keep their datagram's tag */
+        if (!recovering) {
+            fragment_msg->tag = gnrc_sixlowpan_frag_next_tag();
+            _cut = _can_cut(fragment_msg->pkt);
         }
-        fragment_msg->offset += res;
-
-        /* send message to self*/
-        msg.type = GNRC_SIXLOWPAN_MSG_FRAG_SND;
-        msg.content.ptr = (void *)fragment_msg;
-        msg_send_to_self(&msg);
-        thread_yield();
     }
-    else {
+    else if (_cut && !recovering) {
+        /* already sent fragments were cut off the datagram */
+        payload_len += fragment_msg->offset;
+    }
+    /* _cut belongs to the datagram in _fragment_msg */
+    cut = _cut && !recovering;
+
+    /* hand all fragments to the interface in one go, unless they are paced.
+     * Recovered fragments are never paced, the pacing timer belongs to
+     * _fragment_msg */
+    do {
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+        if (recovering) {
+            _sfr_skip_acked(iface, _sfr_get(fragment_msg), payload_len);
+        }
+#endif
         /* (offset + (datagram_size - payload_len) < datagram_size) simplified */
-        if (fragment_msg->offset < payload_len) {
-            if ((res = _send_nth_fragment(iface, fragment_msg->pkt, payload_len, fragment_msg->datagram_size,
-                                          fragment_msg->offset)) == 0) {
-                /* error sending subsequent fragment */
-                DEBUG("6lo frag: error sending subsequent fragment (offset = %" PRIu16
-                      ")\n", fragment_msg->offset);
-                gnrc_pktbuf_release(fragment_msg->pkt);
-                fragment_msg->pkt = NULL;
+        if (fragment_msg->offset >= payload_len) {
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+            if (_sfr_wait_for_ack(fragment_msg)) {
+                DEBUG("6lo frag: waiting for acknowledgment of datagram %" PRIu16 "\n",
+                      fragment_msg->tag);
                 return;
-                }
-            fragment_msg->offset += res;
-
-            /* send message to self*/
-            msg.type = GNRC_SIXLOWPAN_MSG_FRAG_SND;
-            msg.content.ptr = (void *)fragment_msg;
-            msg_send_to_self(&msg);
-            thread_yield();
+            }
+#endif
+            _frag_msg_release(fragment_msg);
+            return;
+        }
+        /* Check weater to send the first or an Nth fragment */
+        if (fragment_msg->offset == 0) {
+            res = _send_1st_fragment(iface, fragment_msg->pkt, payload_len,
+                                     fragment_msg->datagram_size,
+                                     fragment_msg->tag, cut);
         }
         else {
-            gnrc_pktbuf_release(fragment_msg->pkt);
-            fragment_msg->pkt = NULL;
+            res = _send_nth_fragment(iface, fragment_msg->pkt, payload_len,
+                                     fragment_msg->datagram_size,
+                                     fragment_msg->offset, fragment_msg->tag,
+                                     cut);
         }
-    }
+        if (res == 0) {
+            /* error sending fragment */
+            DEBUG("6lo frag: error sending fragment (offset = %" PRIu16 ")\n",
+                  fragment_msg->offset);
+            _frag_msg_release(fragment_msg);
+            return;
+        }
+        fragment_msg->offset += res;
+    } while ((GNRC_SIXLOWPAN_FRAG_PACING_US == 0) || recovering);
+
+#if GNRC_SIXLOWPAN_FRAG_PACING_US
+    /* give the link some air before the next fragment */
+    xtimer_set_msg(&_pacing_timer, GNRC_SIXLOWPAN_FRAG_PACING_US, &_pacing_msg,
+                   sched_active_pid);
+#endif
 }
 
 void gnrc_sixlowpan_frag_recv(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
@@ -315,6 +673,12 @@ void gnrc_sixlowpan_frag_recv(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
             return;
     }
 
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+    if (vrb_forward(hdr, pkt, offset)) {
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+#endif
     rbuf_add(hdr, pkt, frag_size, offset);
 
     gnrc_pktbuf_release(pkt);
@@ -325,4 +689,106 @@ void gnrc_sixlowpan_frag_gc_rbuf(void)
     rbuf_gc();
 }
 
+uint16_t gnrc_sixlowpan_frag_next_tag(void)
+{
+    return ++_tag;
+}
+
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+void gnrc_sixlowpan_frag_sfr_recv_ack(gnrc_pktsnip_t *pkt, void *ctx,
+                                      unsigned page)
+{
+    gnrc_netif_hdr_t *hdr = pkt->next->data;
+    sixlowpan_sfr_ack_t *ack = pkt->data;
+    _sfr_t *sfr = NULL;
+    size_t size;
+
+    (void)ctx;
+    (void)page;
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+    /* acknowledgments for forwarded datagrams go back to the previous hop */
+    if (vrb_forward_ack(hdr, pkt)) {
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+#endif
+    if (pkt->size < sizeof(sixlowpan_sfr_ack_t)) {
+        DEBUG("6lo frag: acknowledgment too short\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    size = byteorder_ntohs(ack->disp_size) & SIXLOWPAN_FRAG_SIZE_MASK;
+    /* the acknowledgment must come from the destination of the datagram */
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_SFR_DATAGRAMS_NUMOF; i++) {
+        gnrc_netif_hdr_t *frag_hdr;
+
+        if (_sfr[i].msg.pkt == NULL) {
+            continue;
+        }
+        frag_hdr = _sfr[i].msg.pkt->data;
+        if ((byteorder_ntohs(ack->tag) == _sfr[i].msg.tag) &&
+            (size == _sfr[i].msg.datagram_size) &&
+            (hdr->src_l2addr_len == frag_hdr->dst_l2addr_len) &&
+            (memcmp(gnrc_netif_hdr_get_src_addr(hdr),
+                    gnrc_netif_hdr_get_dst_addr(frag_hdr),
+                    hdr->src_l2addr_len) == 0)) {
+            sfr = &_sfr[i];
+            break;
+        }
+    }
+    if ((sfr == NULL) ||
+        (pkt->size < (sizeof(sixlowpan_sfr_ack_t) + SIXLOWPAN_SFR_ACK_BITMAP_SIZE(size)))) {
+        DEBUG("6lo frag: acknowledgment for unknown datagram\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    _sfr_peer_set(gnrc_netif_hdr_get_src_addr(hdr), hdr->src_l2addr_len, true);
+    xtimer_remove(&sfr->timer);
+    memcpy(sfr->acked, ack + 1, SIXLOWPAN_SFR_ACK_BITMAP_SIZE(size));
+    gnrc_pktbuf_release(pkt);
+    if (_sfr_acked(sfr, 0, size)) {
+        DEBUG("6lo frag: datagram %" PRIu16 " acknowledged\n", sfr->msg.tag);
+        _frag_msg_release(&sfr->msg);
+        return;
+    }
+    _sfr_recover(sfr);
+}
+
+void gnrc_sixlowpan_frag_sfr_timeout(msg_t *msg)
+{
+    _sfr_t *sfr = NULL;
+
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_SFR_DATAGRAMS_NUMOF; i++) {
+        if ((_sfr[i].msg.pkt != NULL) &&
+            (msg->content.value == _sfr_round(&_sfr[i]))) {
+            sfr = &_sfr[i];
+            break;
+        }
+    }
+    if (sfr == NULL) {
+        /* an acknowledgment overtook the queued timeout message */
+        return;
+    }
+    DEBUG("6lo frag: acknowledgment timeout for datagram %" PRIu16 "\n",
+          sfr->msg.tag);
+    if (sfr->retries > 0) {
+        gnrc_netif_hdr_t *hdr = sfr->msg.pkt->data;
+        _sfr_peer_t *peer = _sfr_peer_get(gnrc_netif_hdr_get_dst_addr(hdr),
+                                          hdr->dst_l2addr_len);
+
+        if (peer == NULL) {
+            /* the peer never acknowledged: fall back to plain RFC 4944 */
+            DEBUG("6lo frag: peer does not acknowledge, stop waiting for it\n");
+            _sfr_peer_set(gnrc_netif_hdr_get_dst_addr(hdr), hdr->dst_l2addr_len,
+                          false);
+            _frag_msg_release(&sfr->msg);
+            return;
+        }
+    }
+    /* only send the last fragment again to request a new acknowledgment */
+    memset(sfr->acked, 0xff, sizeof(sfr->acked));
+    _sfr_recover(sfr);
+}
+#endif
+
 /** @} */
@@ -21,6 +21,7 @@
 #include "net/gnrc.h"
 #include "net/gnrc/sixlowpan.h"
 #include "net/gnrc/sixlowpan/frag.h"
+#include "net/gnrc/sixlowpan/internal.h"
 #include "net/sixlowpan.h"
 #include "thread.h"
 #include "xtimer.h"
@@ -29,21 +30,6 @@
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
-/* estimated fragment payload size to determinate RBUF_INT_SIZE, default to
- * MAC payload size - fragment header. */
-#ifndef GNRC_SIXLOWPAN_FRAG_SIZE
-/* assuming 64-bit source/destination address, source PAN ID omitted */
-#define GNRC_SIXLOWPAN_FRAG_SIZE (104 - 5)
-#endif
-
-#ifndef RBUF_INT_SIZE
-/* same as ((int) ceil((double) N / D)) */
-#define DIV_CEIL(N, D) (((N) + (D) - 1) / (D))
-#define RBUF_INT_SIZE (DIV_CEIL(IPV6_MIN_MTU, GNRC_SIXLOWPAN_FRAG_SIZE) * RBUF_SIZE)
-#endif
-
-static rbuf_int_t rbuf_int[RBUF_INT_SIZE];
-
 static rbuf_t rbuf[RBUF_SIZE];
 
 static char l2addr_str[3 * IEEE802154_LONG_ADDRESS_LEN];
@@ -54,19 +40,54 @@ static msg_t _gc_timer_msg = { .type = GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF };
 /* ------------------------------------
  * internal function definitions
  * ------------------------------------*/
-/* checks whether start and end overlaps, but not identical to, given interval i */
-static inline bool _rbuf_int_overlap_partially(rbuf_int_t *i, uint16_t start, uint16_t end);
-/* gets a free entry from interval buffer */
-static rbuf_int_t *_rbuf_int_get_free(void);
+/* counts the already received units of the fragment */
+static size_t _rbuf_received_units(rbuf_t *entry, size_t offset, size_t frag_size);
+/* marks the units of the fragment as received */
+static void _rbuf_set_received(rbuf_t *entry, size_t offset, size_t frag_size);
 /* remove entry from reassembly buffer */
 static void _rbuf_rem(rbuf_t *entry);
-/* update interval buffer of entry */
-static bool _rbuf_update_ints(rbuf_t *entry, uint16_t offset, size_t frag_size);
+/* remove entry after its datagram was dispatched */
+static void _rbuf_complete(rbuf_t *entry);
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+/* send a selective fragment recovery acknowledgment for entry */
+static void _rbuf_send_ack(gnrc_netif_hdr_t *netif_hdr, rbuf_t *entry);
+#endif
 /* gets an entry identified by its tupel */
 static rbuf_t *_rbuf_get(const void *src, size_t src_len,
                          const void *dst, size_t dst_len,
                          size_t size, uint16_t tag);
 
+/* entry holds a datagram or remembers a dispatched one */
+static inline bool _rbuf_in_use(const rbuf_t *entry)
+{
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    return (entry->super.pkt != NULL) || entry->completed;
+#else
+    return (entry->super.pkt != NULL);
+#endif
+}
+
+/* time in microseconds an entry in use is kept after the last fragment */
+static inline uint32_t _rbuf_timeout(const rbuf_t *entry)
+{
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    if (entry->completed) {
+        return RBUF_COMPLETED_TIMEOUT;
+    }
+#else
+    (void)entry;
+#endif
+    return RBUF_TIMEOUT;
+}
+
+/* size of the datagram of an entry in use */
+static inline size_t _rbuf_size(const rbuf_t *entry)
+{
+    /* current_size reached the datagram size when it was dispatched */
+    return (entry->super.pkt != NULL) ? entry->super.pkt->size :
+                                        entry->super.current_size;
+}
+
 void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
               size_t frag_size, size_t offset)
 {
@@ -75,8 +96,9 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
      * (reason: cppcheck is clearly wrong here) */
     unsigned int data_offset = 0;
     size_t original_size = frag_size;
+    size_t received, units;
+    bool last;
     sixlowpan_frag_t *frag = pkt->data;
-    rbuf_int_t *ptr;
     uint8_t *data = ((uint8_t *)pkt->data) + sizeof(sixlowpan_frag_t);
 
     rbuf_gc();
@@ -90,7 +112,17 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
         return;
     }
 
-    ptr = entry->ints;
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    if (entry->completed) {
+        /* the sender repeats the last fragment if it missed the
+         * acknowledgment for a datagram that was already dispatched */
+        if ((offset > 0) &&
+            ((offset + frag_size) >= entry->super.current_size)) {
+            _rbuf_send_ack(netif_hdr, entry);
+        }
+        return;
+    }
+#endif
 
     /* dispatches in the first fragment are ignored */
     if (offset == 0) {
@@ -131,28 +163,34 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
         return;
     }
 
+    if (frag_size == 0) {
+        DEBUG("6lo rfrag: fragment carries no data, ignoring\n");
+        return;
+    }
+    last = ((offset + frag_size) == entry->super.pkt->size);
+
     /* If the fragment overlaps another fragment and differs in either the size
      * or the offset of the overlapped fragment, discards the datagram
      * https://tools.ietf.org/html/rfc4944#section-5.3 */
-    while (ptr != NULL) {
-        if (_rbuf_int_overlap_partially(ptr, offset, offset + frag_size - 1)) {
-            DEBUG("6lo rfrag: overlapping intervals, discarding datagram\n");
-            gnrc_pktbuf_release(entry->super.pkt);
-            _rbuf_rem(entry);
-
-            /* "A fresh reassembly may be commenced with the most recently
-             * received link fragment"
-             * https://tools.ietf.org/html/rfc4944#section-5.3 */
-            rbuf_add(netif_hdr, pkt, original_size, offset);
+    received = _rbuf_received_units(entry, offset, frag_size);
+    units = ((offset + frag_size - 1) / 8) - (offset / 8) + 1;
+    if ((received > 0) && (received < units)) {
+        DEBUG("6lo rfrag: overlapping intervals, discarding datagram\n");
+        gnrc_pktbuf_release(entry->super.pkt);
+        _rbuf_rem(entry);
 
-            return;
-        }
+        /* "A fresh reassembly may be commenced with the most recently
+         * received link fragment"
+         * https://tools.ietf.org/html/rfc4944#section-5.3 */
+        rbuf_add(netif_hdr, pkt, original_size, offset);
 
-        ptr = ptr->next;
+        return;
     }
 
-    if (_rbuf_update_ints(entry, offset, frag_size)) {
+    /* fragments are only copied once, so duplicates are ignored */
+    if (received == 0) {
         DEBUG("6lo rbuf: add fragment data\n");
+        _rbuf_set_received(entry, offset, frag_size);
         entry->super.current_size += (uint16_t)frag_size;
         memcpy(((uint8_t *)entry->super.pkt->data) + offset + data_offset, data,
                frag_size - data_offset);
@@ -182,70 +220,116 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
         new_netif_hdr->rssi = netif_hdr->rssi;
         LL_APPEND(entry->super.pkt, netif);
         gnrc_sixlowpan_dispatch_recv(entry->super.pkt, NULL, 0);
-        _rbuf_rem(entry);
+        _rbuf_complete(entry);
+    }
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    /* the last fragment requests an acknowledgment */
+    if (last) {
+        _rbuf_send_ack(netif_hdr, entry);
     }
+#else
+    (void)last;
+#endif
 }
 
-static inline bool _rbuf_int_overlap_partially(rbuf_int_t *i, uint16_t start, uint16_t end)
+static size_t _rbuf_received_units(rbuf_t *entry, size_t offset, size_t frag_size)
 {
-    /* start and ends are both inclusive, so using <= for both */
-    return ((i->start <= end) && (start <= i->end)) && /* overlaps */
-        ((start != i->start) || (end != i->end)); /* not identical */
-}
+    size_t res = 0;
 
-static rbuf_int_t *_rbuf_int_get_free(void)
-{
-    for (unsigned int i = 0; i < RBUF_INT_SIZE; i++) {
-        if (rbuf_int[i].end == 0) { /* start must be smaller than end anyways*/
-            return rbuf_int + i;
+    for (size_t i = offset / 8; i <= ((offset + frag_size - 1) / 8); i++) {
+        if (bf_isset(entry->received, i)) {
+            res++;
         }
     }
-
-    return NULL;
+    return res;
 }
 
-static void _rbuf_rem(rbuf_t *entry)
+static void _rbuf_set_received(rbuf_t *entry, size_t offset, size_t frag_size)
 {
-    while (entry->ints != NULL) {
-        rbuf_int_t *next = entry->ints->next;
+    DEBUG("6lo rfrag: add interval (%u, %u) to entry (%s, ",
+          (unsigned)offset, (unsigned)(offset + frag_size - 1),
+          gnrc_netif_addr_to_str(entry->super.src, entry->super.src_len,
+                                 l2addr_str));
+    DEBUG("%s, %u, %u)\n", gnrc_netif_addr_to_str(entry->super.dst,
+                                                  entry->super.dst_len,
+                                                  l2addr_str),
+          (unsigned)entry->super.pkt->size, entry->super.tag);
 
-        entry->ints->start = 0;
-        entry->ints->end = 0;
-        entry->ints->next = NULL;
-        entry->ints = next;
+    for (size_t i = offset / 8; i <= ((offset + frag_size - 1) / 8); i++) {
+        bf_set(entry->received, i);
     }
+}
 
+static void _rbuf_rem(rbuf_t *entry)
+{
+    memset(entry->received, 0, sizeof(entry->received));
     entry->super.pkt = NULL;
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    entry->completed = false;
+#endif
 }
 
-static bool _rbuf_update_ints(rbuf_t *entry, uint16_t offset, size_t frag_size)
+static void _rbuf_complete(rbuf_t *entry)
 {
-    rbuf_int_t *new;
-    uint16_t end = (uint16_t)(offset + frag_size - 1);
-
-    new = _rbuf_int_get_free();
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    /* keep the entry for a short while to acknowledge repeated last
+     * fragments. The packet belongs to the upper layer now. */
+    entry->super.pkt = NULL;
+    entry->completed = true;
+#else
+    _rbuf_rem(entry);
+#endif
+}
 
-    if (new == NULL) {
-        DEBUG("6lo rfrag: no space left in rbuf interval buffer.\n");
-        return false;
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+static void _rbuf_send_ack(gnrc_netif_hdr_t *netif_hdr, rbuf_t *entry)
+{
+    gnrc_pktsnip_t *ack, *netif;
+    sixlowpan_sfr_ack_t *hdr;
+    size_t size = (entry->completed) ? entry->super.current_size :
+                                       entry->super.pkt->size;
+    size_t bitmap_size = SIXLOWPAN_SFR_ACK_BITMAP_SIZE(size);
+
+    /* there is no single sender to acknowledge to */
+    if (netif_hdr->flags & (GNRC_NETIF_HDR_FLAGS_BROADCAST |
+                            GNRC_NETIF_HDR_FLAGS_MULTICAST)) {
+        return;
     }
-
-    new->start = offset;
-    new->end = end;
-
-    DEBUG("6lo rfrag: add interval (%" PRIu16 ", %" PRIu16 ") to entry (%s, ",
-          new->start, new->end, gnrc_netif_addr_to_str(entry->super.src,
-                                                       entry->super.src_len,
-                                                       l2addr_str));
+    ack = gnrc_pktbuf_add(NULL, NULL, sizeof(sixlowpan_sfr_ack_t) + bitmap_size,
+                          GNRC_NETTYPE_SIXLOWPAN);
+    if (ack == NULL) {
+        DEBUG("6lo rfrag: unable to allocate acknowledgment\n");
+        return;
+    }
+    hdr = ack->data;
+    hdr->disp = SIXLOWPAN_SFR_ACK_DISP;
+    hdr->disp_size = byteorder_htons((uint16_t)size);
+    hdr->tag = byteorder_htons(entry->super.tag);
+    if (entry->completed) {
+        memset(hdr + 1, 0xff, bitmap_size);
+    }
+    else {
+        memcpy(hdr + 1, entry->received, bitmap_size);
+    }
+    netif = gnrc_netif_hdr_build(entry->super.dst, entry->super.dst_len,
+                                 entry->super.src, entry->super.src_len);
+    if (netif == NULL) {
+        DEBUG("6lo rfrag: unable to allocate acknowledgment netif header\n");
+        gnrc_pktbuf_release(ack);
+        return;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = netif_hdr->if_pid;
+    LL_PREPEND(ack, netif);
+    DEBUG("6lo rfrag: acknowledge entry (%s, ",
+          gnrc_netif_addr_to_str(entry->super.src, entry->super.src_len,
+                                 l2addr_str));
     DEBUG("%s, %u, %u)\n", gnrc_netif_addr_to_str(entry->super.dst,
                                                   entry->super.dst_len,
                                                   l2addr_str),
-          (unsigned)entry->super.pkt->size, entry->super.tag);
-
-    LL_PREPEND(entry->ints, new);
-
-    return true;
+          (unsigned)size, entry->super.tag);
+    gnrc_sixlowpan_dispatch_send(ack, NULL, 0);
 }
+#endif
 
 void rbuf_gc(void)
 {
@@ -254,8 +338,8 @@ void rbuf_gc(void)
 
     for (i = 0; i < RBUF_SIZE; i++) {
         /* since pkt occupies pktbuf, aggressivly collect garbage */
-        if ((rbuf[i].super.pkt != NULL) &&
-              ((now_usec - rbuf[i].arrival) > RBUF_TIMEOUT)) {
+        if (_rbuf_in_use(&rbuf[i]) &&
+              ((now_usec - rbuf[i].arrival) > _rbuf_timeout(&rbuf[i]))) {
             DEBUG("6lo rfrag: entry (%s, ",
                   gnrc_netif_addr_to_str(rbuf[i].super.src,
                                          rbuf[i].super.src_len,
@@ -264,9 +348,11 @@ void rbuf_gc(void)
                   gnrc_netif_addr_to_str(rbuf[i].super.dst,
                                          rbuf[i].super.dst_len,
                                          l2addr_str),
-                  (unsigned)rbuf[i].super.pkt->size, rbuf[i].super.tag);
+                  (unsigned)_rbuf_size(&rbuf[i]), rbuf[i].super.tag);
 
-            gnrc_pktbuf_release(rbuf[i].super.pkt);
+            if (rbuf[i].super.pkt != NULL) {
+                gnrc_pktbuf_release(rbuf[i].super.pkt);
+            }
             _rbuf_rem(&(rbuf[i]));
         }
     }
@@ -277,16 +363,32 @@ static inline void _set_rbuf_timeout(void)
     xtimer_set_msg(&_gc_timer, RBUF_TIMEOUT, &_gc_timer_msg, sched_active_pid);
 }
 
+static rbuf_t *_rbuf_oldest_pending(void)
+{
+    rbuf_t *oldest = NULL;
+
+    for (unsigned int i = 0; i < RBUF_SIZE; i++) {
+        if ((rbuf[i].super.pkt != NULL) &&
+            ((oldest == NULL) || (oldest->arrival - rbuf[i].arrival < UINT32_MAX / 2))) {
+            oldest = &(rbuf[i]);
+        }
+    }
+    return oldest;
+}
+
 static rbuf_t *_rbuf_get(const void *src, size_t src_len,
                          const void *dst, size_t dst_len,
                          size_t size, uint16_t tag)
 {
     rbuf_t *res = NULL, *oldest = NULL;
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    rbuf_t *completed = NULL;
+#endif
     uint32_t now_usec = xtimer_now_usec();
 
     for (unsigned int i = 0; i < RBUF_SIZE; i++) {
         /* check first if entry already available */
-        if ((rbuf[i].super.pkt != NULL) && (rbuf[i].super.pkt->size == size) &&
+        if (_rbuf_in_use(&rbuf[i]) && (_rbuf_size(&rbuf[i]) == size) &&
             (rbuf[i].super.tag == tag) && (rbuf[i].super.src_len == src_len) &&
             (rbuf[i].super.dst_len == dst_len) &&
             (memcmp(rbuf[i].super.src, src, src_len) == 0) &&
@@ -299,16 +401,22 @@ static rbuf_t *_rbuf_get(const void *src, size_t src_len,
                   gnrc_netif_addr_to_str(rbuf[i].super.dst,
                                          rbuf[i].super.dst_len,
                                          l2addr_str),
-                  (unsigned)rbuf[i].super.pkt->size, rbuf[i].super.tag);
+                  (unsigned)_rbuf_size(&rbuf[i]), rbuf[i].super.tag);
             rbuf[i].arrival = now_usec;
             _set_rbuf_timeout();
             return &(rbuf[i]);
         }
 
         /* if there is a free spot: remember it */
-        if ((res == NULL) && (rbuf[i].super.pkt == NULL)) {
+        if ((res == NULL) && !_rbuf_in_use(&rbuf[i])) {
             res = &(rbuf[i]);
         }
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+        /* a dispatched datagram gives way before one still in reassembly */
+        if ((completed == NULL) && rbuf[i].completed) {
+            completed = &(rbuf[i]);
+        }
+#endif
 
         /* remember oldest slot */
         /* note that xtimer_now will overflow in ~1.2 hours */
@@ -317,13 +425,22 @@ static rbuf_t *_rbuf_get(const void *src, size_t src_len,
         }
     }
 
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    if ((res == NULL) && (completed != NULL)) {
+        DEBUG("6lo rfrag: reassembly buffer full, forget dispatched entry\n");
+        _rbuf_rem(completed);
+        res = completed;
+    }
+#endif
     /* entry not in buffer and no empty spot found */
     if (res == NULL) {
         assert(oldest != NULL);
-        /* if oldest->pkt == NULL, res must not be NULL */
-        assert(oldest->super.pkt != NULL);
+        /* if oldest is not in use, res must not be NULL */
+        assert(_rbuf_in_use(oldest));
         DEBUG("6lo rfrag: reassembly buffer full, remove oldest entry\n");
-        gnrc_pktbuf_release(oldest->super.pkt);
+        if (oldest->super.pkt != NULL) {
+            gnrc_pktbuf_release(oldest->super.pkt);
+        }
         _rbuf_rem(oldest);
         res = oldest;
     }
@@ -331,6 +448,14 @@ static rbuf_t *_rbuf_get(const void *src, size_t src_len,
     /* now we have an empty spot */
 
     res->super.pkt = gnrc_pktbuf_add(NULL, NULL, size, GNRC_NETTYPE_IPV6);
+    /* reassembly space is taken from the packet buffer: if it is exhausted,
+     * make room by dropping the oldest incomplete datagrams */
+    while ((res->super.pkt == NULL) && ((oldest = _rbuf_oldest_pending()) != NULL)) {
+        DEBUG("6lo rfrag: packet buffer full, remove oldest entry\n");
+        gnrc_pktbuf_release(oldest->super.pkt);
+        _rbuf_rem(oldest);
+        res->super.pkt = gnrc_pktbuf_add(NULL, NULL, size, GNRC_NETTYPE_IPV6);
+    }
     if (res->super.pkt == NULL) {
         DEBUG("6lo rfrag: can not allocate reassembly buffer space.\n");
         return NULL;
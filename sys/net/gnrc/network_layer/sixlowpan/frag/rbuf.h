@@ -20,7 +20,9 @@
 #define RBUF_H
 
 #include <inttypes.h>
+#include <stdbool.h>
 
+#include "bitfield.h"
 #include "net/gnrc/netif/hdr.h"
 #include "net/gnrc/pkt.h"
 
@@ -30,26 +32,22 @@
 extern "C" {
 #endif
 
-#define RBUF_SIZE           (4U)               /**< size of the reassembly buffer */
-#define RBUF_TIMEOUT        (3U * US_PER_SEC) /**< timeout for reassembly in microseconds */
+#define RBUF_SIZE           (GNRC_SIXLOWPAN_FRAG_RBUF_SIZE)       /**< size of the reassembly buffer */
+#define RBUF_TIMEOUT        (GNRC_SIXLOWPAN_FRAG_RBUF_TIMEOUT_US) /**< timeout for reassembly in microseconds */
 
 /**
- * @brief   Fragment intervals to identify limits of fragments.
+ * @brief   Time in microseconds a dispatched datagram is remembered after
+ *          its last fragment arrived
  *
- * @note    Fragments MUST NOT overlap and overlapping fragments are to be
- *          discarded
- *
- * @see <a href="https://tools.ietf.org/html/rfc4944#section-5.3">
- *          RFC 4944, section 5.3
- *      </a>
- *
- * @internal
+ * Long enough to acknowledge the last fragment again, if the sender repeats
+ * it after a lost acknowledgment.
  */
-typedef struct rbuf_int {
-    struct rbuf_int *next;  /**< next element in interval list */
-    uint16_t start;         /**< start byte of interval */
-    uint16_t end;           /**< end byte of interval */
-} rbuf_int_t;
+#define RBUF_COMPLETED_TIMEOUT  (2U * GNRC_SIXLOWPAN_SFR_ACK_TIMEOUT_US)
+
+/**
+ * @brief   Number of 8-octet units of the largest possible datagram
+ */
+#define RBUF_UNITS_MAX      ((SIXLOWPAN_FRAG_MAX_LEN + 7U) / 8U)
 
 /**
  * @brief   Internal representation of the 6LoWPAN reassembly buffer.
@@ -62,9 +60,31 @@ typedef struct rbuf_int {
  */
 typedef struct {
     gnrc_sixlowpan_rbuf_t super;        /**< exposed part of the reassembly buffer */
-    rbuf_int_t *ints;                   /**< intervals of the fragment */
+    /**
+     * @brief   Received 8-octet units of the datagram
+     *
+     * @note    Fragment offsets are multiples of 8 and only the last fragment
+     *          of a datagram may have a size that is not, so every unit
+     *          belongs to exactly one fragment.
+     *
+     * @see <a href="https://tools.ietf.org/html/rfc4944#section-5.3">
+     *          RFC 4944, section 5.3
+     *      </a>
+     */
+    BITFIELD(received, RBUF_UNITS_MAX);
     uint32_t arrival;                   /**< time in microseconds of arrival of
                                          *   last received fragment */
+#if defined(MODULE_GNRC_SIXLOWPAN_FRAG_SFR) || defined(DOXYGEN)
+    /**
+     * @brief   The datagram was dispatched already
+     *
+     * The entry is kept for @ref RBUF_COMPLETED_TIMEOUT to acknowledge
+     * retransmissions of the last fragment, in case the sender missed the
+     * acknowledgment, or until its slot is needed for another datagram.
+     * gnrc_sixlowpan_rbuf_t::pkt is NULL in that case.
+     */
+    bool completed;
+#endif
 } rbuf_t;
 
 /**
@@ -0,0 +1,383 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6/nib.h"
+#include "net/gnrc/netif/internal.h"
+#include "net/gnrc/sixlowpan.h"
+#include "net/gnrc/sixlowpan/frag.h"
+#include "net/gnrc/sixlowpan/iphc.h"
+#include "net/gnrc/sixlowpan/internal.h"
+#include "net/ipv6/hdr.h"
+#include "net/sixlowpan.h"
+#include "net/udp.h"
+#include "utlist.h"
+#include "xtimer.h"
+
+#include "vrb.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static vrb_t _vrb[VRB_SIZE];
+
+static char l2addr_str[3 * IEEE802154_LONG_ADDRESS_LEN];
+
+/* removes entries whose datagram did not progress for VRB_TIMEOUT */
+static void _vrb_gc(uint32_t now_usec)
+{
+    for (unsigned i = 0; i < VRB_SIZE; i++) {
+        if ((_vrb[i].datagram_size != 0) &&
+            ((now_usec - _vrb[i].arrival) > VRB_TIMEOUT)) {
+            DEBUG("6lo vrb: entry (%s, %u, %u) timed out\n",
+                  gnrc_netif_addr_to_str(_vrb[i].src, _vrb[i].src_len,
+                                         l2addr_str),
+                  (unsigned)_vrb[i].datagram_size, _vrb[i].tag);
+            _vrb[i].datagram_size = 0;
+        }
+    }
+}
+
+/* gets the entry of a datagram from the previous hop */
+static vrb_t *_vrb_get(gnrc_netif_hdr_t *netif_hdr, size_t size,
+                       uint16_t tag)
+{
+    for (unsigned i = 0; i < VRB_SIZE; i++) {
+        if ((_vrb[i].datagram_size == size) && (_vrb[i].tag == tag) &&
+            (_vrb[i].in_netif == netif_hdr->if_pid) &&
+            (_vrb[i].src_len == netif_hdr->src_l2addr_len) &&
+            (memcmp(_vrb[i].src, gnrc_netif_hdr_get_src_addr(netif_hdr),
+                    _vrb[i].src_len) == 0)) {
+            return &_vrb[i];
+        }
+    }
+    return NULL;
+}
+
+/* gets a free entry, or the oldest one if the buffer is full */
+static vrb_t *_vrb_alloc(void)
+{
+    vrb_t *oldest = NULL;
+
+    for (unsigned i = 0; i < VRB_SIZE; i++) {
+        if (_vrb[i].datagram_size == 0) {
+            return &_vrb[i];
+        }
+        /* note that xtimer_now will overflow in ~1.2 hours */
+        if ((oldest == NULL) || (oldest->arrival - _vrb[i].arrival < UINT32_MAX / 2)) {
+            oldest = &_vrb[i];
+        }
+    }
+    DEBUG("6lo vrb: virtual reassembly buffer full, remove oldest entry\n");
+    return oldest;
+}
+
+static gnrc_pktsnip_t *_netif_hdr_build(gnrc_netif_t *netif,
+                                        uint8_t *dst, size_t dst_len)
+{
+    gnrc_pktsnip_t *res = gnrc_netif_hdr_build(netif->l2addr,
+                                               netif->l2addr_len,
+                                               dst, dst_len);
+
+    if (res != NULL) {
+        ((gnrc_netif_hdr_t *)res->data)->if_pid = netif->pid;
+    }
+    return res;
+}
+
+/* decodes the IPv6 header and the compressed next headers of a first
+ * fragment. disp_len is set to the number of bytes they take in the
+ * fragment, nh_len to the number of next header bytes behind the IPv6
+ * header in the result. */
+static gnrc_pktsnip_t *_decode(gnrc_pktsnip_t *frag, size_t datagram_size,
+                               size_t *disp_len, size_t *nh_len)
+{
+    uint8_t *data = ((uint8_t *)frag->data) + sizeof(sixlowpan_frag_t);
+    size_t len = frag->size - sizeof(sixlowpan_frag_t);
+    /* IPHC decodes UDP headers of fragmented datagrams right behind the IPv6
+     * header */
+    gnrc_pktsnip_t *hdr = gnrc_pktbuf_add(NULL, NULL,
+                                          sizeof(ipv6_hdr_t) + sizeof(udp_hdr_t),
+                                          GNRC_NETTYPE_IPV6);
+
+    if (hdr == NULL) {
+        DEBUG("6lo vrb: unable to allocate header space\n");
+        return NULL;
+    }
+    memset(hdr->data, 0, hdr->size);
+    *nh_len = 0;
+    if ((len > sizeof(ipv6_hdr_t)) && (data[0] == SIXLOWPAN_UNCOMP)) {
+        memcpy(hdr->data, data + 1, sizeof(ipv6_hdr_t));
+        *disp_len = 1 + sizeof(ipv6_hdr_t);
+        return hdr;
+    }
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC
+    if ((len > 0) && sixlowpan_iphc_is(data)) {
+        *disp_len = gnrc_sixlowpan_iphc_decode(&hdr, frag, datagram_size,
+                                               sizeof(sixlowpan_frag_t),
+                                               nh_len);
+        if ((*disp_len != 0) && (*disp_len <= len)) {
+            return hdr;
+        }
+    }
+#else
+    (void)datagram_size;
+#endif
+    gnrc_pktbuf_release(hdr);
+    return NULL;
+}
+
+/* builds the first fragment for the next link from the decoded headers in
+ * hdr and the rest of frag, returns it in sending order */
+static gnrc_pktsnip_t *_encode(gnrc_pktsnip_t *frag, gnrc_pktsnip_t *hdr,
+                               size_t disp_len, size_t nh_len,
+                               gnrc_netif_t *out_netif,
+                               gnrc_ipv6_nib_nc_t *nce, uint16_t out_tag)
+{
+    sixlowpan_frag_t *frag_hdr = frag->data;
+    uint8_t *data = ((uint8_t *)(frag_hdr + 1)) + disp_len;
+    size_t len = frag->size - sizeof(sixlowpan_frag_t) - disp_len;
+    gnrc_pktsnip_t *netif, *payload, *ipv6, *disp;
+
+    /* IPHC expects uncompressed next headers in the snip behind the IPv6
+     * header */
+    payload = gnrc_pktbuf_add(NULL, NULL, nh_len + len, GNRC_NETTYPE_UNDEF);
+    if (payload == NULL) {
+        return NULL;
+    }
+    memcpy(payload->data, ((ipv6_hdr_t *)hdr->data) + 1, nh_len);
+    memcpy(((uint8_t *)payload->data) + nh_len, data, len);
+    ipv6 = gnrc_pktbuf_add(payload, hdr->data, sizeof(ipv6_hdr_t),
+                           GNRC_NETTYPE_IPV6);
+    if (ipv6 == NULL) {
+        gnrc_pktbuf_release(payload);
+        return NULL;
+    }
+    netif = _netif_hdr_build(out_netif, nce->l2addr, nce->l2addr_len);
+    if (netif == NULL) {
+        gnrc_pktbuf_release(ipv6);
+        return NULL;
+    }
+    LL_PREPEND(ipv6, netif);
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC
+    if (out_netif->flags & GNRC_NETIF_FLAGS_6LO_HC) {
+        if (!gnrc_sixlowpan_iphc_encode(netif)) {
+            DEBUG("6lo vrb: error on IPHC encoding\n");
+            gnrc_pktbuf_release(netif);
+            return NULL;
+        }
+    }
+    else
+#endif
+    {
+        disp = gnrc_pktbuf_add(ipv6, NULL, sizeof(uint8_t),
+                               GNRC_NETTYPE_SIXLOWPAN);
+        if (disp == NULL) {
+            gnrc_pktbuf_release(netif);
+            return NULL;
+        }
+        *((uint8_t *)disp->data) = SIXLOWPAN_UNCOMP;
+        netif->next = disp;
+    }
+    disp = gnrc_pktbuf_add(netif->next, NULL, sizeof(sixlowpan_frag_t),
+                           GNRC_NETTYPE_SIXLOWPAN);
+    if (disp == NULL) {
+        gnrc_pktbuf_release(netif);
+        return NULL;
+    }
+    netif->next = disp;
+    frag_hdr = disp->data;
+    frag_hdr->disp_size = ((sixlowpan_frag_t *)frag->data)->disp_size;
+    frag_hdr->tag = byteorder_htons(out_tag);
+    return netif;
+}
+
+static bool _forward_1st(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *frag,
+                         size_t datagram_size, uint16_t tag, vrb_t *entry,
+                         uint32_t now_usec)
+{
+    gnrc_netif_t *in_netif = gnrc_netif_get_by_pid(netif_hdr->if_pid);
+    gnrc_netif_t *out_netif = NULL;
+    gnrc_ipv6_nib_nc_t nce;
+    gnrc_pktsnip_t *hdr, *pkt;
+    ipv6_hdr_t *ipv6_hdr;
+    size_t disp_len, nh_len;
+    uint16_t out_tag;
+
+    if ((in_netif == NULL) || !gnrc_netif_is_rtr(in_netif) ||
+        (netif_hdr->flags & (GNRC_NETIF_HDR_FLAGS_BROADCAST |
+                             GNRC_NETIF_HDR_FLAGS_MULTICAST))) {
+        return false;
+    }
+    if ((hdr = _decode(frag, datagram_size, &disp_len, &nh_len)) == NULL) {
+        DEBUG("6lo vrb: unable to decode first fragment\n");
+        return false;
+    }
+    ipv6_hdr = hdr->data;
+    /* everything IPv6 needs to handle itself is reassembled first */
+    if ((ipv6_hdr->hl <= 1) || ipv6_addr_is_multicast(&ipv6_hdr->dst) ||
+        ipv6_addr_is_link_local(&ipv6_hdr->src) ||
+        ipv6_addr_is_link_local(&ipv6_hdr->dst) ||
+        (gnrc_netif_get_by_ipv6_addr(&ipv6_hdr->dst) != NULL) ||
+        (gnrc_ipv6_nib_get_next_hop_l2addr(&ipv6_hdr->dst, NULL, NULL,
+                                           &nce) < 0) ||
+        ((out_netif = gnrc_netif_get_by_pid(gnrc_ipv6_nib_nc_get_iface(&nce))) == NULL) ||
+        !gnrc_netif_is_6ln(out_netif) || (out_netif->sixlo.max_frag_size == 0)) {
+        gnrc_pktbuf_release(hdr);
+        return false;
+    }
+    ipv6_hdr->hl--;
+    /* repeated first fragments keep the tag on the next link */
+    out_tag = (entry != NULL) ? entry->out_tag : gnrc_sixlowpan_frag_next_tag();
+    pkt = _encode(frag, hdr, disp_len, nh_len, out_netif, &nce, out_tag);
+    gnrc_pktbuf_release(hdr);
+    if (pkt == NULL) {
+        DEBUG("6lo vrb: unable to build first fragment\n");
+        return false;
+    }
+    if (gnrc_pkt_len(pkt->next) > out_netif->sixlo.max_frag_size) {
+        DEBUG("6lo vrb: first fragment does not fit next link\n");
+        gnrc_pktbuf_release(pkt);
+        return false;
+    }
+    if (entry == NULL) {
+        entry = _vrb_alloc();
+        memcpy(entry->src, gnrc_netif_hdr_get_src_addr(netif_hdr),
+               netif_hdr->src_l2addr_len);
+        entry->src_len = netif_hdr->src_l2addr_len;
+        entry->datagram_size = datagram_size;
+        entry->tag = tag;
+        entry->out_tag = out_tag;
+        entry->in_netif = netif_hdr->if_pid;
+    }
+    /* the route may have changed for a repeated first fragment */
+    memcpy(entry->out_dst, nce.l2addr, nce.l2addr_len);
+    entry->out_dst_len = nce.l2addr_len;
+    entry->out_netif = out_netif->pid;
+    entry->arrival = now_usec;
+    DEBUG("6lo vrb: forward datagram (%s, %u, %u) with tag %u\n",
+          gnrc_netif_addr_to_str(entry->src, entry->src_len, l2addr_str),
+          (unsigned)datagram_size, tag, out_tag);
+    gnrc_sixlowpan_dispatch_send(pkt, NULL, 0);
+    return true;
+}
+
+static void _forward_nth(vrb_t *entry, gnrc_pktsnip_t *frag)
+{
+    gnrc_netif_t *out_netif = gnrc_netif_get_by_pid(entry->out_netif);
+    gnrc_pktsnip_t *netif, *copy;
+
+    if ((out_netif == NULL) || (frag->size > out_netif->sixlo.max_frag_size)) {
+        DEBUG("6lo vrb: fragment does not fit next link, dropping\n");
+        return;
+    }
+    copy = gnrc_pktbuf_add(NULL, frag->data, frag->size, GNRC_NETTYPE_SIXLOWPAN);
+    if (copy == NULL) {
+        DEBUG("6lo vrb: unable to allocate fragment, dropping\n");
+        return;
+    }
+    ((sixlowpan_frag_t *)copy->data)->tag = byteorder_htons(entry->out_tag);
+    netif = _netif_hdr_build(out_netif, entry->out_dst, entry->out_dst_len);
+    if (netif == NULL) {
+        DEBUG("6lo vrb: unable to allocate netif header, dropping\n");
+        gnrc_pktbuf_release(copy);
+        return;
+    }
+    LL_PREPEND(copy, netif);
+    gnrc_sixlowpan_dispatch_send(netif, NULL, 0);
+}
+
+bool vrb_forward(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *frag,
+                 size_t offset)
+{
+    sixlowpan_frag_t *hdr = frag->data;
+    size_t datagram_size = byteorder_ntohs(hdr->disp_size) & SIXLOWPAN_FRAG_SIZE_MASK;
+    uint16_t tag = byteorder_ntohs(hdr->tag);
+    uint32_t now_usec = xtimer_now_usec();
+    vrb_t *entry;
+
+    _vrb_gc(now_usec);
+    entry = _vrb_get(netif_hdr, datagram_size, tag);
+    if (offset == 0) {
+        return _forward_1st(netif_hdr, frag, datagram_size, tag, entry,
+                            now_usec);
+    }
+    /* subsequent fragments that arrive before the first are reassembled */
+    if (entry == NULL) {
+        return false;
+    }
+    entry->arrival = now_usec;
+    _forward_nth(entry, frag);
+    return true;
+}
+
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+bool vrb_forward_ack(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *ack)
+{
+    sixlowpan_sfr_ack_t *hdr = ack->data;
+    gnrc_netif_t *in_netif;
+    gnrc_pktsnip_t *netif, *copy;
+    size_t datagram_size;
+    vrb_t *entry = NULL;
+
+    if (ack->size < sizeof(sixlowpan_sfr_ack_t)) {
+        return false;
+    }
+    datagram_size = byteorder_ntohs(hdr->disp_size) & SIXLOWPAN_FRAG_SIZE_MASK;
+    for (unsigned i = 0; i < VRB_SIZE; i++) {
+        if ((_vrb[i].datagram_size == datagram_size) &&
+            (_vrb[i].out_tag == byteorder_ntohs(hdr->tag)) &&
+            (_vrb[i].out_netif == netif_hdr->if_pid) &&
+            (_vrb[i].out_dst_len == netif_hdr->src_l2addr_len) &&
+            (memcmp(_vrb[i].out_dst, gnrc_netif_hdr_get_src_addr(netif_hdr),
+                    _vrb[i].out_dst_len) == 0)) {
+            entry = &_vrb[i];
+            break;
+        }
+    }
+    if ((entry == NULL) ||
+        ((in_netif = gnrc_netif_get_by_pid(entry->in_netif)) == NULL)) {
+        return false;
+    }
+    /* a dropped acknowledgment is recovered by the sender's timeout */
+    copy = gnrc_pktbuf_add(NULL, ack->data, ack->size, GNRC_NETTYPE_SIXLOWPAN);
+    if (copy == NULL) {
+        return true;
+    }
+    ((sixlowpan_sfr_ack_t *)copy->data)->tag = byteorder_htons(entry->tag);
+    netif = _netif_hdr_build(in_netif, entry->src, entry->src_len);
+    if (netif == NULL) {
+        gnrc_pktbuf_release(copy);
+        return true;
+    }
+    LL_PREPEND(copy, netif);
+    DEBUG("6lo vrb: forward acknowledgment for datagram (%s, %u, %u)\n",
+          gnrc_netif_addr_to_str(entry->src, entry->src_len, l2addr_str),
+          (unsigned)datagram_size, entry->tag);
+    gnrc_sixlowpan_dispatch_send(netif, NULL, 0);
+    return true;
+}
+#endif
+
+#else  /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
+typedef int dont_be_pedantic;
+#endif /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
+
+/** @} */
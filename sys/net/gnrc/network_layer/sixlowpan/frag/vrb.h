@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_sixlowpan_frag
+ * @{
+ *
+ * @file
+ * @internal
+ * @brief   6LoWPAN virtual reassembly buffer
+ *
+ * A router that is not the destination of a fragmented datagram forwards
+ * each fragment as soon as it arrives instead of reassembling the datagram
+ * first. Only the first fragment is decompressed, to find the next hop, and
+ * compressed again for the next link. Subsequent fragments just get the
+ * datagram tag of the next link.
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc8930">RFC 8930</a>
+ */
+#ifndef VRB_H
+#define VRB_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "kernel_types.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pkt.h"
+#include "net/gnrc/sixlowpan/frag.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define VRB_SIZE            (GNRC_SIXLOWPAN_FRAG_VRB_SIZE)       /**< size of the virtual reassembly buffer */
+#define VRB_TIMEOUT         (GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT_US) /**< timeout for entries in microseconds */
+
+/**
+ * @brief   An entry in the virtual reassembly buffer
+ *
+ * Maps the datagram tag a previous hop chose to the one used on the link
+ * to the next hop.
+ *
+ * @internal
+ */
+typedef struct {
+    uint8_t src[IEEE802154_LONG_ADDRESS_LEN];   /**< address of the previous hop */
+    uint8_t out_dst[IEEE802154_LONG_ADDRESS_LEN];   /**< address of the next hop */
+    uint8_t src_len;                /**< length of vrb_t::src */
+    uint8_t out_dst_len;            /**< length of vrb_t::out_dst */
+    uint16_t datagram_size;         /**< size of the datagram, 0 if unused */
+    uint16_t tag;                   /**< tag used by the previous hop */
+    uint16_t out_tag;               /**< tag used towards the next hop */
+    kernel_pid_t in_netif;          /**< interface to the previous hop */
+    kernel_pid_t out_netif;         /**< interface to the next hop */
+    uint32_t arrival;               /**< time in microseconds of arrival of
+                                     *   last forwarded fragment */
+} vrb_t;
+
+/**
+ * @brief   Forwards a fragment of a datagram that is not destined to this
+ *          node
+ *
+ * A first fragment creates an entry if the datagram's destination is
+ * reachable over a 6LoWPAN interface, subsequent fragments are only
+ * forwarded if an entry exists for them.
+ *
+ * @param[in] netif_hdr     The interface header of the fragment.
+ * @param[in] frag          The fragment. Stays with the caller.
+ * @param[in] offset        The fragment's offset.
+ *
+ * @return  true, if the fragment was handled.
+ * @return  false, if the fragment needs to be reassembled.
+ *
+ * @internal
+ */
+bool vrb_forward(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *frag,
+                 size_t offset);
+
+#if defined(MODULE_GNRC_SIXLOWPAN_FRAG_SFR) || defined(DOXYGEN)
+/**
+ * @brief   Forwards a selective fragment recovery acknowledgment to the
+ *          previous hop of a forwarded datagram
+ *
+ * @param[in] netif_hdr     The interface header of the acknowledgment.
+ * @param[in] ack           The acknowledgment. Stays with the caller.
+ *
+ * @return  true, if the acknowledgment was forwarded.
+ * @return  false, if the acknowledgment is not for a forwarded datagram.
+ *
+ * @internal
+ */
+bool vrb_forward_ack(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *ack);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VRB_H */
+/** @} */
@@ -23,6 +23,7 @@
 #include "net/gnrc/sixlowpan/iphc.h"
 #include "net/gnrc/netif.h"
 #include "net/sixlowpan.h"
+#include "net/udp.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -164,12 +165,26 @@ static void _receive(gnrc_pktsnip_t *pkt)
         return;
     }
 #endif
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    else if (sixlowpan_sfr_ack_is(dispatch)) {
+        DEBUG("6lo: received selective fragment recovery acknowledgment\n");
+        gnrc_sixlowpan_frag_sfr_recv_ack(pkt, NULL, 0);
+        return;
+    }
+#endif
 #ifdef MODULE_GNRC_SIXLOWPAN_IPHC
     else if (sixlowpan_iphc_is(dispatch)) {
-        size_t dispatch_size, nh_len;
+        size_t dispatch_size, nh_len, dec_hdr_size = sizeof(ipv6_hdr_t);
         gnrc_pktsnip_t *sixlowpan;
-        gnrc_pktsnip_t *dec_hdr = gnrc_pktbuf_add(NULL, NULL, sizeof(ipv6_hdr_t),
-                                                  GNRC_NETTYPE_IPV6);
+        gnrc_pktsnip_t *dec_hdr;
+
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
+        if (dispatch[0] & SIXLOWPAN_IPHC1_NH) {
+            /* reserve space to decompress the UDP header into */
+            dec_hdr_size += sizeof(udp_hdr_t);
+        }
+#endif
+        dec_hdr = gnrc_pktbuf_add(NULL, NULL, dec_hdr_size, GNRC_NETTYPE_IPV6);
         if ((dec_hdr == NULL) ||
             (dispatch_size = gnrc_sixlowpan_iphc_decode(&dec_hdr, pkt, 0, 0,
                                                         &nh_len)) == 0) {
@@ -380,6 +395,12 @@ static void *_event_loop(void *args)
                 gnrc_sixlowpan_frag_gc_rbuf();
                 break;
 #endif
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+            case GNRC_SIXLOWPAN_MSG_FRAG_SFR_TIMEOUT:
+                DEBUG("6lo: fragment acknowledgment timeout event received\n");
+                gnrc_sixlowpan_frag_sfr_timeout(&msg);
+                break;
+#endif
 
             default:
                 DEBUG("6lo: operation not supported\n");
@@ -17,6 +17,7 @@
  */
 
 #include <stdbool.h>
+#include <string.h>
 
 #include "byteorder.h"
 #include "net/ieee802154.h"
@@ -89,6 +90,11 @@
 #define NHC_UDP_8BIT_PORT           (0xF000)
 #define NHC_UDP_8BIT_MASK           (0xFF00)
 
+/* worst case: context identifier extension and all IPv6 header fields inline */
+#define IPHC_MAX_HDR_LEN            (SIXLOWPAN_IPHC_HDR_LEN + \
+                                     SIXLOWPAN_IPHC_CID_EXT_LEN + \
+                                     sizeof(ipv6_hdr_t))
+
 static inline bool _context_overlaps_iid(gnrc_sixlowpan_ctx_t *ctx,
                                          ipv6_addr_t *addr,
                                          eui64_t *iid)
@@ -127,7 +133,8 @@ static inline size_t iphc_nhc_udp_decode(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t **d
     uint8_t tmp;
     udp_hdr_t *udp_hdr;
 
-    if (datagram_size == 0) {    /* received packet is not fragmented */
+    if ((datagram_size == 0) &&  /* received packet is not fragmented */
+        (ipv6->size != (sizeof(ipv6_hdr_t) + sizeof(udp_hdr_t)))) {
         udp = gnrc_pktbuf_add(NULL, NULL, sizeof(udp_hdr_t),
                               snip_type);
         if (udp == NULL) {
@@ -190,7 +197,7 @@ static inline size_t iphc_nhc_udp_decode(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t **d
     }
 
     /* TODO subtract extension header length */
-    if (udp != NULL) {
+    if (datagram_size == 0) {
         udp_hdr->length = byteorder_htons(pkt->size - offset + sizeof(udp_hdr_t));
     }
     else {
@@ -203,6 +210,15 @@ static inline size_t iphc_nhc_udp_decode(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t **d
         udp->next = ipv6;
         *dec_hdr = udp;
     }
+    else if (datagram_size == 0) {
+        /* UDP header was decompressed into the space reserved behind the
+         * IPv6 header => split it off, the remainder becomes the UDP header */
+        if (gnrc_pktbuf_mark(ipv6, sizeof(ipv6_hdr_t), GNRC_NETTYPE_IPV6) == NULL) {
+            DEBUG("6lo: error on splitting IPHC NHC UDP header\n");
+            return 0;
+        }
+        ipv6->type = snip_type;
+    }
 
     return offset;
 }
@@ -236,17 +252,19 @@ size_t gnrc_sixlowpan_iphc_decode(gnrc_pktsnip_t **dec_hdr, gnrc_pktsnip_t *pkt,
     switch (iphc_hdr[IPHC1_IDX] & SIXLOWPAN_IPHC1_TF) {
         case IPHC_TF_ECN_DSCP_FL:
             ipv6_hdr_set_tc(ipv6_hdr, iphc_hdr[payload_offset++]);
+            ipv6_hdr->v_tc_fl.u8[1] &= 0xf0;
             ipv6_hdr->v_tc_fl.u8[1] |= iphc_hdr[payload_offset++] & 0x0f;
-            ipv6_hdr->v_tc_fl.u8[2] |= iphc_hdr[payload_offset++];
-            ipv6_hdr->v_tc_fl.u8[3] |= iphc_hdr[payload_offset++];
+            ipv6_hdr->v_tc_fl.u8[2] = iphc_hdr[payload_offset++];
+            ipv6_hdr->v_tc_fl.u8[3] = iphc_hdr[payload_offset++];
             break;
 
         case IPHC_TF_ECN_FL:
             ipv6_hdr_set_tc_ecn(ipv6_hdr, iphc_hdr[payload_offset] >> 6);
             ipv6_hdr_set_tc_dscp(ipv6_hdr, 0);
+            ipv6_hdr->v_tc_fl.u8[1] &= 0xf0;
             ipv6_hdr->v_tc_fl.u8[1] |= iphc_hdr[payload_offset++] & 0x0f;
-            ipv6_hdr->v_tc_fl.u8[2] |= iphc_hdr[payload_offset++];
-            ipv6_hdr->v_tc_fl.u8[3] |= iphc_hdr[payload_offset++];
+            ipv6_hdr->v_tc_fl.u8[2] = iphc_hdr[payload_offset++];
+            ipv6_hdr->v_tc_fl.u8[3] = iphc_hdr[payload_offset++];
             break;
 
         case IPHC_TF_ECN_DSCP:
@@ -516,6 +534,12 @@ size_t gnrc_sixlowpan_iphc_decode(gnrc_pktsnip_t **dec_hdr, gnrc_pktsnip_t *pkt,
     (void)nh_len;
 #endif
 
+    if ((datagram_size == 0) && (*dec_hdr == ipv6) &&
+        (ipv6->size > sizeof(ipv6_hdr_t))) {
+        /* space reserved for a next header was not used */
+        gnrc_pktbuf_realloc_data(ipv6, sizeof(ipv6_hdr_t));
+    }
+
     return payload_offset;
 }
 
@@ -584,21 +608,27 @@ static inline size_t iphc_nhc_udp_encode(gnrc_pktsnip_t *udp, ipv6_hdr_t *ipv6_h
 bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
 {
     gnrc_netif_hdr_t *netif_hdr = pkt->data;
-    ipv6_hdr_t *ipv6_hdr = pkt->next->data;
-    uint8_t *iphc_hdr;
+    gnrc_pktsnip_t *ipv6 = pkt->next;
+    ipv6_hdr_t *ipv6_hdr = ipv6->data;
+    uint8_t iphc_buf[IPHC_MAX_HDR_LEN];
+    uint8_t *iphc_hdr = iphc_buf;
     uint16_t inline_pos = SIXLOWPAN_IPHC_HDR_LEN;
     bool addr_comp = false, nhc_comp = false;
     gnrc_sixlowpan_ctx_t *src_ctx = NULL, *dst_ctx = NULL;
-    gnrc_pktsnip_t *dispatch = gnrc_pktbuf_add(NULL, NULL, pkt->next->size,
-                                               GNRC_NETTYPE_SIXLOWPAN);
-
-    if (dispatch == NULL) {
-        DEBUG("6lo iphc: error allocating dispatch space\n");
-        return false;
+    gnrc_pktsnip_t *dispatch = NULL;
+
+    if (ipv6->users > 1) {
+        /* IPv6 header is shared (e.g. held for retransmission) so it can't be
+         * overwritten => compress into a new dispatch */
+        dispatch = gnrc_pktbuf_add(NULL, NULL, IPHC_MAX_HDR_LEN,
+                                   GNRC_NETTYPE_SIXLOWPAN);
+        if (dispatch == NULL) {
+            DEBUG("6lo iphc: error allocating dispatch space\n");
+            return false;
+        }
+        iphc_hdr = dispatch->data;
     }
 
-    iphc_hdr = dispatch->data;
-
     /* set initial dispatch value*/
     iphc_hdr[IPHC1_IDX] = SIXLOWPAN_IPHC1_DISP;
     iphc_hdr[IPHC2_IDX] = 0;
@@ -664,7 +694,7 @@ bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
 
         /* copy remaining byteos of flow label */
         iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_fl(ipv6_hdr) & 0x0000ff00) >> 8);
-        iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_fl(ipv6_hdr) & 0x000000ff) >> 8);
+        iphc_hdr[inline_pos++] = (uint8_t)(ipv6_hdr_get_fl(ipv6_hdr) & 0x000000ff);
     }
 
     /* compress next header */
@@ -881,6 +911,20 @@ bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
         iphc_hdr[inline_pos++] = ipv6_hdr->nh;
     }
 
+    if (dispatch == NULL) {
+        /* replace the IPv6 header with the dispatch in its own buffer. In
+         * all but one corner case (context identifier extension with both
+         * addresses inline) this only shrinks the data, so no new space is
+         * allocated */
+        if (gnrc_pktbuf_realloc_data(ipv6, (size_t)inline_pos) != 0) {
+            DEBUG("6lo iphc: error reallocating dispatch space\n");
+            return false;
+        }
+        memcpy(ipv6->data, iphc_hdr, inline_pos);
+        ipv6->type = GNRC_NETTYPE_SIXLOWPAN;
+        return true;
+    }
+
     /* shrink dispatch allocation to final size */
     /* NOTE: Since this only shrinks the data nothing bad SHOULD happen ;-) */
     gnrc_pktbuf_realloc_data(dispatch, (size_t)inline_pos);
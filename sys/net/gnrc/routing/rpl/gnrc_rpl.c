@@ -29,6 +29,12 @@
 #include "net/gnrc/rpl/p2p.h"
 #include "net/gnrc/rpl/p2p_dodag.h"
 #endif
+#ifdef MODULE_GNRC_RPL_SR_TABLE
+#include "net/gnrc/rpl/sr_table.h"
+#endif
+#ifdef MODULE_GNRC_RPL_TRICKLE_ADAPT
+#include "bitarithm.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -59,6 +65,9 @@ static void _update_lifetime(void);
 static void _dao_handle_send(gnrc_rpl_dodag_t *dodag);
 static void _receive(gnrc_pktsnip_t *pkt);
 static void *_event_loop(void *args);
+#ifdef MODULE_GNRC_RPL_TRICKLE_ADAPT
+static void _trickle_adapt(trickle_t *trickle);
+#endif
 
 evtimer_msg_t gnrc_rpl_evtimer;
 
@@ -133,6 +142,11 @@ gnrc_rpl_instance_t *gnrc_rpl_root_init(uint8_t instance_id, ipv6_addr_t *dodag_
 #ifndef GNRC_RPL_WITHOUT_PIO
     dodag->dio_opts |= GNRC_RPL_REQ_DIO_OPT_PREFIX_INFO;
 #endif
+#ifdef MODULE_GNRC_RPL_SR_TABLE
+    if (inst->mop == GNRC_RPL_MOP_NON_STORING_MODE) {
+        gnrc_rpl_sr_table_init(dodag_id);
+    }
+#endif
 
     trickle_start(gnrc_rpl_pid, &dodag->trickle, GNRC_RPL_MSG_TYPE_TRICKLE_MSG,
                   (1 << dodag->dio_min), dodag->dio_interval_doubl,
@@ -238,6 +252,26 @@ static void _parent_timeout(gnrc_rpl_parent_t *parent)
     evtimer_add_msg(&gnrc_rpl_evtimer, &parent->timeout_event, gnrc_rpl_pid);
 }
 
+#ifdef MODULE_GNRC_RPL_TRICKLE_ADAPT
+static void _trickle_adapt(trickle_t *trickle)
+{
+    gnrc_rpl_dodag_t *dodag = container_of(trickle, gnrc_rpl_dodag_t, trickle);
+    /* one bit per sender hash, so the count saturates below 32 */
+    uint32_t senders = dodag->dio_senders[0] | dodag->dio_senders[1];
+    unsigned neighbors = bitarithm_bits_set(senders & 0xffff) +
+                         bitarithm_bits_set(senders >> 16);
+
+    /* forget senders that have been silent for a whole generation */
+    if (++dodag->dio_senders_age >= GNRC_RPL_TRICKLE_ADAPT_INTERVALS) {
+        dodag->dio_senders[1] = dodag->dio_senders[0];
+        dodag->dio_senders[0] = 0;
+        dodag->dio_senders_age = 0;
+    }
+    trickle_adapt(trickle, (1 << dodag->dio_min), dodag->dio_interval_doubl,
+                  dodag->dio_redun, neighbors);
+}
+#endif
+
 static void *_event_loop(void *args)
 {
     msg_t msg, reply;
@@ -285,6 +319,9 @@ static void *_event_loop(void *args)
                 DEBUG("RPL: GNRC_RPL_MSG_TYPE_TRICKLE_MSG received\n");
                 trickle = msg.content.ptr;
                 if (trickle && (trickle->callback.func != NULL)) {
+#ifdef MODULE_GNRC_RPL_TRICKLE_ADAPT
+                    _trickle_adapt(trickle);
+#endif
                     trickle_callback(trickle);
                 }
                 break;
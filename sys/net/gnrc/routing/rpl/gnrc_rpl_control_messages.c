@@ -41,6 +41,10 @@
 #include "net/gnrc/rpl/p2p.h"
 #endif
 
+#ifdef MODULE_GNRC_RPL_SR_TABLE
+#include "net/gnrc/rpl/sr_table.h"
+#endif
+
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
@@ -380,6 +384,18 @@ void gnrc_rpl_send_DIS(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination,
     gnrc_rpl_send(pkt, KERNEL_PID_UNDEF, NULL, destination, (inst? &(inst->dodag.dodag_id) : NULL));
 }
 
+#ifdef MODULE_GNRC_RPL_TRICKLE_ADAPT
+/* estimates the number of neighbors for the trickle timer of the DODAG */
+static void _record_dio_sender(gnrc_rpl_dodag_t *dodag, const ipv6_addr_t *src)
+{
+    uint32_t h = src->u32[2].u32 ^ src->u32[3].u32;
+
+    h = ((h >> 16) ^ h) * 0x45d9f3b;
+    h = (h >> 16) ^ h;
+    dodag->dio_senders[0] |= ((uint32_t)1) << (h & 0x1f);
+}
+#endif
+
 static inline uint32_t _sec_to_ms(uint32_t sec)
 {
     if (sec == UINT32_MAX) {
@@ -539,6 +555,18 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
                     break;
                 }
 
+#ifdef MODULE_GNRC_RPL_SR_TABLE
+                /* in non-storing mode, the root keeps the parent of each
+                 * target for source routing */
+                ipv6_addr_t *parent = NULL;
+                if ((inst->mop == GNRC_RPL_MOP_NON_STORING_MODE) &&
+                    (dodag->node_status == GNRC_RPL_ROOT_NODE) &&
+                    (transit->length == (GNRC_RPL_OPT_TRANSIT_INFO_LEN +
+                                         sizeof(ipv6_addr_t)))) {
+                    parent = (ipv6_addr_t *) (transit + 1);
+                }
+#endif
+
                 do {
                     DEBUG("RPL: updating FT entry %s/%d\n",
                           ipv6_addr_to_str(addr_str, &(first_target->target), sizeof(addr_str)),
@@ -550,6 +578,15 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
                                          first_target->prefix_length, src,
                                          dodag->iface,
                                          transit->path_lifetime * dodag->lifetime_unit);
+#ifdef MODULE_GNRC_RPL_SR_TABLE
+                    if (parent != NULL) {
+                        DEBUG("RPL: adding source route parent %s\n",
+                              ipv6_addr_to_str(addr_str, parent, sizeof(addr_str)));
+                        gnrc_rpl_sr_table_add(&(first_target->target), parent,
+                                              transit->path_lifetime *
+                                              dodag->lifetime_unit);
+                    }
+#endif
 
                     first_target = (gnrc_rpl_opt_target_t *) (((uint8_t *) (first_target)) +
                                    sizeof(gnrc_rpl_opt_t) + first_target->length);
@@ -709,6 +746,9 @@ void gnrc_rpl_recv_DIO(gnrc_rpl_dio_t *dio, kernel_pid_t iface, ipv6_addr_t *src
             return;
         }
 
+#ifdef MODULE_GNRC_RPL_TRICKLE_ADAPT
+        _record_dio_sender(dodag, src);
+#endif
         gnrc_rpl_delay_dao(dodag);
         trickle_start(gnrc_rpl_pid, &dodag->trickle, GNRC_RPL_MSG_TYPE_TRICKLE_MSG,
                       (1 << dodag->dio_min), dodag->dio_interval_doubl,
@@ -746,6 +786,10 @@ void gnrc_rpl_recv_DIO(gnrc_rpl_dio_t *dio, kernel_pid_t iface, ipv6_addr_t *src
     }
 #endif
 
+#ifdef MODULE_GNRC_RPL_TRICKLE_ADAPT
+    _record_dio_sender(dodag, src);
+#endif
+
     if (GNRC_RPL_COUNTER_GREATER_THAN(dio->version_number, dodag->version)) {
         if (dodag->node_status == GNRC_RPL_ROOT_NODE) {
             dodag->version = GNRC_RPL_COUNTER_INCREMENT(dio->version_number);
@@ -157,6 +157,10 @@ bool gnrc_rpl_dodag_init(gnrc_rpl_instance_t *instance, ipv6_addr_t *dodag_id, k
     dodag->iface = iface;
     dodag->dao_event.msg.content.ptr = instance;
     dodag->dao_event.msg.type = GNRC_RPL_MSG_TYPE_DODAG_DAO_TX;
+#ifdef MODULE_GNRC_RPL_TRICKLE_ADAPT
+    memset(dodag->dio_senders, 0, sizeof(dodag->dio_senders));
+    dodag->dio_senders_age = 0;
+#endif
 
     if ((netif != NULL) && !(netif->flags & GNRC_NETIF_FLAGS_IPV6_FORWARDING)) {
         gnrc_rpl_leaf_operation(dodag);
@@ -310,6 +314,13 @@ static gnrc_rpl_parent_t *_gnrc_rpl_find_preferred_parent(gnrc_rpl_dodag_t *doda
         return NULL;
     }
 
+    if (dodag->instance->of->update_parent != NULL) {
+        /* once per parent instead of once per comparison, and for all parents,
+         * as a parent whose DIOs get lost would keep an outdated metric */
+        LL_FOREACH(dodag->parents, elt) {
+            dodag->instance->of->update_parent(elt);
+        }
+    }
     LL_SORT(dodag->parents, dodag->instance->of->parent_cmp);
     new_best = dodag->parents;
 
@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_rpl_mrhof
+ * @{
+ * @file
+ * @brief       Minimum Rank with Hysteresis Objective Function
+ *
+ * Implementation of MRHOF with the ETX metric, as of RFC 6719.
+ * @}
+ */
+
+#include <string.h>
+
+#include "net/gnrc/ipv6/nib/nc.h"
+#include "net/gnrc/netif/internal.h"
+#include "net/gnrc/rpl.h"
+#include "net/gnrc/rpl/of_mrhof.h"
+#include "net/gnrc/rpl/structs.h"
+#include "net/netstats/neighbor.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+static uint16_t calc_rank(gnrc_rpl_parent_t *, uint16_t);
+static gnrc_rpl_parent_t *which_parent(gnrc_rpl_parent_t *, gnrc_rpl_parent_t *);
+static int parent_cmp(gnrc_rpl_parent_t *, gnrc_rpl_parent_t *);
+static gnrc_rpl_dodag_t *which_dodag(gnrc_rpl_dodag_t *, gnrc_rpl_dodag_t *);
+static void reset(gnrc_rpl_dodag_t *);
+static void update_parent(gnrc_rpl_parent_t *);
+
+static gnrc_rpl_of_t gnrc_rpl_mrhof = {
+    GNRC_RPL_MRHOF_OCP,
+    calc_rank,
+    which_parent,
+    parent_cmp,
+    which_dodag,
+    reset,
+    NULL,
+    NULL,
+    NULL,
+    update_parent
+};
+
+/* Preferred parent of each DODAG, for the hysteresis. Kept by address, as
+ * the parent entry may be reused once the parent is removed. */
+static struct {
+    gnrc_rpl_dodag_t *dodag;
+    ipv6_addr_t addr;
+} _preferred[GNRC_RPL_INSTANCES_NUMOF];
+
+gnrc_rpl_of_t *gnrc_rpl_get_of_mrhof(void)
+{
+    return &gnrc_rpl_mrhof;
+}
+
+/*
+ * Finds the link statistics of a neighbor by its link-local address.
+ */
+static netstats_nb_t *_get_nb(gnrc_netif_t *netif, const ipv6_addr_t *addr)
+{
+    void *state = NULL;
+    gnrc_ipv6_nib_nc_t nce;
+    uint8_t l2addr[sizeof(uint64_t)];
+
+    while (gnrc_ipv6_nib_nc_iter(netif->pid, &state, &nce)) {
+        if (ipv6_addr_equal(&nce.ipv6, addr) && (nce.l2addr_len > 0)) {
+            return netstats_nb_get(&netif->neighbors, nce.l2addr,
+                                   nce.l2addr_len);
+        }
+    }
+    /* not resolved; try the EUI-64 the interface identifier was built from */
+    memcpy(l2addr, &addr->u64[1], sizeof(l2addr));
+    l2addr[0] ^= 0x02;
+    return netstats_nb_get(&netif->neighbors, l2addr, sizeof(l2addr));
+}
+
+/*
+ * Reads the ETX of the link to a parent into the parent, so that comparing
+ * parents needs no lookup in the neighbor cache.
+ */
+void update_parent(gnrc_rpl_parent_t *parent)
+{
+    gnrc_netif_t *netif = gnrc_netif_get_by_pid(parent->dodag->iface);
+    netstats_nb_t *nb;
+
+    if (netif == NULL) {
+        return;
+    }
+    gnrc_netif_acquire(netif);
+    nb = _get_nb(netif, &parent->addr);
+    parent->link_metric = (nb != NULL) ? nb->etx : NETSTATS_NB_ETX_INIT;
+    parent->link_metric_type = GNRC_RPL_MRHOF_METRIC_ETX;
+    gnrc_netif_release(netif);
+}
+
+/*
+ * Returns the ETX of the link to a parent, as of its last update.
+ */
+static uint16_t _link_metric(gnrc_rpl_parent_t *parent)
+{
+    if (parent->link_metric_type != GNRC_RPL_MRHOF_METRIC_ETX) {
+        return NETSTATS_NB_ETX_INIT;
+    }
+    return (uint16_t)parent->link_metric;
+}
+
+/*
+ * Returns the path cost through a parent, or UINT32_MAX if the parent must
+ * not be chosen.
+ */
+static uint32_t _path_cost(gnrc_rpl_parent_t *parent)
+{
+    uint16_t link_metric = _link_metric(parent);
+    uint32_t cost = (uint32_t)parent->rank + link_metric;
+
+    if ((parent->rank == GNRC_RPL_INFINITE_RANK) ||
+        (link_metric > GNRC_RPL_MRHOF_MAX_LINK_METRIC) ||
+        (cost > GNRC_RPL_MRHOF_MAX_PATH_COST)) {
+        return UINT32_MAX;
+    }
+    return cost;
+}
+
+static bool _is_preferred(gnrc_rpl_parent_t *parent)
+{
+    for (unsigned i = 0; i < GNRC_RPL_INSTANCES_NUMOF; i++) {
+        if (_preferred[i].dodag == parent->dodag) {
+            return ipv6_addr_equal(&_preferred[i].addr, &parent->addr);
+        }
+    }
+    return false;
+}
+
+static void _set_preferred(gnrc_rpl_parent_t *parent)
+{
+    unsigned slot = 0;
+
+    for (unsigned i = 0; i < GNRC_RPL_INSTANCES_NUMOF; i++) {
+        if (_preferred[i].dodag == parent->dodag) {
+            slot = i;
+            break;
+        }
+        if (_preferred[i].dodag == NULL) {
+            slot = i;
+        }
+    }
+    _preferred[slot].dodag = parent->dodag;
+    _preferred[slot].addr = parent->addr;
+}
+
+void reset(gnrc_rpl_dodag_t *dodag)
+{
+    for (unsigned i = 0; i < GNRC_RPL_INSTANCES_NUMOF; i++) {
+        if (_preferred[i].dodag == dodag) {
+            _preferred[i].dodag = NULL;
+        }
+    }
+}
+
+uint16_t calc_rank(gnrc_rpl_parent_t *parent, uint16_t base_rank)
+{
+    uint32_t add = GNRC_RPL_DEFAULT_MIN_HOP_RANK_INCREASE;
+
+    if (base_rank == 0) {
+        if (parent == NULL) {
+            return GNRC_RPL_INFINITE_RANK;
+        }
+
+        base_rank = parent->rank;
+    }
+
+    if (parent != NULL) {
+        uint16_t link_metric = _link_metric(parent);
+
+        if (((uint32_t)parent->rank + link_metric) >
+            GNRC_RPL_MRHOF_MAX_PATH_COST) {
+            /* not even the best parent is close enough to the root */
+            return GNRC_RPL_INFINITE_RANK;
+        }
+        add = parent->dodag->instance->min_hop_rank_inc;
+        if (link_metric > add) {
+            add = link_metric;
+        }
+        _set_preferred(parent);
+    }
+
+    if ((base_rank + add) >= GNRC_RPL_INFINITE_RANK) {
+        return GNRC_RPL_INFINITE_RANK;
+    }
+
+    return base_rank + add;
+}
+
+gnrc_rpl_parent_t *which_parent(gnrc_rpl_parent_t *p1, gnrc_rpl_parent_t *p2)
+{
+    if (parent_cmp(p1, p2) > 0) {
+        return p2;
+    }
+    return p1;
+}
+
+int parent_cmp(gnrc_rpl_parent_t *parent1, gnrc_rpl_parent_t *parent2)
+{
+    uint32_t cost1 = _path_cost(parent1);
+    uint32_t cost2 = _path_cost(parent2);
+
+    /* stay with the preferred parent unless the other one is clearly better */
+    if ((cost1 != UINT32_MAX) && _is_preferred(parent1)) {
+        cost1 = (cost1 > GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD)
+              ? cost1 - GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD : 0;
+    }
+    else if ((cost2 != UINT32_MAX) && _is_preferred(parent2)) {
+        cost2 = (cost2 > GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD)
+              ? cost2 - GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD : 0;
+    }
+
+    if (cost1 < cost2) {
+        return -1;
+    }
+    else if (cost1 > cost2) {
+        return 1;
+    }
+    return 0;
+}
+
+/* Not used yet */
+gnrc_rpl_dodag_t *which_dodag(gnrc_rpl_dodag_t *d1, gnrc_rpl_dodag_t *d2)
+{
+    (void) d2;
+    return d1;
+}
@@ -0,0 +1,394 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_rpl_sr_table
+ * @{
+ *
+ * @file
+ * @brief       Source route table implementation
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "assert.h"
+#include "mutex.h"
+#include "net/gnrc/rpl/sr_table.h"
+#include "net/gnrc/rpl/srh.h"
+#include "xtimer.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/* no entry, or an unknown parent */
+#define NONE            (UINT16_MAX)
+/* the parent is the root */
+#define ROOT            (UINT16_MAX - 1)
+/* at most 15 prefix octets can be elided */
+#define COMPR_MAX       (15U)
+
+typedef struct {
+    ipv6_addr_t addr;   /* unspecified if the entry is unused */
+    uint32_t expires;   /* second the report expires, 0 if not reported */
+    uint16_t parent;    /* index of the parent, ROOT or NONE */
+    uint16_t next;      /* next entry in the bucket or the free list */
+} _entry_t;
+
+typedef struct {
+    uint32_t valid_until;   /* first expiry of a report on the route */
+    uint16_t target;        /* index of the target, NONE if unused */
+    uint16_t gen;           /* value of _gen the header was built at */
+    uint16_t next_hop;      /* index of the first hop */
+    uint8_t len;            /* length of srh */
+    uint8_t srh[GNRC_RPL_SR_TABLE_CACHE_SRH_LEN];
+} _cache_t;
+
+static mutex_t _mutex = MUTEX_INIT;
+static ipv6_addr_t _root;
+static _entry_t _entries[GNRC_RPL_SR_TABLE_SIZE];
+static uint16_t _buckets[GNRC_RPL_SR_TABLE_SIZE];
+static uint16_t _free;
+static uint16_t _free_numof;
+static _cache_t _cache[GNRC_RPL_SR_TABLE_CACHE_SIZE];
+/* counts changes of the graph, which invalidate the cache */
+static uint16_t _gen;
+
+static inline uint32_t _now(void)
+{
+    return (uint32_t)(xtimer_now_usec64() / US_PER_SEC);
+}
+
+static inline bool _is_used(uint16_t idx)
+{
+    return !ipv6_addr_is_unspecified(&_entries[idx].addr);
+}
+
+static inline bool _is_reported(uint16_t idx, uint32_t now)
+{
+    return _entries[idx].expires > now;
+}
+
+static inline uint16_t _bucket(const ipv6_addr_t *addr)
+{
+    /* the interface identifiers differ, the prefixes mostly do not */
+    uint32_t h = addr->u32[1].u32 ^ addr->u32[2].u32 ^ addr->u32[3].u32;
+
+    /* mix, so all octets reach the low bits */
+    h ^= h >> 16;
+    h *= 0x45d9f3bU;
+    h ^= h >> 16;
+    return (uint16_t)(h % GNRC_RPL_SR_TABLE_SIZE);
+}
+
+static void _clear_cache(void)
+{
+    for (unsigned i = 0; i < GNRC_RPL_SR_TABLE_CACHE_SIZE; i++) {
+        _cache[i].target = NONE;
+    }
+}
+
+static void _changed(void)
+{
+    if (++_gen == 0) {
+        /* old entries would match again */
+        _clear_cache();
+    }
+}
+
+static uint16_t _find(const ipv6_addr_t *addr)
+{
+    for (uint16_t i = _buckets[_bucket(addr)]; i != NONE;
+         i = _entries[i].next) {
+        if (ipv6_addr_equal(&_entries[i].addr, addr)) {
+            return i;
+        }
+    }
+    return NONE;
+}
+
+static uint16_t _alloc(const ipv6_addr_t *addr)
+{
+    uint16_t idx = _free;
+    uint16_t *bucket = &_buckets[_bucket(addr)];
+    _entry_t *entry = &_entries[idx];
+
+    assert(_free_numof > 0);
+    _free = entry->next;
+    _free_numof--;
+    entry->addr = *addr;
+    entry->expires = 0;
+    entry->parent = NONE;
+    entry->next = *bucket;
+    *bucket = idx;
+    return idx;
+}
+
+static void _remove(uint16_t idx)
+{
+    _entry_t *entry = &_entries[idx];
+    uint16_t *prev = &_buckets[_bucket(&entry->addr)];
+
+    while (*prev != idx) {
+        prev = &_entries[*prev].next;
+    }
+    *prev = entry->next;
+    ipv6_addr_set_unspecified(&entry->addr);
+    entry->next = _free;
+    _free = idx;
+    _free_numof++;
+}
+
+/*
+ * Removes the entries that are not reported and are no parent of a
+ * reported entry.
+ */
+static void _purge(uint32_t now)
+{
+    uint8_t referenced[(GNRC_RPL_SR_TABLE_SIZE + 7) / 8];
+    uint16_t removed = _free_numof;
+
+    memset(referenced, 0, sizeof(referenced));
+    for (uint16_t i = 0; i < GNRC_RPL_SR_TABLE_SIZE; i++) {
+        uint16_t parent = _entries[i].parent;
+
+        if (_is_used(i) && _is_reported(i, now) && (parent < ROOT)) {
+            referenced[parent / 8] |= (1U << (parent % 8));
+        }
+    }
+    for (uint16_t i = 0; i < GNRC_RPL_SR_TABLE_SIZE; i++) {
+        if (_is_used(i) && !_is_reported(i, now) &&
+            !(referenced[i / 8] & (1U << (i % 8)))) {
+            _remove(i);
+        }
+    }
+    if (removed == _free_numof) {
+        return;
+    }
+    /* entries that are not reported may still point to removed ones */
+    for (uint16_t i = 0; i < GNRC_RPL_SR_TABLE_SIZE; i++) {
+        uint16_t parent = _entries[i].parent;
+
+        if (_is_used(i) && (parent < ROOT) && !_is_used(parent)) {
+            _entries[i].parent = NONE;
+        }
+    }
+    DEBUG("gnrc_rpl_sr_table: purged %u entries\n",
+          (unsigned)(_free_numof - removed));
+    _changed();
+}
+
+static uint8_t _common_octets(const ipv6_addr_t *a, const ipv6_addr_t *b)
+{
+    uint8_t n = 0;
+
+    while ((n < COMPR_MAX) && (a->u8[n] == b->u8[n])) {
+        n++;
+    }
+    return n;
+}
+
+void gnrc_rpl_sr_table_init(const ipv6_addr_t *root)
+{
+    assert(root);
+
+    mutex_lock(&_mutex);
+    _root = *root;
+    memset(_entries, 0, sizeof(_entries));
+    for (uint16_t i = 0; i < GNRC_RPL_SR_TABLE_SIZE; i++) {
+        _entries[i].next = ((i + 1U) < GNRC_RPL_SR_TABLE_SIZE) ? i + 1 : NONE;
+        _buckets[i] = NONE;
+    }
+    _free = 0;
+    _free_numof = GNRC_RPL_SR_TABLE_SIZE;
+    _clear_cache();
+    _changed();
+    mutex_unlock(&_mutex);
+}
+
+int gnrc_rpl_sr_table_add(const ipv6_addr_t *target, const ipv6_addr_t *parent,
+                          uint32_t lifetime)
+{
+    assert(target && parent);
+
+    uint32_t now;
+    uint16_t t, p;
+    unsigned needed;
+
+    if (ipv6_addr_equal(target, &_root) || ipv6_addr_equal(target, parent)) {
+        return -EINVAL;
+    }
+    if (lifetime == 0) {
+        gnrc_rpl_sr_table_del(target);
+        return 0;
+    }
+
+    mutex_lock(&_mutex);
+    now = _now();
+    t = _find(target);
+    p = ipv6_addr_equal(parent, &_root) ? ROOT : _find(parent);
+    /* allocate both entries only after the purge, which could remove the
+     * other one */
+    needed = (t == NONE) + (p == NONE);
+    if (needed > _free_numof) {
+        _purge(now);
+        t = _find(target);
+        p = ipv6_addr_equal(parent, &_root) ? ROOT : _find(parent);
+        needed = (t == NONE) + (p == NONE);
+        if (needed > _free_numof) {
+            mutex_unlock(&_mutex);
+            DEBUG("gnrc_rpl_sr_table: table full\n");
+            return -ENOMEM;
+        }
+    }
+    if (t == NONE) {
+        t = _alloc(target);
+    }
+    if (p == NONE) {
+        /* known as parent only, until its own DAO arrives */
+        p = _alloc(parent);
+    }
+    if (_entries[t].parent != p) {
+        _entries[t].parent = p;
+        _changed();
+    }
+    _entries[t].expires = (lifetime < (UINT32_MAX - now)) ? now + lifetime
+                                                         : UINT32_MAX;
+    mutex_unlock(&_mutex);
+    return 0;
+}
+
+void gnrc_rpl_sr_table_del(const ipv6_addr_t *target)
+{
+    assert(target);
+
+    uint16_t t;
+
+    mutex_lock(&_mutex);
+    t = _find(target);
+    if ((t != NONE) && (_entries[t].expires != 0)) {
+        _entries[t].expires = 0;
+        _changed();
+    }
+    mutex_unlock(&_mutex);
+}
+
+static ssize_t _build_srh(const uint16_t *path, unsigned depth, uint8_t *buf,
+                          size_t len)
+{
+    gnrc_rpl_srh_t *srh = (gnrc_rpl_srh_t *)buf;
+    const ipv6_addr_t *first = &_entries[path[depth - 1]].addr;
+    const ipv6_addr_t *target = &_entries[path[0]].addr;
+    unsigned n = depth - 1;
+    uint8_t compri, compre, pad;
+    uint8_t *vec;
+    size_t size;
+
+    /* path[0] is the target, path[depth - 1] the first hop; the addresses
+     * in the header are the hops after the first one, target last */
+    compre = _common_octets(target, first);
+    compri = (n > 1) ? COMPR_MAX : compre;
+    for (unsigned k = 1; k < n; k++) {
+        uint8_t common = _common_octets(&_entries[path[k]].addr, first);
+
+        if (common < compri) {
+            compri = common;
+        }
+    }
+    size = ((n - 1) * (sizeof(ipv6_addr_t) - compri)) +
+           (sizeof(ipv6_addr_t) - compre);
+    pad = (8 - (size & 0x7)) & 0x7;
+    if ((sizeof(gnrc_rpl_srh_t) + size + pad) > len) {
+        return -ENOBUFS;
+    }
+
+    srh->nh = 0;
+    srh->len = (size + pad) / 8;
+    srh->type = GNRC_RPL_SRH_TYPE;
+    srh->seg_left = n;
+    srh->compr = (compri << 4) | compre;
+    srh->pad_resv = pad << 4;
+    srh->resv = 0;
+    vec = (uint8_t *)(srh + 1);
+    for (unsigned k = 0; k < n; k++) {
+        const ipv6_addr_t *addr = &_entries[path[n - 1 - k]].addr;
+        uint8_t elided = (k == (n - 1)) ? compre : compri;
+
+        memcpy(vec, &addr->u8[elided], sizeof(ipv6_addr_t) - elided);
+        vec += sizeof(ipv6_addr_t) - elided;
+    }
+    memset(vec, 0, pad);
+    return sizeof(gnrc_rpl_srh_t) + size + pad;
+}
+
+ssize_t gnrc_rpl_sr_table_get_srh(const ipv6_addr_t *target,
+                                  ipv6_addr_t *next_hop, void *buf, size_t len)
+{
+    assert(target && next_hop && buf);
+
+    uint16_t path[GNRC_RPL_SR_TABLE_MAX_DEPTH];
+    uint32_t now, valid_until = UINT32_MAX;
+    unsigned depth = 0;
+    uint16_t t, i;
+    _cache_t *cache;
+    ssize_t res;
+
+    mutex_lock(&_mutex);
+    now = _now();
+    if ((t = _find(target)) == NONE) {
+        mutex_unlock(&_mutex);
+        return -ENOENT;
+    }
+    cache = &_cache[t % GNRC_RPL_SR_TABLE_CACHE_SIZE];
+    if ((cache->target == t) && (cache->gen == _gen) &&
+        (now < cache->valid_until)) {
+        res = -ENOBUFS;
+        if (cache->len <= len) {
+            memcpy(buf, cache->srh, cache->len);
+            *next_hop = _entries[cache->next_hop].addr;
+            res = cache->len;
+        }
+        mutex_unlock(&_mutex);
+        return res;
+    }
+
+    /* follow the parents up to the root */
+    for (i = t; i != ROOT; i = _entries[i].parent) {
+        if ((i == NONE) || !_is_reported(i, now)) {
+            mutex_unlock(&_mutex);
+            return -EHOSTUNREACH;
+        }
+        if (depth == GNRC_RPL_SR_TABLE_MAX_DEPTH) {
+            mutex_unlock(&_mutex);
+            return -ELOOP;
+        }
+        path[depth++] = i;
+        if (_entries[i].expires < valid_until) {
+            valid_until = _entries[i].expires;
+        }
+    }
+
+    *next_hop = _entries[path[depth - 1]].addr;
+    if (depth == 1) {
+        mutex_unlock(&_mutex);
+        return 0;
+    }
+    res = _build_srh(path, depth, buf, len);
+    if ((res > 0) && ((size_t)res <= GNRC_RPL_SR_TABLE_CACHE_SRH_LEN)) {
+        cache->target = t;
+        cache->gen = _gen;
+        cache->next_hop = path[depth - 1];
+        cache->valid_until = valid_until;
+        cache->len = res;
+        memcpy(cache->srh, buf, res);
+    }
+    mutex_unlock(&_mutex);
+    return res;
+}
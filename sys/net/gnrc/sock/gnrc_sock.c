@@ -24,6 +24,10 @@
 #include "xtimer.h"
 
 #include "sock_types.h"
+#ifdef MODULE_GNRC_SOCK_SELECT
+#include "net/sock/select.h"
+#include "thread_flags.h"
+#endif
 #include "gnrc_sock_internal.h"
 
 #ifdef MODULE_XTIMER
@@ -43,10 +47,45 @@ static void _callback_put(void *arg)
 }
 #endif
 
+#if defined(MODULE_GNRC_SOCK_SELECT) || defined(MODULE_GNRC_SOCK_ASYNC)
+static void _netapi_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    msg_t msg = { .type = cmd, .content = { .ptr = pkt } };
+    gnrc_sock_reg_t *reg = ctx;
+
+    if (mbox_try_put(&reg->mbox, &msg) < 1) {
+        /* mbox is full, drop the packet as gnrc_netapi would do */
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+#ifdef MODULE_GNRC_SOCK_SELECT
+    thread_t *waiter = reg->waiter;
+
+    if (waiter != NULL) {
+        thread_flags_set(waiter, SOCK_SELECT_THREAD_FLAG);
+    }
+#endif
+#ifdef MODULE_GNRC_SOCK_ASYNC
+    if ((cmd == GNRC_NETAPI_MSG_TYPE_RCV) && (reg->async_cb.generic != NULL)) {
+        /* reg is the first member of every sock type */
+        reg->async_cb.generic(reg, SOCK_ASYNC_MSG_RECV, reg->async_cb_arg);
+    }
+#endif
+}
+#endif
+
 void gnrc_sock_create(gnrc_sock_reg_t *reg, gnrc_nettype_t type, uint32_t demux_ctx)
 {
     mbox_init(&reg->mbox, reg->mbox_queue, SOCK_MBOX_SIZE);
+#if defined(MODULE_GNRC_SOCK_SELECT) || defined(MODULE_GNRC_SOCK_ASYNC)
+    /* fill mbox from a callback so the waiting thread or the asynchronous
+     * callback can be notified */
+    reg->netreg_cb.cb = _netapi_cb;
+    reg->netreg_cb.ctx = reg;
+    gnrc_netreg_entry_init_cb(&reg->entry, demux_ctx, &reg->netreg_cb);
+#else
     gnrc_netreg_entry_init_mbox(&reg->entry, demux_ctx, &reg->mbox);
+#endif
     gnrc_netreg_register(type, &reg->entry);
 }
 
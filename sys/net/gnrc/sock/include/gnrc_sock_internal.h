@@ -122,6 +122,19 @@ static inline void gnrc_ep_set(sock_ip_ep_t *out, const sock_ip_ep_t *in,
  */
 void gnrc_sock_create(gnrc_sock_reg_t *reg, gnrc_nettype_t type, uint32_t demux_ctx);
 
+#if defined(MODULE_GNRC_SOCK_SELECT) || defined(DOXYGEN)
+/**
+ * @brief   Checks if a packet is waiting in the mbox of a sock
+ * @internal
+ */
+static inline bool gnrc_sock_readable(gnrc_sock_reg_t *reg)
+{
+    /* mbox of a sock that was created without local end-point is not
+     * initialized, its queue is NULL then */
+    return (reg->mbox.msg_array != NULL) && (cib_avail(&reg->mbox.cib) > 0);
+}
+#endif
+
 /**
  * @brief   Receive a packet internally
  * @internal
@@ -31,6 +31,16 @@
 #include "net/gnrc/netreg.h"
 #include "net/sock/ip.h"
 #include "net/sock/udp.h"
+#ifdef MODULE_GNRC_SOCK_TCP
+#include "net/gnrc/tcp.h"
+#include "net/sock/tcp.h"
+#endif
+#ifdef MODULE_GNRC_SOCK_SELECT
+#include "thread.h"
+#endif
+#ifdef MODULE_GNRC_SOCK_ASYNC
+#include "net/sock/async_types.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -51,6 +61,46 @@ typedef struct gnrc_sock_reg {
     gnrc_netreg_entry_t entry;          /**< @ref net_gnrc_netreg entry for mbox */
     mbox_t mbox;                        /**< @ref core_mbox target for the sock */
     msg_t mbox_queue[SOCK_MBOX_SIZE];   /**< queue for gnrc_sock_reg_t::mbox */
+#if defined(MODULE_GNRC_SOCK_SELECT) || defined(MODULE_GNRC_SOCK_ASYNC) || \
+    defined(DOXYGEN)
+    /**
+     * @brief   Callback descriptor that fills gnrc_sock_reg_t::mbox
+     *
+     * @note    Only available with module `gnrc_sock_select` or
+     *          `gnrc_sock_async`
+     */
+    gnrc_netreg_entry_cbd_t netreg_cb;
+#endif
+#if defined(MODULE_GNRC_SOCK_SELECT) || defined(DOXYGEN)
+    /**
+     * @brief   Thread to notify when a packet is put into gnrc_sock_reg_t::mbox
+     *
+     * @note    Only available with module `gnrc_sock_select`
+     */
+    thread_t *waiter;
+#endif
+#if defined(MODULE_GNRC_SOCK_ASYNC) || defined(DOXYGEN)
+    /**
+     * @brief   Asynchronous event callback
+     *
+     * @note    Only available with module `gnrc_sock_async`
+     */
+    sock_async_cb_t async_cb;
+    /**
+     * @brief   Argument for gnrc_sock_reg_t::async_cb
+     *
+     * @note    Only available with module `gnrc_sock_async`
+     */
+    void *async_cb_arg;
+#if defined(MODULE_SOCK_ASYNC_EVENT) || defined(DOXYGEN)
+    /**
+     * @brief   Asynchronous event context
+     *
+     * @note    Only available with module `sock_async_event`
+     */
+    sock_async_ctx_t async_ctx;
+#endif
+#endif
 } gnrc_sock_reg_t;
 
 /**
@@ -75,6 +125,28 @@ struct sock_udp {
     uint16_t flags;                     /**< option flags */
 };
 
+#if defined(MODULE_GNRC_SOCK_TCP) || defined(DOXYGEN)
+/**
+ * @brief   TCP sock type
+ * @internal
+ *
+ * @note    Must only contain the TCB, so an array of socks can be used as
+ *          the backlog of a @ref net_gnrc_tcp listen queue.
+ */
+struct sock_tcp {
+    gnrc_tcp_tcb_t tcb;                 /**< TCB of the connection */
+};
+
+/**
+ * @brief   TCP listening queue type
+ * @internal
+ */
+struct sock_tcp_queue {
+    gnrc_tcp_tcb_queue_t queue;         /**< queue of listening TCBs */
+    sock_tcp_ep_t local;                /**< local end-point */
+};
+#endif
+
 #ifdef __cplusplus
 }
 #endif
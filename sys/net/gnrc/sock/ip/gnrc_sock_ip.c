@@ -22,6 +22,12 @@
 #include "net/protnum.h"
 #include "net/gnrc/ipv6.h"
 #include "net/sock/ip.h"
+#ifdef MODULE_GNRC_SOCK_ASYNC
+#include "net/sock/async.h"
+#endif
+#ifdef MODULE_GNRC_SOCK_SELECT
+#include "net/sock/select.h"
+#endif
 #include "random.h"
 
 #include "gnrc_sock_internal.h"
@@ -30,6 +36,12 @@ int sock_ip_create(sock_ip_t *sock, const sock_ip_ep_t *local,
                    const sock_ip_ep_t *remote, uint8_t proto, uint16_t flags)
 {
     assert(sock);
+#ifdef MODULE_GNRC_SOCK_ASYNC
+    sock->reg.async_cb.generic = NULL;
+#endif
+#ifdef MODULE_GNRC_SOCK_SELECT
+    sock->reg.waiter = NULL;
+#endif
     if ((local != NULL) && (remote != NULL) &&
         (local->netif != SOCK_ADDR_ANY_NETIF) &&
         (remote->netif != SOCK_ADDR_ANY_NETIF) &&
@@ -193,7 +205,44 @@ ssize_t sock_ip_send(sock_ip_t *sock, const void *data, size_t len,
     if (res <= 0) {
         return res;
     }
+#ifdef MODULE_GNRC_SOCK_ASYNC
+    if ((sock != NULL) && (sock->reg.async_cb.ip != NULL)) {
+        sock->reg.async_cb.ip(sock, SOCK_ASYNC_MSG_SENT,
+                              sock->reg.async_cb_arg);
+    }
+#endif
     return res;
 }
 
+#ifdef MODULE_GNRC_SOCK_SELECT
+void sock_ip_notify(sock_ip_t *sock, thread_t *thread)
+{
+    assert(sock != NULL);
+    sock->reg.waiter = thread;
+}
+
+bool sock_ip_readable(sock_ip_t *sock)
+{
+    assert(sock != NULL);
+    return gnrc_sock_readable(&sock->reg);
+}
+#endif
+
+#ifdef MODULE_GNRC_SOCK_ASYNC
+void sock_ip_set_cb(sock_ip_t *sock, sock_ip_cb_t cb, void *arg)
+{
+    assert(sock != NULL);
+    sock->reg.async_cb.ip = cb;
+    sock->reg.async_cb_arg = arg;
+}
+
+#ifdef MODULE_SOCK_ASYNC_EVENT
+sock_async_ctx_t *sock_ip_get_async_ctx(sock_ip_t *sock)
+{
+    assert(sock != NULL);
+    return &sock->reg.async_ctx;
+}
+#endif
+#endif
+
 /** @} */
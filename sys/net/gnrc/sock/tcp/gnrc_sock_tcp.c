@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       GNRC implementation of @ref net_sock_tcp
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/af.h"
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/tcp.h"
+#include "net/sock/tcp.h"
+
+/**
+ * @brief   Maximum length of an end point address as string, including an
+ *          interface specifier
+ */
+#define EP_ADDR_STR_LEN     (IPV6_ADDR_MAX_STR_LEN + sizeof("%65535"))
+
+/**
+ * @brief   Timeout used to emulate @ref SOCK_NO_TIMEOUT
+ */
+#define LONG_TIMEOUT        (UINT32_MAX - 1)
+
+/**
+ * @brief   Converts the address of an end point into the string format
+ *          expected by @ref net_gnrc_tcp
+ */
+static char *_ep_addr_to_str(char *str, const sock_tcp_ep_t *ep)
+{
+    size_t len;
+
+    if (ipv6_addr_to_str(str, (ipv6_addr_t *)&ep->addr.ipv6,
+                         IPV6_ADDR_MAX_STR_LEN) == NULL) {
+        return NULL;
+    }
+    len = strlen(str);
+    if (ep->netif != SOCK_ADDR_ANY_NETIF) {
+        snprintf(&str[len], EP_ADDR_STR_LEN - len, "%%%u", (unsigned)ep->netif);
+    }
+    return str;
+}
+
+/**
+ * @brief   Fills an end point from the addresses stored in a TCB
+ */
+static void _tcb_to_ep(sock_tcp_ep_t *ep, const uint8_t *addr, uint16_t port,
+                       const gnrc_tcp_tcb_t *tcb)
+{
+    ep->family = AF_INET6;
+    memcpy(&ep->addr.ipv6, addr, sizeof(ep->addr.ipv6));
+    ep->netif = (tcb->ll_iface > 0) ? (uint16_t)tcb->ll_iface : SOCK_ADDR_ANY_NETIF;
+    ep->port = port;
+}
+
+int sock_tcp_connect(sock_tcp_t *sock, const sock_tcp_ep_t *remote,
+                     uint16_t local_port, uint16_t flags)
+{
+    char addr[EP_ADDR_STR_LEN];
+
+    assert(sock != NULL);
+    assert((remote != NULL) && (remote->port != 0));
+    (void)flags;
+
+    if (remote->family != AF_INET6) {
+        return -EAFNOSUPPORT;
+    }
+    if (_ep_addr_to_str(addr, remote) == NULL) {
+        return -EINVAL;
+    }
+    gnrc_tcp_tcb_init(&sock->tcb);
+    return gnrc_tcp_open_active(&sock->tcb, AF_INET6, addr, remote->port,
+                                local_port);
+}
+
+int sock_tcp_listen(sock_tcp_queue_t *queue, const sock_tcp_ep_t *local,
+                    sock_tcp_t *queue_array, unsigned queue_len,
+                    uint16_t flags)
+{
+    char addr[EP_ADDR_STR_LEN];
+    const char *local_addr = NULL;
+
+    assert(queue != NULL);
+    assert((local != NULL) && (local->port != 0));
+    assert((queue_array != NULL) && (queue_len != 0));
+    (void)flags;
+
+    if (local->family != AF_INET6) {
+        return -EAFNOSUPPORT;
+    }
+    if (!ipv6_addr_is_unspecified((ipv6_addr_t *)&local->addr.ipv6)) {
+        if ((local_addr = _ep_addr_to_str(addr, local)) == NULL) {
+            return -EINVAL;
+        }
+    }
+    gnrc_tcp_tcb_queue_init(&queue->queue);
+    memcpy(&queue->local, local, sizeof(sock_tcp_ep_t));
+    /* struct sock_tcp only wraps the TCB, so the array can be used directly */
+    return gnrc_tcp_listen(&queue->queue, (gnrc_tcp_tcb_t *)queue_array,
+                           queue_len, AF_INET6, local_addr, local->port);
+}
+
+void sock_tcp_disconnect(sock_tcp_t *sock)
+{
+    assert(sock != NULL);
+    gnrc_tcp_close(&sock->tcb);
+}
+
+void sock_tcp_stop_listen(sock_tcp_queue_t *queue)
+{
+    assert(queue != NULL);
+    gnrc_tcp_stop_listen(&queue->queue);
+}
+
+int sock_tcp_get_local(sock_tcp_t *sock, sock_tcp_ep_t *ep)
+{
+    assert((sock != NULL) && (ep != NULL));
+
+    if (sock->tcb.local_port == 0) {
+        return -EADDRNOTAVAIL;
+    }
+    _tcb_to_ep(ep, sock->tcb.local_addr, sock->tcb.local_port, &sock->tcb);
+    return 0;
+}
+
+int sock_tcp_get_remote(sock_tcp_t *sock, sock_tcp_ep_t *ep)
+{
+    assert((sock != NULL) && (ep != NULL));
+
+    if (sock->tcb.peer_port == 0) {
+        return -ENOTCONN;
+    }
+    _tcb_to_ep(ep, sock->tcb.peer_addr, sock->tcb.peer_port, &sock->tcb);
+    return 0;
+}
+
+int sock_tcp_queue_get_local(sock_tcp_queue_t *queue, sock_tcp_ep_t *ep)
+{
+    assert((queue != NULL) && (ep != NULL));
+
+    if (queue->queue.tcbs == NULL) {
+        return -EADDRNOTAVAIL;
+    }
+    memcpy(ep, &queue->local, sizeof(sock_tcp_ep_t));
+    return 0;
+}
+
+int sock_tcp_accept(sock_tcp_queue_t *queue, sock_tcp_t **sock,
+                    uint32_t timeout)
+{
+    gnrc_tcp_tcb_t *tcb = NULL;
+    int res;
+
+    assert((queue != NULL) && (sock != NULL));
+
+    do {
+        res = gnrc_tcp_accept(&queue->queue, &tcb,
+                              (timeout == SOCK_NO_TIMEOUT) ? LONG_TIMEOUT : timeout);
+    } while ((res == -ETIMEDOUT) && (timeout == SOCK_NO_TIMEOUT));
+    if (res == 0) {
+        *sock = (sock_tcp_t *)tcb;
+    }
+    return res;
+}
+
+ssize_t sock_tcp_read(sock_tcp_t *sock, void *data, size_t max_len,
+                      uint32_t timeout)
+{
+    ssize_t res;
+
+    assert((sock != NULL) && (data != NULL) && (max_len > 0));
+
+    do {
+        res = gnrc_tcp_recv(&sock->tcb, data, max_len,
+                            (timeout == SOCK_NO_TIMEOUT) ? LONG_TIMEOUT : timeout);
+    } while ((res == -ETIMEDOUT) && (timeout == SOCK_NO_TIMEOUT));
+    return res;
+}
+
+ssize_t sock_tcp_write(sock_tcp_t *sock, const void *data, size_t len)
+{
+    assert(sock != NULL);
+    assert((len == 0) || (data != NULL));
+
+    return gnrc_tcp_send(&sock->tcb, data, len, 0);
+}
+
+/** @} */
@@ -18,11 +18,18 @@
 #include <errno.h>
 
 #include "byteorder.h"
+#include "irq.h"
 #include "net/af.h"
 #include "net/protnum.h"
 #include "net/gnrc/ipv6.h"
 #include "net/gnrc/udp.h"
 #include "net/sock/udp.h"
+#ifdef MODULE_GNRC_SOCK_ASYNC
+#include "net/sock/async.h"
+#endif
+#ifdef MODULE_GNRC_SOCK_SELECT
+#include "net/sock/select.h"
+#endif
 #include "net/udp.h"
 
 #include "gnrc_sock_internal.h"
@@ -87,6 +94,12 @@ int sock_udp_create(sock_udp_t *sock, const sock_udp_ep_t *local,
                     const sock_udp_ep_t *remote, uint16_t flags)
 {
     assert(sock);
+#ifdef MODULE_GNRC_SOCK_ASYNC
+    sock->reg.async_cb.generic = NULL;
+#endif
+#ifdef MODULE_GNRC_SOCK_SELECT
+    sock->reg.waiter = NULL;
+#endif
     assert(remote == NULL || remote->port != 0);
     if ((local != NULL) && (remote != NULL) &&
         (local->netif != SOCK_ADDR_ANY_NETIF) &&
@@ -138,6 +151,10 @@ int sock_udp_create(sock_udp_t *sock, const sock_udp_ep_t *local,
         /* listen only with local given */
         gnrc_sock_create(&sock->reg, GNRC_NETTYPE_UDP, sock->local.port);
     }
+    else {
+        /* marks the mbox as not initialized for gnrc_sock_readable() */
+        sock->reg.mbox.msg_array = NULL;
+    }
     sock->flags = flags;
     return 0;
 }
@@ -174,15 +191,20 @@ int sock_udp_get_remote(sock_udp_t *sock, sock_udp_ep_t *remote)
     return 0;
 }
 
-ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
-                      uint32_t timeout, sock_udp_ep_t *remote)
+/**
+ * @brief   Receives a UDP packet and checks it against the remote of @p sock
+ *
+ * @return  0 and the received packet in @p pkt_out on success
+ * @return  negative errno on error, see sock_udp_recv()
+ */
+static int _recv(sock_udp_t *sock, gnrc_pktsnip_t **pkt_out, uint32_t timeout,
+                 sock_udp_ep_t *remote)
 {
     gnrc_pktsnip_t *pkt, *udp;
     udp_hdr_t *hdr;
     sock_ip_ep_t tmp;
     int res;
 
-    assert((sock != NULL) && (data != NULL) && (max_len > 0));
     if (sock->local.family == AF_UNSPEC) {
         return -EADDRNOTAVAIL;
     }
@@ -191,10 +213,6 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
     if (res < 0) {
         return res;
     }
-    if (pkt->size > max_len) {
-        gnrc_pktbuf_release(pkt);
-        return -ENOBUFS;
-    }
     udp = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_UDP);
     assert(udp);
     hdr = udp->data;
@@ -213,9 +231,112 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
         gnrc_pktbuf_release(pkt);
         return -EPROTO;
     }
-    memcpy(data, pkt->data, pkt->size);
+    *pkt_out = pkt;
+    return 0;
+}
+
+/**
+ * @brief   Copies the payload of @p pkt to @p data and releases @p pkt
+ */
+static ssize_t _copy_payload(gnrc_pktsnip_t *pkt, void *data, size_t max_len)
+{
+    size_t size = pkt->size;
+
+    if (size > max_len) {
+        gnrc_pktbuf_release(pkt);
+        return -ENOBUFS;
+    }
+    memcpy(data, pkt->data, size);
     gnrc_pktbuf_release(pkt);
-    return (int)pkt->size;
+    return (ssize_t)size;
+}
+
+ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
+                      uint32_t timeout, sock_udp_ep_t *remote)
+{
+    gnrc_pktsnip_t *pkt;
+    int res;
+
+    assert((sock != NULL) && (data != NULL) && (max_len > 0));
+    if ((res = _recv(sock, &pkt, timeout, remote)) < 0) {
+        return res;
+    }
+    return _copy_payload(pkt, data, max_len);
+}
+
+ssize_t sock_udp_recv_buf(sock_udp_t *sock, void **data, void **buf_ctx,
+                          uint32_t timeout, sock_udp_ep_t *remote)
+{
+    gnrc_pktsnip_t *pkt;
+    int res;
+
+    assert((sock != NULL) && (data != NULL) && (buf_ctx != NULL));
+    if (*buf_ctx != NULL) {
+        /* the payload was already handed out in one piece on the previous
+         * call, so only the packet remains to be released */
+        gnrc_pktbuf_release(*buf_ctx);
+        *buf_ctx = NULL;
+        *data = NULL;
+        return 0;
+    }
+    if ((res = _recv(sock, &pkt, timeout, remote)) < 0) {
+        return res;
+    }
+    *data = pkt->data;
+    *buf_ctx = pkt;
+    return (ssize_t)pkt->size;
+}
+
+/**
+ * @brief   Returns the payload size of the datagram waiting next in the mbox
+ *          of @p sock without taking it, 0 if there is none
+ */
+static size_t _next_payload_size(sock_udp_t *sock)
+{
+    mbox_t *mbox = &sock->reg.mbox;
+    size_t size = 0;
+    unsigned state = irq_disable();
+    int idx = cib_peek(&mbox->cib);
+
+    if ((idx >= 0) && (mbox->msg_array[idx].type == GNRC_NETAPI_MSG_TYPE_RCV)) {
+        size = ((gnrc_pktsnip_t *)mbox->msg_array[idx].content.ptr)->size;
+    }
+    irq_restore(state);
+    return size;
+}
+
+int sock_udp_recv_batch(sock_udp_t *sock, sock_udp_msg_t *msgs, unsigned num,
+                        uint32_t timeout)
+{
+    unsigned i = 0;
+
+    assert((sock != NULL) && (msgs != NULL) && (num > 0));
+    while (i < num) {
+        gnrc_pktsnip_t *pkt;
+        ssize_t res;
+
+        assert((msgs[i].data != NULL) && (msgs[i].len > 0));
+        if ((i > 0) && (_next_payload_size(sock) > msgs[i].len)) {
+            /* leave the datagram in the mbox, so the next call reports
+             * -ENOBUFS for it instead of dropping it silently */
+            break;
+        }
+        /* only wait for the first datagram, the others are just taken from
+         * the mbox if they are already there */
+        res = _recv(sock, &pkt, (i == 0) ? timeout : 0, msgs[i].remote);
+        if ((res == -EPROTO) && (i > 0)) {
+            /* dropped for its remote as sock_udp_recv() would */
+            continue;
+        }
+        if (res == 0) {
+            res = _copy_payload(pkt, msgs[i].data, msgs[i].len);
+        }
+        if (res < 0) {
+            return (i == 0) ? (int)res : (int)i;
+        }
+        msgs[i++].len = (size_t)res;
+    }
+    return (int)i;
 }
 
 ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
@@ -315,7 +436,61 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
     if (res > 0) {
         res -= sizeof(udp_hdr_t);
     }
+#ifdef MODULE_GNRC_SOCK_ASYNC
+    if ((res >= 0) && (sock != NULL) && (sock->reg.async_cb.udp != NULL)) {
+        sock->reg.async_cb.udp(sock, SOCK_ASYNC_MSG_SENT,
+                               sock->reg.async_cb_arg);
+    }
+#endif
     return res;
 }
 
+int sock_udp_send_batch(sock_udp_t *sock, const sock_udp_msg_t *msgs,
+                        unsigned num)
+{
+    unsigned i;
+
+    assert((msgs != NULL) && (num > 0));
+    for (i = 0; i < num; i++) {
+        ssize_t res = sock_udp_send(sock, msgs[i].data, msgs[i].len,
+                                    msgs[i].remote);
+
+        if (res < 0) {
+            return (i == 0) ? (int)res : (int)i;
+        }
+    }
+    return (int)i;
+}
+
+#ifdef MODULE_GNRC_SOCK_SELECT
+void sock_udp_notify(sock_udp_t *sock, thread_t *thread)
+{
+    assert(sock != NULL);
+    sock->reg.waiter = thread;
+}
+
+bool sock_udp_readable(sock_udp_t *sock)
+{
+    assert(sock != NULL);
+    return gnrc_sock_readable(&sock->reg);
+}
+#endif
+
+#ifdef MODULE_GNRC_SOCK_ASYNC
+void sock_udp_set_cb(sock_udp_t *sock, sock_udp_cb_t cb, void *arg)
+{
+    assert(sock != NULL);
+    sock->reg.async_cb.udp = cb;
+    sock->reg.async_cb_arg = arg;
+}
+
+#ifdef MODULE_SOCK_ASYNC_EVENT
+sock_async_ctx_t *sock_udp_get_async_ctx(sock_udp_t *sock)
+{
+    assert(sock != NULL);
+    return &sock->reg.async_ctx;
+}
+#endif
+#endif
+
 /** @} */
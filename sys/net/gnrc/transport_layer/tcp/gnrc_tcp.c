@@ -222,6 +222,86 @@ static int _gnrc_tcp_open(gnrc_tcp_tcb_t *tcb, char *target_addr, uint16_t targe
     return ret;
 }
 
+/**
+ * @brief Put a TCB of a listen queue (back) into LISTEN state.
+ *
+ * @param[in,out] tcb   Closed TCB, that is part of a listen queue.
+ *
+ * @returns   Zero on success.
+ */
+static int _listen(gnrc_tcp_tcb_t *tcb)
+{
+    int ret;
+
+    mutex_lock(&(tcb->function_lock));
+
+    /* Forget everything about the previous connection */
+    tcb->status &= (STATUS_PASSIVE | STATUS_ALLOW_ANY_ADDR);
+    tcb->rtt_var = RTO_UNINITIALIZED;
+    tcb->srtt = RTO_UNINITIALIZED;
+    tcb->rto = RTO_UNINITIALIZED;
+    tcb->retries = 0;
+    tcb->mss = 0;
+
+    /* Call FSM with event: CALL_OPEN, T: CLOSED -> LISTEN */
+    ret = _fsm(tcb, FSM_EVENT_CALL_OPEN, NULL, NULL, 0);
+    mutex_unlock(&(tcb->function_lock));
+    return ret;
+}
+
+/**
+ * @brief Pick an established, not yet accepted connection from a listen queue.
+ *
+ * @note Closed TCBs, that were not accepted are put back into LISTEN state.
+ *
+ * @param[in,out] queue   Listen queue to search.
+ *
+ * @returns   Pointer to the accepted TCB.
+ *            NULL if no connection was established.
+ */
+static gnrc_tcp_tcb_t *_accept(gnrc_tcp_tcb_queue_t *queue)
+{
+    for (size_t i = 0; i < queue->tcbs_len; ++i) {
+        gnrc_tcp_tcb_t *tcb = &(queue->tcbs[i]);
+        bool accepted = false;
+
+        mutex_lock(&(tcb->fsm_lock));
+        if (!(tcb->status & STATUS_ACCEPTED) &&
+            (tcb->state == FSM_STATE_ESTABLISHED || tcb->state == FSM_STATE_CLOSE_WAIT)) {
+            tcb->status |= STATUS_ACCEPTED;
+            accepted = true;
+        }
+        mutex_unlock(&(tcb->fsm_lock));
+
+        if (accepted) {
+            return tcb;
+        }
+        if (tcb->state == FSM_STATE_CLOSED && !(tcb->status & STATUS_ACCEPTED)) {
+            _listen(tcb);
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Mark a TCB as no longer used by the application.
+ *
+ * @param[in,out] tcb   TCB that was closed or aborted.
+ */
+static void _release(gnrc_tcp_tcb_t *tcb)
+{
+    mutex_lock(&(tcb->fsm_lock));
+    tcb->status &= ~STATUS_ACCEPTED;
+    mutex_unlock(&(tcb->fsm_lock));
+
+    /* Let gnrc_tcp_accept() put the TCB back into LISTEN state */
+    if (tcb->queue != NULL) {
+        msg_t msg;
+        msg.type = MSG_TYPE_NOTIFY_USER;
+        mbox_try_put(&(tcb->queue->mbox), &msg);
+    }
+}
+
 /* External GNRC TCP API */
 int gnrc_tcp_init(void)
 {
@@ -308,12 +388,187 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, uint8_t address_family,
     return _gnrc_tcp_open(tcb, NULL, 0, local_addr, local_port, 1);
 }
 
-ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
-                      const uint32_t timeout_duration_us)
+void gnrc_tcp_tcb_queue_init(gnrc_tcp_tcb_queue_t *queue)
+{
+    assert(queue != NULL);
+
+    memset(queue, 0, sizeof(gnrc_tcp_tcb_queue_t));
+    mutex_init(&(queue->lock));
+    mbox_init(&(queue->mbox), queue->mbox_raw, GNRC_TCP_TCB_MBOX_SIZE);
+}
+
+int gnrc_tcp_listen(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t *tcbs, size_t tcbs_len,
+                    uint8_t address_family, const char *local_addr, uint16_t local_port)
 {
+    assert(queue != NULL);
+    assert(tcbs != NULL);
+    assert(tcbs_len > 0);
+    assert(local_port != PORT_UNSPEC);
+
+#ifdef MODULE_GNRC_IPV6
+    ipv6_addr_t addr = IPV6_ADDR_UNSPECIFIED;
+
+    /* Check AF-Family support and parse local address if it was supplied */
+    if (local_addr != NULL) {
+        if (address_family != AF_INET6) {
+            return -EAFNOSUPPORT;
+        }
+        if (ipv6_addr_from_str(&addr, local_addr) == NULL) {
+            DEBUG("gnrc_tcp.c : gnrc_tcp_listen() : Invalid local addr\n");
+            return -EINVAL;
+        }
+    }
+#else
+    (void) address_family;
+    (void) local_addr;
+    return -EAFNOSUPPORT;
+#endif
+
+    mutex_lock(&(queue->lock));
+
+    /* Queue is already listening: Return -EISCONN */
+    if (queue->tcbs != NULL) {
+        mutex_unlock(&(queue->lock));
+        return -EISCONN;
+    }
+
+    /* Check if another connection is listening on local_port */
+    mutex_lock(&_list_tcb_lock);
+    for (gnrc_tcp_tcb_t *iter = _list_tcb_head; iter != NULL; iter = iter->next) {
+        if (iter->local_port == local_port && iter->state == FSM_STATE_LISTEN) {
+            mutex_unlock(&_list_tcb_lock);
+            mutex_unlock(&(queue->lock));
+            return -EADDRINUSE;
+        }
+    }
+    mutex_unlock(&_list_tcb_lock);
+
+    /* Setup TCBs and put them into LISTEN state */
+    for (size_t i = 0; i < tcbs_len; ++i) {
+        gnrc_tcp_tcb_t *tcb = &(tcbs[i]);
+
+        gnrc_tcp_tcb_init(tcb);
+        tcb->status |= STATUS_PASSIVE;
+        if (local_addr == NULL) {
+            tcb->status |= STATUS_ALLOW_ANY_ADDR;
+        }
+#ifdef MODULE_GNRC_IPV6
+        memcpy(tcb->local_addr, &addr, sizeof(addr));
+#endif
+        tcb->local_port = local_port;
+        tcb->queue = queue;
+        _fsm(tcb, FSM_EVENT_CALL_OPEN, NULL, NULL, 0);
+    }
+    queue->tcbs = tcbs;
+    queue->tcbs_len = tcbs_len;
+
+    mutex_unlock(&(queue->lock));
+    return 0;
+}
+
+int gnrc_tcp_accept(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t **tcb,
+                    const uint32_t user_timeout_duration_us)
+{
+    assert(queue != NULL);
     assert(tcb != NULL);
-    assert(data != NULL);
 
+    msg_t msg;
+    xtimer_t user_timeout;
+    cb_arg_t user_timeout_arg = {MSG_TYPE_USER_SPEC_TIMEOUT, &(queue->mbox)};
+    int ret = 0;
+
+    mutex_lock(&(queue->lock));
+
+    /* Queue is not listening: Return -EINVAL */
+    if (queue->tcbs == NULL) {
+        mutex_unlock(&(queue->lock));
+        return -EINVAL;
+    }
+
+    /* 'Flush' mbox */
+    while (mbox_try_get(&(queue->mbox), &msg) != 0) {
+    }
+
+    /* Setup user specified timeout if timeout_us is greater than zero */
+    if (user_timeout_duration_us > 0) {
+        _setup_timeout(&user_timeout, user_timeout_duration_us, _cb_mbox_put_msg,
+                       &user_timeout_arg);
+    }
+
+    /* Search for established connections until one was found or the timeout fired */
+    while ((*tcb = _accept(queue)) == NULL) {
+        if (user_timeout_duration_us == 0) {
+            ret = -EAGAIN;
+            break;
+        }
+
+        /* Don't block gnrc_tcp_stop_listen() and other callers while waiting */
+        mutex_unlock(&(queue->lock));
+        mbox_get(&(queue->mbox), &msg);
+        mutex_lock(&(queue->lock));
+
+        if (queue->tcbs == NULL) {
+            DEBUG("gnrc_tcp.c : gnrc_tcp_accept() : Queue stopped listening\n");
+            ret = -EINVAL;
+            break;
+        }
+        if (msg.type == MSG_TYPE_USER_SPEC_TIMEOUT) {
+            DEBUG("gnrc_tcp.c : gnrc_tcp_accept() : USER_SPEC_TIMEOUT\n");
+            ret = -ETIMEDOUT;
+            break;
+        }
+    }
+
+    /* Cleanup */
+    if (user_timeout_duration_us > 0) {
+        xtimer_remove(&user_timeout);
+    }
+    mutex_unlock(&(queue->lock));
+    return ret;
+}
+
+void gnrc_tcp_stop_listen(gnrc_tcp_tcb_queue_t *queue)
+{
+    assert(queue != NULL);
+
+    mutex_lock(&(queue->lock));
+    for (size_t i = 0; i < queue->tcbs_len; ++i) {
+        gnrc_tcp_tcb_t *tcb = &(queue->tcbs[i]);
+
+        tcb->queue = NULL;
+        if (!(tcb->status & STATUS_ACCEPTED)) {
+            gnrc_tcp_abort(tcb);
+        }
+    }
+    queue->tcbs = NULL;
+    queue->tcbs_len = 0;
+    mutex_unlock(&(queue->lock));
+
+    /* Wake up a pending gnrc_tcp_accept() */
+    msg_t msg;
+    msg.type = MSG_TYPE_NOTIFY_USER;
+    mbox_try_put(&(queue->mbox), &msg);
+}
+
+/**
+ * @brief   Transmits data or a packet to the connected peer
+ *
+ * @param[in,out] tcb                   TCB holding the connection information.
+ * @param[in]     data                  Data to transmit, if @p pkt is NULL.
+ * @param[in]     len                   Number of bytes in @p data.
+ * @param[in,out] pkt                   If not NULL, payload chain to transmit without copying.
+ *                                      Points to the untransmitted rest of the chain on return.
+ * @param[in]     timeout_duration_us   User specified timeout, zero for none.
+ *
+ * @returns   The number of successfully transmitted bytes.
+ *            -ENOTCONN if connection is not established.
+ *            -ECONNRESET if connection was resetted by the peer.
+ *            -ECONNABORTED if the connection was aborted.
+ *            -ETIMEDOUT if @p timeout_duration_us expired.
+ */
+static ssize_t _gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
+                              gnrc_pktsnip_t **pkt, const uint32_t timeout_duration_us)
+{
     msg_t msg;
     xtimer_t connection_timeout;
     cb_arg_t connection_timeout_arg = {MSG_TYPE_CONNECTION_TIMEOUT, &(tcb->mbox)};
@@ -323,6 +578,7 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
     cb_arg_t probe_timeout_arg = {MSG_TYPE_PROBE_TIMEOUT, &(tcb->mbox)};
     uint32_t probe_timeout_duration_us = 0;
     ssize_t ret = 0;
+    size_t sent = 0;
     bool probing_mode = false;
 
     /* Lock the TCB for this function call */
@@ -350,8 +606,9 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
         _setup_timeout(&user_timeout, timeout_duration_us, _cb_mbox_put_msg, &user_timeout_arg);
     }
 
-    /* Loop until something was sent and acked */
-    while (ret == 0 || tcb->pkt_retransmit != NULL) {
+    /* Loop until something was sent. Sent data stays in the retransmission */
+    /* queue, this call blocks only while the send window or the queue is full. */
+    while (ret == 0) {
         /* Check if the connections state is closed. If so, a reset was received */
         if (tcb->state == FSM_STATE_CLOSED) {
             ret = -ECONNRESET;
@@ -366,13 +623,43 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                 probe_timeout_duration_us = tcb->rto;
             }
             /* Setup probe timeout */
-            _setup_timeout(&probe_timeout, timeout_duration_us, _cb_mbox_put_msg,
+            _setup_timeout(&probe_timeout, probe_timeout_duration_us, _cb_mbox_put_msg,
                            &probe_timeout_arg);
         }
 
-        /* Try to send data in case there nothing has been sent and we are not probing */
-        if (ret == 0 && !probing_mode) {
+        /* Try to send data in case we are not probing */
+        if (!probing_mode && pkt == NULL) {
             ret = _fsm(tcb, FSM_EVENT_CALL_SEND, NULL, (void *) data, len);
+            if (ret > 0) {
+                break;
+            }
+        }
+        /* Send as much of the payload chain as possible, return once it was sent */
+        else if (!probing_mode) {
+            while (*pkt != NULL) {
+                gnrc_pktsnip_t *next = (*pkt)->next;
+                size_t size = (*pkt)->size;
+                int res = (size == 0) ? 0 : _fsm(tcb, FSM_EVENT_CALL_SEND_PKT, *pkt, NULL, 0);
+
+                /* Drop empty snips */
+                if (size == 0) {
+                    (*pkt)->next = NULL;
+                    gnrc_pktbuf_release(*pkt);
+                    *pkt = next;
+                    continue;
+                }
+                if (res <= 0) {
+                    break;
+                }
+                sent += res;
+                if ((size_t) res == size) {
+                    *pkt = next;
+                }
+            }
+            if (*pkt == NULL) {
+                ret = sent;
+                break;
+            }
         }
 
         /* Wait for responses */
@@ -386,7 +673,6 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
 
             case MSG_TYPE_USER_SPEC_TIMEOUT:
                 DEBUG("gnrc_tcp.c : gnrc_tcp_send() : USER_SPEC_TIMEOUT\n");
-                _fsm(tcb, FSM_EVENT_CLEAR_RETRANSMIT, NULL, NULL, 0);
                 ret = -ETIMEDOUT;
                 break;
 
@@ -433,12 +719,50 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
     return ret;
 }
 
-ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
+ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                       const uint32_t timeout_duration_us)
 {
     assert(tcb != NULL);
     assert(data != NULL);
 
+    return _gnrc_tcp_send(tcb, data, len, NULL, timeout_duration_us);
+}
+
+ssize_t gnrc_tcp_send_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt,
+                          const uint32_t timeout_duration_us)
+{
+    assert(tcb != NULL);
+    assert(pkt != NULL);
+
+    ssize_t ret = _gnrc_tcp_send(tcb, NULL, 0, &pkt, timeout_duration_us);
+
+    /* Release what could not be sent */
+    if (pkt != NULL) {
+        gnrc_pktbuf_release(pkt);
+    }
+    return ret;
+}
+
+/**
+ * @brief   Receives data or a packet from the connected peer
+ *
+ * @param[in,out] tcb                   TCB holding the connection information.
+ * @param[in]     event                 FSM_EVENT_CALL_RECV or FSM_EVENT_CALL_RECV_PKT.
+ * @param[out]    data                  Buffer to copy data into, or pointer to a packet
+ *                                      pointer in case of FSM_EVENT_CALL_RECV_PKT.
+ * @param[in]     max_len               Size of @p data.
+ * @param[in]     timeout_duration_us   Timeout, zero for a non-blocking call.
+ *
+ * @returns   The number of received bytes.
+ *            -ENOTCONN if connection is not established.
+ *            -EAGAIN if  timeout_duration_us is zero and no data is available.
+ *            -ECONNRESET if connection was resetted by the peer.
+ *            -ECONNABORTED if the connection was aborted.
+ *            -ETIMEDOUT if @p timeout_duration_us expired.
+ */
+static ssize_t _gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, fsm_event_t event, void *data,
+                              const size_t max_len, const uint32_t timeout_duration_us)
+{
     msg_t msg;
     xtimer_t connection_timeout;
     cb_arg_t connection_timeout_arg = {MSG_TYPE_CONNECTION_TIMEOUT, &(tcb->mbox)};
@@ -458,7 +782,7 @@ ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
 
     /* If this call is non-blocking (timeout_duration_us == 0): Try to read data and return */
     if (timeout_duration_us == 0) {
-        ret = _fsm(tcb, FSM_EVENT_CALL_RECV, NULL, data, max_len);
+        ret = _fsm(tcb, event, NULL, data, max_len);
         if (ret == 0) {
             ret = -EAGAIN;
         }
@@ -489,10 +813,10 @@ ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
         }
 
         /* Try to read available data */
-        ret = _fsm(tcb, FSM_EVENT_CALL_RECV, NULL, data, max_len);
+        ret = _fsm(tcb, event, NULL, data, max_len);
 
         /* If there was no data: Wait for next packet or until the timeout fires */
-        if (ret <= 0) {
+        if (ret == 0) {
             mbox_get(&(tcb->mbox), &msg);
             switch (msg.type) {
                 case MSG_TYPE_CONNECTION_TIMEOUT:
@@ -503,7 +827,6 @@ ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
 
                 case MSG_TYPE_USER_SPEC_TIMEOUT:
                     DEBUG("gnrc_tcp.c : gnrc_tcp_send() : USER_SPEC_TIMEOUT\n");
-                    _fsm(tcb, FSM_EVENT_CLEAR_RETRANSMIT, NULL, NULL, 0);
                     ret = -ETIMEDOUT;
                     break;
 
@@ -525,6 +848,32 @@ ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
     return ret;
 }
 
+ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
+                      const uint32_t timeout_duration_us)
+{
+    assert(tcb != NULL);
+    assert(data != NULL);
+
+    return _gnrc_tcp_recv(tcb, FSM_EVENT_CALL_RECV, data, max_len, timeout_duration_us);
+}
+
+ssize_t gnrc_tcp_recv_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **pkt,
+                          const uint32_t timeout_duration_us)
+{
+    assert(tcb != NULL);
+    assert(pkt != NULL);
+
+    return _gnrc_tcp_recv(tcb, FSM_EVENT_CALL_RECV_PKT, pkt, 0, timeout_duration_us);
+}
+
+void gnrc_tcp_recv_pkt_release(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt)
+{
+    assert(tcb != NULL);
+    assert(pkt != NULL);
+
+    _fsm(tcb, FSM_EVENT_CALL_RELEASE_PKT, pkt, NULL, 0);
+}
+
 void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb)
 {
     assert(tcb != NULL);
@@ -539,6 +888,7 @@ void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb)
     /* Return if connection is closed */
     if (tcb->state == FSM_STATE_CLOSED) {
         mutex_unlock(&(tcb->function_lock));
+        _release(tcb);
         return;
     }
 
@@ -578,6 +928,7 @@ void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb)
     xtimer_remove(&connection_timeout);
     tcb->status &= ~STATUS_WAIT_FOR_MSG;
     mutex_unlock(&(tcb->function_lock));
+    _release(tcb);
 }
 
 void gnrc_tcp_abort(gnrc_tcp_tcb_t *tcb)
@@ -591,6 +942,7 @@ void gnrc_tcp_abort(gnrc_tcp_tcb_t *tcb)
         _fsm(tcb, FSM_EVENT_CALL_ABORT, NULL, NULL, 0);
     }
     mutex_unlock(&(tcb->function_lock));
+    _release(tcb);
 }
 
 int gnrc_tcp_calc_csum(const gnrc_pktsnip_t *hdr, const gnrc_pktsnip_t *pseudo_hdr)
@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc
+ * @{
+ *
+ * @file
+ * @brief       Implementation of internal/cc.h
+ * @}
+ */
+
+#include "internal/common.h"
+#include "internal/pkt.h"
+#include "internal/cc.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/**
+ * @brief Number of duplicate acknowledgments that trigger a fast retransmit.
+ */
+#define DUP_ACK_THRESHOLD (3U)
+
+/**
+ * @brief Upper limit for the congestion window. Without window scaling the
+ *        peer can not advertise a larger window anyway.
+ */
+#define CWND_MAX          (UINT16_MAX)
+
+/**
+ * @brief Calculates the sender maximum segment size.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   Size of the largest segment sent on this connection.
+ */
+static uint32_t _smss(const gnrc_tcp_tcb_t *tcb)
+{
+    return ((tcb->mss > 0) && (tcb->mss < GNRC_TCP_MSS)) ? tcb->mss : GNRC_TCP_MSS;
+}
+
+/**
+ * @brief Reduces ssthresh after a loss was detected (RFC 5681, Equation 4).
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _reduce_ssthresh(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t half_flight = (tcb->snd_nxt - tcb->snd_una) / 2;
+
+    tcb->ssthresh = (half_flight > 2 * _smss(tcb)) ? half_flight : 2 * _smss(tcb);
+}
+
+void _cc_init(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t smss = _smss(tcb);
+
+    /* Initial window (RFC 5681, Section 3.1) */
+    if (smss > 2190) {
+        tcb->cwnd = 2 * smss;
+    }
+    else if (smss > 1095) {
+        tcb->cwnd = 3 * smss;
+    }
+    else {
+        tcb->cwnd = 4 * smss;
+    }
+    tcb->ssthresh = CWND_MAX;
+    tcb->recover = tcb->snd_una - 1;
+    tcb->dup_acks = 0;
+    tcb->status &= ~(STATUS_FAST_RECOVERY | STATUS_LOSS_RECOVERY);
+}
+
+uint32_t _cc_get_wnd(const gnrc_tcp_tcb_t *tcb)
+{
+    return (tcb->cwnd < tcb->snd_wnd) ? tcb->cwnd : tcb->snd_wnd;
+}
+
+void _cc_ack(gnrc_tcp_tcb_t *tcb, const uint32_t acked)
+{
+    uint32_t smss = _smss(tcb);
+    bool full_ack = LSS_32_BIT(tcb->recover, tcb->snd_una);
+
+    tcb->dup_acks = 0;
+
+    if (tcb->status & STATUS_FAST_RECOVERY) {
+        /* Full acknowledgment: leave fast recovery (RFC 6582, Section 3.2, Step 3) */
+        if (full_ack) {
+            uint32_t flight = tcb->snd_nxt - tcb->snd_una;
+
+            DEBUG("gnrc_tcp_cc.c : _cc_ack() : leave fast recovery\n");
+            flight = (flight > smss) ? flight : smss;
+            tcb->cwnd = (tcb->ssthresh < flight + smss) ? tcb->ssthresh : flight + smss;
+            tcb->status &= ~STATUS_FAST_RECOVERY;
+        }
+        /* Partial acknowledgment: retransmit next segment and deflate window */
+        else {
+            DEBUG("gnrc_tcp_cc.c : _cc_ack() : partial ack in fast recovery\n");
+            _pkt_fast_retransmit(tcb);
+            tcb->cwnd = (acked < tcb->cwnd) ? tcb->cwnd - acked : 0;
+            if (acked >= smss) {
+                tcb->cwnd += smss;
+            }
+            if (tcb->cwnd < smss) {
+                tcb->cwnd = smss;
+            }
+        }
+        return;
+    }
+
+    /* After a timeout, all segments sent before it are considered lost */
+    if (tcb->status & STATUS_LOSS_RECOVERY) {
+        if (full_ack) {
+            tcb->status &= ~STATUS_LOSS_RECOVERY;
+        }
+        else {
+            _pkt_fast_retransmit(tcb);
+        }
+    }
+
+    /* Slow start or congestion avoidance (RFC 5681, Section 3.1) */
+    if (tcb->cwnd < tcb->ssthresh) {
+        tcb->cwnd += (acked < smss) ? acked : smss;
+    }
+    else {
+        uint32_t inc = (smss * smss) / tcb->cwnd;
+
+        tcb->cwnd += (inc > 0) ? inc : 1;
+    }
+    if (tcb->cwnd > CWND_MAX) {
+        tcb->cwnd = CWND_MAX;
+    }
+}
+
+void _cc_dup_ack(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t smss = _smss(tcb);
+
+    /* Every further duplicate acknowledgment signals a segment that left the network */
+    if (tcb->status & STATUS_FAST_RECOVERY) {
+        tcb->cwnd = (tcb->cwnd + smss < CWND_MAX) ? tcb->cwnd + smss : CWND_MAX;
+        return;
+    }
+    if (++tcb->dup_acks != DUP_ACK_THRESHOLD) {
+        return;
+    }
+    /* Do not react to losses in data sent before the last recovery (RFC 6582, Section 3.2) */
+    if (!LSS_32_BIT(tcb->recover, tcb->snd_una)) {
+        return;
+    }
+
+    /* Fast retransmit and enter fast recovery (RFC 6582, Section 3.2, Step 2) */
+    DEBUG("gnrc_tcp_cc.c : _cc_dup_ack() : fast retransmit\n");
+    _reduce_ssthresh(tcb);
+    tcb->recover = tcb->snd_nxt - 1;
+    tcb->cwnd = tcb->ssthresh + DUP_ACK_THRESHOLD * smss;
+    tcb->status |= STATUS_FAST_RECOVERY;
+    tcb->status &= ~STATUS_LOSS_RECOVERY;
+    _pkt_fast_retransmit(tcb);
+}
+
+void _cc_timeout(gnrc_tcp_tcb_t *tcb)
+{
+    DEBUG("gnrc_tcp_cc.c : _cc_timeout()\n");
+
+    /* Reduce ssthresh only once if a segment is retransmitted multiple times */
+    if (tcb->retries == 0) {
+        _reduce_ssthresh(tcb);
+    }
+    /* Restart with the loss window (RFC 5681, Section 3.1) */
+    tcb->cwnd = _smss(tcb);
+    tcb->recover = tcb->snd_nxt - 1;
+    tcb->dup_acks = 0;
+    tcb->status &= ~STATUS_FAST_RECOVERY;
+    tcb->status |= STATUS_LOSS_RECOVERY;
+}
@@ -163,7 +163,8 @@ static int _receive(gnrc_pktsnip_t *pkt)
     }
 
     /* Validate checksum */
-    if (byteorder_ntohs(hdr->checksum) != _pkt_calc_csum(tcp, ip, pkt)) {
+    if (!(gnrc_netif_hdr_get_flag(pkt) & GNRC_NETIF_HDR_FLAGS_CSUM_VALID) &&
+        (byteorder_ntohs(hdr->checksum) != _pkt_calc_csum(tcp, ip, pkt))) {
         DEBUG("gnrc_tcp_eventloop.c : _receive() : Invalid checksum\n");
         gnrc_pktbuf_release(pkt);
         return -EINVAL;
@@ -20,6 +20,7 @@
 #include "random.h"
 #include "net/af.h"
 #include "internal/common.h"
+#include "internal/cc.h"
 #include "internal/pkt.h"
 #include "internal/option.h"
 #include "internal/rcvbuf.h"
@@ -37,6 +38,11 @@
  */
 #define TCB_EQUAL(a,b)      ((a) != (b))
 
+/**
+ * @brief Number of segments using up the receive window, that enlarge the receive buffer
+ */
+#define RCV_WND_FILLS_TO_GROW   (4U)
+
 /**
  * @brief Checks if a given port number is currently used by a TCB as local_port.
  *
@@ -80,10 +86,12 @@ static uint16_t _get_random_local_port(void)
  */
 static int _clear_retransmit(gnrc_tcp_tcb_t *tcb)
 {
-    if (tcb->pkt_retransmit != NULL) {
-        gnrc_pktbuf_release(tcb->pkt_retransmit);
+    if (tcb->retransmit_queue_len > 0) {
+        for (unsigned i = 0; i < tcb->retransmit_queue_len; i++) {
+            gnrc_pktbuf_release(tcb->retransmit_queue[i]);
+        }
         xtimer_remove(&(tcb->tim_tout));
-        tcb->pkt_retransmit = NULL;
+        tcb->retransmit_queue_len = 0;
     }
     return 0;
 }
@@ -104,6 +112,20 @@ static int _restart_timewait_timer(gnrc_tcp_tcb_t *tcb)
     return 0;
 }
 
+/**
+ * @brief Notify a thread waiting in gnrc_tcp_accept() on the TCBs listen queue.
+ *
+ * @param[in] tcb   TCB whose connection state changed.
+ */
+static void _notify_queue(gnrc_tcp_tcb_t *tcb)
+{
+    if (tcb->queue != NULL) {
+        msg_t msg;
+        msg.type = MSG_TYPE_NOTIFY_USER;
+        mbox_try_put(&(tcb->queue->mbox), &msg);
+    }
+}
+
 /**
  * @brief Transition from current FSM state into another state.
  *
@@ -131,6 +153,7 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
             /* Free potencially allocated receive buffer */
             _rcvbuf_release_buffer(tcb);
             tcb->status |= STATUS_NOTIFY_USER;
+            _notify_queue(tcb);
             break;
 
         case FSM_STATE_LISTEN:
@@ -145,10 +168,8 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
 #endif
             tcb->peer_port = PORT_UNSPEC;
 
-            /* Allocate receive buffer */
-            if (_rcvbuf_get_buffer(tcb) == -ENOMEM) {
-                return -ENOMEM;
-            }
+            /* The receive buffer is allocated on the arrival of a SYN */
+            _rcvbuf_release_buffer(tcb);
 
             /* Add connection to active connections (if not already active) */
             mutex_lock(&_list_tcb_lock);
@@ -164,6 +185,7 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
             if (_rcvbuf_get_buffer(tcb) == -ENOMEM) {
                 return -ENOMEM;
             }
+            tcb->rcv_wnd = _rcvbuf_get_free(tcb);
 
             /* Add connection to active connections (if not already active) */
             mutex_lock(&_list_tcb_lock);
@@ -189,6 +211,11 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
             break;
 
         case FSM_STATE_ESTABLISHED:
+            _cc_init(tcb);
+            tcb->status |= STATUS_NOTIFY_USER;
+            _notify_queue(tcb);
+            break;
+
         case FSM_STATE_CLOSE_WAIT:
             tcb->status |= STATUS_NOTIFY_USER;
             break;
@@ -210,7 +237,7 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
  * @param[in,out] tcb   TCB holding the connection information.
  *
  * @returns   Zero on success.
- *            -ENOMEM if receive buffer could not be allocated.
+ *            -ENOMEM if receive buffer for an active open could not be allocated.
  *            -EADDRINUSE if given local port number is already in use.
  */
 static int _fsm_call_open(gnrc_tcp_tcb_t *tcb)
@@ -218,14 +245,10 @@ static int _fsm_call_open(gnrc_tcp_tcb_t *tcb)
     int ret = 0;
 
     DEBUG("gnrc_tcp_fsm.c : _fsm_call_open()\n");
-    tcb->rcv_wnd = GNRC_TCP_DEFAULT_WINDOW;
 
     if (tcb->status & STATUS_PASSIVE) {
         /* Passive open, T: CLOSED -> LISTEN */
-        if (_transition_to(tcb, FSM_STATE_LISTEN) == -ENOMEM) {
-            _transition_to(tcb, FSM_STATE_CLOSED);
-            return -ENOMEM;
-        }
+        _transition_to(tcb, FSM_STATE_LISTEN);
     }
     else {
         /* Active Open, set TCB values, send SYN, T: CLOSED -> SYN_SENT */
@@ -253,6 +276,9 @@ static int _fsm_call_open(gnrc_tcp_tcb_t *tcb)
 /**
  * @brief FSM Handling function for sending data.
  *
+ * @note Sends as many segments as the peers window and the retransmission
+ *       queue allow, without waiting for acknowledgments in between.
+ *
  * @param[in,out] tcb   TCB holding the connection information.
  * @param[in,out] buf   Buffer containing data to send.
  * @param[in]     len   Maximum Number of Bytes to send from @p buf.
@@ -263,24 +289,121 @@ static int _fsm_call_send(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_call_send()\n");
 
-    size_t payload = (tcb->snd_una + tcb->snd_wnd) - tcb->snd_nxt;
+    size_t sent = 0;
+
+    while (sent < len && tcb->retransmit_queue_len < GNRC_TCP_RETRANSMIT_QUEUE_SIZE) {
+        uint32_t wnd_end = tcb->snd_una + _cc_get_wnd(tcb);
+
+        /* Check if window is open */
+        if (!LSS_32_BIT(tcb->snd_nxt, wnd_end)) {
+            break;
+        }
 
-    /* Check if window is open and all packets were transmitted */
-    if (payload > 0 && tcb->snd_wnd > 0 && tcb->pkt_retransmit == NULL) {
         /* Calculate segment size */
+        size_t payload = wnd_end - tcb->snd_nxt;
         payload = (payload < GNRC_TCP_MSS) ? payload : GNRC_TCP_MSS;
         payload = (payload < tcb->mss) ? payload : tcb->mss;
-        payload = (payload < len) ? payload : len;
+        payload = (payload < (len - sent)) ? payload : (len - sent);
 
-        /* Calculate payload size for this segment */
+        /* Build and send segment, stop if the pktbuf is exhausted */
         gnrc_pktsnip_t *out_pkt = NULL;
         uint16_t seq_con = 0;
-        _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK | MSK_PSH, tcb->snd_nxt, tcb->rcv_nxt, buf, payload);
+        if (_pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK | MSK_PSH, tcb->snd_nxt, tcb->rcv_nxt,
+                       (uint8_t *)buf + sent, payload) < 0) {
+            break;
+        }
         _pkt_setup_retransmit(tcb, out_pkt, false);
         _pkt_send(tcb, out_pkt, seq_con, false);
-        return payload;
+        sent += payload;
+    }
+    return sent;
+}
+
+/**
+ * @brief FSM Handling function for sending a payload snip without copying it.
+ *
+ * @note The snip is sent as a single segment if window and MSS allow it,
+ *       otherwise the first part of the snip is split off with
+ *       gnrc_pktbuf_mark(). If the whole snip is sent, @p pkt is owned by
+ *       the retransmission queue afterwards and pkt->next is cleared.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ * @param[in,out] pkt   Payload snip to send.
+ *
+ * @returns   Number of bytes sent from @p pkt.
+ */
+static int _fsm_call_send_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt)
+{
+    DEBUG("gnrc_tcp_fsm.c : _fsm_call_send_pkt()\n");
+
+    uint32_t wnd_end = tcb->snd_una + _cc_get_wnd(tcb);
+
+    /* Check if window is open and the retransmission queue has room */
+    if (!LSS_32_BIT(tcb->snd_nxt, wnd_end) ||
+        tcb->retransmit_queue_len >= GNRC_TCP_RETRANSMIT_QUEUE_SIZE) {
+        return 0;
+    }
+
+    /* Calculate segment size */
+    size_t wnd = wnd_end - tcb->snd_nxt;
+    size_t payload = (GNRC_TCP_MSS < tcb->mss) ? GNRC_TCP_MSS : tcb->mss;
+
+    /* Rather wait for the window to take the whole snip than split it */
+    if (pkt->size <= payload && pkt->size > wnd && tcb->retransmit_queue_len > 0) {
+        return 0;
+    }
+    payload = (payload < wnd) ? payload : wnd;
+    payload = (payload < pkt->size) ? payload : pkt->size;
+
+    /* Build headers, stop if the pktbuf is exhausted */
+    gnrc_pktsnip_t *out_pkt = NULL;
+    gnrc_pktsnip_t *tcp_snp = NULL;
+    uint16_t seq_con = 0;
+    if (_pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK | MSK_PSH, tcb->snd_nxt, tcb->rcv_nxt,
+                   NULL, 0) < 0) {
+        return 0;
+    }
+
+    /* Split off the segments payload, if the snip does not fit */
+    gnrc_pktsnip_t *seg = pkt;
+    if (payload < pkt->size) {
+        seg = gnrc_pktbuf_mark(pkt, payload, GNRC_NETTYPE_UNDEF);
+        if (seg == NULL) {
+            gnrc_pktbuf_release(out_pkt);
+            return 0;
+        }
+        /* gnrc_pktbuf_mark() inserted seg behind pkt: unlink it */
+        pkt->next = seg->next;
+    }
+    seg->next = NULL;
+
+    /* Append payload to the TCP header */
+    LL_SEARCH_SCALAR(out_pkt, tcp_snp, type, GNRC_NETTYPE_TCP);
+    tcp_snp->next = seg;
+    seq_con += payload;
+
+    _pkt_setup_retransmit(tcb, out_pkt, false);
+    _pkt_send(tcb, out_pkt, seq_con, false);
+    return payload;
+}
+
+/**
+ * @brief Open the receive window after received data was consumed.
+ *
+ * @param[in,out] tcb    TCB holding the connection information.
+ */
+static void _open_rcv_wnd(gnrc_tcp_tcb_t *tcb)
+{
+    /* If receive buffer can store more than GNRC_TCP_MSS: open window to available buffer size */
+    if (_rcvbuf_get_free(tcb) >= GNRC_TCP_MSS) {
+        tcb->rcv_wnd = _rcvbuf_get_free(tcb);
+
+        /* Send ACK to anounce window update */
+        gnrc_pktsnip_t *out_pkt = NULL;
+        uint16_t seq_con = 0;
+        _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt, NULL, 0);
+        _pkt_send(tcb, out_pkt, seq_con, false);
     }
-    return 0;
 }
 
 /**
@@ -296,26 +419,62 @@ static int _fsm_call_recv(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_call_recv()\n");
 
-    if (ringbuffer_empty(&tcb->rcv_buf)) {
+    if (_rcvbuf_empty(tcb)) {
         return 0;
     }
 
     /* Read data into 'buf' up to 'len' bytes from receive buffer */
-    size_t rcvd = ringbuffer_get(&(tcb->rcv_buf), buf, len);
+    size_t rcvd = _rcvbuf_get(tcb, buf, len);
 
-    /* If receive buffer can store more than GNRC_TCP_MSS: open window to available buffer size */
-    if (ringbuffer_get_free(&tcb->rcv_buf) >= GNRC_TCP_MSS) {
-        tcb->rcv_wnd = ringbuffer_get_free(&(tcb->rcv_buf));
+    _open_rcv_wnd(tcb);
+    return rcvd;
+}
 
-        /* Send ACK to anounce window update */
-        gnrc_pktsnip_t *out_pkt = NULL;
-        uint16_t seq_con = 0;
-        _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt, NULL, 0);
-        _pkt_send(tcb, out_pkt, seq_con, false);
+/**
+ * @brief FSM handling function for receiving data as packet.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ * @param[out]    pkt   Packet, starting with the received data.
+ *
+ * @returns   Number of received bytes in @p pkt.
+ *            -ENOMEM if the packet could not be allocated.
+ */
+static int _fsm_call_recv_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **pkt)
+{
+    DEBUG("gnrc_tcp_fsm.c : _fsm_call_recv_pkt()\n");
+
+    if (_rcvbuf_empty(tcb)) {
+        return 0;
+    }
+
+    int rcvd = _rcvbuf_get_pkt(tcb, pkt);
+    if (rcvd > 0) {
+        _open_rcv_wnd(tcb);
     }
     return rcvd;
 }
 
+/**
+ * @brief FSM handling function for releasing a packet returned by _fsm_call_recv_pkt().
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ * @param[in]     pkt   Packet to release.
+ *
+ * @returns   Zero on success.
+ */
+static int _fsm_call_release_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt)
+{
+    DEBUG("gnrc_tcp_fsm.c : _fsm_call_release_pkt()\n");
+
+    _rcvbuf_release_pkt(tcb, pkt);
+
+    /* Announce the freed space, if the connection still receives data */
+    if (tcb->rcv_buf_raw != NULL) {
+        _open_rcv_wnd(tcb);
+    }
+    return 0;
+}
+
 /**
  * @brief FSM handling function for starting connection teardown sequence.
  *
@@ -469,6 +628,13 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 return 0;
             }
 
+            /* Allocate receive buffer, drop SYN if the pool is exhausted */
+            if (_rcvbuf_get_buffer(tcb) == -ENOMEM) {
+                DEBUG("gnrc_tcp_fsm.c : _fsm_rcvd_pkt() : Out of receive buffers\n");
+                return 0;
+            }
+            tcb->rcv_wnd = _rcvbuf_get_free(tcb);
+
             /* SYN request is valid, fill TCB with connection information */
 #ifdef MODULE_GNRC_IPV6
             if (snp->type == GNRC_NETTYPE_IPV6 && tcb->address_family == AF_INET6) {
@@ -586,10 +752,7 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
         if (ctl & MSK_RST) {
             /* .. and state is SYN_RCVD and the connection is passive: SYN_RCVD -> LISTEN */
             if (tcb->state == FSM_STATE_SYN_RCVD && (tcb->status & STATUS_PASSIVE)) {
-                if (_transition_to(tcb, FSM_STATE_LISTEN) == -ENOMEM) {
-                    _transition_to(tcb, FSM_STATE_CLOSED);
-                    return -ENOMEM;
-                }
+                _transition_to(tcb, FSM_STATE_LISTEN);
             }
             else {
                 _transition_to(tcb, FSM_STATE_CLOSED);
@@ -627,8 +790,20 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 tcb->state == FSM_STATE_CLOSING || tcb->state == FSM_STATE_LAST_ACK) {
                 /* Acknowledge previously sent data */
                 if (LSS_32_BIT(tcb->snd_una, seg_ack) && LEQ_32_BIT(seg_ack, tcb->snd_nxt)) {
+                    uint32_t acked = seg_ack - tcb->snd_una;
+
                     tcb->snd_una = seg_ack;
                     _pkt_acknowledge(tcb, seg_ack);
+                    _cc_ack(tcb, acked);
+
+                    /* Signal user: the send window advanced */
+                    tcb->status |= STATUS_NOTIFY_USER;
+                }
+                /* Duplicate ACK (RFC 5681, Section 2): Signal user, window might be inflated */
+                else if (seg_ack == tcb->snd_una && pay_len == 0 && seg_wnd == tcb->snd_wnd &&
+                         !(ctl & (MSK_SYN | MSK_FIN)) && tcb->retransmit_queue_len > 0) {
+                    _cc_dup_ack(tcb);
+                    tcb->status |= STATUS_NOTIFY_USER;
                 }
                 /* ACK received for something not yet sent: Reply with pure ACK */
                 else if (LSS_32_BIT(tcb->snd_nxt, seg_ack)) {
@@ -652,25 +827,25 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 /* Additional processing */
                 /* Check additionaly if previously sent FIN was acknowledged */
                 if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->retransmit_queue_len == 0) {
                         _transition_to(tcb, FSM_STATE_FIN_WAIT_2);
                     }
                 }
                 /* If retransmission queue is empty, acknowledge close operation */
                 if (tcb->state == FSM_STATE_FIN_WAIT_2) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->retransmit_queue_len == 0) {
                         /* Optional: Unblock user close operation */
                     }
                 }
                 /* If our FIN has been acknowledged: Transition to TIME_WAIT */
                 if (tcb->state == FSM_STATE_CLOSING) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->retransmit_queue_len == 0) {
                         _transition_to(tcb, FSM_STATE_TIME_WAIT);
                     }
                 }
                 /* If our FIN was acknowledged and status is LAST_ACK: close connection */
                 if (tcb->state == FSM_STATE_LAST_ACK) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->retransmit_queue_len == 0) {
                         _transition_to(tcb, FSM_STATE_CLOSED);
                         return 0;
                     }
@@ -690,13 +865,18 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
 
                 /* Accept only data that is expected, to be received */
                 if (tcb->rcv_nxt == seg_seq) {
-                    /* Copy contents into receive buffer */
-                    while (snp && snp->type == GNRC_NETTYPE_UNDEF) {
-                        tcb->rcv_nxt += ringbuffer_add(&(tcb->rcv_buf), snp->data, snp->size);
-                        snp = snp->next;
+                    /* Store payload in receive buffer */
+                    uint32_t added = _rcvbuf_add(tcb, snp);
+                    tcb->rcv_nxt += added;
+                    /* Autotune receive window: Enlarge the buffer, if the peer keeps
+                     * sending as much as the announced window allows */
+                    if ((added + GNRC_TCP_MSS > tcb->rcv_wnd) &&
+                        (++tcb->rcv_wnd_fills >= RCV_WND_FILLS_TO_GROW)) {
+                        tcb->rcv_wnd_fills = 0;
+                        _rcvbuf_grow_buffer(tcb);
                     }
                     /* Shrink receive window */
-                    tcb->rcv_wnd = ringbuffer_get_free(&(tcb->rcv_buf));
+                    tcb->rcv_wnd = _rcvbuf_get_free(tcb);
                     /* Notify owner because new data is available */
                     tcb->status |= STATUS_NOTIFY_USER;
                 }
@@ -724,7 +904,7 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 _transition_to(tcb, FSM_STATE_CLOSE_WAIT);
             }
             else if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                if (tcb->pkt_retransmit == NULL) {
+                if (tcb->retransmit_queue_len == 0) {
                     _transition_to(tcb, FSM_STATE_TIME_WAIT);
                 }
                 else {
@@ -766,9 +946,10 @@ static int _fsm_timeout_timewait(gnrc_tcp_tcb_t *tcb)
 static int _fsm_timeout_retransmit(gnrc_tcp_tcb_t *tcb)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_retransmit()\n");
-    if (tcb->pkt_retransmit != NULL) {
-        _pkt_setup_retransmit(tcb, tcb->pkt_retransmit, true);
-        _pkt_send(tcb, tcb->pkt_retransmit, 0, true);
+    if (tcb->retransmit_queue_len > 0) {
+        _cc_timeout(tcb);
+        _pkt_setup_retransmit(tcb, tcb->retransmit_queue[0], true);
+        _pkt_send(tcb, tcb->retransmit_queue[0], 0, true);
     }
     else {
         DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_retransmit() : Retransmit queue is empty\n");
@@ -829,7 +1010,8 @@ static int _fsm_clear_retransmit(gnrc_tcp_tcb_t *tcb)
  *
  * @param[in,out] tcb     TCB holding the connection information.
  * @param[in]     event   Current event that triggers fsm translation.
- * @param[in]     in_pkt  Packet that triggered fsm event. Only in case of RCVD_PKT.
+ * @param[in]     in_pkt  Packet that triggered fsm event. Only in case of RCVD_PKT,
+ *                        CALL_SEND_PKT and CALL_RELEASE_PKT.
  * @param[in,out] buf     Buffer for send and receive functions.
  * @param[in]     len     Number of bytes to send or receive in @p buf.
  *
@@ -851,9 +1033,18 @@ static int _fsm_unprotected(gnrc_tcp_tcb_t *tcb, fsm_event_t event, gnrc_pktsnip
         case FSM_EVENT_CALL_SEND :
             ret = _fsm_call_send(tcb, buf, len);
             break;
+        case FSM_EVENT_CALL_SEND_PKT :
+            ret = _fsm_call_send_pkt(tcb, in_pkt);
+            break;
         case FSM_EVENT_CALL_RECV :
             ret = _fsm_call_recv(tcb, buf, len);
             break;
+        case FSM_EVENT_CALL_RECV_PKT :
+            ret = _fsm_call_recv_pkt(tcb, (gnrc_pktsnip_t **) buf);
+            break;
+        case FSM_EVENT_CALL_RELEASE_PKT :
+            ret = _fsm_call_release_pkt(tcb, in_pkt);
+            break;
         case FSM_EVENT_CALL_CLOSE :
             ret = _fsm_call_close(tcb);
             break;
@@ -46,6 +46,43 @@ static inline uint32_t _max(const uint32_t x, const uint32_t y)
   return (x > y) ? x : y;
 }
 
+/**
+ * @brief Calculates the RTO from the current round trip time estimates.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _calc_rto(gnrc_tcp_tcb_t *tcb)
+{
+    /* If there is no measurement yet: rto is 1 sec (Lower Bound) */
+    if (tcb->srtt == RTO_UNINITIALIZED || tcb->rtt_var == RTO_UNINITIALIZED) {
+        tcb->rto = GNRC_TCP_RTO_LOWER_BOUND;
+    }
+    else {
+        tcb->rto = tcb->srtt + _max(GNRC_TCP_RTO_GRANULARITY,  GNRC_TCP_RTO_K * tcb->rtt_var);
+    }
+}
+
+/**
+ * @brief Starts the retransmission timer for the oldest unacknowledged segment.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _set_retransmit_timer(gnrc_tcp_tcb_t *tcb)
+{
+    /* Perform boundry checks on current RTO before usage */
+    if (tcb->rto < (int32_t) GNRC_TCP_RTO_LOWER_BOUND) {
+        tcb->rto = GNRC_TCP_RTO_LOWER_BOUND;
+    }
+    else if (tcb->rto > (int32_t) GNRC_TCP_RTO_UPPER_BOUND) {
+        tcb->rto = GNRC_TCP_RTO_UPPER_BOUND;
+    }
+
+    /* Setup retransmission timer, msg to TCP thread with ptr to TCB */
+    tcb->msg_tout.type = MSG_TYPE_RETRANSMISSION;
+    tcb->msg_tout.content.ptr = (void *) tcb;
+    xtimer_set_msg(&tcb->tim_tout, tcb->rto, &tcb->msg_tout, gnrc_tcp_pid);
+}
+
 int _pkt_build_reset_from_pkt(gnrc_pktsnip_t **out_pkt, gnrc_pktsnip_t *in_pkt)
 {
     tcp_hdr_t tcp_hdr_out;
@@ -260,13 +297,19 @@ int _pkt_send(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *out_pkt, const uint16_t seq_c
         return -EINVAL;
     }
 
-    /* If this is no retransmission, advance sequence number and measure time */
+    /* If this is no retransmission, advance sequence number. */
+    /* Time one segment per round trip, if no measurement is in progress. */
     if (!retransmit) {
-        tcb->retries = 0;
+        if (seq_con > 0 && !(tcb->status & STATUS_RTT_MEASURE)) {
+            tcb->status |= STATUS_RTT_MEASURE;
+            tcb->rtt_start = xtimer_now().ticks32;
+            tcb->rtt_seq = tcb->snd_nxt + seq_con;
+        }
         tcb->snd_nxt += seq_con;
-        tcb->rtt_start = xtimer_now().ticks32;
     }
+    /* A retransmission invalidates the running measurement (Karns Algorithm) */
     else {
+        tcb->status &= ~STATUS_RTT_MEASURE;
         tcb->retries += 1;
     }
 
@@ -351,12 +394,6 @@ int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool r
         return -EINVAL;
     }
 
-    /* Check if retransmit queue is full and pkt is not already in retransmit queue */
-    if (tcb->pkt_retransmit != NULL && tcb->pkt_retransmit != pkt) {
-        DEBUG("gnrc_tcp_pkt.c : _pkt_setup_retransmit() : Nothing to do\n");
-        return -ENOMEM;
-    }
-
     /* Extract control bits and segment length */
     LL_SEARCH_SCALAR(pkt, snp, type, GNRC_NETTYPE_TCP);
     ctl = byteorder_ntohs(((tcp_hdr_t *) snp->data)->off_ctl);
@@ -367,19 +404,31 @@ int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool r
         return 0;
     }
 
-    /* Assign pkt and increase users: every send attempt consumes a user */
-    tcb->pkt_retransmit = pkt;
+    if (!retransmit) {
+        /* Check if retransmit queue is full */
+        if (tcb->retransmit_queue_len >=
+            (sizeof(tcb->retransmit_queue) / sizeof(tcb->retransmit_queue[0]))) {
+            DEBUG("gnrc_tcp_pkt.c : _pkt_setup_retransmit() : Retransmit queue is full\n");
+            return -ENOMEM;
+        }
+        tcb->retransmit_queue[tcb->retransmit_queue_len++] = pkt;
+    }
+    /* Only the oldest segment is retransmitted */
+    else if (tcb->retransmit_queue_len == 0 || tcb->retransmit_queue[0] != pkt) {
+        DEBUG("gnrc_tcp_pkt.c : _pkt_setup_retransmit() : pkt is not the oldest segment\n");
+        return -EINVAL;
+    }
+
+    /* Increase users: every send attempt consumes a user */
     gnrc_pktbuf_hold(pkt, 1);
 
     /* RTO adjustment */
     if (!retransmit) {
-        /* If this is the first transmission: rto is 1 sec (Lower Bound) */
-        if (tcb->srtt == RTO_UNINITIALIZED || tcb->rtt_var == RTO_UNINITIALIZED) {
-            tcb->rto = GNRC_TCP_RTO_LOWER_BOUND;
-        }
-        else {
-            tcb->rto = tcb->srtt + _max(GNRC_TCP_RTO_GRANULARITY,  GNRC_TCP_RTO_K * tcb->rtt_var);
+        /* The timer is already running for an older segment */
+        if (tcb->retransmit_queue_len > 1) {
+            return 0;
         }
+        _calc_rto(tcb);
     }
     else {
         /* If this is a retransmission: Double the rto (Timer Backoff) */
@@ -392,51 +441,70 @@ int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool r
             tcb->rtt_var = RTO_UNINITIALIZED;
         }
     }
+    _set_retransmit_timer(tcb);
+    return 0;
+}
 
-    /* Perform boundry checks on current RTO before usage */
-    if (tcb->rto < (int32_t) GNRC_TCP_RTO_LOWER_BOUND) {
-        tcb->rto = GNRC_TCP_RTO_LOWER_BOUND;
-    }
-    else if (tcb->rto > (int32_t) GNRC_TCP_RTO_UPPER_BOUND) {
-        tcb->rto = GNRC_TCP_RTO_UPPER_BOUND;
+int _pkt_fast_retransmit(gnrc_tcp_tcb_t *tcb)
+{
+    if (tcb->retransmit_queue_len == 0) {
+        DEBUG("gnrc_tcp_pkt.c : _pkt_fast_retransmit() : Retransmit queue is empty\n");
+        return -ENODATA;
     }
 
-    /* Setup retransmission timer, msg to TCP thread with ptr to TCB */
-    tcb->msg_tout.type = MSG_TYPE_RETRANSMISSION;
-    tcb->msg_tout.content.ptr = (void *) tcb;
-    xtimer_set_msg(&tcb->tim_tout, tcb->rto, &tcb->msg_tout, gnrc_tcp_pid);
+    /* Karns Algorithm: The running measurement became ambiguous */
+    tcb->status &= ~STATUS_RTT_MEASURE;
+
+    /* Every send attempt consumes a user */
+    gnrc_pktbuf_hold(tcb->retransmit_queue[0], 1);
+    if (gnrc_netapi_send(gnrc_tcp_pid, tcb->retransmit_queue[0]) < 1) {
+        DEBUG("gnrc_tcp_pkt.c : _pkt_fast_retransmit() : Nobody took the segment\n");
+        gnrc_pktbuf_release(tcb->retransmit_queue[0]);
+        return -EAGAIN;
+    }
     return 0;
 }
 
 int _pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack)
 {
-    uint32_t seg = 0;
-    gnrc_pktsnip_t *snp = NULL;
-    tcp_hdr_t *hdr;
+    uint8_t acked = 0;
 
     /* Retransmission queue is empty. Nothing to ACK there */
-    if (tcb->pkt_retransmit == NULL) {
+    if (tcb->retransmit_queue_len == 0) {
         DEBUG("gnrc_tcp_pkt.c : _pkt_acknowledge() : There is no packet to ack\n");
         return -ENODATA;
     }
 
-    LL_SEARCH_SCALAR(tcb->pkt_retransmit, snp, type, GNRC_NETTYPE_TCP);
-    hdr = (tcp_hdr_t *) snp->data;
+    /* Release all segments covered by the cumulative acknowledgment */
+    while (acked < tcb->retransmit_queue_len) {
+        gnrc_pktsnip_t *pkt = tcb->retransmit_queue[acked];
+        gnrc_pktsnip_t *snp = NULL;
 
-    /* There must be a packet, waiting to be acknowledged. */
-    seg = byteorder_ntohl(hdr->seq_num) + _pkt_get_seg_len(tcb->pkt_retransmit) - 1;
-
-    /* If segment can be acknowledged -> stop timer, release packet from pktbuf and update rto. */
-    if (LSS_32_BIT(seg, ack)) {
-        xtimer_remove(&(tcb->tim_tout));
-        gnrc_pktbuf_release(tcb->pkt_retransmit);
-        tcb->pkt_retransmit = NULL;
+        LL_SEARCH_SCALAR(pkt, snp, type, GNRC_NETTYPE_TCP);
+        uint32_t seg = byteorder_ntohl(((tcp_hdr_t *) snp->data)->seq_num) +
+                       _pkt_get_seg_len(pkt) - 1;
+        if (!LSS_32_BIT(seg, ack)) {
+            break;
+        }
+        gnrc_pktbuf_release(pkt);
+        acked++;
+    }
+    if (acked == 0) {
+        return 0;
+    }
+    tcb->retransmit_queue_len -= acked;
+    memmove(tcb->retransmit_queue, &tcb->retransmit_queue[acked],
+            tcb->retransmit_queue_len * sizeof(tcb->retransmit_queue[0]));
+    tcb->retries = 0;
 
-        /* Measure round trip time */
+    /* Measure round trip time, if the timed segment was acknowledged */
+    if ((tcb->status & STATUS_RTT_MEASURE) && LEQ_32_BIT(tcb->rtt_seq, ack)) {
         int32_t rtt = xtimer_now().ticks32 - tcb->rtt_start;
 
-        /* Use time only if ther was no timer overflow and no retransmission (Karns Alogrithm) */
-        if (tcb->retries == 0 && rtt > 0) {
+        tcb->status &= ~STATUS_RTT_MEASURE;
+
+        /* Use time only if there was no timer overflow */
+        if (rtt > 0) {
             /* If this is the first sample taken */
             if (tcb->srtt == RTO_UNINITIALIZED && tcb->rtt_var == RTO_UNINITIALIZED) {
                 tcb->srtt = rtt;
@@ -451,6 +519,15 @@ int _pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack)
             }
         }
     }
+
+    /* Restart timer for the remaining segments or stop it (RFC 6298, Section 5) */
+    _calc_rto(tcb);
+    if (tcb->retransmit_queue_len > 0) {
+        _set_retransmit_timer(tcb);
+    }
+    else {
+        xtimer_remove(&(tcb->tim_tout));
+    }
     return 0;
 }
 
@@ -16,6 +16,8 @@
  * @author      Simon Brummer <simon.brummer@posteo.de>
  */
 #include <errno.h>
+#include <string.h>
+#include "net/gnrc/pktbuf.h"
 #include "internal/rcvbuf.h"
 
 #define ENABLE_DEBUG (0)
@@ -33,26 +35,32 @@ void _rcvbuf_init(void)
 {
     DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_init() : entry\n");
     mutex_init(&(_static_buf.lock));
-    for (size_t i = 0; i < GNRC_TCP_RCV_BUFFERS; ++i) {
-        _static_buf.entries[i].used = 0;
-    }
+    memset(_static_buf.used, 0, sizeof(_static_buf.used));
 }
 
 /**
- * @brief Allocate receive buffer.
+ * @brief Allocate contiguous blocks from the receive buffer pool.
+ *
+ * @param[in] num   Number of blocks to allocate.
  *
- * @returns   Not NULL if a receive buffer was allocated.
+ * @returns   Not NULL if the blocks were allocated.
  *            NULL if allocation failed.
  */
-static void* _rcvbuf_alloc(void)
+static void* _rcvbuf_alloc(const unsigned num)
 {
     void *result = NULL;
+    unsigned free = 0;
+
     DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_alloc() : Entry\n");
     mutex_lock(&(_static_buf.lock));
-    for (size_t i = 0; i < GNRC_TCP_RCV_BUFFERS; ++i) {
-        if (_static_buf.entries[i].used == 0) {
-            _static_buf.entries[i].used = 1;
-            result = (void *)(_static_buf.entries[i].buffer);
+    for (unsigned i = 0; i < RCVBUF_BLOCKS; ++i) {
+        free = bf_isset(_static_buf.used, i) ? 0 : free + 1;
+        if (free == num) {
+            /* First fit: mark blocks as used */
+            for (unsigned j = i + 1 - num; j <= i; ++j) {
+                bf_set(_static_buf.used, j);
+            }
+            result = (void *)(_static_buf.blocks[i + 1 - num]);
             break;
         }
     }
@@ -61,18 +69,19 @@ static void* _rcvbuf_alloc(void)
 }
 
 /**
- * @brief Release allocated receive buffer.
+ * @brief Release allocated receive buffer blocks.
  *
  * @param[in] buf   Pointer to buffer that should be released.
+ * @param[in] size  Size of @p buf in bytes.
  */
-static void _rcvbuf_free(void * const buf)
+static void _rcvbuf_free(void * const buf, const unsigned size)
 {
+    unsigned first = ((uint8_t *)buf - _static_buf.blocks[0]) / GNRC_TCP_RCV_BUF_BLOCK_SIZE;
+
     DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_free() : Entry\n");
     mutex_lock(&(_static_buf.lock));
-    for (size_t i = 0; i < GNRC_TCP_RCV_BUFFERS; ++i) {
-        if ((_static_buf.entries[i].used == 1) && (buf == _static_buf.entries[i].buffer)) {
-            _static_buf.entries[i].used = 0;
-        }
+    for (unsigned i = first; i < first + (size / GNRC_TCP_RCV_BUF_BLOCK_SIZE); ++i) {
+        bf_unset(_static_buf.used, i);
     }
     mutex_unlock(&(_static_buf.lock));
 }
@@ -80,22 +89,211 @@ static void _rcvbuf_free(void * const buf)
 int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb)
 {
     if (tcb->rcv_buf_raw == NULL) {
-        tcb->rcv_buf_raw = _rcvbuf_alloc();
+        tcb->rcv_buf_raw = _rcvbuf_alloc(RCVBUF_BLOCKS_INIT);
         if (tcb->rcv_buf_raw == NULL) {
             DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_get_buffer() : Can't allocate rcv_buf_raw\n");
             return -ENOMEM;
         }
         else {
-            ringbuffer_init(&tcb->rcv_buf, (char *) tcb->rcv_buf_raw, GNRC_TCP_RCV_BUF_SIZE);
+            ringbuffer_init(&tcb->rcv_buf, (char *) tcb->rcv_buf_raw,
+                            RCVBUF_BLOCKS_INIT * GNRC_TCP_RCV_BUF_BLOCK_SIZE);
+            tcb->rcv_wnd_fills = 0;
+        }
+    }
+    return 0;
+}
+
+int _rcvbuf_grow_buffer(gnrc_tcp_tcb_t *tcb)
+{
+    unsigned num = tcb->rcv_buf.size / GNRC_TCP_RCV_BUF_BLOCK_SIZE;
+    uint8_t *buf = NULL;
+
+    if (tcb->rcv_buf_raw == NULL || num >= RCVBUF_BLOCKS_MAX) {
+        return -ENOMEM;
+    }
+
+    /* Try to double the buffer size, settle for less if the pool is short */
+    for (unsigned grow = (2 * num < RCVBUF_BLOCKS_MAX) ? 2 * num : RCVBUF_BLOCKS_MAX;
+         grow > num; --grow) {
+        if ((buf = _rcvbuf_alloc(grow)) != NULL) {
+            num = grow;
+            break;
         }
     }
+    if (buf == NULL) {
+        DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_grow_buffer() : Pool exhausted\n");
+        return -ENOMEM;
+    }
+    DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_grow_buffer() : Grow to %u blocks\n", num);
+
+    /* Move contents into the new buffer, oldest byte first */
+    unsigned avail = ringbuffer_get(&tcb->rcv_buf, (char *) buf, tcb->rcv_buf.avail);
+    _rcvbuf_free(tcb->rcv_buf_raw, tcb->rcv_buf.size);
+    tcb->rcv_buf_raw = buf;
+    ringbuffer_init(&tcb->rcv_buf, (char *) buf, num * GNRC_TCP_RCV_BUF_BLOCK_SIZE);
+    tcb->rcv_buf.avail = avail;
     return 0;
 }
 
+#if GNRC_TCP_RCV_QUEUE_SIZE > 0
+/**
+ * @brief Remove the oldest segment from the receive queue.
+ *
+ * @param[in,out] tcb   TCB holding the receive queue.
+ *
+ * @returns   The removed segment.
+ */
+static gnrc_pktsnip_t *_rcvbuf_dequeue(gnrc_tcp_tcb_t *tcb)
+{
+    gnrc_pktsnip_t *pkt = tcb->rcv_queue[0];
+
+    tcb->rcv_queue_len -= 1;
+    memmove(&tcb->rcv_queue[0], &tcb->rcv_queue[1],
+            tcb->rcv_queue_len * sizeof(gnrc_pktsnip_t *));
+    tcb->rcv_queue_off = 0;
+    return pkt;
+}
+
+/**
+ * @brief Account for payload of a segment, that is no longer held.
+ *
+ * @param[in,out] tcb    TCB the segment was received on.
+ * @param[in]     size   Payload size of the segment.
+ */
+static void _rcvbuf_unhold(gnrc_tcp_tcb_t *tcb, size_t size)
+{
+    tcb->rcv_pkt_bytes = (tcb->rcv_pkt_bytes > size) ? tcb->rcv_pkt_bytes - size : 0;
+}
+#endif
+
 void _rcvbuf_release_buffer(gnrc_tcp_tcb_t *tcb)
 {
     if (tcb->rcv_buf_raw != NULL) {
-        _rcvbuf_free(tcb->rcv_buf_raw);
+        _rcvbuf_free(tcb->rcv_buf_raw, tcb->rcv_buf.size);
         tcb->rcv_buf_raw = NULL;
     }
+#if GNRC_TCP_RCV_QUEUE_SIZE > 0
+    while (tcb->rcv_queue_len > 0) {
+        gnrc_pktbuf_release(_rcvbuf_dequeue(tcb));
+    }
+    tcb->rcv_pkt_bytes = 0;
+#endif
+}
+
+size_t _rcvbuf_add(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt)
+{
+    size_t added = 0;
+
+#if GNRC_TCP_RCV_QUEUE_SIZE > 0
+    /* Queue single payload snips, as long as no older data is copied into the
+     * receive buffer. The receive buffer keeps room for the queued payload. */
+    if ((pkt->next == NULL || pkt->next->type != GNRC_NETTYPE_UNDEF) &&
+        (tcb->rcv_queue_len < GNRC_TCP_RCV_QUEUE_SIZE) && ringbuffer_empty(&tcb->rcv_buf) &&
+        (pkt->size <= _rcvbuf_get_free(tcb))) {
+        gnrc_pktbuf_hold(pkt, 1);
+        tcb->rcv_queue[tcb->rcv_queue_len++] = pkt;
+        tcb->rcv_pkt_bytes += pkt->size;
+        return pkt->size;
+    }
+#endif
+    while (pkt && pkt->type == GNRC_NETTYPE_UNDEF) {
+        added += ringbuffer_add(&(tcb->rcv_buf), pkt->data, pkt->size);
+        pkt = pkt->next;
+    }
+    return added;
+}
+
+size_t _rcvbuf_get(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
+{
+    size_t rcvd = 0;
+
+#if GNRC_TCP_RCV_QUEUE_SIZE > 0
+    /* Queued segments are older than the contents of the receive buffer */
+    while (tcb->rcv_queue_len > 0 && rcvd < len) {
+        gnrc_pktsnip_t *pkt = tcb->rcv_queue[0];
+        size_t num = pkt->size - tcb->rcv_queue_off;
+
+        num = (num < (len - rcvd)) ? num : (len - rcvd);
+        memcpy((uint8_t *)buf + rcvd, (uint8_t *)pkt->data + tcb->rcv_queue_off, num);
+        rcvd += num;
+        tcb->rcv_queue_off += num;
+        if (tcb->rcv_queue_off == pkt->size) {
+            _rcvbuf_unhold(tcb, pkt->size);
+            gnrc_pktbuf_release(_rcvbuf_dequeue(tcb));
+        }
+    }
+#endif
+    rcvd += ringbuffer_get(&(tcb->rcv_buf), (char *)buf + rcvd, len - rcvd);
+    return rcvd;
+}
+
+int _rcvbuf_get_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **pkt)
+{
+    size_t size;
+
+#if GNRC_TCP_RCV_QUEUE_SIZE > 0
+    if (tcb->rcv_queue_len > 0) {
+        gnrc_pktsnip_t *head = tcb->rcv_queue[0];
+
+        /* Hand out the segment, its payload is accounted until it is released */
+        if (tcb->rcv_queue_off == 0) {
+            *pkt = _rcvbuf_dequeue(tcb);
+            return head->size;
+        }
+
+        /* Segment was partially read by _rcvbuf_get(): copy the remainder */
+        size = head->size - tcb->rcv_queue_off;
+        *pkt = gnrc_pktbuf_add(NULL, (uint8_t *)head->data + tcb->rcv_queue_off, size,
+                               GNRC_NETTYPE_UNDEF);
+        if (*pkt == NULL) {
+            return -ENOMEM;
+        }
+        _rcvbuf_unhold(tcb, head->size);
+        gnrc_pktbuf_release(_rcvbuf_dequeue(tcb));
+        return size;
+    }
+#endif
+    size = tcb->rcv_buf.avail;
+    if (size == 0) {
+        return 0;
+    }
+    *pkt = gnrc_pktbuf_add(NULL, NULL, size, GNRC_NETTYPE_UNDEF);
+    if (*pkt == NULL) {
+        return -ENOMEM;
+    }
+    ringbuffer_get(&(tcb->rcv_buf), (*pkt)->data, size);
+    return size;
+}
+
+void _rcvbuf_release_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt)
+{
+#if GNRC_TCP_RCV_QUEUE_SIZE > 0
+    /* Only queued segments still carry their TCP header, copies don't */
+    if (pkt->next != NULL && pkt->next->type == GNRC_NETTYPE_TCP) {
+        _rcvbuf_unhold(tcb, pkt->size);
+    }
+#else
+    (void) tcb;
+#endif
+    gnrc_pktbuf_release(pkt);
+}
+
+bool _rcvbuf_empty(const gnrc_tcp_tcb_t *tcb)
+{
+#if GNRC_TCP_RCV_QUEUE_SIZE > 0
+    if (tcb->rcv_queue_len > 0) {
+        return false;
+    }
+#endif
+    return ringbuffer_empty(&(tcb->rcv_buf));
+}
+
+size_t _rcvbuf_get_free(const gnrc_tcp_tcb_t *tcb)
+{
+    size_t free = ringbuffer_get_free(&(tcb->rcv_buf));
+
+#if GNRC_TCP_RCV_QUEUE_SIZE > 0
+    free = (free > tcb->rcv_pkt_bytes) ? free - tcb->rcv_pkt_bytes : 0;
+#endif
+    return free;
 }
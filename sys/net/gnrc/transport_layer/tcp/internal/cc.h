@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_tcp TCP
+ * @ingroup     net_gnrc
+ * @brief       RIOT's TCP implementation for the GNRC network stack.
+ *
+ * @{
+ *
+ * @file
+ * @brief       TCP congestion control declarations (NewReno, RFC 5681 and RFC 6582).
+ */
+
+#ifndef CC_H
+#define CC_H
+
+#include <stdint.h>
+#include "net/gnrc/tcp/tcb.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Initializes the congestion control state of a synchronized connection.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _cc_init(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Calculates the amount of data that may be outstanding.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   The minimum of the peers receive window and the congestion window.
+ */
+uint32_t _cc_get_wnd(const gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Processes an acknowledgment for new data.
+ *
+ * @note Must be called after snd_una and the retransmission queue were updated.
+ *
+ * @param[in,out] tcb     TCB holding the connection information.
+ * @param[in]     acked   Number of newly acknowledged bytes.
+ */
+void _cc_ack(gnrc_tcp_tcb_t *tcb, const uint32_t acked);
+
+/**
+ * @brief Processes a duplicate acknowledgment.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _cc_dup_ack(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Processes an expiration of the retransmission timer.
+ *
+ * @note Must be called before the oldest segment is retransmitted.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _cc_timeout(gnrc_tcp_tcb_t *tcb);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CC_H */
+/** @} */
@@ -53,7 +53,10 @@ typedef enum {
 typedef enum {
     FSM_EVENT_CALL_OPEN,          /* User function call: open */
     FSM_EVENT_CALL_SEND,          /* User function call: send */
+    FSM_EVENT_CALL_SEND_PKT,      /* User function call: send_pkt */
     FSM_EVENT_CALL_RECV,          /* User function call: recv */
+    FSM_EVENT_CALL_RECV_PKT,      /* User function call: recv_pkt */
+    FSM_EVENT_CALL_RELEASE_PKT,   /* User function call: recv_pkt_release */
     FSM_EVENT_CALL_CLOSE,         /* User function call: close */
     FSM_EVENT_CALL_ABORT,         /* User function call: abort */
     FSM_EVENT_RCVD_PKT,           /* Paket received from peer */
@@ -69,8 +72,10 @@ typedef enum {
  *
  * @param[in,out] tcb     TCB holding the connection information.
  * @param[in]     event   Current event that triggers FSM transition.
- * @param[in]     in_pkt  Incomming packet. Only not NULL in case of event RCVD_PKT.
- * @param[in,out] buf     Buffer for send and receive functions.
+ * @param[in]     in_pkt  Incomming packet in case of event RCVD_PKT, user supplied
+ *                        packet in case of CALL_SEND_PKT and CALL_RELEASE_PKT.
+ * @param[in,out] buf     Buffer for send and receive functions. Pointer to a packet
+ *                        pointer in case of CALL_RECV_PKT.
  * @param[in]     len     Number of bytes to send or receive.
  *
  * @returns   Zero on success
@@ -110,18 +110,38 @@ uint32_t _pkt_get_pay_len(gnrc_pktsnip_t *pkt);
 /**
  * @brief Adds a packet to the retransmission mechanism.
  *
+ * @note The retransmission timer always runs for the oldest segment in the
+ *       retransmission queue. Only this segment is ever retransmitted.
+ *
  * @param[in,out] tcb          TCB holding the connection information.
  * @param[in]     pkt          Packet to add to the retransmission mechanism.
  * @param[in]     retransmit   Flag used to indicate that @p pkt is a retransmit.
  *
  * @returns   Zero on success.
  *            -ENOMEM if the retransmission queue is full.
- *            -EINVAL if pkt is null.
+ *            -EINVAL if pkt is null or a retransmit of anything but the oldest segment.
  */
 int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool retransmit);
 
 /**
- * @brief Acknowledges and removes packet from the retransmission mechanism.
+ * @brief Retransmits the oldest segment in the retransmission queue.
+ *
+ * @note In contrast to a retransmission on timeout, neither the RTO nor
+ *       the retransmission timer are changed.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ *
+ * @returns   Zero on success.
+ *            -ENODATA if the retransmission queue is empty.
+ *            -EAGAIN if the segment could not be handed to the network layer.
+ */
+int _pkt_fast_retransmit(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Acknowledges and removes packets from the retransmission mechanism.
+ *
+ * @note All segments covered by the cumulative acknowledgment @p ack are
+ *       released. If segments remain, the retransmission timer is restarted.
  *
  * @param[in,out] tcb   TCB holding the connection information.
  * @param[in]     ack   Acknowldegment number used to acknowledge packets.
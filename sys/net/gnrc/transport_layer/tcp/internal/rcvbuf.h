@@ -22,8 +22,11 @@
 #ifndef RCVBUF_H
 #define RCVBUF_H
 
+#include <stdbool.h>
 #include <stdint.h>
+#include "bitfield.h"
 #include "mutex.h"
+#include "net/gnrc/pkt.h"
 #include "net/gnrc/tcp/config.h"
 #include "net/gnrc/tcp/tcb.h"
 
@@ -32,19 +35,32 @@ extern "C" {
 #endif
 
 /**
- * @brief Receive buffer entry.
+ * @brief Number of blocks in the receive buffer pool.
  */
-typedef struct rcvbuf_entry {
-    uint8_t used;                          /**< Flag: Is buffer in use? */
-    uint8_t buffer[GNRC_TCP_RCV_BUF_SIZE]; /**< Receive buffer storage */
-} rcvbuf_entry_t;
+#define RCVBUF_BLOCKS \
+    ((GNRC_TCP_RCV_BUFFERS * GNRC_TCP_RCV_BUF_SIZE) / GNRC_TCP_RCV_BUF_BLOCK_SIZE)
+
+/**
+ * @brief Maximum number of blocks in a single receive buffer.
+ */
+#define RCVBUF_BLOCKS_MAX   (GNRC_TCP_RCV_BUF_SIZE / GNRC_TCP_RCV_BUF_BLOCK_SIZE)
+
+/**
+ * @brief Number of blocks a connection starts with, enough for GNRC_TCP_DEFAULT_WINDOW.
+ */
+#define RCVBUF_BLOCKS_INIT \
+    (((GNRC_TCP_DEFAULT_WINDOW + GNRC_TCP_RCV_BUF_BLOCK_SIZE - 1) / \
+      GNRC_TCP_RCV_BUF_BLOCK_SIZE) < RCVBUF_BLOCKS_MAX ? \
+     ((GNRC_TCP_DEFAULT_WINDOW + GNRC_TCP_RCV_BUF_BLOCK_SIZE - 1) / \
+      GNRC_TCP_RCV_BUF_BLOCK_SIZE) : RCVBUF_BLOCKS_MAX)
 
 /**
  * @brief   Stuct holding receive buffers.
  */
 typedef struct rcvbuf {
-    mutex_t lock;                                 /**< Lock for allocation synchronization */
-    rcvbuf_entry_t entries[GNRC_TCP_RCV_BUFFERS]; /**< Maintained receive buffers */
+    mutex_t lock;                   /**< Lock for allocation synchronization */
+    BITFIELD(used, RCVBUF_BLOCKS);  /**< Blocks currently in use */
+    uint8_t blocks[RCVBUF_BLOCKS][GNRC_TCP_RCV_BUF_BLOCK_SIZE]; /**< Block storage */
 } rcvbuf_t;
 
 /**
@@ -53,7 +69,7 @@ typedef struct rcvbuf {
 void _rcvbuf_init(void);
 
 /**
- * @brief Allocate receive buffer and assign it to TCB.
+ * @brief Allocate receive buffer of RCVBUF_BLOCKS_INIT blocks and assign it to TCB.
  *
  * @param[in,out] tcb   TCB that aquires receive buffer.
  *
@@ -62,6 +78,19 @@ void _rcvbuf_init(void);
  */
 int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb);
 
+/**
+ * @brief Enlarge the receive buffer of a TCB, keeping its contents.
+ *
+ * @note The buffer size is doubled if possible, otherwise it grows by as
+ *       many blocks as are available, up to GNRC_TCP_RCV_BUF_SIZE.
+ *
+ * @param[in,out] tcb   TCB holding the receive buffer that should grow.
+ *
+ * @returns   Zero on success.
+ *            -ENOMEM if the buffer could not be enlarged.
+ */
+int _rcvbuf_grow_buffer(gnrc_tcp_tcb_t *tcb);
+
 /**
  * @brief Release allocated receive buffer.
  *
@@ -69,6 +98,73 @@ int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb);
  */
 void _rcvbuf_release_buffer(gnrc_tcp_tcb_t *tcb);
 
+/**
+ * @brief Store the payload of a received in-order segment.
+ *
+ * @note With GNRC_TCP_RCV_QUEUE_SIZE > 0 the segment is queued without
+ *       copying if possible, otherwise its payload is copied into the
+ *       receive buffer.
+ *
+ * @param[in,out] tcb   TCB holding the receive buffer.
+ * @param[in]     pkt   Received packet, starting with the payload.
+ *
+ * @returns   Number of stored payload bytes.
+ */
+size_t _rcvbuf_add(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief Copy received data into a user supplied buffer.
+ *
+ * @param[in,out] tcb   TCB holding the receive buffer.
+ * @param[out]    buf   Buffer to copy the received data into.
+ * @param[in]     len   Size of @p buf.
+ *
+ * @returns   Number of bytes copied into @p buf.
+ */
+size_t _rcvbuf_get(gnrc_tcp_tcb_t *tcb, void *buf, size_t len);
+
+/**
+ * @brief Take received data as a packet.
+ *
+ * @note Queued segments are returned as they are, data from the receive
+ *       buffer is copied into a newly allocated packet.
+ *
+ * @param[in,out] tcb   TCB holding the receive buffer.
+ * @param[out]    pkt   Packet, starting with the received data.
+ *
+ * @returns   Number of bytes in the payload of @p pkt.
+ *            Zero if no data was received.
+ *            -ENOMEM if the packet could not be allocated.
+ */
+int _rcvbuf_get_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **pkt);
+
+/**
+ * @brief Release a packet returned by _rcvbuf_get_pkt().
+ *
+ * @param[in,out] tcb   TCB the packet was received on.
+ * @param[in]     pkt   Packet to release.
+ */
+void _rcvbuf_release_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief Check if received data is available.
+ *
+ * @param[in] tcb   TCB holding the receive buffer.
+ *
+ * @returns   true if no received data is available.
+ *            false otherwise.
+ */
+bool _rcvbuf_empty(const gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Get number of bytes that can still be received.
+ *
+ * @param[in] tcb   TCB holding the receive buffer.
+ *
+ * @returns   Free space in the receive buffer minus the payload of held segments.
+ */
+size_t _rcvbuf_get_free(const gnrc_tcp_tcb_t *tcb);
+
 #ifdef __cplusplus
 }
 #endif
@@ -136,7 +136,10 @@ static void _receive(gnrc_pktsnip_t *pkt)
     hdr = (udp_hdr_t *)udp->data;
 
     /* validate checksum */
-    if (byteorder_ntohs(hdr->checksum) == 0) {
+    if (gnrc_netif_hdr_get_flag(pkt) & GNRC_NETIF_HDR_FLAGS_CSUM_VALID) {
+        DEBUG("udp: checksum already verified\n");
+    }
+    else if (byteorder_ntohs(hdr->checksum) == 0) {
         /* RFC 8200 Section 8.1
          * "IPv6 receivers must discard UDP packets containing a zero checksum,
          * and should log the error."
@@ -145,7 +148,7 @@ static void _receive(gnrc_pktsnip_t *pkt)
         gnrc_pktbuf_release(pkt);
         return;
     }
-    if (_calc_csum(udp, ipv6, pkt) != 0xFFFF) {
+    else if (_calc_csum(udp, ipv6, pkt) != 0xFFFF) {
         DEBUG("udp: received packet with invalid checksum, dropping it\n");
         gnrc_pktbuf_release(pkt);
         return;
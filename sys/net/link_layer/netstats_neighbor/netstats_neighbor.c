@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_netstats_neighbor
+ * @{
+ *
+ * @file
+ * @brief       Neighbor link statistics implementation
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "assert.h"
+#include "net/netstats/neighbor.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/* LQI of a perfect link */
+#define LQI_MAX         (255U)
+
+static inline bool _match(const netstats_nb_t *nb, const uint8_t *l2_addr,
+                          uint8_t len)
+{
+    return ((nb->l2_addr_len == len) &&
+            (memcmp(nb->l2_addr, l2_addr, len) == 0));
+}
+
+static void _touch(netstats_nb_table_t *table, netstats_nb_t *nb)
+{
+    nb->last_used = ++table->clock;
+}
+
+/*
+ * Finds a neighbor, or adds it in place of an unused or else the least
+ * recently used entry.
+ */
+static netstats_nb_t *_get_or_add(netstats_nb_table_t *table,
+                                  const uint8_t *l2_addr, uint8_t len)
+{
+    netstats_nb_t *nb = netstats_nb_get(table, l2_addr, len);
+
+    if (nb != NULL) {
+        return nb;
+    }
+    nb = &table->entries[0];
+    for (unsigned i = 0; i < NETSTATS_NB_SIZE; i++) {
+        netstats_nb_t *entry = &table->entries[i];
+
+        if (entry->l2_addr_len == 0) {
+            nb = entry;
+            break;
+        }
+        /* the clock wraps around, so compare ages */
+        if ((uint16_t)(table->clock - entry->last_used) >
+            (uint16_t)(table->clock - nb->last_used)) {
+            nb = entry;
+        }
+    }
+    if (nb == table->pending) {
+        table->pending = NULL;
+    }
+    DEBUG("netstats_nb: new neighbor in entry %u\n",
+          (unsigned)(nb - table->entries));
+    memset(nb, 0, sizeof(*nb));
+    memcpy(nb->l2_addr, l2_addr, len);
+    nb->l2_addr_len = len;
+    nb->etx = NETSTATS_NB_ETX_INIT;
+    return nb;
+}
+
+void netstats_nb_init(netstats_nb_table_t *table)
+{
+    assert(table);
+
+    memset(table, 0, sizeof(*table));
+}
+
+netstats_nb_t *netstats_nb_get(netstats_nb_table_t *table,
+                               const uint8_t *l2_addr, uint8_t len)
+{
+    assert(table && l2_addr);
+
+    for (unsigned i = 0; i < NETSTATS_NB_SIZE; i++) {
+        if (_match(&table->entries[i], l2_addr, len)) {
+            return &table->entries[i];
+        }
+    }
+    return NULL;
+}
+
+void netstats_nb_record(netstats_nb_table_t *table, const uint8_t *l2_addr,
+                        uint8_t len)
+{
+    assert(table && (len <= NETSTATS_NB_ADDR_MAXLEN));
+
+    if ((l2_addr == NULL) || (len == 0)) {
+        table->pending = NULL;
+        return;
+    }
+    table->pending = _get_or_add(table, l2_addr, len);
+    _touch(table, table->pending);
+}
+
+netstats_nb_t *netstats_nb_update_tx(netstats_nb_table_t *table,
+                                     netstats_nb_result_t result,
+                                     uint8_t retries)
+{
+    assert(table);
+
+    netstats_nb_t *nb = table->pending;
+    uint32_t sample;
+
+    if (nb == NULL) {
+        return NULL;
+    }
+    table->pending = NULL;
+    if (result == NETSTATS_NB_BUSY) {
+        /* nothing was sent, so the link is not to blame */
+        return nb;
+    }
+
+    if (result == NETSTATS_NB_SUCCESS) {
+        sample = (retries + 1) * NETSTATS_NB_ETX_DIVISOR;
+    }
+    else {
+        sample = NETSTATS_NB_ETX_NOACK_PENALTY;
+        nb->tx_failed++;
+    }
+    if (nb->tx_count == 0) {
+        /* the first transmission replaces the initial estimate */
+        nb->etx = (sample > NETSTATS_NB_ETX_MAX) ? NETSTATS_NB_ETX_MAX : sample;
+    }
+    else {
+        uint32_t etx = ((NETSTATS_NB_EWMA_ALPHA * sample) +
+                        ((100U - NETSTATS_NB_EWMA_ALPHA) * nb->etx)) / 100U;
+
+        nb->etx = (etx > NETSTATS_NB_ETX_MAX) ? NETSTATS_NB_ETX_MAX : etx;
+    }
+    /* saturate, so tx_count == 0 keeps meaning no transmissions */
+    if (nb->tx_count < UINT16_MAX) {
+        nb->tx_count++;
+    }
+    DEBUG("netstats_nb: ETX %u/%u after %u retries\n", (unsigned)nb->etx,
+          NETSTATS_NB_ETX_DIVISOR, (unsigned)retries);
+    return nb;
+}
+
+netstats_nb_t *netstats_nb_update_rx(netstats_nb_table_t *table,
+                                     const uint8_t *l2_addr, uint8_t len,
+                                     int16_t rssi, uint8_t lqi)
+{
+    assert(table && l2_addr && (len <= NETSTATS_NB_ADDR_MAXLEN));
+
+    netstats_nb_t *nb = _get_or_add(table, l2_addr, len);
+
+    _touch(table, nb);
+    nb->rssi = rssi;
+    nb->lqi  = lqi;
+    if (nb->rx_count < UINT16_MAX) {
+        nb->rx_count++;
+    }
+    if ((nb->tx_count == 0) && (lqi > 0)) {
+        /* no transmissions yet, so estimate from the LQI */
+        uint32_t etx = (NETSTATS_NB_ETX_DIVISOR * LQI_MAX) / lqi;
+
+        nb->etx = (etx > NETSTATS_NB_ETX_MAX) ? NETSTATS_NB_ETX_MAX : etx;
+    }
+    return nb;
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       Glue between the asynchronous sock API and @ref sys_event
+ */
+
+#include <assert.h>
+
+#include "irq.h"
+#include "net/sock/async_event.h"
+
+static void _event_handler(event_t *ev)
+{
+    sock_event_t *event = (sock_event_t *)ev;
+    unsigned state = irq_disable();
+    sock_async_flags_t type = event->type;
+
+    event->type = 0;
+    irq_restore(state);
+    if (type) {
+        event->cb.generic(event->sock, type, event->cb_arg);
+    }
+}
+
+/* called in the context of the network stack, so only collect the flags
+ * and leave the work to the event thread */
+static void _cb(void *sock, sock_async_flags_t type, void *arg)
+{
+    sock_event_t *event = arg;
+    unsigned state = irq_disable();
+
+    event->sock = sock;
+    event->type |= type;
+    irq_restore(state);
+    event_post(event->queue, &event->super);
+}
+
+static void _set_ctx(sock_async_ctx_t *ctx, event_queue_t *ev_queue,
+                     sock_async_cb_t cb, void *cb_arg)
+{
+    ctx->event.super.list_node.next = NULL;
+    ctx->event.super.handler = _event_handler;
+    ctx->event.queue = ev_queue;
+    ctx->event.cb = cb;
+    ctx->event.cb_arg = cb_arg;
+    ctx->event.type = 0;
+}
+
+#ifdef MODULE_SOCK_IP
+static void _ip_cb(sock_ip_t *sock, sock_async_flags_t type, void *arg)
+{
+    _cb(sock, type, arg);
+}
+
+void sock_ip_event_init(sock_ip_t *sock, event_queue_t *ev_queue,
+                        sock_ip_cb_t handler, void *handler_arg)
+{
+    sock_async_ctx_t *ctx = sock_ip_get_async_ctx(sock);
+
+    assert((ev_queue != NULL) && (handler != NULL));
+    _set_ctx(ctx, ev_queue, (sock_async_cb_t){ .ip = handler }, handler_arg);
+    sock_ip_set_cb(sock, _ip_cb, &ctx->event);
+}
+#endif
+
+#ifdef MODULE_SOCK_UDP
+static void _udp_cb(sock_udp_t *sock, sock_async_flags_t type, void *arg)
+{
+    _cb(sock, type, arg);
+}
+
+void sock_udp_event_init(sock_udp_t *sock, event_queue_t *ev_queue,
+                         sock_udp_cb_t handler, void *handler_arg)
+{
+    sock_async_ctx_t *ctx = sock_udp_get_async_ctx(sock);
+
+    assert((ev_queue != NULL) && (handler != NULL));
+    _set_ctx(ctx, ev_queue, (sock_async_cb_t){ .udp = handler }, handler_arg);
+    sock_udp_set_cb(sock, _udp_cb, &ctx->event);
+}
+#endif
+
+/** @} */
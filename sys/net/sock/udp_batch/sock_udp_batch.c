@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       Batch functions of the UDP sock API for stacks that do not
+ *              implement them
+ *
+ * The functions just loop over sock_udp_recv() and sock_udp_send(), so they
+ * save no work over calling those directly.
+ */
+
+#include <assert.h>
+#include <errno.h>
+
+#include "net/sock/udp.h"
+
+int sock_udp_recv_batch(sock_udp_t *sock, sock_udp_msg_t *msgs, unsigned num,
+                        uint32_t timeout)
+{
+    unsigned i = 0;
+
+    assert((sock != NULL) && (msgs != NULL) && (num > 0));
+    while (i < num) {
+        ssize_t res;
+
+        assert((msgs[i].data != NULL) && (msgs[i].len > 0));
+        /* only wait for the first datagram */
+        res = sock_udp_recv(sock, msgs[i].data, msgs[i].len,
+                            (i == 0) ? timeout : 0, msgs[i].remote);
+        if ((res == -EPROTO) && (i > 0)) {
+            continue;
+        }
+        if (res < 0) {
+            return (i == 0) ? (int)res : (int)i;
+        }
+        msgs[i++].len = (size_t)res;
+    }
+    return (int)i;
+}
+
+int sock_udp_send_batch(sock_udp_t *sock, const sock_udp_msg_t *msgs,
+                        unsigned num)
+{
+    unsigned i;
+
+    assert((msgs != NULL) && (num > 0));
+    for (i = 0; i < num; i++) {
+        ssize_t res = sock_udp_send(sock, msgs[i].data, msgs[i].len,
+                                    msgs[i].remote);
+
+        if (res < 0) {
+            return (i == 0) ? (int)res : (int)i;
+        }
+    }
+    return (int)i;
+}
+
+/** @} */
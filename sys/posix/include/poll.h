@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  posix_sockets
+ * @{
+ */
+
+/**
+ * @file
+ * @brief   Definitions for the poll() function
+ * @see     <a href="http://pubs.opengroup.org/onlinepubs/9699919799/basedefs/poll.h.html">
+ *              The Open Group Base Specifications Issue 7, <poll.h>
+ *          </a>
+ *
+ * @note    Only available with module `posix_select`
+ */
+#ifdef CPU_NATIVE
+/* If building on native we need to use the system header instead */
+#pragma GCC system_header
+/* without the GCC pragma above #include_next will trigger a pedantic error */
+#include_next <poll.h>
+#else
+#ifndef POLL_H
+#define POLL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name    Event flags for struct pollfd::events and struct pollfd::revents
+ * @{
+ */
+#define POLLIN      (0x0001)    /**< Data other than high-priority data may be read */
+#define POLLPRI     (0x0002)    /**< High-priority data may be read */
+#define POLLOUT     (0x0004)    /**< Normal data may be written */
+#define POLLERR     (0x0008)    /**< An error has occurred (revents only) */
+#define POLLHUP     (0x0010)    /**< Device has been disconnected (revents only) */
+#define POLLNVAL    (0x0020)    /**< Invalid fd member (revents only) */
+#define POLLRDNORM  (POLLIN)    /**< Normal data may be read */
+#define POLLWRNORM  (POLLOUT)   /**< Equivalent to POLLOUT */
+/** @} */
+
+/**
+ * @brief   Type for the number of file descriptors passed to poll()
+ */
+typedef unsigned int nfds_t;
+
+/**
+ * @brief   File descriptor to poll
+ */
+struct pollfd {
+    int fd;         /**< the file descriptor to poll */
+    short events;   /**< the events of interest */
+    short revents;  /**< the events that occurred */
+};
+
+/**
+ * @brief   Input/output multiplexing
+ *
+ * @see <a href="http://pubs.opengroup.org/onlinepubs/9699919799/functions/poll.html">
+ *          The Open Group Base Specification Issue 7, poll
+ *      </a>
+ *
+ * @param[in,out] fds   File descriptors to poll. Negative file descriptors
+ *                      are ignored.
+ * @param[in] nfds      Number of elements in @p fds.
+ * @param[in] timeout   Time to wait in milliseconds. 0 returns immediately,
+ *                      -1 waits until any of @p fds becomes ready.
+ *
+ * @return  Number of elements of @p fds with a non-zero
+ *          pollfd::revents on success.
+ * @return  0, when the call timed out.
+ * @return  -1 on error, errno is set to indicate the error.
+ */
+int poll(struct pollfd fds[], nfds_t nfds, int timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* POLL_H */
+#endif /* CPU_NATIVE */
+/** @} */
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  posix_sockets
+ * @{
+ */
+
+/**
+ * @file
+ * @brief   Definitions for the select() function
+ * @see     <a href="http://pubs.opengroup.org/onlinepubs/9699919799/basedefs/sys_select.h.html">
+ *              The Open Group Base Specifications Issue 7, <sys/select.h>
+ *          </a>
+ *
+ * @note    Only available with module `posix_select`
+ */
+#if defined(CPU_NATIVE) || MODULE_NEWLIB
+/* If building on native or newlib we need to use the system header instead */
+#pragma GCC system_header
+/* without the GCC pragma above #include_next will trigger a pedantic error */
+#include_next <sys/select.h>
+#else
+#ifndef SYS_SELECT_H
+#define SYS_SELECT_H
+
+#include <stdint.h>
+#include <string.h>
+#include <sys/time.h>   /* for struct timeval */
+
+#include "bitfield.h"
+#include "vfs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximum number of file descriptors in an fd_set
+ */
+#ifndef FD_SETSIZE
+#define FD_SETSIZE      (VFS_MAX_OPEN_FILES)
+#endif
+
+/**
+ * @brief   Set of file descriptors
+ */
+typedef struct {
+    BITFIELD(fds, FD_SETSIZE);  /**< one bit per file descriptor */
+} fd_set;
+
+/**
+ * @name    Manipulation of fd_set
+ * @{
+ */
+#define FD_CLR(fd, set)     bf_unset((set)->fds, (fd))
+#define FD_ISSET(fd, set)   bf_isset((set)->fds, (fd))
+#define FD_SET(fd, set)     bf_set((set)->fds, (fd))
+#define FD_ZERO(set)        memset((set), 0, sizeof(fd_set))
+/** @} */
+
+/**
+ * @brief   Synchronous I/O multiplexing
+ *
+ * @see <a href="http://pubs.opengroup.org/onlinepubs/9699919799/functions/select.html">
+ *          The Open Group Base Specification Issue 7, select
+ *      </a>
+ *
+ * @param[in] nfds          Range of file descriptors to check, i.e. one more
+ *                          than the highest file descriptor in any of the sets.
+ * @param[in,out] readfds   File descriptors to check for being ready to read.
+ *                          May be NULL.
+ * @param[in,out] writefds  File descriptors to check for being ready to write.
+ *                          May be NULL.
+ * @param[in,out] errorfds  File descriptors to check for pending errors. No
+ *                          error conditions are reported, so the set is
+ *                          always cleared. May be NULL.
+ * @param[in] timeout       Maximum time to wait. NULL waits until any of the
+ *                          file descriptors becomes ready.
+ *
+ * @return  Number of file descriptors set in all sets on success.
+ * @return  0, when the call timed out.
+ * @return  -1 on error, errno is set to indicate the error.
+ */
+int select(int nfds, fd_set *readfds, fd_set *writefds, fd_set *errorfds,
+           struct timeval *timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SYS_SELECT_H */
+#endif /* CPU_NATIVE || MODULE_NEWLIB */
+/** @} */
@@ -36,6 +36,15 @@
 #include "net/sock/udp.h"
 #include "net/sock/tcp.h"
 
+#ifdef MODULE_POSIX_SELECT
+#include <poll.h>
+#include <sys/select.h>
+
+#include "net/sock/select.h"
+#include "thread_flags.h"
+#include "xtimer.h"
+#endif
+
 /* enough to create sockets both with socket() and accept() */
 #define _ACTUAL_SOCKET_POOL_SIZE   (SOCKET_POOL_SIZE + \
                                     (SOCKET_POOL_SIZE * SOCKET_TCP_QUEUE_SIZE))
@@ -1046,6 +1055,239 @@ int setsockopt(int socket, int level, int option_name, const void *option_value,
 #endif
 }
 
+#ifdef MODULE_POSIX_SELECT
+/**
+ * @brief   Registers (or with @p thread == NULL unregisters) a thread to be
+ *          notified when data arrives at the socket with file descriptor @p fd
+ */
+static void _select_notify(int fd, thread_t *thread)
+{
+    socket_t *s;
+
+    mutex_lock(&_socket_pool_mutex);
+    s = _get_socket(fd);
+    if ((s != NULL) && (s->sock != NULL)) {
+        switch (s->type) {
+#ifdef MODULE_SOCK_IP
+            case SOCK_RAW:
+                sock_ip_notify(&s->sock->raw, thread);
+                break;
+#endif
+#ifdef MODULE_SOCK_UDP
+            case SOCK_DGRAM:
+                sock_udp_notify(&s->sock->udp, thread);
+                break;
+#endif
+            default:
+                break;
+        }
+    }
+    mutex_unlock(&_socket_pool_mutex);
+}
+
+/**
+ * @brief   Checks which of @p events occurred at the socket with file
+ *          descriptor @p fd
+ *
+ * @return  The occurred events, POLLNVAL if @p fd can't be polled
+ */
+static short _select_check(int fd, short events)
+{
+    socket_t *s;
+    short revents = 0;
+
+    mutex_lock(&_socket_pool_mutex);
+    s = _get_socket(fd);
+    if ((s == NULL) || (s->domain == AF_UNSPEC)) {
+        mutex_unlock(&_socket_pool_mutex);
+        return POLLNVAL;
+    }
+    switch (s->type) {
+#ifdef MODULE_SOCK_IP
+        case SOCK_RAW:
+            if ((s->sock != NULL) && sock_ip_readable(&s->sock->raw)) {
+                revents |= POLLIN;
+            }
+            /* sending a datagram never blocks */
+            revents |= POLLOUT;
+            break;
+#endif
+#ifdef MODULE_SOCK_UDP
+        case SOCK_DGRAM:
+            if ((s->sock != NULL) && sock_udp_readable(&s->sock->udp)) {
+                revents |= POLLIN;
+            }
+            /* sending a datagram never blocks */
+            revents |= POLLOUT;
+            break;
+#endif
+        default:
+            /* no readiness information available for stream sockets */
+            (void)events;
+            revents = POLLNVAL;
+            break;
+    }
+    mutex_unlock(&_socket_pool_mutex);
+    return revents & (events | POLLERR | POLLHUP | POLLNVAL);
+}
+
+/**
+ * @brief   Waits until one of the registered sockets is notified or
+ *          @p timeout expired
+ *
+ * @return  false, if the caller should stop checking the sockets
+ */
+static bool _select_wait(uint32_t *timeout)
+{
+    if (*timeout == 0) {
+        return false;
+    }
+    if (thread_flags_wait_any(SOCK_SELECT_THREAD_FLAG | THREAD_FLAG_TIMEOUT) &
+        THREAD_FLAG_TIMEOUT) {
+        /* check one last time */
+        *timeout = 0;
+    }
+    return true;
+}
+
+static void _select_timer_set(xtimer_t *timer, uint32_t timeout)
+{
+    thread_flags_clear(THREAD_FLAG_TIMEOUT);
+    if ((timeout != 0) && (timeout != SOCK_NO_TIMEOUT)) {
+        xtimer_set_timeout_flag(timer, timeout);
+    }
+}
+
+int poll(struct pollfd fds[], nfds_t nfds, int timeout)
+{
+    thread_t *me = (thread_t *)sched_active_thread;
+    xtimer_t timer = { .target = 0, .long_target = 0 };
+    uint32_t t = SOCK_NO_TIMEOUT;
+    int res;
+
+    if ((fds == NULL) && (nfds > 0)) {
+        errno = EFAULT;
+        return -1;
+    }
+    if (timeout >= 0) {
+        const uint32_t max_timeout_msecs = (SOCK_NO_TIMEOUT - 1) / US_PER_MS;
+
+        t = ((uint32_t)timeout > max_timeout_msecs) ?
+            (max_timeout_msecs * US_PER_MS) : ((uint32_t)timeout * US_PER_MS);
+    }
+    /* register before the first check, so no packet is missed in between */
+    for (nfds_t i = 0; i < nfds; i++) {
+        if (fds[i].fd >= 0) {
+            _select_notify(fds[i].fd, me);
+        }
+    }
+    _select_timer_set(&timer, t);
+    do {
+        thread_flags_clear(SOCK_SELECT_THREAD_FLAG);
+        res = 0;
+        for (nfds_t i = 0; i < nfds; i++) {
+            fds[i].revents = (fds[i].fd < 0) ? 0 : _select_check(fds[i].fd,
+                                                                 fds[i].events);
+            if (fds[i].revents != 0) {
+                res++;
+            }
+        }
+    } while ((res == 0) && _select_wait(&t));
+    xtimer_remove(&timer);
+    for (nfds_t i = 0; i < nfds; i++) {
+        if (fds[i].fd >= 0) {
+            _select_notify(fds[i].fd, NULL);
+        }
+    }
+    return res;
+}
+
+int select(int nfds, fd_set *readfds, fd_set *writefds, fd_set *errorfds,
+           struct timeval *timeout)
+{
+    thread_t *me = (thread_t *)sched_active_thread;
+    xtimer_t timer = { .target = 0, .long_target = 0 };
+    fd_set rd, wr;
+    uint32_t t = SOCK_NO_TIMEOUT;
+    int res;
+
+    if ((nfds < 0) || (nfds > FD_SETSIZE)) {
+        errno = EINVAL;
+        return -1;
+    }
+    if (timeout != NULL) {
+        const uint32_t max_timeout_secs = (SOCK_NO_TIMEOUT - 1) / US_PER_SEC;
+
+        if ((timeout->tv_sec < 0) || (timeout->tv_usec < 0) ||
+            (timeout->tv_usec >= (long)US_PER_SEC)) {
+            errno = EINVAL;
+            return -1;
+        }
+        t = ((uint32_t)timeout->tv_sec >= max_timeout_secs) ?
+            (max_timeout_secs * US_PER_SEC) :
+            ((uint32_t)timeout->tv_sec * US_PER_SEC) + timeout->tv_usec;
+    }
+    FD_ZERO(&rd);
+    FD_ZERO(&wr);
+    if (readfds != NULL) {
+        memcpy(&rd, readfds, sizeof(fd_set));
+        FD_ZERO(readfds);
+    }
+    if (writefds != NULL) {
+        memcpy(&wr, writefds, sizeof(fd_set));
+        FD_ZERO(writefds);
+    }
+    if (errorfds != NULL) {
+        /* no error conditions are tracked for sockets */
+        FD_ZERO(errorfds);
+    }
+    for (int fd = 0; fd < nfds; fd++) {
+        if (FD_ISSET(fd, &rd) || FD_ISSET(fd, &wr)) {
+            if (_select_check(fd, 0) & POLLNVAL) {
+                errno = EBADF;
+                return -1;
+            }
+        }
+    }
+    /* register before the first check, so no packet is missed in between */
+    for (int fd = 0; fd < nfds; fd++) {
+        if (FD_ISSET(fd, &rd)) {
+            _select_notify(fd, me);
+        }
+    }
+    _select_timer_set(&timer, t);
+    do {
+        thread_flags_clear(SOCK_SELECT_THREAD_FLAG);
+        res = 0;
+        for (int fd = 0; fd < nfds; fd++) {
+            short events = (FD_ISSET(fd, &rd) ? POLLIN : 0) |
+                           (FD_ISSET(fd, &wr) ? POLLOUT : 0);
+            short revents;
+
+            if (events == 0) {
+                continue;
+            }
+            revents = _select_check(fd, events);
+            if (revents & POLLIN) {
+                FD_SET(fd, readfds);
+                res++;
+            }
+            if (revents & POLLOUT) {
+                FD_SET(fd, writefds);
+                res++;
+            }
+        }
+    } while ((res == 0) && _select_wait(&t));
+    xtimer_remove(&timer);
+    for (int fd = 0; fd < nfds; fd++) {
+        if (FD_ISSET(fd, &rd)) {
+            _select_notify(fd, NULL);
+        }
+    }
+    return res;
+}
+#endif
+
 /**
  * @}
  */
@@ -297,12 +297,16 @@ int _gnrc_rpl_dodag_show(void)
         tc = (int64_t) tc < 0 ? 0 : tc / US_PER_SEC;
 
         printf("\tdodag [%s | R: %d | OP: %s | PIO: %s | "
-               "TR(I=[%d,%d], k=%d, c=%d, TC=%" PRIu32 "s)]\n",
+               "TR(I=[%" PRIu32 ",%d], k=%d, c=%d, TC=%" PRIu32 "s)]\n",
                ipv6_addr_to_str(addr_str, &dodag->dodag_id, sizeof(addr_str)),
                dodag->my_rank, (dodag->node_status == GNRC_RPL_LEAF_NODE ? "Leaf" : "Router"),
                ((dodag->dio_opts & GNRC_RPL_REQ_DIO_OPT_PREFIX_INFO) ? "on" : "off"),
-               (1 << dodag->dio_min), dodag->dio_interval_doubl, dodag->trickle.k,
+               dodag->trickle.Imin, dodag->trickle.Imax, dodag->trickle.k,
                dodag->trickle.c, (uint32_t) (tc & 0xFFFFFFFF));
+        printf("\ttrickle [TX: %" PRIu32 " | suppressed: %" PRIu32
+               " | resets: %" PRIu32 "]\n",
+               dodag->trickle.stats.transmissions,
+               dodag->trickle.stats.suppressions, dodag->trickle.stats.resets);
 
 #ifdef MODULE_GNRC_RPL_P2P
         if (dodag->instance->mop == GNRC_RPL_P2P_MOP) {
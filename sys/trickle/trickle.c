@@ -14,6 +14,8 @@
  * @author  Cenk Gündoğan <cenk.guendogan@haw-hamburg.de>
  */
 
+#include <string.h>
+
 #include "inttypes.h"
 #include "random.h"
 #include "trickle.h"
@@ -25,8 +27,12 @@ void trickle_callback(trickle_t *trickle)
 {
     /* Handle k=0 like k=infinity (according to RFC6206, section 6.5) */
     if ((trickle->c < trickle->k) || (trickle->k == 0)) {
+        trickle->stats.transmissions++;
         (*trickle->callback.func)(trickle->callback.args);
     }
+    else {
+        trickle->stats.suppressions++;
+    }
 
     trickle_interval(trickle);
 }
@@ -44,6 +50,11 @@ void trickle_interval(trickle_t *trickle)
         trickle->I = max_interval;
         old_interval = max_interval / 2;
     }
+    /* Imin may have been raised by trickle_set_params() */
+    else if (trickle->I < trickle->Imin) {
+        trickle->I = trickle->Imin;
+        old_interval = trickle->Imin / 2;
+    }
 
     DEBUG("trickle: I == %" PRIu32 ", diff == %" PRIu32 "\n", trickle->I, diff);
 
@@ -58,8 +69,7 @@ void trickle_interval(trickle_t *trickle)
 
 void trickle_reset_timer(trickle_t *trickle)
 {
-    assert(trickle->I > trickle->Imin);
-
+    trickle->stats.resets++;
     trickle_stop(trickle);
     trickle->I = trickle->t = trickle->Imin;
     trickle_interval(trickle);
@@ -82,10 +92,54 @@ void trickle_start(kernel_pid_t pid, trickle_t *trickle, uint16_t msg_type,
     trickle->pid = pid;
     trickle->msg.content.ptr = trickle;
     trickle->msg.type = msg_type;
+    memset(&trickle->stats, 0, sizeof(trickle->stats));
 
     trickle_interval(trickle);
 }
 
+void trickle_set_params(trickle_t *trickle, uint32_t Imin, uint8_t Imax,
+                        uint8_t k)
+{
+    assert(Imin > 0);
+    assert((Imin << Imax) < (UINT32_MAX / 2));
+
+    trickle->Imin = Imin;
+    trickle->Imax = Imax;
+    trickle->k = k;
+}
+
+void trickle_adapt(trickle_t *trickle, uint32_t Imin, uint8_t Imax, uint8_t k,
+                   unsigned neighbors)
+{
+    uint8_t shift = 0;
+
+    if (neighbors > TRICKLE_ADAPT_DENSITY) {
+        /* keep Imin << Imax, the longest interval */
+        for (unsigned n = neighbors / TRICKLE_ADAPT_DENSITY;
+             (n > 1) && (shift < Imax); n >>= 1) {
+            shift++;
+        }
+        Imin <<= shift;
+        Imax -= shift;
+        if (k > 0) {
+            k = ((k * TRICKLE_ADAPT_DENSITY) + neighbors - 1) / neighbors;
+        }
+    }
+    else {
+        for (unsigned n = (neighbors > 0) ? neighbors : 1;
+             ((n * 2) <= TRICKLE_ADAPT_DENSITY) &&
+             (shift < TRICKLE_ADAPT_SPARSE_SHIFT) && ((Imin >> shift) > 1);
+             n <<= 1) {
+            shift++;
+        }
+        Imin >>= shift;
+        Imax += shift;
+    }
+    DEBUG("trickle: %u neighbors, Imin == %" PRIu32 ", Imax == %u, k == %u\n",
+          neighbors, Imin, (unsigned)Imax, (unsigned)k);
+    trickle_set_params(trickle, Imin, Imax, k);
+}
+
 void trickle_stop(trickle_t *trickle)
 {
     xtimer_remove(&trickle->msg_timer);
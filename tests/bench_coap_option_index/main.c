@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compare finding CoAP options with the option index to
+ *              scanning the parsed options
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "net/nanocoap.h"
+#include "xtimer.h"
+
+#define OPT_SIZE1           (60U)   /* beyond the indexed option numbers */
+#define ITERATIONS          (1024U)
+
+/* nanocoap needs the global resource list */
+const coap_resource_t coap_resources[] = {
+    { "/.well-known/core", COAP_GET, NULL, NULL },
+};
+
+const unsigned coap_resources_numof = sizeof(coap_resources) /
+                                      sizeof(coap_resources[0]);
+
+static const unsigned _opt_nums[] = {
+    COAP_OPT_OBSERVE, COAP_OPT_URI_PATH, COAP_OPT_CONTENT_FORMAT,
+    COAP_OPT_BLOCK2, COAP_OPT_BLOCK1, OPT_SIZE1,
+};
+
+#define OPT_NUMS_NUMOF      (sizeof(_opt_nums) / sizeof(_opt_nums[0]))
+
+/*
+ * Builds a typical request with Uri-Path x3, Content-Format, Observe, Block2
+ * and Size1 into buf; returns its length.
+ */
+static size_t _build_req(uint8_t *buf, size_t len)
+{
+    coap_pkt_t pkt;
+    uint8_t token[2] = {0xDA, 0xEC};
+    size_t hdr_len = coap_build_hdr((coap_hdr_t *)buf, COAP_TYPE_CON,
+                                    &token[0], 2, COAP_METHOD_PUT, 0xABCD);
+
+    coap_pkt_init(&pkt, buf, len, hdr_len);
+    coap_opt_add_uint(&pkt, COAP_OPT_OBSERVE, 0);
+    coap_opt_add_string(&pkt, COAP_OPT_URI_PATH, "/node/sensor/temp", '/');
+    coap_opt_add_uint(&pkt, COAP_OPT_CONTENT_FORMAT, COAP_FORMAT_CBOR);
+    /* block 3, size 64, no more */
+    coap_opt_add_uint(&pkt, COAP_OPT_BLOCK2, (3 << 4) | 2);
+    coap_opt_add_uint(&pkt, OPT_SIZE1, 1000);
+    return coap_opt_finish(&pkt, COAP_OPT_FINISH_NONE);
+}
+
+/* what coap_find_option() did before the option index */
+static uint8_t *_find_option_scan(coap_pkt_t *pkt, unsigned opt_num)
+{
+    for (unsigned i = 0; i < pkt->options_len; i++) {
+        if (pkt->options[i].opt_num == opt_num) {
+            return (uint8_t *)pkt->hdr + pkt->options[i].offset;
+        }
+    }
+    return NULL;
+}
+
+int main(void)
+{
+    uint8_t buf[128];
+    coap_pkt_t pkt;
+    size_t len = _build_req(buf, sizeof(buf));
+    uint32_t start, scan_time, index_time;
+    unsigned found = 0;
+
+    puts("nanocoap option index benchmark");
+
+    start = xtimer_now_usec();
+    for (unsigned n = 0; n < ITERATIONS; n++) {
+        coap_parse(&pkt, buf, len);
+        for (unsigned i = 0; i < OPT_NUMS_NUMOF; i++) {
+            if (_find_option_scan(&pkt, _opt_nums[i]) != NULL) {
+                found++;
+            }
+        }
+    }
+    scan_time = xtimer_now_usec() - start;
+
+    start = xtimer_now_usec();
+    for (unsigned n = 0; n < ITERATIONS; n++) {
+        coap_parse(&pkt, buf, len);
+        for (unsigned i = 0; i < OPT_NUMS_NUMOF; i++) {
+            if (coap_find_option(&pkt, _opt_nums[i]) != NULL) {
+                found++;
+            }
+        }
+    }
+    index_time = xtimer_now_usec() - start;
+
+    /* all but Block1 are present */
+    if (found != (2U * ITERATIONS * (OPT_NUMS_NUMOF - 1))) {
+        puts("FAILED: options not found");
+        return 1;
+    }
+    printf("{ \"requests\" : %u, \"lookups\" : %u, \"scan\" : %" PRIu32
+           ", \"index\" : %" PRIu32 " }\n", ITERATIONS,
+           ITERATIONS * (unsigned)OPT_NUMS_NUMOF, scan_time, index_time);
+    puts("SUCCESS");
+
+    return 0;
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compare finding CoAP resources with the resource index to
+ *              scanning sorted resources
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/nanocoap.h"
+#include "xtimer.h"
+
+/* three quarters of the slots, as recommended for the index */
+#define RESOURCES_NUMOF     ((NANOCOAP_RESOURCE_INDEX_SIZE * 3U) / 4U)
+#define ITERATIONS          (64U)
+
+/* nanocoap needs the global resource list, the benchmark uses its own */
+const coap_resource_t coap_resources[] = {
+    { "/.well-known/core", COAP_GET, NULL, NULL },
+};
+
+const unsigned coap_resources_numof = sizeof(coap_resources) /
+                                      sizeof(coap_resources[0]);
+
+static coap_resource_index_t _index;
+static coap_resource_t _resources[RESOURCES_NUMOF];
+static char _paths[RESOURCES_NUMOF][sizeof("/node/000/sensor")];
+
+/* the lookup gcoap and nanocoap use if the index is too small */
+static const coap_resource_t *_scan(const char *path, unsigned method_flag)
+{
+    for (unsigned i = 0; i < RESOURCES_NUMOF; i++) {
+        int res = strcmp(path, _resources[i].path);
+
+        if (res < 0) {
+            break;
+        }
+        if ((res == 0) && (_resources[i].methods & method_flag)) {
+            return &_resources[i];
+        }
+    }
+    return NULL;
+}
+
+int main(void)
+{
+    uint32_t start, scan_time, index_time;
+    unsigned found = 0;
+
+    puts("CoAP resource index benchmark");
+    coap_resource_index_init(&_index);
+    for (unsigned i = 0; i < RESOURCES_NUMOF; i++) {
+        snprintf(_paths[i], sizeof(_paths[i]), "/node/%03u/sensor", i);
+        _resources[i].path = _paths[i];
+        _resources[i].methods = COAP_GET;
+        if (coap_resource_index_add(&_index, &_resources[i]) < 0) {
+            puts("FAILED: resource index full");
+            return 1;
+        }
+    }
+
+    start = xtimer_now_usec();
+    for (unsigned n = 0; n < ITERATIONS; n++) {
+        for (unsigned i = 0; i < RESOURCES_NUMOF; i++) {
+            if (_scan(_paths[i], COAP_GET) == &_resources[i]) {
+                found++;
+            }
+        }
+    }
+    scan_time = xtimer_now_usec() - start;
+
+    start = xtimer_now_usec();
+    for (unsigned n = 0; n < ITERATIONS; n++) {
+        for (unsigned i = 0; i < RESOURCES_NUMOF; i++) {
+            const coap_resource_t *resource;
+
+            if ((coap_resource_index_find(&_index, _paths[i], COAP_GET,
+                                          &resource) == 0) &&
+                (resource == &_resources[i])) {
+                found++;
+            }
+        }
+    }
+    index_time = xtimer_now_usec() - start;
+
+    if (found != (2U * ITERATIONS * RESOURCES_NUMOF)) {
+        puts("FAILED: not all resources found");
+        return 1;
+    }
+    printf("{ \"resources\" : %u, \"lookups\" : %u, \"scan\" : %" PRIu32
+           ", \"index\" : %" PRIu32 " }\n", (unsigned)RESOURCES_NUMOF,
+           ITERATIONS * (unsigned)RESOURCES_NUMOF, scan_time, index_time);
+    puts("SUCCESS");
+
+    return 0;
+}
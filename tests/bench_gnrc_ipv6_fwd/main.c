@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure IPv6 packets forwarded per second
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/ipv6/nib.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/ipv6/hdr.h"
+#include "net/netdev_test.h"
+#include "net/protnum.h"
+#include "xtimer.h"
+
+#ifndef TEST_DURATION
+#define TEST_DURATION       (1000000U)
+#endif
+
+#define TEST_HL             (64U)
+#define TEST_MTU            (1500U)
+#define PAYLOAD_SIZES_NUMOF (sizeof(_payload_sizes) / sizeof(_payload_sizes[0]))
+
+static const size_t _payload_sizes[] = { 8U, 256U, 1232U };
+static const uint8_t _next_hop_l2addr[] = { 0x3e, 0xe6, 0xb5, 0x0f, 0x19, 0x22 };
+static const uint8_t _src_l2addr[] = { 0x3e, 0xe6, 0xb5, 0x0f, 0x19, 0x23 };
+
+static netdev_test_t _devs[2];
+static char _netif_stacks[2][THREAD_STACKSIZE_DEFAULT];
+static uint8_t _payload[1232U];
+static volatile unsigned _flag = 0;
+static unsigned _forwarded = 0;
+
+static ipv6_addr_t _src, _dst, _next_hop;
+
+static void _timer_callback(void *arg)
+{
+    (void)arg;
+
+    _flag = 1;
+}
+
+static int _get_device_type(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    (void)max_len;
+    *((uint16_t *)value) = NETDEV_TYPE_UNKNOWN;
+    return sizeof(uint16_t);
+}
+
+static int _get_max_packet_size(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    (void)max_len;
+    *((uint16_t *)value) = TEST_MTU;
+    return sizeof(uint16_t);
+}
+
+static int _mock_netif_send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *ipv6 = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_IPV6);
+
+    (void)netif;
+    /* don't count neighbor discovery messages */
+    if ((ipv6 != NULL) && (((ipv6_hdr_t *)ipv6->data)->hl == (TEST_HL - 1))) {
+        _forwarded++;
+    }
+    gnrc_pktbuf_release(pkt);
+    return 0;
+}
+
+static const gnrc_netif_ops_t _mock_ops = {
+    .send = _mock_netif_send,
+    .get = gnrc_netif_get_from_netdev,
+    .set = gnrc_netif_set_from_netdev,
+};
+
+static gnrc_netif_t *_create_netif(unsigned i)
+{
+    netdev_test_setup(&_devs[i], NULL);
+    netdev_test_set_get_cb(&_devs[i], NETOPT_DEVICE_TYPE, _get_device_type);
+    netdev_test_set_get_cb(&_devs[i], NETOPT_MAX_PACKET_SIZE,
+                           _get_max_packet_size);
+    return gnrc_netif_create(_netif_stacks[i], sizeof(_netif_stacks[i]),
+                             GNRC_NETIF_PRIO, "mock", (netdev_t *)&_devs[i],
+                             &_mock_ops);
+}
+
+static gnrc_pktsnip_t *_build_rcv_pkt(gnrc_netif_t *ingress, size_t size)
+{
+    gnrc_pktsnip_t *netif, *ipv6, *payload;
+    ipv6_hdr_t *hdr;
+
+    netif = gnrc_netif_hdr_build((uint8_t *)_src_l2addr, sizeof(_src_l2addr),
+                                 NULL, 0);
+    if (netif == NULL) {
+        return NULL;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = ingress->pid;
+    ipv6 = gnrc_pktbuf_add(netif, NULL, sizeof(ipv6_hdr_t), GNRC_NETTYPE_IPV6);
+    if (ipv6 == NULL) {
+        gnrc_pktbuf_release(netif);
+        return NULL;
+    }
+    hdr = ipv6->data;
+    memset(hdr, 0, sizeof(ipv6_hdr_t));
+    ipv6_hdr_set_version(hdr);
+    hdr->len = byteorder_htons(size);
+    hdr->nh = PROTNUM_IPV6_NONXT;
+    hdr->hl = TEST_HL;
+    hdr->src = _src;
+    hdr->dst = _dst;
+    /* received packets are in receive order: payload first */
+    payload = gnrc_pktbuf_add(ipv6, _payload, size, GNRC_NETTYPE_UNDEF);
+    if (payload == NULL) {
+        gnrc_pktbuf_release(ipv6);
+        return NULL;
+    }
+    return payload;
+}
+
+int main(void)
+{
+    gnrc_netif_t *ingress, *egress;
+    xtimer_t timer = { .callback = _timer_callback };
+
+    puts("IPv6 forwarding benchmark");
+    ipv6_addr_from_str(&_src, "2001:db8:1::1");
+    ipv6_addr_from_str(&_dst, "2001:db8:2::1");
+    ipv6_addr_from_str(&_next_hop, "fe80::3ce6:b5ff:fe0f:1922");
+
+    ingress = _create_netif(0);
+    egress = _create_netif(1);
+    if ((gnrc_ipv6_nib_ft_add(&_dst, 64U, &_next_hop, egress->pid, 0) < 0) ||
+        (gnrc_ipv6_nib_nc_set(&_next_hop, egress->pid, _next_hop_l2addr,
+                              sizeof(_next_hop_l2addr)) < 0)) {
+        puts("FAILED: unable to configure route");
+        return 1;
+    }
+
+    for (unsigned i = 0; i < PAYLOAD_SIZES_NUMOF; i++) {
+        uint32_t injected = 0;
+
+        _flag = 0;
+        _forwarded = 0;
+        xtimer_set(&timer, TEST_DURATION);
+        while (!_flag) {
+            gnrc_pktsnip_t *pkt = _build_rcv_pkt(ingress, _payload_sizes[i]);
+
+            if (pkt == NULL) {
+                /* packet buffer is full, give lower-priority threads a
+                 * chance to drain it */
+                thread_yield();
+                continue;
+            }
+            if (gnrc_netapi_receive(gnrc_ipv6_pid, pkt) < 1) {
+                gnrc_pktbuf_release(pkt);
+                continue;
+            }
+            injected++;
+        }
+        if (_forwarded > injected) {
+            puts("FAILED: forwarded more packets than injected");
+            return 1;
+        }
+        printf("{ \"payload\" : %u, \"result\" : %u }\n",
+               (unsigned)_payload_sizes[i], _forwarded);
+    }
+    puts("SUCCESS");
+
+    return 0;
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the throughput of 6LoWPAN fragmentation over
+ *              socket_zep
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "net/gnrc.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/sixlowpan/frag.h"
+#include "net/ieee802154.h"
+#include "net/ipv6.h"
+#include "net/ipv6/hdr.h"
+#include "net/protnum.h"
+#include "utlist.h"
+#include "xtimer.h"
+
+#define DATAGRAMS_NUMOF     (64U)
+#define DATAGRAM_SIZE       (IPV6_MIN_MTU)
+#define PAYLOAD_SIZE        (DATAGRAM_SIZE - sizeof(ipv6_hdr_t))
+
+static const uint8_t _dst_l2addr[] = { 0x3e, 0xe6, 0xb5, 0x0f, 0x19, 0x22, 0x00, 0x02 };
+
+static uint8_t _payload[PAYLOAD_SIZE];
+
+static gnrc_pktsnip_t *_build_datagram(gnrc_netif_t *netif, uint32_t seq)
+{
+    gnrc_pktsnip_t *netif_hdr, *ipv6, *payload;
+    ipv6_hdr_t *hdr;
+
+    memcpy(_payload, &seq, sizeof(seq));
+    payload = gnrc_pktbuf_add(NULL, _payload, PAYLOAD_SIZE, GNRC_NETTYPE_UNDEF);
+    if (payload == NULL) {
+        return NULL;
+    }
+    ipv6 = gnrc_pktbuf_add(payload, NULL, sizeof(ipv6_hdr_t), GNRC_NETTYPE_IPV6);
+    if (ipv6 == NULL) {
+        gnrc_pktbuf_release(payload);
+        return NULL;
+    }
+    hdr = ipv6->data;
+    memset(hdr, 0, sizeof(ipv6_hdr_t));
+    ipv6_hdr_set_version(hdr);
+    hdr->len = byteorder_htons(PAYLOAD_SIZE);
+    hdr->nh = PROTNUM_IPV6_NONXT;
+    hdr->hl = 64U;
+    ipv6_addr_set_link_local_prefix(&hdr->src);
+    ieee802154_get_iid((eui64_t *)&hdr->src.u64[1], netif->l2addr,
+                       netif->l2addr_len);
+    ipv6_addr_set_link_local_prefix(&hdr->dst);
+    ieee802154_get_iid((eui64_t *)&hdr->dst.u64[1], _dst_l2addr,
+                       sizeof(_dst_l2addr));
+    netif_hdr = gnrc_netif_hdr_build(netif->l2addr, netif->l2addr_len,
+                                     (uint8_t *)_dst_l2addr,
+                                     sizeof(_dst_l2addr));
+    if (netif_hdr == NULL) {
+        gnrc_pktbuf_release(ipv6);
+        return NULL;
+    }
+    ((gnrc_netif_hdr_t *)netif_hdr->data)->if_pid = netif->pid;
+    LL_PREPEND(ipv6, netif_hdr);
+    return netif_hdr;
+}
+
+/* waits until 6LoWPAN handed all fragments of the previous datagram to the
+ * interface */
+static void _wait_for_sender(void)
+{
+    while (gnrc_sixlowpan_msg_frag_get() == NULL) {
+        /* 6LoWPAN and the interface have a higher priority, so they only
+         * let us run while they are waiting */
+        thread_yield();
+    }
+}
+
+int main(void)
+{
+    gnrc_netif_t *netif = gnrc_netif_iter(NULL);
+    uint32_t start, duration;
+
+    puts("6LoWPAN fragmentation throughput test");
+    if (netif == NULL) {
+        puts("FAILED: no interface");
+        return 1;
+    }
+    /* let neighbor discovery on start-up pass */
+    xtimer_sleep(1);
+
+    start = xtimer_now_usec();
+    for (uint32_t seq = 0; seq < DATAGRAMS_NUMOF; seq++) {
+        gnrc_pktsnip_t *pkt;
+
+        _wait_for_sender();
+        if ((pkt = _build_datagram(netif, seq)) == NULL) {
+            printf("FAILED: unable to send datagram %u\n", (unsigned)seq);
+            return 1;
+        }
+        if (!gnrc_netapi_dispatch_send(GNRC_NETTYPE_SIXLOWPAN,
+                                       GNRC_NETREG_DEMUX_CTX_ALL, pkt)) {
+            gnrc_pktbuf_release(pkt);
+        }
+    }
+    _wait_for_sender();
+    duration = xtimer_now_usec() - start;
+
+    printf("sent %u datagrams of %u bytes in %u us\n", DATAGRAMS_NUMOF,
+           DATAGRAM_SIZE, (unsigned)duration);
+    printf("{ \"payload\" : %u, \"pacing\" : %u, \"result\" : %u }\n",
+           DATAGRAM_SIZE, GNRC_SIXLOWPAN_FRAG_PACING_US,
+           (unsigned)(((uint64_t)DATAGRAMS_NUMOF * DATAGRAM_SIZE * 8U * US_PER_MS) /
+                      duration));
+    puts("SUCCESS");
+
+    return 0;
+}
@@ -0,0 +1,103 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+import socket
+import struct
+
+IEEE802154_FRAME_LEN_MAX = 127
+ZEP_DATA_HEADER_SIZE = 32
+FCS_LEN = 2
+RCVBUF_LEN = IEEE802154_FRAME_LEN_MAX + ZEP_DATA_HEADER_SIZE + FCS_LEN
+zep_params = {
+        "local_addr": "::",
+        "local_port": 12345,
+        "remote_addr": "::1",
+        "remote_port": 17754,
+    }
+SIXLOWPAN_FRAG_DISP_MASK = 0xf8
+SIXLOWPAN_FRAG_1_DISP = 0xc0
+SIXLOWPAN_FRAG_N_DISP = 0xe0
+SIXLOWPAN_FRAG_SIZE_MASK = 0x07ff
+s = None
+
+
+def ieee802154_hdr_len(frame):
+    """Returns the length of the MAC header of an IEEE 802.15.4 frame"""
+    fcf, = struct.unpack_from("<H", frame)
+    addr_lens = {0: 0, 2: 2, 3: 8}
+    dst_mode = (fcf >> 10) & 0x3
+    src_mode = (fcf >> 14) & 0x3
+    pan_comp = fcf & 0x40
+    length = 3     # frame control field and sequence number
+    if dst_mode:
+        length += 2 + addr_lens[dst_mode]
+    if src_mode:
+        length += (0 if (pan_comp and dst_mode) else 2) + addr_lens[src_mode]
+    return length
+
+
+def frag_tag(frame, datagram_size):
+    """Returns the datagram tag, if the frame is a fragment of a datagram of
+    datagram_size bytes, None otherwise"""
+    sixlo = frame[ieee802154_hdr_len(frame):]
+    if (len(sixlo) < 4) or \
+       ((sixlo[0] & SIXLOWPAN_FRAG_DISP_MASK) not in (SIXLOWPAN_FRAG_1_DISP,
+                                                      SIXLOWPAN_FRAG_N_DISP)):
+        return None
+    disp_size, tag = struct.unpack_from(">HH", sixlo)
+    if (disp_size & SIXLOWPAN_FRAG_SIZE_MASK) != datagram_size:
+        return None
+    return tag
+
+
+def testfunc(child):
+    child.expect(r"sent (?P<datagrams>\d+) datagrams of (?P<size>\d+) bytes "
+                 r"in \d+ us")
+    datagrams = int(child.match.group('datagrams'))
+    size = int(child.match.group('size'))
+    child.expect(r"{ \"payload\" : \d+, \"pacing\" : \d+, \"result\" : \d+ }")
+    child.expect_exact("SUCCESS")
+    # fragments per datagram tag, other frames (e.g. of neighbor discovery)
+    # are ignored
+    frags = {}
+    s.settimeout(1)
+    try:
+        while True:
+            data, addr = s.recvfrom(RCVBUF_LEN)
+            assert(len(data) > (ZEP_DATA_HEADER_SIZE + FCS_LEN))
+            tag = frag_tag(data[ZEP_DATA_HEADER_SIZE:-FCS_LEN], size)
+            if tag is not None:
+                frags[tag] = frags.get(tag, 0) + 1
+    except socket.timeout:
+        pass
+    # every datagram needs to be split into the same number of fragments
+    assert(len(frags) == datagrams)
+    assert(len(set(frags.values())) == 1)
+    assert(list(frags.values())[0] > 1)
+
+
+if __name__ == "__main__":
+    sys.path.append(os.path.join(os.environ['RIOTTOOLS'], 'testrunner'))
+    import testrunner
+
+    os.environ['TERMFLAGS'] = "-z [%s]:%d,[%s]:%d" % (
+            zep_params['local_addr'], zep_params['local_port'],
+            zep_params['remote_addr'], zep_params['remote_port'])
+    s = socket.socket(family=socket.AF_INET6, type=socket.SOCK_DGRAM)
+    s.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, 1 << 20)
+    s.bind(("::", zep_params['remote_port']))
+    res = testrunner.run(testfunc, timeout=30, echo=True, traceback=True)
+    s.close()
+    if (res == 0):
+        print("Run tests successful")
+    else:
+        print("Run tests failed")
+    sys.exit(res)
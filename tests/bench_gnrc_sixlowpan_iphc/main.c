@@ -0,0 +1,250 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the throughput of 6LoWPAN IPHC compression and
+ *              decompression
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan/ctx.h"
+#include "net/gnrc/sixlowpan/iphc.h"
+#include "net/ieee802154.h"
+#include "net/ipv6/addr.h"
+#include "net/ipv6/hdr.h"
+#include "net/protnum.h"
+#include "net/udp.h"
+#include "xtimer.h"
+
+#define PAYLOAD_SIZE        (16U)
+#define BATCH               (8U)
+#define ITERATIONS          (512U)
+
+typedef struct {
+    const char *name;
+    const char *src;    /* NULL: link-local address derived from L2 address */
+    const char *dst;    /* NULL: link-local address derived from L2 address */
+    uint32_t fl;
+    uint16_t src_port;
+    uint16_t dst_port;
+    uint8_t tc;
+    uint8_t hl;
+} _case_t;
+
+static const uint8_t _src_l2[] = { 0x3e, 0xe6, 0xb5, 0x0f, 0x19, 0x22, 0x00, 0x01 };
+static const uint8_t _dst_l2[] = { 0x3e, 0xe6, 0xb5, 0x0f, 0x19, 0x22, 0x00, 0x02 };
+
+static const _case_t _cases[] = {
+    { "link-local L2", NULL, NULL, 0, 0xf0b1, 0xf0b2, 0, 64 },
+    { "link-local 16 bit", "fe80::ff:fe00:1", "fe80::ff:fe00:2",
+      0, 0xf001, 5683, 0, 255 },
+    { "context 0 64 bit", "2001:db8::1", "2001:db8::2", 0, 5683, 0xf002, 0, 1 },
+    { "context 1 L2", "2001:db8:1::3ce6:b50f:1922:1",
+      "2001:db8:1::3ce6:b50f:1922:2", 0, 5683, 5683, 0xb8, 64 },
+    { "multicast 8 bit", NULL, "ff02::1", 0x12345, 0xf0b1, 0xf0b2, 0, 64 },
+    { "inline", "2001:db8:ffff::1", "2001:db8:fffe::1", 0xabcde, 1234, 5678,
+      0xb8, 42 },
+};
+
+#define CASES_NUMOF         (sizeof(_cases) / sizeof(_cases[0]))
+
+static void _init_ctx(void)
+{
+    ipv6_addr_t prefix = IPV6_ADDR_UNSPECIFIED;
+
+    gnrc_sixlowpan_ctx_reset();
+    prefix.u16[0] = byteorder_htons(0x2001);
+    prefix.u16[1] = byteorder_htons(0x0db8);
+    gnrc_sixlowpan_ctx_update(0, &prefix, 64, UINT16_MAX, true);
+    prefix.u16[2] = byteorder_htons(0x0001);
+    gnrc_sixlowpan_ctx_update(1, &prefix, 64, UINT16_MAX, true);
+}
+
+static void _init_addr(ipv6_addr_t *addr, const char *str, const uint8_t *l2)
+{
+    if (str == NULL) {
+        ipv6_addr_set_link_local_prefix(addr);
+        ieee802154_get_iid((eui64_t *)&addr->u64[1], l2,
+                           IEEE802154_LONG_ADDRESS_LEN);
+    }
+    else {
+        ipv6_addr_from_str(addr, str);
+    }
+}
+
+static gnrc_pktsnip_t *_netif_hdr_build(void)
+{
+    return gnrc_netif_hdr_build((uint8_t *)_src_l2, sizeof(_src_l2),
+                                (uint8_t *)_dst_l2, sizeof(_dst_l2));
+}
+
+/* builds [netif][IPv6][UDP][payload] as handed down to 6LoWPAN */
+static gnrc_pktsnip_t *_build_pkt(const _case_t *c)
+{
+    gnrc_pktsnip_t *payload, *udp, *ipv6, *netif;
+    udp_hdr_t *udp_hdr;
+    ipv6_hdr_t *ipv6_hdr;
+
+    payload = gnrc_pktbuf_add(NULL, NULL, PAYLOAD_SIZE, GNRC_NETTYPE_UNDEF);
+    if (payload == NULL) {
+        return NULL;
+    }
+    memset(payload->data, 0xa5, PAYLOAD_SIZE);
+    udp = gnrc_pktbuf_add(payload, NULL, sizeof(udp_hdr_t), GNRC_NETTYPE_UDP);
+    if (udp == NULL) {
+        gnrc_pktbuf_release(payload);
+        return NULL;
+    }
+    udp_hdr = udp->data;
+    udp_hdr->src_port = byteorder_htons(c->src_port);
+    udp_hdr->dst_port = byteorder_htons(c->dst_port);
+    udp_hdr->length = byteorder_htons(sizeof(udp_hdr_t) + PAYLOAD_SIZE);
+    udp_hdr->checksum = byteorder_htons(0xabcd);
+    ipv6 = gnrc_pktbuf_add(udp, NULL, sizeof(ipv6_hdr_t), GNRC_NETTYPE_IPV6);
+    if (ipv6 == NULL) {
+        gnrc_pktbuf_release(udp);
+        return NULL;
+    }
+    ipv6_hdr = ipv6->data;
+    memset(ipv6_hdr, 0, sizeof(ipv6_hdr_t));
+    ipv6_hdr_set_version(ipv6_hdr);
+    ipv6_hdr_set_tc(ipv6_hdr, c->tc);
+    ipv6_hdr_set_fl(ipv6_hdr, c->fl);
+    ipv6_hdr->len = udp_hdr->length;
+    ipv6_hdr->nh = PROTNUM_UDP;
+    ipv6_hdr->hl = c->hl;
+    _init_addr(&ipv6_hdr->src, c->src, _src_l2);
+    _init_addr(&ipv6_hdr->dst, c->dst, _dst_l2);
+    if ((netif = _netif_hdr_build()) == NULL) {
+        gnrc_pktbuf_release(ipv6);
+        return NULL;
+    }
+    netif->next = ipv6;
+    return netif;
+}
+
+/* flattens an encoded packet into a received frame: [frame][netif] */
+static gnrc_pktsnip_t *_to_frame(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *netif = _netif_hdr_build(), *frame;
+    size_t offset = 0;
+
+    if (netif == NULL) {
+        return NULL;
+    }
+    frame = gnrc_pktbuf_add(netif, NULL, gnrc_pkt_len(pkt->next),
+                            GNRC_NETTYPE_SIXLOWPAN);
+    if (frame == NULL) {
+        gnrc_pktbuf_release(netif);
+        return NULL;
+    }
+    for (gnrc_pktsnip_t *snip = pkt->next; snip != NULL; snip = snip->next) {
+        memcpy((uint8_t *)frame->data + offset, snip->data, snip->size);
+        offset += snip->size;
+    }
+    return frame;
+}
+
+/* decodes a frame into the room reserved for IPv6 and UDP header, as
+ * gnrc_sixlowpan does for unfragmented frames */
+static gnrc_pktsnip_t *_decode(gnrc_pktsnip_t *frame, size_t *disp_len)
+{
+    gnrc_pktsnip_t *dec_hdr = gnrc_pktbuf_add(NULL, NULL,
+                                              sizeof(ipv6_hdr_t) +
+                                              sizeof(udp_hdr_t),
+                                              GNRC_NETTYPE_IPV6);
+    size_t nh_len = 0;
+
+    if (dec_hdr != NULL) {
+        *disp_len = gnrc_sixlowpan_iphc_decode(&dec_hdr, frame, 0, 0,
+                                               &nh_len);
+        if (*disp_len == 0) {
+            gnrc_pktbuf_release(dec_hdr);
+            return NULL;
+        }
+    }
+    return dec_hdr;
+}
+
+static int _run(const _case_t *c)
+{
+    gnrc_pktsnip_t *pkts[BATCH];
+    uint32_t enc = 0, dec = 0, start;
+    size_t disp_len = 0;
+
+    for (unsigned i = 0; i < (ITERATIONS / BATCH); i++) {
+        for (unsigned j = 0; j < BATCH; j++) {
+            if ((pkts[j] = _build_pkt(c)) == NULL) {
+                return -1;
+            }
+        }
+        start = xtimer_now_usec();
+        for (unsigned j = 0; j < BATCH; j++) {
+            gnrc_sixlowpan_iphc_encode(pkts[j]);
+        }
+        enc += xtimer_now_usec() - start;
+        for (unsigned j = 0; j < BATCH; j++) {
+            gnrc_pktsnip_t *frame = _to_frame(pkts[j]);
+
+            gnrc_pktbuf_release(pkts[j]);
+            if (frame == NULL) {
+                return -1;
+            }
+            pkts[j] = frame;
+        }
+        start = xtimer_now_usec();
+        for (unsigned j = 0; j < BATCH; j++) {
+            /* keep decoded header with the frame for releasing */
+            gnrc_pktsnip_t *dec_hdr = _decode(pkts[j], &disp_len);
+
+            if (dec_hdr == NULL) {
+                return -1;
+            }
+            dec_hdr->next->next = pkts[j];
+            pkts[j] = dec_hdr;
+        }
+        dec += xtimer_now_usec() - start;
+        for (unsigned j = 0; j < BATCH; j++) {
+            gnrc_pktbuf_release(pkts[j]);
+        }
+    }
+    printf("{ \"case\" : \"%s\", \"dispatch\" : %u, \"packets\" : %u, "
+           "\"encode\" : %" PRIu32 ", \"decode\" : %" PRIu32 " }\n", c->name,
+           (unsigned)disp_len, ITERATIONS, enc, dec);
+    return 0;
+}
+
+int main(void)
+{
+    puts("6LoWPAN IPHC throughput test");
+    _init_ctx();
+    for (unsigned i = 0; i < CASES_NUMOF; i++) {
+        if (_run(&_cases[i]) < 0) {
+            printf("FAILED: %s\n", _cases[i].name);
+            return 1;
+        }
+    }
+    if (!gnrc_pktbuf_is_empty()) {
+        puts("FAILED: packet buffer not empty");
+        return 1;
+    }
+    puts("SUCCESS");
+
+    return 0;
+}
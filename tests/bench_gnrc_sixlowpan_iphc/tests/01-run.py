@@ -0,0 +1,27 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+
+CASES_NUMOF = 6
+
+
+def testfunc(child):
+    for _ in range(CASES_NUMOF):
+        child.expect(r"{ \"case\" : \"[^\"]+\", \"dispatch\" : \d+, "
+                     r"\"packets\" : \d+, \"encode\" : \d+, "
+                     r"\"decode\" : \d+ }")
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.path.append(os.path.join(os.environ['RIOTTOOLS'], 'testrunner'))
+    from testrunner import run
+    sys.exit(run(testfunc))
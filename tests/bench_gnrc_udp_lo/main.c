@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure local UDP round-trips per second over the loopback
+ *              interface
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "net/gnrc/netif/lo.h"
+#include "net/ipv6/addr.h"
+#include "net/sock/udp.h"
+#include "xtimer.h"
+
+#ifndef TEST_DURATION
+#define TEST_DURATION       (1000000U)
+#endif
+
+#define TEST_SERVER_PORT    (61616U)
+#define TEST_CLIENT_PORT    (61617U)
+#define TEST_TIMEOUT        (100000U)
+#define PAYLOAD_SIZES_NUMOF (sizeof(_payload_sizes) / sizeof(_payload_sizes[0]))
+
+static const size_t _payload_sizes[] = { 8U, 256U, 1232U };
+
+static uint8_t _payload[1232U];
+static uint8_t _rcv_buf[1232U];
+static volatile unsigned _flag = 0;
+
+static sock_udp_t _server, _client;
+
+static void _timer_callback(void *arg)
+{
+    (void)arg;
+
+    _flag = 1;
+}
+
+static int _round_trip(size_t size)
+{
+    sock_udp_ep_t remote;
+    ssize_t res;
+
+    if (sock_udp_send(&_client, _payload, size, NULL) < 0) {
+        return -1;
+    }
+    res = sock_udp_recv(&_server, _rcv_buf, sizeof(_rcv_buf), TEST_TIMEOUT,
+                        &remote);
+    if ((res < 0) || ((size_t)res != size)) {
+        return -1;
+    }
+    if (sock_udp_send(&_server, _rcv_buf, res, &remote) < 0) {
+        return -1;
+    }
+    res = sock_udp_recv(&_client, _rcv_buf, sizeof(_rcv_buf), TEST_TIMEOUT,
+                        NULL);
+    if ((res < 0) || ((size_t)res != size)) {
+        return -1;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
+    sock_udp_ep_t remote = SOCK_IPV6_EP_ANY;
+    xtimer_t timer = { .callback = _timer_callback };
+
+    puts("UDP loopback round-trip benchmark");
+    if (gnrc_netif_lo_get() == NULL) {
+        puts("FAILED: no loopback interface");
+        return 1;
+    }
+    memset(_payload, 0xa5, sizeof(_payload));
+
+    local.port = TEST_SERVER_PORT;
+    if (sock_udp_create(&_server, &local, NULL, 0) < 0) {
+        puts("FAILED: unable to create server sock");
+        return 1;
+    }
+    local.port = TEST_CLIENT_PORT;
+    ipv6_addr_set_loopback((ipv6_addr_t *)&remote.addr.ipv6);
+    remote.port = TEST_SERVER_PORT;
+    if (sock_udp_create(&_client, &local, &remote, 0) < 0) {
+        puts("FAILED: unable to create client sock");
+        return 1;
+    }
+
+    for (unsigned i = 0; i < PAYLOAD_SIZES_NUMOF; i++) {
+        unsigned round_trips = 0;
+
+        _flag = 0;
+        xtimer_set(&timer, TEST_DURATION);
+        while (!_flag) {
+            if (_round_trip(_payload_sizes[i]) < 0) {
+                xtimer_remove(&timer);
+                printf("FAILED: round-trip with payload %u failed\n",
+                       (unsigned)_payload_sizes[i]);
+                return 1;
+            }
+            round_trips++;
+        }
+        printf("{ \"payload\" : %u, \"result\" : %u }\n",
+               (unsigned)_payload_sizes[i], round_trips);
+    }
+    puts("SUCCESS");
+
+    return 0;
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the throughput of the Internet checksum
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "net/inet_csum.h"
+#include "xtimer.h"
+
+#define ITERATIONS          (1000U)
+
+static const uint16_t _sizes[] = { 8, 64, 256, 1280 };
+
+#define SIZES_NUMOF         (sizeof(_sizes) / sizeof(_sizes[0]))
+
+static uint8_t _buf[1280];
+
+/* what inet_csum() did before summing words at a time */
+static uint16_t _csum_bytewise(uint16_t sum, const uint8_t *buf, uint16_t len)
+{
+    uint32_t csum = sum;
+
+    for (unsigned i = 0; i < len; i++) {
+        csum += (i & 1) ? buf[i] : (buf[i] << 8);
+    }
+    while (csum >> 16) {
+        csum = (csum & 0xffff) + (csum >> 16);
+    }
+    return csum;
+}
+
+int main(void)
+{
+    puts("inet_csum throughput test");
+
+    for (unsigned i = 0; i < sizeof(_buf); i++) {
+        _buf[i] = (uint8_t)((i * 151) + (i >> 3));
+    }
+    for (unsigned i = 0; i < SIZES_NUMOF; i++) {
+        uint32_t start, bytewise_time, csum_time;
+        uint16_t bytewise = 0, csum = 0;
+
+        start = xtimer_now_usec();
+        for (unsigned n = 0; n < ITERATIONS; n++) {
+            bytewise = _csum_bytewise(bytewise, _buf, _sizes[i]);
+        }
+        bytewise_time = xtimer_now_usec() - start;
+
+        start = xtimer_now_usec();
+        for (unsigned n = 0; n < ITERATIONS; n++) {
+            csum = inet_csum(csum, _buf, _sizes[i]);
+        }
+        csum_time = xtimer_now_usec() - start;
+
+        if (csum != bytewise) {
+            printf("FAILED: checksums of %u bytes differ\n",
+                   (unsigned)_sizes[i]);
+            return 1;
+        }
+        printf("{ \"size\" : %u, \"iterations\" : %u, \"bytewise\" : %"
+               PRIu32 ", \"inet_csum\" : %" PRIu32 " }\n",
+               (unsigned)_sizes[i], ITERATIONS, bytewise_time, csum_time);
+    }
+    puts("SUCCESS");
+
+    return 0;
+}
@@ -0,0 +1,25 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+SIZES = (8, 64, 256, 1280)
+
+
+def testfunc(child):
+    for size in SIZES:
+        child.expect(r"{ \"size\" : %d, \"iterations\" : \d+, "
+                     r"\"bytewise\" : \d+, \"inet_csum\" : \d+ }" % size)
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.path.append(os.path.join(os.environ['RIOTTOOLS'], 'testrunner'))
+    from testrunner import run
+    sys.exit(run(testfunc))
@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the throughput of gcoap blockwise transfers
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "net/gcoap.h"
+#include "net/nanocoap_sock.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define REPR_SIZE           (64U * 1024U)
+#define SERVER_PORT         (GCOAP_PORT + 1)
+#define SERVER_BUF_SIZE     (GCOAP_PDU_BUF_SIZE)
+#define MAIN_QUEUE_SIZE     (8U)
+
+static ssize_t _source_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                               void *ctx);
+static ssize_t _sink_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                             void *ctx);
+
+const coap_resource_t coap_resources[] = {
+    { "/sink", COAP_POST, _sink_handler, NULL },
+    { "/source", COAP_GET, _source_handler, NULL },
+};
+
+const unsigned coap_resources_numof = sizeof(coap_resources) /
+                                      sizeof(coap_resources[0]);
+
+static char _server_stack[THREAD_STACKSIZE_DEFAULT];
+static uint8_t _server_buf[SERVER_BUF_SIZE];
+static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
+static mutex_t _done = MUTEX_INIT_LOCKED;
+static gcoap_block_xfer_t _xfer;
+static size_t _received;       /* counted by client (block2) or server */
+static unsigned _state;
+static bool _corrupt;
+
+static inline uint8_t _pattern(size_t offset)
+{
+    return (uint8_t)((offset * 7) + (offset >> 8));
+}
+
+static bool _check(size_t offset, const uint8_t *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        if (data[i] != _pattern(offset + i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* generates the representation, for the server as well as for the client */
+static ssize_t _gen(void *ctx, size_t offset, uint8_t *buf, size_t len)
+{
+    (void)ctx;
+    if (offset >= REPR_SIZE) {
+        return 0;
+    }
+    if (len > (REPR_SIZE - offset)) {
+        len = REPR_SIZE - offset;
+    }
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = _pattern(offset + i);
+    }
+    return len;
+}
+
+static ssize_t _source_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                               void *ctx)
+{
+    return coap_block2_reply(pdu, buf, len, COAP_FORMAT_OCTET, _gen, ctx);
+}
+
+static ssize_t _sink_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                             void *ctx)
+{
+    coap_block1_t block1;
+    uint8_t *payload_start = buf + coap_get_total_hdr_len(pdu);
+    uint8_t *bufpos = payload_start;
+
+    (void)ctx;
+    coap_get_block1(pdu, &block1);
+    if ((block1.offset != _received) ||
+        !_check(block1.offset, pdu->payload, pdu->payload_len)) {
+        return coap_build_reply(pdu, COAP_CODE_REQUEST_ENTITY_INCOMPLETE,
+                                buf, len, 0);
+    }
+    _received += pdu->payload_len;
+    bufpos += coap_put_block1_ok(bufpos, &block1, 0);
+    return coap_build_reply(pdu, (block1.more == 1) ? COAP_CODE_231
+                                                    : COAP_CODE_204,
+                            buf, len, bufpos - payload_start);
+}
+
+static void *_server(void *arg)
+{
+    sock_udp_ep_t local = { .family = AF_INET6, .port = SERVER_PORT };
+
+    (void)arg;
+    nanocoap_server(&local, _server_buf, sizeof(_server_buf));
+    return NULL;
+}
+
+/* runs on the gcoap thread */
+static void _block_handler(gcoap_block_xfer_t *xfer, unsigned state,
+                           coap_pkt_t *pdu, size_t offset)
+{
+    (void)xfer;
+    switch (state) {
+        case GCOAP_BLOCK_NEXT:
+            if (!_check(offset, pdu->payload, pdu->payload_len)) {
+                _corrupt = true;
+            }
+            _received += pdu->payload_len;
+            return;
+        case GCOAP_BLOCK_DONE:
+            if ((pdu != NULL) && (coap_get_code_raw(pdu) != COAP_CODE_204)) {
+                state = GCOAP_BLOCK_ERR;
+            }
+            break;
+        default:
+            break;
+    }
+    _state = state;
+    mutex_unlock(&_done);
+}
+
+static int _run(const char *name)
+{
+    sock_udp_ep_t remote = { .family = AF_INET6,
+                             .netif = SOCK_ADDR_ANY_NETIF,
+                             .port = SERVER_PORT };
+    uint32_t start, time;
+    int res;
+
+    ipv6_addr_set_loopback((ipv6_addr_t *)&remote.addr.ipv6);
+    _received = 0;
+    _corrupt = false;
+    start = xtimer_now_usec();
+    if (strcmp(name, "block2") == 0) {
+        res = gcoap_block2_get(&_xfer, &remote, "/source", _block_handler,
+                               NULL);
+    }
+    else {
+        res = gcoap_block1_send(&_xfer, &remote, "/sink", COAP_METHOD_POST,
+                                _gen, _block_handler, NULL);
+    }
+    if (res < 0) {
+        printf("%s: unable to start transfer\n", name);
+        return -1;
+    }
+    mutex_lock(&_done);
+    time = xtimer_now_usec() - start;
+    if ((_state != GCOAP_BLOCK_DONE) || _corrupt || (_received != REPR_SIZE)) {
+        printf("%s: failed after %u bytes\n", name, (unsigned)_received);
+        return -1;
+    }
+    printf("{ \"transfer\" : \"%s\", \"size\" : %u, \"time\" : %" PRIu32
+           ", \"result\" : %" PRIu32 " }\n", name, REPR_SIZE, time,
+           (uint32_t)(((uint64_t)REPR_SIZE * 8 * 1000) / time));
+    return 0;
+}
+
+int main(void)
+{
+    msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+    thread_create(_server_stack, sizeof(_server_stack),
+                  THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                  _server, NULL, "nanocoap");
+
+    if ((_run("block2") < 0) || (_run("block1") < 0)) {
+        puts("FAILED");
+        return 1;
+    }
+    puts("SUCCESS");
+
+    return 0;
+}
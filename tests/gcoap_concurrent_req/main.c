@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Keeps as many gcoap requests open as gcoap allows
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/gcoap.h"
+#include "net/nanocoap_sock.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define REQ_NUMOF           (GCOAP_REQ_WAITING_MAX)
+/* each server gets GCOAP_NSTART requests, the last one none */
+#define SERVER_NUMOF        (REQ_NUMOF / GCOAP_NSTART)
+#define SERVER_PORT         (GCOAP_PORT + 1)
+#define SERVER_BUF_SIZE     (64U)
+#define REQ_PATH            "/value"
+#define RESP_TIMEOUT        (1U * US_PER_SEC)
+#define MAIN_QUEUE_SIZE     (8U)
+
+#if SERVER_NUMOF < 2
+#error "GCOAP_REQ_WAITING_MAX must allow twice GCOAP_NSTART requests"
+#endif
+
+static ssize_t _value_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                              void *ctx);
+
+const coap_resource_t coap_resources[] = {
+    { REQ_PATH, COAP_GET, _value_handler, NULL },
+};
+
+const unsigned coap_resources_numof = sizeof(coap_resources) /
+                                      sizeof(coap_resources[0]);
+
+static char _server_stacks[SERVER_NUMOF][THREAD_STACKSIZE_DEFAULT];
+static uint8_t _server_bufs[SERVER_NUMOF][SERVER_BUF_SIZE];
+static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
+static volatile unsigned _responses = 0;
+
+static ssize_t _value_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                              void *ctx)
+{
+    (void)ctx;
+    return coap_reply_simple(pdu, COAP_CODE_205, buf, len, COAP_FORMAT_TEXT,
+                             (uint8_t *)"42", 2);
+}
+
+static void *_server(void *arg)
+{
+    unsigned i = (uintptr_t)arg;
+    sock_udp_ep_t local = { .family = AF_INET6, .port = SERVER_PORT + i };
+
+    nanocoap_server(&local, _server_bufs[i], sizeof(_server_bufs[i]));
+    return NULL;
+}
+
+/* runs on the gcoap thread */
+static void _resp_handler(unsigned req_state, coap_pkt_t *pdu,
+                          sock_udp_ep_t *remote)
+{
+    (void)remote;
+    if ((req_state == GCOAP_MEMO_RESP) && (coap_get_code(pdu) == 205)) {
+        _responses++;
+    }
+}
+
+static size_t _send_req(unsigned server, unsigned type)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+    sock_udp_ep_t remote = { .family = AF_INET6,
+                             .netif = SOCK_ADDR_ANY_NETIF,
+                             .port = SERVER_PORT + server };
+    ssize_t len;
+
+    ipv6_addr_set_loopback((ipv6_addr_t *)&remote.addr.ipv6);
+    if (gcoap_req_init(&pdu, buf, sizeof(buf), COAP_METHOD_GET, REQ_PATH) < 0) {
+        return 0;
+    }
+    coap_hdr_set_type(pdu.hdr, type);
+    len = gcoap_finish(&pdu, 0, COAP_FORMAT_NONE);
+    if (len < 0) {
+        return 0;
+    }
+    return gcoap_req_send2(buf, len, &remote, _resp_handler);
+}
+
+/* opens REQ_NUMOF requests of a type and waits for their responses */
+static int _round(unsigned type, const char *name)
+{
+    unsigned sent = 0;
+
+    _responses = 0;
+    /* servers 0 to SERVER_NUMOF - 2 get GCOAP_NSTART open requests each */
+    for (unsigned i = 0; i < REQ_NUMOF - GCOAP_NSTART; i++) {
+        if (_send_req(i % (SERVER_NUMOF - 1), type) > 0) {
+            sent++;
+        }
+    }
+    printf("%s: open requests: %u of %u\n", name, (unsigned)gcoap_op_state(),
+           sent);
+    if (sent != REQ_NUMOF - GCOAP_NSTART) {
+        puts("FAILED");
+        return 1;
+    }
+    /* server 0 is at NSTART, so these wait for its responses */
+    for (unsigned i = 0; i < GCOAP_NSTART; i++) {
+        if (_send_req(0, type) == 0) {
+            puts("FAILED: request over NSTART not queued");
+            return 1;
+        }
+        sent++;
+    }
+    if (gcoap_op_state() != REQ_NUMOF) {
+        puts("FAILED: queued requests not tracked");
+        return 1;
+    }
+    printf("%s: requests over NSTART queued\n", name);
+    /* queued requests hold memos too, so the pool is exhausted */
+    if (_send_req(SERVER_NUMOF - 1, type) != 0) {
+        puts("FAILED: request over pool size sent");
+        return 1;
+    }
+    printf("%s: request over pool size dropped\n", name);
+
+    for (unsigned t = 0; (_responses < sent) && (t < RESP_TIMEOUT);
+         t += US_PER_MS) {
+        xtimer_usleep(US_PER_MS);
+    }
+    printf("%s: received %u of %u responses\n", name, _responses, sent);
+    if ((_responses != sent) || (gcoap_op_state() != 0)) {
+        puts("FAILED");
+        return 1;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+    /* the servers only get to answer once main sleeps */
+    for (unsigned i = 0; i < SERVER_NUMOF; i++) {
+        thread_create(_server_stacks[i], sizeof(_server_stacks[i]),
+                      THREAD_PRIORITY_MAIN + 1, THREAD_CREATE_STACKTEST,
+                      _server, (void *)(uintptr_t)i, "nanocoap");
+    }
+    /* let the servers open their socks */
+    xtimer_usleep(10U * US_PER_MS);
+
+    if (_round(COAP_TYPE_NON, "NON") || _round(COAP_TYPE_CON, "CON")) {
+        return 1;
+    }
+    puts("SUCCESS");
+
+    return 0;
+}
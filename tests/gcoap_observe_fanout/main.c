@@ -0,0 +1,269 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Sends one gcoap Observe notification to many observers
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/gcoap.h"
+#include "net/sock/udp.h"
+#include "xtimer.h"
+
+#define OBSERVER_NUMOF      (GCOAP_OBS_CLIENTS_MAX)
+#define OBSERVER_PORT       (GCOAP_PORT + 1)
+#define RESOURCE_PATH       "/reading"
+#define READING             "21.5 C"
+#define RECV_TIMEOUT        (100U * US_PER_MS)
+#define MAIN_QUEUE_SIZE     (8U)
+
+static ssize_t _reading_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                                void *ctx);
+
+static const coap_resource_t _resources[] = {
+    { RESOURCE_PATH, COAP_GET, _reading_handler, NULL },
+};
+
+static gcoap_listener_t _listener = {
+    (coap_resource_t *)&_resources[0],
+    sizeof(_resources) / sizeof(_resources[0]),
+    NULL
+};
+
+/* one more observer than fits into the pool of clients */
+static sock_udp_t _socks[OBSERVER_NUMOF + 1];
+static uint16_t _msgids[OBSERVER_NUMOF];
+static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
+
+static ssize_t _reading_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                                void *ctx)
+{
+    (void)ctx;
+    gcoap_resp_init(pdu, buf, len, COAP_CODE_CONTENT);
+    memcpy(pdu->payload, READING, strlen(READING));
+    return gcoap_finish(pdu, strlen(READING), COAP_FORMAT_TEXT);
+}
+
+/* observers use tokens of all lengths, to vary the header they get */
+static unsigned _token(unsigned observer, uint8_t *token)
+{
+    unsigned token_len = (observer % GCOAP_TOKENLEN_MAX) + 1;
+
+    for (unsigned i = 0; i < token_len; i++) {
+        token[i] = (observer << 3) + i;
+    }
+    return token_len;
+}
+
+static bool _has_token(coap_pkt_t *pkt, unsigned observer)
+{
+    uint8_t token[GCOAP_TOKENLEN_MAX];
+    unsigned token_len = _token(observer, token);
+
+    return (coap_get_token_len(pkt) == token_len) &&
+           (memcmp(pkt->token, token, token_len) == 0);
+}
+
+static bool _has_reading(coap_pkt_t *pkt)
+{
+    return (pkt->payload_len == strlen(READING)) &&
+           (memcmp(pkt->payload, READING, strlen(READING)) == 0);
+}
+
+/* sends a GET request with Observe option for the resource; returns 1 if the
+ * response has an Observe option, 0 if not, and -1 on failure */
+static int _observe(unsigned observer, uint32_t observe)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    uint8_t token[GCOAP_TOKENLEN_MAX];
+    coap_pkt_t pkt;
+    uint32_t value;
+    sock_udp_ep_t remote = { .family = AF_INET6,
+                             .netif = SOCK_ADDR_ANY_NETIF,
+                             .port = GCOAP_PORT };
+    unsigned token_len = _token(observer, token);
+    ssize_t len = coap_build_hdr((coap_hdr_t *)buf, COAP_TYPE_NON, token,
+                                 token_len, COAP_METHOD_GET, observer);
+
+    ipv6_addr_set_loopback((ipv6_addr_t *)&remote.addr.ipv6);
+    coap_pkt_init(&pkt, buf, sizeof(buf), len);
+    coap_opt_add_uint(&pkt, COAP_OPT_OBSERVE, observe);
+    coap_opt_add_string(&pkt, COAP_OPT_URI_PATH, RESOURCE_PATH, '/');
+    len = coap_opt_finish(&pkt, COAP_OPT_FINISH_NONE);
+
+    if (sock_udp_send(&_socks[observer], buf, len, &remote) <= 0) {
+        return -1;
+    }
+    len = sock_udp_recv(&_socks[observer], buf, sizeof(buf), RECV_TIMEOUT,
+                        NULL);
+    if ((len <= 0) || (coap_parse(&pkt, buf, len) < 0) ||
+        (coap_get_code(&pkt) != 205) || !_has_token(&pkt, observer) ||
+        !_has_reading(&pkt)) {
+        return -1;
+    }
+    /* a registration is confirmed by the Observe option in the response */
+    return (coap_get_option_uint(&pkt, COAP_OPT_OBSERVE, &value) == 0);
+}
+
+static size_t _notify(void)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+    ssize_t len;
+
+    if (gcoap_obs_notify_init(&pdu, buf, sizeof(buf), &_resources[0]) !=
+        GCOAP_OBS_INIT_OK) {
+        return 0;
+    }
+    memcpy(pdu.payload, READING, strlen(READING));
+    len = gcoap_finish(&pdu, strlen(READING), COAP_FORMAT_TEXT);
+    if (len < 0) {
+        return 0;
+    }
+    return gcoap_obs_notify(&pdu, len, &_resources[0]);
+}
+
+/* sends the notification with the API that encodes it for one observer */
+static size_t _notify_legacy(void)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+    ssize_t len;
+
+    if (gcoap_obs_init(&pdu, buf, sizeof(buf), &_resources[0]) !=
+        GCOAP_OBS_INIT_OK) {
+        return 0;
+    }
+    memcpy(pdu.payload, READING, strlen(READING));
+    len = gcoap_finish(&pdu, strlen(READING), COAP_FORMAT_TEXT);
+    if (len < 0) {
+        return 0;
+    }
+    return gcoap_obs_send(buf, len, &_resources[0]);
+}
+
+/* receives the notification for an observer, and returns true if it is
+ * addressed to it, with a message ID no other observer got */
+static bool _recv_notification(unsigned observer)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pkt;
+    uint32_t value;
+    ssize_t len = sock_udp_recv(&_socks[observer], buf, sizeof(buf),
+                                RECV_TIMEOUT, NULL);
+
+    if ((len <= 0) || (coap_parse(&pkt, buf, len) < 0) ||
+        (coap_get_type(&pkt) != COAP_TYPE_NON) ||
+        (coap_get_code(&pkt) != 205) || !_has_token(&pkt, observer) ||
+        !_has_reading(&pkt) ||
+        (coap_get_option_uint(&pkt, COAP_OPT_OBSERVE, &value) != 0)) {
+        return false;
+    }
+    _msgids[observer] = coap_get_id(&pkt);
+    for (unsigned i = 0; i < observer; i++) {
+        if (_msgids[i] == _msgids[observer]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(void)
+{
+    unsigned registered = 0, received = 0;
+    size_t notified;
+    uint32_t start, time;
+
+    msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+    gcoap_register_listener(&_listener);
+
+    for (unsigned i = 0; i < (OBSERVER_NUMOF + 1); i++) {
+        sock_udp_ep_t local = { .family = AF_INET6,
+                                .port = OBSERVER_PORT + i };
+
+        if (sock_udp_create(&_socks[i], &local, NULL, 0) < 0) {
+            puts("FAILED: unable to create sock");
+            return 1;
+        }
+    }
+
+    for (unsigned i = 0; i < OBSERVER_NUMOF; i++) {
+        if (_observe(i, COAP_OBS_REGISTER) == 1) {
+            registered++;
+        }
+    }
+    printf("registered %u of %u observers\n", registered, OBSERVER_NUMOF);
+    if (registered != OBSERVER_NUMOF) {
+        puts("FAILED");
+        return 1;
+    }
+    /* the response still arrives, just without Observe option */
+    if (_observe(OBSERVER_NUMOF, COAP_OBS_REGISTER) != 0) {
+        puts("FAILED: registration over pool size accepted");
+        return 1;
+    }
+    puts("registration over pool size refused");
+
+    start = xtimer_now_usec();
+    notified = _notify();
+    time = xtimer_now_usec() - start;
+    printf("notified %u of %u observers in %" PRIu32 " us\n",
+           (unsigned)notified, OBSERVER_NUMOF, time);
+    for (unsigned i = 0; i < OBSERVER_NUMOF; i++) {
+        if (_recv_notification(i)) {
+            received++;
+        }
+    }
+    printf("received %u of %u notifications\n", received, OBSERVER_NUMOF);
+    if ((notified != OBSERVER_NUMOF) || (received != OBSERVER_NUMOF)) {
+        puts("FAILED");
+        return 1;
+    }
+
+    received = 0;
+    if (_notify_legacy() == 0) {
+        puts("FAILED: legacy notification not sent");
+        return 1;
+    }
+    for (unsigned i = 0; i < OBSERVER_NUMOF; i++) {
+        if (_recv_notification(i)) {
+            received++;
+        }
+    }
+    printf("received %u of %u legacy notifications\n", received,
+           OBSERVER_NUMOF);
+    if (received != OBSERVER_NUMOF) {
+        puts("FAILED");
+        return 1;
+    }
+
+    if (_observe(0, COAP_OBS_DEREGISTER) != 0) {
+        puts("FAILED: deregistration");
+        return 1;
+    }
+    notified = _notify();
+    printf("notified %u of %u observers after deregistration\n",
+           (unsigned)notified, OBSERVER_NUMOF - 1);
+    if (notified != (OBSERVER_NUMOF - 1)) {
+        puts("FAILED");
+        return 1;
+    }
+    puts("SUCCESS");
+
+    return 0;
+}
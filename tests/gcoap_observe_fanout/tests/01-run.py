@@ -0,0 +1,31 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+
+def testfunc(child):
+    child.expect(r"registered (\d+) of (\d+) observers")
+    assert child.match.group(1) == child.match.group(2)
+    child.expect_exact("registration over pool size refused")
+    child.expect(r"notified (\d+) of (\d+) observers in \d+ us")
+    assert child.match.group(1) == child.match.group(2)
+    child.expect(r"received (\d+) of (\d+) notifications")
+    assert child.match.group(1) == child.match.group(2)
+    child.expect(r"received (\d+) of (\d+) legacy notifications")
+    assert child.match.group(1) == child.match.group(2)
+    child.expect(r"notified (\d+) of (\d+) observers after deregistration")
+    assert child.match.group(1) == child.match.group(2)
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.path.append(os.path.join(os.environ['RIOTTOOLS'], 'testrunner'))
+    from testrunner import run
+    sys.exit(run(testfunc))
@@ -0,0 +1,267 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the response cache of the gcoap proxy
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/gcoap.h"
+#include "net/gcoap_proxy.h"
+#include "net/sock/udp.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define UPSTREAM_PORT       (GCOAP_PORT + 1)
+#define CLIENT_PORT         (GCOAP_PORT + 2)
+#define CLIENT_NUMOF        (3U)
+#define UPSTREAM_DELAY      (50U * US_PER_MS)
+#define RECV_TIMEOUT        (500U * US_PER_MS)
+#define MAX_AGE             (3U)
+#define ETAG                (0x7631U)
+#define HITS_NUMOF          (100U)
+#define MAIN_QUEUE_SIZE     (8U)
+
+static char _upstream_stack[THREAD_STACKSIZE_MAIN];
+static sock_udp_t _upstream_sock;
+static sock_udp_t _socks[CLIENT_NUMOF];
+static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
+static unsigned _upstream_reqs;
+static uint16_t _msgid;
+/* Max-Age of the last response received, or UINT32_MAX if it had none */
+static uint32_t _max_age;
+
+static gcoap_proxy_route_t _route = {
+    .path = "/sensor",
+    .upstream = { .family = AF_INET6,
+                  .netif = SOCK_ADDR_ANY_NETIF,
+                  .port = UPSTREAM_PORT },
+};
+
+/*
+ * Slow upstream server: answers every GET with the path requested as
+ * payload, or with 2.03 if the request carries the current ETag.
+ */
+static void *_upstream(void *arg)
+{
+    (void)arg;
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    sock_udp_ep_t local = { .family = AF_INET6, .port = UPSTREAM_PORT };
+    sock_udp_ep_t remote;
+    coap_pkt_t pkt;
+
+    sock_udp_create(&_upstream_sock, &local, NULL, 0);
+    while (1) {
+        ssize_t len = sock_udp_recv(&_upstream_sock, buf, sizeof(buf),
+                                    SOCK_NO_TIMEOUT, &remote);
+        char path[NANOCOAP_URI_MAX];
+        uint8_t token[GCOAP_TOKENLEN_MAX];
+        unsigned token_len;
+        unsigned code = COAP_CODE_CONTENT;
+        uint32_t etag;
+
+        if ((len <= 0) || (coap_parse(&pkt, buf, len) < 0)) {
+            continue;
+        }
+        _upstream_reqs++;
+        xtimer_usleep(UPSTREAM_DELAY);
+
+        strcpy(path, (char *)pkt.url);
+        if ((coap_get_option_uint(&pkt, COAP_OPT_ETAG, &etag) == 0) &&
+            (etag == ETAG)) {
+            code = COAP_CODE_VALID;
+        }
+        token_len = coap_get_token_len(&pkt);
+        memcpy(token, pkt.token, token_len);
+        len = coap_build_hdr((coap_hdr_t *)buf, COAP_TYPE_NON, token,
+                             token_len, code, coap_get_id(&pkt));
+        coap_pkt_init(&pkt, buf, sizeof(buf), len);
+        coap_opt_add_uint(&pkt, COAP_OPT_ETAG, ETAG);
+        coap_opt_add_uint(&pkt, COAP_OPT_MAX_AGE, MAX_AGE);
+        if (code == COAP_CODE_CONTENT) {
+            len = coap_opt_finish(&pkt, COAP_OPT_FINISH_PAYLOAD);
+            memcpy(pkt.payload, path, strlen(path));
+            len += strlen(path);
+        }
+        else {
+            len = coap_opt_finish(&pkt, COAP_OPT_FINISH_NONE);
+        }
+        sock_udp_send(&_upstream_sock, buf, len, &remote);
+    }
+    return NULL;
+}
+
+static void _send_get(unsigned client, const char *path, const char *proxy_uri)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    uint8_t token = client;
+    uint8_t *pos = buf;
+    sock_udp_ep_t remote = { .family = AF_INET6,
+                             .netif = SOCK_ADDR_ANY_NETIF,
+                             .port = GCOAP_PORT };
+
+    ipv6_addr_set_loopback((ipv6_addr_t *)&remote.addr.ipv6);
+    pos += coap_build_hdr((coap_hdr_t *)buf, COAP_TYPE_CON, &token, 1,
+                          COAP_METHOD_GET, _msgid++);
+    if (path) {
+        pos += coap_put_option_uri(pos, 0, path, COAP_OPT_URI_PATH);
+    }
+    if (proxy_uri) {
+        pos += coap_put_option(pos, 0, COAP_OPT_PROXY_URI,
+                               (uint8_t *)proxy_uri, strlen(proxy_uri));
+    }
+    sock_udp_send(&_socks[client], buf, pos - buf, &remote);
+}
+
+/*
+ * Receives the response for a client, skipping an empty ACK, and returns
+ * true if it carries the expected payload. Stores its Max-Age in _max_age.
+ */
+static bool _recv_content(unsigned client, const char *payload)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pkt;
+
+    while (1) {
+        ssize_t len = sock_udp_recv(&_socks[client], buf, sizeof(buf),
+                                    RECV_TIMEOUT, NULL);
+
+        if ((len <= 0) || (coap_parse(&pkt, buf, len) < 0)) {
+            return false;
+        }
+        if (coap_get_code_raw(&pkt) != COAP_CODE_EMPTY) {
+            break;
+        }
+    }
+    if (coap_get_option_uint(&pkt, COAP_OPT_MAX_AGE, &_max_age) != 0) {
+        _max_age = UINT32_MAX;
+    }
+    return (coap_get_code_raw(&pkt) == COAP_CODE_CONTENT) &&
+           (coap_get_token_len(&pkt) == 1) && (pkt.token[0] == client) &&
+           (pkt.payload_len == strlen(payload)) &&
+           (memcmp(pkt.payload, payload, pkt.payload_len) == 0);
+}
+
+static uint32_t _get(const char *path, const char *proxy_uri,
+                     const char *payload, bool *ok)
+{
+    uint32_t start = xtimer_now_usec();
+
+    _send_get(0, path, proxy_uri);
+    *ok = _recv_content(0, payload);
+    return xtimer_now_usec() - start;
+}
+
+int main(void)
+{
+    gcoap_proxy_stats_t stats;
+    uint32_t miss_time, hits_time = 0;
+    unsigned upstream_reqs, hits_ok = 0;
+    bool ok;
+
+    msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+    for (unsigned i = 0; i < CLIENT_NUMOF; i++) {
+        sock_udp_ep_t local = { .family = AF_INET6, .port = CLIENT_PORT + i };
+
+        if (sock_udp_create(&_socks[i], &local, NULL, 0) < 0) {
+            puts("FAILED: unable to create sock");
+            return 1;
+        }
+    }
+    thread_create(_upstream_stack, sizeof(_upstream_stack),
+                  THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                  _upstream, NULL, "upstream");
+    ipv6_addr_set_loopback((ipv6_addr_t *)&_route.upstream.addr.ipv6);
+    gcoap_proxy_add_route(&_route);
+
+    /* the first request goes upstream, the others are answered from cache */
+    miss_time = _get("/sensor/temp", NULL, "/sensor/temp", &ok);
+    printf("miss: %" PRIu32 " us\n", miss_time);
+    if (!ok) {
+        puts("FAILED: no response for miss");
+        return 1;
+    }
+    for (unsigned i = 0; i < HITS_NUMOF; i++) {
+        hits_time += _get("/sensor/temp", NULL, "/sensor/temp", &ok);
+        hits_ok += ok;
+    }
+    printf("hit: %" PRIu32 " us on average, %u of %u ok\n",
+           hits_time / HITS_NUMOF, hits_ok, HITS_NUMOF);
+    if ((hits_ok != HITS_NUMOF) || (_upstream_reqs != 1)) {
+        puts("FAILED");
+        return 1;
+    }
+
+    /* a response from the cache carries the remaining freshness */
+    xtimer_usleep(US_PER_SEC + (100U * US_PER_MS));
+    _get("/sensor/temp", NULL, "/sensor/temp", &ok);
+    printf("cached Max-Age: %" PRIu32 "\n", _max_age);
+    if (!ok || (_max_age >= MAX_AGE)) {
+        puts("FAILED");
+        return 1;
+    }
+
+    /* identical requests while the first is upstream share its response */
+    upstream_reqs = _upstream_reqs;
+    for (unsigned i = 0; i < CLIENT_NUMOF; i++) {
+        _send_get(i, "/sensor/humidity", NULL);
+    }
+    for (unsigned i = 0; i < CLIENT_NUMOF; i++) {
+        if (!_recv_content(i, "/sensor/humidity")) {
+            puts("FAILED: no response for concurrent request");
+            return 1;
+        }
+    }
+    printf("concurrent: %u requests, %u upstream\n", CLIENT_NUMOF,
+           _upstream_reqs - upstream_reqs);
+    if ((_upstream_reqs - upstream_reqs) != 1) {
+        puts("FAILED");
+        return 1;
+    }
+
+    /* a stale response is validated upstream by its ETag */
+    xtimer_usleep((MAX_AGE * US_PER_SEC) + (100U * US_PER_MS));
+    _get("/sensor/temp", NULL, "/sensor/temp", &ok);
+    gcoap_proxy_get_stats(&stats);
+    printf("revalidated: %" PRIu32 "\n", stats.revalidated);
+    if (!ok || (stats.revalidated != 1)) {
+        puts("FAILED");
+        return 1;
+    }
+
+    /* forward proxy */
+    _get(NULL, "coap://[::1]:5684/sensor/light", "/sensor/light", &ok);
+    if (!ok) {
+        puts("FAILED: no response for Proxy-Uri");
+        return 1;
+    }
+    puts("forward proxy ok");
+
+    gcoap_proxy_get_stats(&stats);
+    printf("requests: %" PRIu32 ", hits: %" PRIu32 ", coalesced: %" PRIu32
+           ", fetches: %" PRIu32 "\n", stats.requests, stats.hits,
+           stats.coalesced, stats.fetches);
+    printf("hit rate: %" PRIu32 " %%\n", (stats.hits * 100) / stats.requests);
+    if ((stats.fetches != _upstream_reqs) || (stats.coalesced != 2)) {
+        puts("FAILED");
+        return 1;
+    }
+    puts("SUCCESS");
+
+    return 0;
+}
@@ -0,0 +1,31 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+
+def testfunc(child):
+    child.expect(r"miss: (\d+) us")
+    miss = int(child.match.group(1))
+    child.expect(r"hit: (\d+) us on average, (\d+) of (\d+) ok")
+    assert int(child.match.group(1)) < miss
+    assert child.match.group(2) == child.match.group(3)
+    child.expect(r"cached Max-Age: (\d+)")
+    assert int(child.match.group(1)) < 3
+    child.expect(r"concurrent: \d+ requests, 1 upstream")
+    child.expect_exact("revalidated: 1")
+    child.expect_exact("forward proxy ok")
+    child.expect(r"hit rate: \d+ %")
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.path.append(os.path.join(os.environ['RIOTTOOLS'], 'testrunner'))
+    from testrunner import run
+    sys.exit(run(testfunc))
@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compares OF0 and MRHOF in a simulated lossy network
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "net/gnrc/rpl.h"
+#include "net/gnrc/rpl/of_manager.h"
+#include "net/gnrc/rpl/of_mrhof.h"
+#include "net/gnrc/rpl/structs.h"
+#include "net/netstats/neighbor.h"
+#include "random.h"
+#include "utlist.h"
+
+#define NODES_NUMOF         (6U)
+#define ROOT                (0U)
+#define PACKETS_NUMOF       (1000U)
+#define PARENT_INTERVAL     (50U)
+#define TX_ATTEMPTS         (4U)
+#define RANDOM_SEED         (0x6719)
+#define LQI_MAX             (255U)
+
+typedef struct {
+    gnrc_rpl_instance_t inst;
+    gnrc_rpl_parent_t parents[NODES_NUMOF];
+    netstats_nb_table_t nb;
+} node_t;
+
+typedef struct {
+    unsigned delivered;
+    unsigned retransmissions;
+} result_t;
+
+/* packet delivery ratio of the links, in percent; 0 for no link */
+static const uint8_t _pdr[NODES_NUMOF][NODES_NUMOF] = {
+    {  0, 95, 90, 20, 25,  0 },
+    { 95,  0, 60, 95,  0,  0 },
+    { 90, 60,  0,  0, 90, 30 },
+    { 20, 95,  0,  0, 50, 90 },
+    { 25,  0, 90, 50,  0, 40 },
+    {  0,  0, 30, 90, 40,  0 },
+};
+
+static node_t _nodes[NODES_NUMOF];
+
+static void _l2_addr(unsigned id, uint8_t *l2_addr)
+{
+    static const uint8_t base[] = { 0x02, 0x00, 0x00, 0xff,
+                                    0xfe, 0x00, 0x00, 0x00 };
+
+    memcpy(l2_addr, base, sizeof(base));
+    l2_addr[7] = id;
+}
+
+static unsigned _id(const gnrc_rpl_parent_t *parent)
+{
+    return parent->addr.u8[15];
+}
+
+static void _init(gnrc_rpl_of_t *of)
+{
+    memset(_nodes, 0, sizeof(_nodes));
+    for (unsigned i = 0; i < NODES_NUMOF; i++) {
+        node_t *node = &_nodes[i];
+        gnrc_rpl_dodag_t *dodag = &node->inst.dodag;
+
+        node->inst.of = of;
+        node->inst.min_hop_rank_inc = GNRC_RPL_DEFAULT_MIN_HOP_RANK_INCREASE;
+        dodag->instance = &node->inst;
+        dodag->iface = KERNEL_PID_UNDEF;
+        dodag->my_rank = (i == ROOT) ? GNRC_RPL_ROOT_RANK
+                                     : GNRC_RPL_INFINITE_RANK;
+        of->reset(dodag);
+        netstats_nb_init(&node->nb);
+        for (unsigned j = 0; j < NODES_NUMOF; j++) {
+            uint8_t l2_addr[8];
+
+            node->parents[j].dodag = dodag;
+            ipv6_addr_set_link_local_prefix(&node->parents[j].addr);
+            node->parents[j].addr.u8[15] = j;
+            if (_pdr[i][j] == 0) {
+                continue;
+            }
+            /* frames heard from the neighbor give a first estimate */
+            _l2_addr(j, l2_addr);
+            netstats_nb_update_rx(&node->nb, l2_addr, sizeof(l2_addr), -80,
+                                  (_pdr[i][j] * LQI_MAX) / 100);
+        }
+    }
+}
+
+/*
+ * Chooses the parents of all nodes, the way the DODAG does on each DIO:
+ * sorts the neighbors with a lower rank and calculates the rank from the
+ * preferred one.
+ */
+static void _select_parents(void)
+{
+    for (unsigned i = 0; i < NODES_NUMOF; i++) {
+        gnrc_rpl_dodag_t *dodag = &_nodes[i].inst.dodag;
+        gnrc_rpl_of_t *of = _nodes[i].inst.of;
+
+        if (i == ROOT) {
+            continue;
+        }
+        dodag->parents = NULL;
+        for (unsigned j = 0; j < NODES_NUMOF; j++) {
+            gnrc_rpl_parent_t *parent = &_nodes[i].parents[j];
+            uint16_t rank = _nodes[j].inst.dodag.my_rank;
+            uint8_t l2_addr[8];
+
+            if ((_pdr[i][j] == 0) || (rank == GNRC_RPL_INFINITE_RANK) ||
+                (rank >= dodag->my_rank)) {
+                continue;
+            }
+            _l2_addr(j, l2_addr);
+            parent->next = NULL;
+            parent->rank = rank;
+            parent->link_metric = netstats_nb_get(&_nodes[i].nb, l2_addr,
+                                                  sizeof(l2_addr))->etx;
+            parent->link_metric_type = GNRC_RPL_MRHOF_METRIC_ETX;
+            LL_APPEND(dodag->parents, parent);
+        }
+        if (dodag->parents != NULL) {
+            LL_SORT(dodag->parents, of->parent_cmp);
+            dodag->my_rank = of->calc_rank(dodag->parents, 0);
+        }
+    }
+}
+
+/*
+ * Sends a packet from a node to the root, with up to TX_ATTEMPTS
+ * transmissions per hop.
+ */
+static bool _send(unsigned src, result_t *res)
+{
+    unsigned cur = src;
+
+    for (unsigned hops = 0; cur != ROOT; hops++) {
+        gnrc_rpl_parent_t *parent = _nodes[cur].inst.dodag.parents;
+        netstats_nb_result_t tx_res = NETSTATS_NB_NOACK;
+        uint8_t l2_addr[8];
+        unsigned next, attempt;
+
+        if ((parent == NULL) || (hops >= NODES_NUMOF)) {
+            return false;
+        }
+        next = _id(parent);
+        for (attempt = 0; attempt < TX_ATTEMPTS; attempt++) {
+            if (random_uint32_range(0, 100) < _pdr[cur][next]) {
+                tx_res = NETSTATS_NB_SUCCESS;
+                break;
+            }
+        }
+        res->retransmissions += (attempt < TX_ATTEMPTS) ? attempt
+                                                        : TX_ATTEMPTS - 1;
+        _l2_addr(next, l2_addr);
+        netstats_nb_record(&_nodes[cur].nb, l2_addr, sizeof(l2_addr));
+        netstats_nb_update_tx(&_nodes[cur].nb, tx_res, attempt);
+        if (tx_res != NETSTATS_NB_SUCCESS) {
+            return false;
+        }
+        cur = next;
+    }
+    return true;
+}
+
+static void _run(const char *name, gnrc_rpl_of_t *of, result_t *res)
+{
+    memset(res, 0, sizeof(*res));
+    random_init(RANDOM_SEED);
+    _init(of);
+    /* let the ranks settle, one hop per round */
+    for (unsigned i = 0; i < NODES_NUMOF; i++) {
+        _select_parents();
+    }
+    for (unsigned p = 0; p < PACKETS_NUMOF; p++) {
+        if ((p % PARENT_INTERVAL) == 0) {
+            _select_parents();
+        }
+        for (unsigned i = 0; i < NODES_NUMOF; i++) {
+            if ((i != ROOT) && _send(i, res)) {
+                res->delivered++;
+            }
+        }
+    }
+    for (unsigned i = 0; i < NODES_NUMOF; i++) {
+        gnrc_rpl_dodag_t *dodag = &_nodes[i].inst.dodag;
+
+        if ((i != ROOT) && (dodag->parents != NULL)) {
+            printf("%s: node %u: parent %u, rank %u\n", name, i,
+                   _id(dodag->parents), dodag->my_rank);
+        }
+    }
+    printf("%s: delivered %u of %u packets, %u retransmissions\n", name,
+           res->delivered, (NODES_NUMOF - 1) * PACKETS_NUMOF,
+           res->retransmissions);
+}
+
+int main(void)
+{
+    gnrc_rpl_of_t *of0, *mrhof;
+    result_t of0_res, mrhof_res;
+
+    gnrc_rpl_of_manager_init();
+    of0 = gnrc_rpl_get_of_for_ocp(0);
+    mrhof = gnrc_rpl_get_of_for_ocp(GNRC_RPL_MRHOF_OCP);
+    if ((of0 == NULL) || (mrhof == NULL) || (of0 == mrhof)) {
+        puts("FAILED: objective functions not registered");
+        return 1;
+    }
+
+    _run("OF0", of0, &of0_res);
+    _run("MRHOF", mrhof, &mrhof_res);
+    if ((mrhof_res.delivered <= of0_res.delivered) ||
+        (mrhof_res.retransmissions >= of0_res.retransmissions)) {
+        puts("FAILED");
+        return 1;
+    }
+    puts("SUCCESS");
+
+    return 0;
+}
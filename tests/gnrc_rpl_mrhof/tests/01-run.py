@@ -0,0 +1,26 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+
+def testfunc(child):
+    child.expect(r"OF0: delivered (\d+) of (\d+) packets, (\d+) retransmissions")
+    of0_delivered = int(child.match.group(1))
+    of0_retrans = int(child.match.group(3))
+    child.expect(r"MRHOF: delivered (\d+) of (\d+) packets, (\d+) retransmissions")
+    assert int(child.match.group(1)) > of0_delivered
+    assert int(child.match.group(3)) < of0_retrans
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.path.append(os.path.join(os.environ['RIOTTOOLS'], 'testrunner'))
+    from testrunner import run
+    sys.exit(run(testfunc))
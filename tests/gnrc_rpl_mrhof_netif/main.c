@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests the link metric of MRHOF on a mockup interface
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "embUnit.h"
+#include "embUnit/embUnit.h"
+#include "net/ethernet.h"
+#include "net/gnrc/ipv6/nib/nc.h"
+#include "net/gnrc/netif/ethernet.h"
+#include "net/gnrc/netif/internal.h"
+#include "net/gnrc/rpl.h"
+#include "net/gnrc/rpl/of_mrhof.h"
+#include "net/gnrc/rpl/structs.h"
+#include "net/netdev_test.h"
+#include "net/netstats/neighbor.h"
+
+#define RETRIES             (3U)
+
+static const uint8_t _loc_l2[] = { 0xce, 0xab, 0xfe, 0xad, 0xf7, 0x26 };
+static const uint8_t _nc_l2[] = { 0x02, 0x00, 0x5e, 0x10, 0x00, 0x01 };
+/* EUI-64 of the interface identifier of _eui64_addr */
+static const uint8_t _eui64_l2[] = { 0x10, 0x34, 0x56, 0xff,
+                                     0xfe, 0x78, 0x9a, 0xbc };
+static const ipv6_addr_t _nc_addr = { {
+        0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x20, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07
+    } };
+static const ipv6_addr_t _eui64_addr = { {
+        0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x12, 0x34, 0x56, 0xff, 0xfe, 0x78, 0x9a, 0xbc
+    } };
+
+static gnrc_netif_t *_mock_netif;
+static netdev_test_t _mock_netdev;
+static char _mock_netif_stack[THREAD_STACKSIZE_DEFAULT];
+static gnrc_rpl_instance_t _inst;
+static gnrc_rpl_parent_t _parents[2];
+
+static int _get_device_type(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    assert(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = NETDEV_TYPE_ETHERNET;
+    return sizeof(uint16_t);
+}
+
+static int _get_max_packet_size(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    assert(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = ETHERNET_DATA_LEN;
+    return sizeof(uint16_t);
+}
+
+static int _get_address(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    assert(max_len >= sizeof(_loc_l2));
+    memcpy(value, _loc_l2, sizeof(_loc_l2));
+    return sizeof(_loc_l2);
+}
+
+static void _tests_init(void)
+{
+    netdev_test_setup(&_mock_netdev, 0);
+    netdev_test_set_get_cb(&_mock_netdev, NETOPT_DEVICE_TYPE,
+                           _get_device_type);
+    netdev_test_set_get_cb(&_mock_netdev, NETOPT_MAX_PACKET_SIZE,
+                           _get_max_packet_size);
+    netdev_test_set_get_cb(&_mock_netdev, NETOPT_ADDRESS, _get_address);
+    _mock_netif = gnrc_netif_ethernet_create(
+            _mock_netif_stack, THREAD_STACKSIZE_DEFAULT, GNRC_NETIF_PRIO,
+            "mockup_eth", &_mock_netdev.netdev
+        );
+    assert(_mock_netif != NULL);
+}
+
+static void _set_up(void)
+{
+    gnrc_netif_acquire(_mock_netif);
+    netstats_nb_init(&_mock_netif->neighbors);
+    gnrc_netif_release(_mock_netif);
+
+    memset(&_inst, 0, sizeof(_inst));
+    memset(_parents, 0, sizeof(_parents));
+    _inst.of = gnrc_rpl_get_of_mrhof();
+    _inst.min_hop_rank_inc = GNRC_RPL_DEFAULT_MIN_HOP_RANK_INCREASE;
+    _inst.dodag.instance = &_inst;
+    _inst.dodag.iface = _mock_netif->pid;
+    _inst.of->reset(&_inst.dodag);
+    for (unsigned i = 0; i < (sizeof(_parents) / sizeof(_parents[0])); i++) {
+        _parents[i].dodag = &_inst.dodag;
+        _parents[i].rank = GNRC_RPL_ROOT_RANK;
+    }
+}
+
+static void _tear_down(void)
+{
+    gnrc_ipv6_nib_nc_del(&_nc_addr, _mock_netif->pid);
+}
+
+/*
+ * Sends a frame to a neighbor that needs RETRIES retransmissions, and
+ * returns the resulting ETX, or 0 if it was not counted.
+ */
+static uint16_t _send(const uint8_t *l2addr, size_t l2addr_len)
+{
+    netstats_nb_t *nb;
+
+    gnrc_netif_acquire(_mock_netif);
+    netstats_nb_record(&_mock_netif->neighbors, l2addr, l2addr_len);
+    nb = netstats_nb_update_tx(&_mock_netif->neighbors, NETSTATS_NB_SUCCESS,
+                               RETRIES);
+    gnrc_netif_release(_mock_netif);
+    return (nb != NULL) ? nb->etx : 0;
+}
+
+static void test_update_parent__neighbor_cache(void)
+{
+    gnrc_rpl_parent_t *parent = &_parents[0];
+    uint16_t etx;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_nc_set(&_nc_addr, _mock_netif->pid,
+                                                  _nc_l2, sizeof(_nc_l2)));
+    etx = _send(_nc_l2, sizeof(_nc_l2));
+    TEST_ASSERT((etx != 0) && (etx != NETSTATS_NB_ETX_INIT));
+    parent->addr = _nc_addr;
+    _inst.of->update_parent(parent);
+    TEST_ASSERT_EQUAL_INT(GNRC_RPL_MRHOF_METRIC_ETX, parent->link_metric_type);
+    TEST_ASSERT_EQUAL_INT(etx, (uint16_t)parent->link_metric);
+}
+
+static void test_update_parent__eui64(void)
+{
+    gnrc_rpl_parent_t *parent = &_parents[0];
+    uint16_t etx = _send(_eui64_l2, sizeof(_eui64_l2));
+
+    TEST_ASSERT((etx != 0) && (etx != NETSTATS_NB_ETX_INIT));
+    parent->addr = _eui64_addr;
+    _inst.of->update_parent(parent);
+    TEST_ASSERT_EQUAL_INT(GNRC_RPL_MRHOF_METRIC_ETX, parent->link_metric_type);
+    TEST_ASSERT_EQUAL_INT(etx, (uint16_t)parent->link_metric);
+}
+
+static void test_update_parent__unknown(void)
+{
+    gnrc_rpl_parent_t *parent = &_parents[0];
+
+    /* statistics of another neighbor only */
+    _send(_nc_l2, sizeof(_nc_l2));
+    parent->addr = _eui64_addr;
+    _inst.of->update_parent(parent);
+    TEST_ASSERT_EQUAL_INT(GNRC_RPL_MRHOF_METRIC_ETX, parent->link_metric_type);
+    TEST_ASSERT_EQUAL_INT(NETSTATS_NB_ETX_INIT, (uint16_t)parent->link_metric);
+}
+
+static void test_parent_cmp__max_path_cost(void)
+{
+    gnrc_rpl_parent_t *far = &_parents[0];
+    gnrc_rpl_parent_t *near = &_parents[1];
+
+    far->link_metric_type = GNRC_RPL_MRHOF_METRIC_ETX;
+    far->link_metric = NETSTATS_NB_ETX_DIVISOR;
+    near->link_metric_type = GNRC_RPL_MRHOF_METRIC_ETX;
+    near->link_metric = 2 * NETSTATS_NB_ETX_DIVISOR;
+    /* far becomes the preferred parent */
+    far->rank = GNRC_RPL_MRHOF_MAX_PATH_COST - 1024;
+    TEST_ASSERT(_inst.of->calc_rank(far, 0) != GNRC_RPL_INFINITE_RANK);
+
+    /* far now costs more than allowed; without the limit, the hysteresis
+     * would keep it over near */
+    far->rank = GNRC_RPL_MRHOF_MAX_PATH_COST - 64;
+    near->rank = GNRC_RPL_MRHOF_MAX_PATH_COST - 320;
+    TEST_ASSERT((far->rank + (unsigned)far->link_metric -
+                 GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD) <
+                (near->rank + (unsigned)near->link_metric));
+    TEST_ASSERT(_inst.of->parent_cmp(far, near) > 0);
+    TEST_ASSERT(_inst.of->which_parent(far, near) == near);
+    TEST_ASSERT_EQUAL_INT(GNRC_RPL_INFINITE_RANK,
+                          _inst.of->calc_rank(far, 0));
+    TEST_ASSERT(_inst.of->calc_rank(near, 0) != GNRC_RPL_INFINITE_RANK);
+}
+
+static Test *tests_gnrc_rpl_mrhof_netif(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_update_parent__neighbor_cache),
+        new_TestFixture(test_update_parent__eui64),
+        new_TestFixture(test_update_parent__unknown),
+        new_TestFixture(test_parent_cmp__max_path_cost),
+    };
+
+    EMB_UNIT_TESTCALLER(tests, _set_up, _tear_down, fixtures);
+
+    return (Test *)&tests;
+}
+
+int main(void)
+{
+    _tests_init();
+
+    TESTS_START();
+    TESTS_RUN(tests_gnrc_rpl_mrhof_netif());
+    TESTS_END();
+
+    return 0;
+}
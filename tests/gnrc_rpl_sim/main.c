@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Node of an RPL network simulated with the ZEP dispatcher
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "msg.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/rpl.h"
+#include "net/gnrc/rpl/dodag.h"
+#include "shell.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define MAIN_QUEUE_SIZE     (8U)
+#define MONITOR_INTERVAL    (10U * US_PER_MS)
+
+static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
+static char _monitor_stack[THREAD_STACKSIZE_DEFAULT];
+/* time the node first had a rank, in ms since boot, or -1 */
+static int32_t _joined_ms = -1;
+static unsigned _parent_changes;
+
+static gnrc_rpl_dodag_t *_get_dodag(void)
+{
+    for (unsigned i = 0; i < GNRC_RPL_INSTANCES_NUMOF; i++) {
+        if (gnrc_rpl_instances[i].state != 0) {
+            return &gnrc_rpl_instances[i].dodag;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Records when the node joins a DODAG and how often it changes its
+ * preferred parent.
+ */
+static void *_monitor(void *arg)
+{
+    ipv6_addr_t parent = IPV6_ADDR_UNSPECIFIED;
+
+    (void)arg;
+    while (1) {
+        gnrc_rpl_dodag_t *dodag = _get_dodag();
+
+        xtimer_usleep(MONITOR_INTERVAL);
+        if ((dodag == NULL) || (dodag->my_rank == GNRC_RPL_INFINITE_RANK)) {
+            continue;
+        }
+        if (_joined_ms < 0) {
+            _joined_ms = xtimer_now_usec64() / US_PER_MS;
+        }
+        if ((dodag->parents != NULL) &&
+            !ipv6_addr_equal(&dodag->parents->addr, &parent)) {
+            if (!ipv6_addr_is_unspecified(&parent)) {
+                _parent_changes++;
+            }
+            parent = dodag->parents->addr;
+        }
+    }
+    return NULL;
+}
+
+static int _simstats(int argc, char **argv)
+{
+    gnrc_rpl_dodag_t *dodag = _get_dodag();
+    gnrc_netif_t *netif = gnrc_netif_iter(NULL);
+    netstats_rpl_t *rpl = &gnrc_rpl_netstats;
+    trickle_stats_t trickle = { 0 };
+    size_t pktbuf_max = 0;
+
+    (void)argc;
+    (void)argv;
+    if (dodag != NULL) {
+        trickle = dodag->trickle.stats;
+    }
+#ifdef DEVELHELP
+    pktbuf_max = gnrc_pktbuf_get_max_used();
+#endif
+    printf("simstats: iface=%d uptime_ms=%" PRIu32 " joined_ms=%" PRIi32
+           " rank=%u parent_changes=%u",
+           (netif != NULL) ? (int)netif->pid : -1,
+           (uint32_t)(xtimer_now_usec64() / US_PER_MS), _joined_ms,
+           (dodag != NULL) ? dodag->my_rank : GNRC_RPL_INFINITE_RANK,
+           _parent_changes);
+    printf(" dio_tx=%" PRIu32 " dio_rx=%" PRIu32 " dis_tx=%" PRIu32
+           " dis_rx=%" PRIu32,
+           rpl->dio_tx_ucast_count + rpl->dio_tx_mcast_count,
+           rpl->dio_rx_ucast_count + rpl->dio_rx_mcast_count,
+           rpl->dis_tx_ucast_count + rpl->dis_tx_mcast_count,
+           rpl->dis_rx_ucast_count + rpl->dis_rx_mcast_count);
+    printf(" dao_tx=%" PRIu32 " dao_rx=%" PRIu32 " dao_ack_tx=%" PRIu32
+           " dao_ack_rx=%" PRIu32,
+           rpl->dao_tx_ucast_count + rpl->dao_tx_mcast_count,
+           rpl->dao_rx_ucast_count + rpl->dao_rx_mcast_count,
+           rpl->dao_ack_tx_ucast_count + rpl->dao_ack_tx_mcast_count,
+           rpl->dao_ack_rx_ucast_count + rpl->dao_ack_rx_mcast_count);
+    printf(" dio_suppressed=%" PRIu32 " trickle_resets=%" PRIu32,
+           trickle.suppressions, trickle.resets);
+    printf(" control_bytes=%" PRIu32 " pktbuf_max=%u\n",
+           rpl->dio_tx_ucast_bytes + rpl->dio_tx_mcast_bytes +
+           rpl->dis_tx_ucast_bytes + rpl->dis_tx_mcast_bytes +
+           rpl->dao_tx_ucast_bytes + rpl->dao_tx_mcast_bytes +
+           rpl->dao_ack_tx_ucast_bytes + rpl->dao_ack_tx_mcast_bytes,
+           (unsigned)pktbuf_max);
+    return 0;
+}
+
+static const shell_command_t shell_commands[] = {
+    { "simstats", "print the statistics of the node in one line", _simstats },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+
+    msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+    thread_create(_monitor_stack, sizeof(_monitor_stack),
+                  THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                  _monitor, NULL, "monitor");
+    shell_run(shell_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
+
+    return 0;
+}
@@ -0,0 +1,44 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+NODES = 5
+PING_COUNT = 10
+
+
+def testfunc(args):
+    results = run_scenario.run(args)
+    run_scenario.print_results(results)
+    assert results["converged"]
+    # the DAOs of every node reached the root
+    assert results["routes_ms"] is not None
+    for node in results["nodes"]:
+        assert node["rank"] != run_scenario.INFINITE_RANK
+        assert node["dio_tx"] > 0
+        if node["id"] != 0:
+            assert node["dao_tx"] > 0
+            # the links lose 5 % of the frames, most pings need to get through
+            assert node["ping"]["received"] >= (PING_COUNT // 2)
+    print("SUCCESS")
+
+
+if __name__ == "__main__":
+    tool_dir = os.path.join(os.environ['RIOTTOOLS'], 'zep_dispatch')
+    sys.path.append(tool_dir)
+    import run_scenario
+
+    args = run_scenario.parse_args([
+        "--elf", os.environ['ELFFILE'],
+        "--nodes", str(NODES),
+        "--topology", os.path.join(tool_dir, "line.topo"),
+        "--ping-count", str(PING_COUNT),
+        "--timeout", "120",
+    ])
+    testfunc(args)
@@ -0,0 +1,288 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmarks the RPL source route table with 500 nodes
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/gnrc/rpl/sr_table.h"
+#include "net/gnrc/rpl/srh.h"
+#include "random.h"
+#include "xtimer.h"
+
+#define NODES_NUMOF     (500U)
+#define ROOT            (0U)
+#define ROUNDS          (10U)
+#define LIFETIME        (3600U)
+#define RANDOM_SEED     (0x6554)
+#define SRH_BUF_SIZE    (sizeof(gnrc_rpl_srh_t) + \
+                         (GNRC_RPL_SR_TABLE_MAX_DEPTH * sizeof(ipv6_addr_t)))
+
+static uint16_t _parents[NODES_NUMOF + 1];
+static uint16_t _order[NODES_NUMOF];
+static uint8_t _srh_buf[SRH_BUF_SIZE];
+
+static void _addr(unsigned id, ipv6_addr_t *addr)
+{
+    static const ipv6_addr_t base = { .u8 = {
+        0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00,
+        0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x00,
+    } };
+
+    *addr = base;
+    addr->u8[14] = (id + 1) >> 8;
+    addr->u8[15] = (id + 1) & 0xff;
+}
+
+/*
+ * Builds a random tree: each node picks a parent among the nodes before
+ * it, so the depth grows with the logarithm of the number of nodes.
+ */
+static void _build_topology(void)
+{
+    _parents[ROOT] = ROOT;
+    for (unsigned i = 1; i <= NODES_NUMOF; i++) {
+        unsigned j = random_uint32_range(0, i);
+
+        _parents[i] = random_uint32_range(0, i);
+        /* DAOs arrive in any order */
+        _order[i - 1] = _order[j];
+        _order[j] = i;
+    }
+}
+
+static unsigned _depth(unsigned id)
+{
+    unsigned depth = 0;
+
+    for (; id != ROOT; id = _parents[id]) {
+        depth++;
+    }
+    return depth;
+}
+
+static int _add_all(void)
+{
+    for (unsigned i = 0; i < NODES_NUMOF; i++) {
+        ipv6_addr_t target, parent;
+
+        _addr(_order[i], &target);
+        _addr(_parents[_order[i]], &parent);
+        if (gnrc_rpl_sr_table_add(&target, &parent, LIFETIME) < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Checks that the header lists the route to a node, as in RFC 6554.
+ */
+static bool _check_srh(unsigned id, const ipv6_addr_t *next_hop,
+                       ssize_t len)
+{
+    const gnrc_rpl_srh_t *srh = (gnrc_rpl_srh_t *)_srh_buf;
+    unsigned depth = _depth(id);
+    uint16_t path[GNRC_RPL_SR_TABLE_MAX_DEPTH];
+    uint8_t compri = srh->compr >> 4, compre = srh->compr & 0xf;
+    const uint8_t *vec = (const uint8_t *)(srh + 1);
+    ipv6_addr_t addr;
+    unsigned n;
+
+    /* path[0] is the first hop */
+    for (unsigned i = depth, hop = id; i > 0; i--, hop = _parents[hop]) {
+        path[i - 1] = hop;
+    }
+    _addr(path[0], &addr);
+    if (!ipv6_addr_equal(&addr, next_hop)) {
+        return false;
+    }
+    if (depth == 1) {
+        return len == 0;
+    }
+    n = depth - 1;
+    if ((len <= 0) || (srh->type != GNRC_RPL_SRH_TYPE) ||
+        (srh->seg_left != n) || (((srh->len + 1U) * 8) != (size_t)len)) {
+        return false;
+    }
+    for (unsigned k = 0; k < n; k++) {
+        uint8_t elided = (k == (n - 1)) ? compre : compri;
+        ipv6_addr_t hop;
+
+        /* elided octets are those of the first hop */
+        hop = *next_hop;
+        memcpy(&hop.u8[elided], vec, sizeof(ipv6_addr_t) - elided);
+        vec += sizeof(ipv6_addr_t) - elided;
+        _addr(path[k + 1], &addr);
+        if (!ipv6_addr_equal(&addr, &hop)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static ssize_t _get_srh(unsigned id, ipv6_addr_t *next_hop)
+{
+    ipv6_addr_t target;
+
+    _addr(id, &target);
+    return gnrc_rpl_sr_table_get_srh(&target, next_hop, _srh_buf,
+                                     sizeof(_srh_buf));
+}
+
+static int _check_all(void)
+{
+    for (unsigned id = 1; id <= NODES_NUMOF; id++) {
+        ipv6_addr_t next_hop;
+        ssize_t len = _get_srh(id, &next_hop);
+
+        if (!_check_srh(id, &next_hop, len)) {
+            printf("wrong route to node %u (%d)\n", id, (int)len);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static uint32_t _get_all(void)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned id = 1; id <= NODES_NUMOF; id++) {
+        ipv6_addr_t next_hop;
+
+        _get_srh(id, &next_hop);
+    }
+    return xtimer_now_usec() - start;
+}
+
+/*
+ * Moves a node and its subtree to another parent, and removes a node, and
+ * checks that the routes change accordingly.
+ */
+static int _check_changes(void)
+{
+    ipv6_addr_t target, parent, next_hop;
+    unsigned moved = 0, removed = 0;
+
+    /* the deepest node is moved below the root */
+    for (unsigned id = 1; id <= NODES_NUMOF; id++) {
+        if (_depth(id) > _depth(moved)) {
+            moved = id;
+        }
+    }
+    moved = _parents[moved];
+    _parents[moved] = ROOT;
+    _addr(moved, &target);
+    _addr(ROOT, &parent);
+    gnrc_rpl_sr_table_add(&target, &parent, LIFETIME);
+    if (_check_all() < 0) {
+        return -1;
+    }
+
+    /* any node with children is removed */
+    for (unsigned id = 1; (id <= NODES_NUMOF) && !removed; id++) {
+        if (_parents[id] != ROOT) {
+            removed = _parents[id];
+        }
+    }
+    _addr(removed, &target);
+    gnrc_rpl_sr_table_del(&target);
+    for (unsigned id = 1; id <= NODES_NUMOF; id++) {
+        unsigned hop = id;
+
+        while ((hop != ROOT) && (hop != removed)) {
+            hop = _parents[hop];
+        }
+        if ((hop == removed) &&
+            (_get_srh(id, &next_hop) != -EHOSTUNREACH)) {
+            printf("route to node %u over removed node %u\n", id, removed);
+            return -1;
+        }
+    }
+    printf("moved node %u, removed node %u\n", moved, removed);
+    return 0;
+}
+
+int main(void)
+{
+    uint32_t add_time = 0, build_time = 0, cached_time = 0;
+    unsigned max_depth = 0, depth_sum = 0, srh_sum = 0, uncompressed_sum = 0;
+    ipv6_addr_t root;
+
+    random_init(RANDOM_SEED);
+    _build_topology();
+    _addr(ROOT, &root);
+
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        uint32_t start;
+
+        gnrc_rpl_sr_table_init(&root);
+        start = xtimer_now_usec();
+        if (_add_all() < 0) {
+            puts("FAILED: table full");
+            return 1;
+        }
+        add_time += xtimer_now_usec() - start;
+        /* once built, once from the cache */
+        if ((r == 0) && ((_check_all() < 0) || (_check_all() < 0))) {
+            puts("FAILED");
+            return 1;
+        }
+        /* the check filled the cache, so start over for the first build */
+        gnrc_rpl_sr_table_init(&root);
+        _add_all();
+        build_time += _get_all();
+        cached_time += _get_all();
+    }
+
+    for (unsigned id = 1; id <= NODES_NUMOF; id++) {
+        ipv6_addr_t next_hop;
+        unsigned depth = _depth(id);
+        ssize_t len = _get_srh(id, &next_hop);
+
+        if (depth > max_depth) {
+            max_depth = depth;
+        }
+        depth_sum += depth;
+        srh_sum += len;
+        if (depth > 1) {
+            uncompressed_sum += sizeof(gnrc_rpl_srh_t) +
+                                ((depth - 1) * sizeof(ipv6_addr_t));
+        }
+    }
+    printf("nodes: %u, depth: %u on average, %u at most\n", NODES_NUMOF,
+           depth_sum / NODES_NUMOF, max_depth);
+    printf("SRH: %u bytes on average, %u bytes uncompressed\n",
+           srh_sum / NODES_NUMOF, uncompressed_sum / NODES_NUMOF);
+    printf("add: %" PRIu32 " ns per DAO\n",
+           (add_time * 1000) / (ROUNDS * NODES_NUMOF));
+    printf("build: %" PRIu32 " ns per SRH\n",
+           (build_time * 1000) / (ROUNDS * NODES_NUMOF));
+    printf("cached: %" PRIu32 " ns per SRH\n",
+           (cached_time * 1000) / (ROUNDS * NODES_NUMOF));
+
+    if (_check_changes() < 0) {
+        puts("FAILED");
+        return 1;
+    }
+    puts("SUCCESS");
+
+    return 0;
+}
@@ -0,0 +1,27 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+
+def testfunc(child):
+    child.expect(r"nodes: 500, depth: \d+ on average, \d+ at most")
+    child.expect(r"SRH: (\d+) bytes on average, (\d+) bytes uncompressed")
+    assert int(child.match.group(1)) < int(child.match.group(2))
+    child.expect(r"add: \d+ ns per DAO")
+    child.expect(r"build: \d+ ns per SRH")
+    child.expect(r"cached: \d+ ns per SRH")
+    child.expect(r"moved node \d+, removed node \d+")
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.path.append(os.path.join(os.environ['RIOTTOOLS'], 'testrunner'))
+    from testrunner import run
+    sys.exit(run(testfunc))
@@ -0,0 +1,246 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the 6LoWPAN datagram delivery ratio over a lossy link
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "bitfield.h"
+#include "msg.h"
+#include "net/gnrc.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/sixlowpan/frag.h"
+#include "net/ipv6.h"
+#include "net/ipv6/hdr.h"
+#include "net/netdev_test.h"
+#include "net/protnum.h"
+#include "random.h"
+#include "utlist.h"
+#include "xtimer.h"
+
+#define DATAGRAMS_NUMOF     (100U)
+#define DATAGRAM_SIZE       (IPV6_MIN_MTU)
+#define PAYLOAD_SIZE        (DATAGRAM_SIZE - sizeof(ipv6_hdr_t))
+#define FRAME_SIZE          (102U)  /* IEEE 802.15.4 with long addresses */
+#define LOSS_PERCENT        (5U)
+#define MIN_RATIO_PERCENT   (95U)
+#define DELIVERY_TIMEOUT    (1U * US_PER_SEC)
+#define MAIN_QUEUE_SIZE     (8U)
+
+static const uint8_t _l2addrs[2][IEEE802154_LONG_ADDRESS_LEN] = {
+    { 0x3e, 0xe6, 0xb5, 0x0f, 0x19, 0x22, 0x00, 0x01 },
+    { 0x3e, 0xe6, 0xb5, 0x0f, 0x19, 0x22, 0x00, 0x02 },
+};
+
+static netdev_test_t _devs[2];
+static gnrc_netif_t *_netifs[2];
+static char _netif_stacks[2][THREAD_STACKSIZE_DEFAULT];
+static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
+static uint8_t _payload[PAYLOAD_SIZE];
+static BITFIELD(_delivered, DATAGRAMS_NUMOF);
+static unsigned _frames = 0;
+
+static int _get_device_type(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    (void)max_len;
+    *((uint16_t *)value) = NETDEV_TYPE_UNKNOWN;
+    return sizeof(uint16_t);
+}
+
+static int _get_max_packet_size(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    (void)max_len;
+    *((uint16_t *)value) = FRAME_SIZE;
+    return sizeof(uint16_t);
+}
+
+/* hands a frame to the 6LoWPAN layer as if the peer interface received it,
+ * unless the lossy link drops it */
+static int _mock_netif_send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+{
+    gnrc_netif_hdr_t *hdr = pkt->data;
+    gnrc_netif_t *peer = (netif == _netifs[0]) ? _netifs[1] : _netifs[0];
+    gnrc_pktsnip_t *netif_hdr, *frame;
+    size_t len = gnrc_pkt_len(pkt->next), offset = 0;
+
+    _frames++;
+    if (random_uint32_range(0, 100) < LOSS_PERCENT) {
+        gnrc_pktbuf_release(pkt);
+        return len;
+    }
+    netif_hdr = gnrc_netif_hdr_build(gnrc_netif_hdr_get_src_addr(hdr),
+                                     hdr->src_l2addr_len,
+                                     gnrc_netif_hdr_get_dst_addr(hdr),
+                                     hdr->dst_l2addr_len);
+    if (netif_hdr == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return -ENOBUFS;
+    }
+    ((gnrc_netif_hdr_t *)netif_hdr->data)->if_pid = peer->pid;
+    frame = gnrc_pktbuf_add(netif_hdr, NULL, len, GNRC_NETTYPE_SIXLOWPAN);
+    if (frame == NULL) {
+        gnrc_pktbuf_release(netif_hdr);
+        gnrc_pktbuf_release(pkt);
+        return -ENOBUFS;
+    }
+    for (gnrc_pktsnip_t *snip = pkt->next; snip != NULL; snip = snip->next) {
+        memcpy((uint8_t *)frame->data + offset, snip->data, snip->size);
+        offset += snip->size;
+    }
+    gnrc_pktbuf_release(pkt);
+    if (!gnrc_netapi_dispatch_receive(GNRC_NETTYPE_SIXLOWPAN,
+                                      GNRC_NETREG_DEMUX_CTX_ALL, frame)) {
+        gnrc_pktbuf_release(frame);
+    }
+    return len;
+}
+
+static const gnrc_netif_ops_t _mock_ops = {
+    .send = _mock_netif_send,
+    .get = gnrc_netif_get_from_netdev,
+    .set = gnrc_netif_set_from_netdev,
+};
+
+static gnrc_netif_t *_create_netif(unsigned i)
+{
+    gnrc_netif_t *netif;
+
+    netdev_test_setup(&_devs[i], NULL);
+    netdev_test_set_get_cb(&_devs[i], NETOPT_DEVICE_TYPE, _get_device_type);
+    netdev_test_set_get_cb(&_devs[i], NETOPT_MAX_PACKET_SIZE,
+                           _get_max_packet_size);
+    netif = gnrc_netif_create(_netif_stacks[i], sizeof(_netif_stacks[i]),
+                              GNRC_NETIF_PRIO, "mock", (netdev_t *)&_devs[i],
+                              &_mock_ops);
+    /* let 6LoWPAN fragment everything that does not fit into a frame */
+    netif->sixlo.max_frag_size = FRAME_SIZE;
+    return netif;
+}
+
+static gnrc_pktsnip_t *_build_datagram(uint32_t seq)
+{
+    gnrc_pktsnip_t *netif, *ipv6, *payload;
+    ipv6_hdr_t *hdr;
+
+    memcpy(_payload, &seq, sizeof(seq));
+    payload = gnrc_pktbuf_add(NULL, _payload, PAYLOAD_SIZE, GNRC_NETTYPE_UNDEF);
+    if (payload == NULL) {
+        return NULL;
+    }
+    ipv6 = gnrc_pktbuf_add(payload, NULL, sizeof(ipv6_hdr_t), GNRC_NETTYPE_IPV6);
+    if (ipv6 == NULL) {
+        gnrc_pktbuf_release(payload);
+        return NULL;
+    }
+    hdr = ipv6->data;
+    memset(hdr, 0, sizeof(ipv6_hdr_t));
+    ipv6_hdr_set_version(hdr);
+    hdr->len = byteorder_htons(PAYLOAD_SIZE);
+    hdr->nh = PROTNUM_IPV6_NONXT;
+    hdr->hl = 64U;
+    ipv6_addr_set_link_local_prefix(&hdr->src);
+    ipv6_addr_set_link_local_prefix(&hdr->dst);
+    netif = gnrc_netif_hdr_build((uint8_t *)_l2addrs[0], sizeof(_l2addrs[0]),
+                                 (uint8_t *)_l2addrs[1], sizeof(_l2addrs[1]));
+    if (netif == NULL) {
+        gnrc_pktbuf_release(ipv6);
+        return NULL;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = _netifs[0]->pid;
+    LL_PREPEND(ipv6, netif);
+    return netif;
+}
+
+/* marks a reassembled datagram as delivered */
+static void _handle_datagram(gnrc_pktsnip_t *pkt)
+{
+    uint32_t seq;
+
+    if ((pkt->type == GNRC_NETTYPE_IPV6) && (pkt->size == DATAGRAM_SIZE)) {
+        memcpy(&seq, (uint8_t *)pkt->data + sizeof(ipv6_hdr_t), sizeof(seq));
+        if (seq < DATAGRAMS_NUMOF) {
+            bf_set(_delivered, seq);
+        }
+    }
+    gnrc_pktbuf_release(pkt);
+}
+
+/* waits until the sender finished the previous datagram */
+static bool _wait_for_sender(void)
+{
+    for (unsigned i = 0; i < (DELIVERY_TIMEOUT / US_PER_MS); i++) {
+        if (gnrc_sixlowpan_msg_frag_get() != NULL) {
+            return true;
+        }
+        xtimer_usleep(US_PER_MS);
+    }
+    return false;
+}
+
+int main(void)
+{
+    gnrc_netreg_entry_t me = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
+                                                        sched_active_pid);
+    unsigned delivered = 0;
+
+    puts("6LoWPAN fragment recovery test");
+    msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+    random_init(0x6106a9);
+    _netifs[0] = _create_netif(0);
+    _netifs[1] = _create_netif(1);
+    /* receive reassembled datagrams directly from 6LoWPAN */
+    gnrc_netreg_register(GNRC_NETTYPE_IPV6, &me);
+
+    for (uint32_t seq = 0; seq < DATAGRAMS_NUMOF; seq++) {
+        gnrc_pktsnip_t *pkt;
+        msg_t msg;
+
+        if (!_wait_for_sender() || ((pkt = _build_datagram(seq)) == NULL)) {
+            printf("FAILED: unable to send datagram %u\n", (unsigned)seq);
+            return 1;
+        }
+        if (!gnrc_netapi_dispatch_send(GNRC_NETTYPE_SIXLOWPAN,
+                                       GNRC_NETREG_DEMUX_CTX_ALL, pkt)) {
+            gnrc_pktbuf_release(pkt);
+        }
+        while (!bf_isset(_delivered, seq) &&
+               (xtimer_msg_receive_timeout(&msg, DELIVERY_TIMEOUT) >= 0)) {
+            if (msg.type == GNRC_NETAPI_MSG_TYPE_RCV) {
+                _handle_datagram(msg.content.ptr);
+            }
+        }
+    }
+    for (unsigned i = 0; i < DATAGRAMS_NUMOF; i++) {
+        if (bf_isset(_delivered, i)) {
+            delivered++;
+        }
+    }
+    printf("delivered %u of %u datagrams (%u frames)\n", delivered,
+           DATAGRAMS_NUMOF, _frames);
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    if ((delivered * 100U) < (DATAGRAMS_NUMOF * MIN_RATIO_PERCENT)) {
+        puts("FAILED");
+        return 1;
+    }
+#endif
+    puts("SUCCESS");
+
+    return 0;
+}
@@ -0,0 +1,346 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure latency and packet buffer usage of a 6LoWPAN router
+ *              forwarding fragmented datagrams
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "msg.h"
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6/nib.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/sixlowpan/frag.h"
+#include "net/ipv6.h"
+#include "net/ipv6/hdr.h"
+#include "net/netdev_test.h"
+#include "net/protnum.h"
+#include "net/sixlowpan.h"
+#include "net/udp.h"
+#include "utlist.h"
+#include "xtimer.h"
+
+#define DATAGRAMS_NUMOF     (10U)
+#define DATAGRAM_SIZE       (IPV6_MIN_MTU)
+#define PAYLOAD_SIZE        (DATAGRAM_SIZE - sizeof(ipv6_hdr_t))
+#define FRAME_SIZE          (102U)  /* IEEE 802.15.4 with long addresses */
+#define FRAME_OVERHEAD      (31U)   /* PHY and MAC header bytes */
+#define BYTE_AIRTIME_US     (32U)   /* 250 kbit/s */
+#define TEST_PORT           (0xf0b1)
+#define DELIVERY_TIMEOUT    (1U * US_PER_SEC)
+#define MAIN_QUEUE_SIZE     (8U)
+#define MSG_TYPE_FORWARDED  (0x4a1e)
+
+enum {
+    SRC = 0,                /**< interface of the previous hop */
+    INGRESS,                /**< router interface to the previous hop */
+    EGRESS,                 /**< router interface to the next hop */
+    NETIF_NUMOF,
+};
+
+static const uint8_t _prev_hop_l2addr[] = {
+    0x3e, 0xe6, 0xb5, 0x0f, 0x19, 0x22, 0x00, 0x01
+};
+static const uint8_t _router_l2addr[] = {
+    0x3e, 0xe6, 0xb5, 0x0f, 0x19, 0x22, 0x00, 0x02
+};
+static const uint8_t _next_hop_l2addr[] = {
+    0x3e, 0xe6, 0xb5, 0x0f, 0x19, 0x22, 0x00, 0x03
+};
+
+static netdev_test_t _devs[NETIF_NUMOF];
+static gnrc_netif_t *_netifs[NETIF_NUMOF];
+static char _netif_stacks[NETIF_NUMOF][THREAD_STACKSIZE_DEFAULT];
+static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
+static uint8_t _payload[PAYLOAD_SIZE];
+static kernel_pid_t _main_pid;
+static ipv6_addr_t _src, _dst, _next_hop;
+
+/* timestamps of the current datagram, in microseconds */
+static uint32_t _last_in;
+static uint32_t _first_out;
+static size_t _min_free = GNRC_PKTBUF_SIZE;
+
+static int _get_device_type(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    (void)max_len;
+    *((uint16_t *)value) = NETDEV_TYPE_IEEE802154;
+    return sizeof(uint16_t);
+}
+
+static int _get_max_packet_size(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    (void)max_len;
+    *((uint16_t *)value) = FRAME_SIZE;
+    return sizeof(uint16_t);
+}
+
+/* largest block the packet buffer can still allocate */
+static size_t _pktbuf_free(void)
+{
+    size_t lo = 0, hi = GNRC_PKTBUF_SIZE;
+
+    while (lo < hi) {
+        size_t mid = (lo + hi + 1) / 2;
+        gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, mid,
+                                              GNRC_NETTYPE_UNDEF);
+
+        if (pkt != NULL) {
+            gnrc_pktbuf_release(pkt);
+            lo = mid;
+        }
+        else {
+            hi = mid - 1;
+        }
+    }
+    return lo;
+}
+
+static void _frame_copy(gnrc_pktsnip_t *pkt, uint8_t *frame)
+{
+    for (; pkt != NULL; pkt = pkt->next) {
+        memcpy(frame, pkt->data, pkt->size);
+        frame += pkt->size;
+    }
+}
+
+/* checks if a frame is the last fragment of a test datagram */
+static bool _is_last_fragment(const uint8_t *frame, size_t len)
+{
+    const sixlowpan_frag_n_t *hdr = (const sixlowpan_frag_n_t *)frame;
+
+    return ((frame[0] & SIXLOWPAN_FRAG_DISP_MASK) == SIXLOWPAN_FRAG_N_DISP) &&
+           ((hdr->offset * 8U + len - sizeof(sixlowpan_frag_n_t)) ==
+            DATAGRAM_SIZE);
+}
+
+/* hands a fragment to the 6LoWPAN layer as if the router's ingress interface
+ * received it */
+static void _inject(const uint8_t *frame, size_t len)
+{
+    gnrc_pktsnip_t *netif_hdr, *pkt;
+
+    netif_hdr = gnrc_netif_hdr_build((uint8_t *)_prev_hop_l2addr,
+                                     sizeof(_prev_hop_l2addr),
+                                     (uint8_t *)_router_l2addr,
+                                     sizeof(_router_l2addr));
+    if (netif_hdr == NULL) {
+        return;
+    }
+    ((gnrc_netif_hdr_t *)netif_hdr->data)->if_pid = _netifs[INGRESS]->pid;
+    pkt = gnrc_pktbuf_add(netif_hdr, frame, len, GNRC_NETTYPE_SIXLOWPAN);
+    if (pkt == NULL) {
+        gnrc_pktbuf_release(netif_hdr);
+        return;
+    }
+    if (!gnrc_netapi_dispatch_receive(GNRC_NETTYPE_SIXLOWPAN,
+                                      GNRC_NETREG_DEMUX_CTX_ALL, pkt)) {
+        gnrc_pktbuf_release(pkt);
+    }
+}
+
+/* transmits frames with the airtime of a 250 kbit/s link: fragments of the
+ * previous hop reach the router, the router's fragments are recorded */
+static int _mock_netif_send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+{
+    uint8_t frame[FRAME_SIZE];
+    size_t len = gnrc_pkt_len(pkt->next);
+    size_t free_space;
+
+    if (len <= sizeof(frame)) {
+        _frame_copy(pkt->next, frame);
+    }
+    gnrc_pktbuf_release(pkt);
+    /* neighbor discovery and other control traffic is not of interest */
+    if ((len > sizeof(frame)) || (len < sizeof(sixlowpan_frag_n_t)) ||
+        !sixlowpan_frag_is((sixlowpan_frag_t *)frame)) {
+        return len;
+    }
+    xtimer_usleep((len + FRAME_OVERHEAD) * BYTE_AIRTIME_US);
+    if (netif == _netifs[SRC]) {
+        if (_is_last_fragment(frame, len)) {
+            _last_in = xtimer_now_usec();
+        }
+        _inject(frame, len);
+    }
+    else if (netif == _netifs[EGRESS]) {
+        if (_first_out == 0) {
+            _first_out = xtimer_now_usec();
+        }
+        if (_is_last_fragment(frame, len)) {
+            msg_t msg = { .type = MSG_TYPE_FORWARDED };
+
+            msg.content.value = xtimer_now_usec();
+            msg_try_send(&msg, _main_pid);
+        }
+    }
+    free_space = _pktbuf_free();
+    if (free_space < _min_free) {
+        _min_free = free_space;
+    }
+    return len;
+}
+
+static const gnrc_netif_ops_t _mock_ops = {
+    .send = _mock_netif_send,
+    .get = gnrc_netif_get_from_netdev,
+    .set = gnrc_netif_set_from_netdev,
+};
+
+static gnrc_netif_t *_create_netif(unsigned i)
+{
+    gnrc_netif_t *netif;
+
+    netdev_test_setup(&_devs[i], NULL);
+    netdev_test_set_get_cb(&_devs[i], NETOPT_DEVICE_TYPE, _get_device_type);
+    netdev_test_set_get_cb(&_devs[i], NETOPT_MAX_PACKET_SIZE,
+                           _get_max_packet_size);
+    netif = gnrc_netif_create(_netif_stacks[i], sizeof(_netif_stacks[i]),
+                              GNRC_NETIF_PRIO, "mock", (netdev_t *)&_devs[i],
+                              &_mock_ops);
+    /* netdev_test is no IEEE 802.15.4 device, so configure 6LoWPAN here */
+    netif->ipv6.mtu = IPV6_MIN_MTU;
+    netif->sixlo.max_frag_size = FRAME_SIZE;
+    netif->flags |= GNRC_NETIF_FLAGS_6LO_HC;
+    return netif;
+}
+
+static gnrc_pktsnip_t *_build_datagram(void)
+{
+    gnrc_pktsnip_t *netif, *ipv6, *payload;
+    ipv6_hdr_t *hdr;
+    udp_hdr_t *udp;
+
+    payload = gnrc_pktbuf_add(NULL, _payload, PAYLOAD_SIZE, GNRC_NETTYPE_UNDEF);
+    if (payload == NULL) {
+        return NULL;
+    }
+    udp = payload->data;
+    udp->src_port = byteorder_htons(TEST_PORT);
+    udp->dst_port = byteorder_htons(TEST_PORT);
+    udp->length = byteorder_htons(PAYLOAD_SIZE);
+    ipv6 = gnrc_pktbuf_add(payload, NULL, sizeof(ipv6_hdr_t), GNRC_NETTYPE_IPV6);
+    if (ipv6 == NULL) {
+        gnrc_pktbuf_release(payload);
+        return NULL;
+    }
+    hdr = ipv6->data;
+    memset(hdr, 0, sizeof(ipv6_hdr_t));
+    ipv6_hdr_set_version(hdr);
+    hdr->len = byteorder_htons(PAYLOAD_SIZE);
+    hdr->nh = PROTNUM_UDP;
+    hdr->hl = 64U;
+    hdr->src = _src;
+    hdr->dst = _dst;
+    netif = gnrc_netif_hdr_build((uint8_t *)_prev_hop_l2addr,
+                                 sizeof(_prev_hop_l2addr),
+                                 (uint8_t *)_router_l2addr,
+                                 sizeof(_router_l2addr));
+    if (netif == NULL) {
+        gnrc_pktbuf_release(ipv6);
+        return NULL;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = _netifs[SRC]->pid;
+    LL_PREPEND(ipv6, netif);
+    return netif;
+}
+
+/* waits until the previous hop finished the previous datagram */
+static bool _wait_for_sender(void)
+{
+    for (unsigned i = 0; i < (DELIVERY_TIMEOUT / US_PER_MS); i++) {
+        if (gnrc_sixlowpan_msg_frag_get() != NULL) {
+            return true;
+        }
+        xtimer_usleep(US_PER_MS);
+    }
+    return false;
+}
+
+int main(void)
+{
+    uint32_t latency = 0;
+    unsigned forwarded = 0, cut_through = 0;
+
+    puts("6LoWPAN fragment forwarding test");
+    msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+    _main_pid = sched_active_pid;
+    ipv6_addr_from_str(&_src, "2001:db8:1::1");
+    ipv6_addr_from_str(&_dst, "2001:db8:2::1");
+    ipv6_addr_from_str(&_next_hop, "fe80::3ce6:b50f:1922:3");
+    for (unsigned i = 0; i < NETIF_NUMOF; i++) {
+        _netifs[i] = _create_netif(i);
+    }
+    if ((gnrc_ipv6_nib_ft_add(&_dst, 64U, &_next_hop, _netifs[EGRESS]->pid, 0) < 0) ||
+        (gnrc_ipv6_nib_nc_set(&_next_hop, _netifs[EGRESS]->pid,
+                              _next_hop_l2addr, sizeof(_next_hop_l2addr)) < 0)) {
+        puts("FAILED: unable to configure route");
+        return 1;
+    }
+
+    for (unsigned i = 0; i < DATAGRAMS_NUMOF; i++) {
+        gnrc_pktsnip_t *pkt;
+        uint32_t start;
+        msg_t msg;
+
+        if (!_wait_for_sender() || ((pkt = _build_datagram()) == NULL)) {
+            printf("FAILED: unable to send datagram %u\n", i);
+            return 1;
+        }
+        _last_in = 0;
+        _first_out = 0;
+        start = xtimer_now_usec();
+        if (!gnrc_netapi_dispatch_send(GNRC_NETTYPE_SIXLOWPAN,
+                                       GNRC_NETREG_DEMUX_CTX_ALL, pkt)) {
+            gnrc_pktbuf_release(pkt);
+        }
+        /* forwarding latency: from the first fragment on the previous hop to
+         * the last fragment on the next hop */
+        if ((xtimer_msg_receive_timeout(&msg, DELIVERY_TIMEOUT) < 0) ||
+            (msg.type != MSG_TYPE_FORWARDED)) {
+            continue;
+        }
+        forwarded++;
+        latency += msg.content.value - start;
+        /* the router sent on before it received the whole datagram */
+        if (_first_out < _last_in) {
+            cut_through++;
+        }
+    }
+    printf("forwarded %u of %u datagrams (%u before reassembly)\n", forwarded,
+           DATAGRAMS_NUMOF, cut_through);
+    printf("latency: %u us per datagram\n",
+           (forwarded > 0) ? (unsigned)(latency / forwarded) : 0U);
+    printf("peak packet buffer usage: %u of %u bytes\n",
+           (unsigned)(GNRC_PKTBUF_SIZE - _min_free), (unsigned)GNRC_PKTBUF_SIZE);
+    if (forwarded != DATAGRAMS_NUMOF) {
+        puts("FAILED");
+        return 1;
+    }
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+    if (cut_through != DATAGRAMS_NUMOF) {
+        puts("FAILED");
+        return 1;
+    }
+#endif
+    puts("SUCCESS");
+
+    return 0;
+}
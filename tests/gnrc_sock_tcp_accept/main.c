@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Accept many concurrent TCP connections from one listen queue
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "mutex.h"
+#include "net/ipv6/addr.h"
+#include "net/sock/tcp.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define CONNS_NUMOF     (16U)
+#define SERVER_PORT     (61616U)
+#define TIMEOUT         (1U * US_PER_SEC)
+
+static char _server_stack[THREAD_STACKSIZE_DEFAULT];
+static sock_tcp_queue_t _queue;
+static sock_tcp_t _queue_array[CONNS_NUMOF];
+static sock_tcp_t *_accepted[CONNS_NUMOF];
+static sock_tcp_t _clients[CONNS_NUMOF];
+static unsigned _accepted_numof;
+static mutex_t _server_ready = MUTEX_INIT_LOCKED;
+static mutex_t _server_accepted = MUTEX_INIT_LOCKED;
+
+static void *_server(void *arg)
+{
+    sock_tcp_ep_t local = SOCK_IPV6_EP_ANY;
+
+    (void)arg;
+    local.port = SERVER_PORT;
+    if (sock_tcp_listen(&_queue, &local, _queue_array, CONNS_NUMOF, 0) < 0) {
+        puts("FAILED: unable to listen");
+        return NULL;
+    }
+    mutex_unlock(&_server_ready);
+
+    /* accept all connections before any data is exchanged */
+    while (_accepted_numof < CONNS_NUMOF) {
+        if (sock_tcp_accept(&_queue, &_accepted[_accepted_numof], TIMEOUT) < 0) {
+            break;
+        }
+        _accepted_numof++;
+    }
+    mutex_unlock(&_server_accepted);
+
+    /* echo one message per connection */
+    for (unsigned i = 0; i < _accepted_numof; i++) {
+        unsigned id;
+
+        if (sock_tcp_read(_accepted[i], &id, sizeof(id), TIMEOUT) == sizeof(id)) {
+            sock_tcp_write(_accepted[i], &id, sizeof(id));
+        }
+    }
+    return NULL;
+}
+
+int main(void)
+{
+    sock_tcp_ep_t remote = { .family = AF_INET6, .port = SERVER_PORT,
+                             .netif = SOCK_ADDR_ANY_NETIF };
+    unsigned connected = 0;
+    unsigned echoed = 0;
+
+    puts("TCP accept test");
+    ipv6_addr_set_loopback((ipv6_addr_t *)&remote.addr.ipv6);
+    thread_create(_server_stack, sizeof(_server_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _server, NULL, "server");
+    mutex_lock(&_server_ready);
+
+    /* keep all client connections open at the same time */
+    for (unsigned i = 0; i < CONNS_NUMOF; i++) {
+        int res = sock_tcp_connect(&_clients[i], &remote, 0, 0);
+
+        if (res < 0) {
+            printf("unable to connect client %u: %d\n", i, res);
+            break;
+        }
+        connected++;
+    }
+    printf("connected %u of %u clients\n", connected, CONNS_NUMOF);
+    mutex_lock(&_server_accepted);
+    printf("accepted %u of %u connections\n", _accepted_numof, CONNS_NUMOF);
+
+    for (unsigned i = 0; i < connected; i++) {
+        sock_tcp_write(&_clients[i], &i, sizeof(i));
+    }
+    for (unsigned i = 0; i < connected; i++) {
+        unsigned reply;
+
+        if ((sock_tcp_read(&_clients[i], &reply, sizeof(reply), TIMEOUT) == sizeof(reply)) &&
+            (reply == i)) {
+            echoed++;
+        }
+    }
+    printf("echoed %u of %u messages\n", echoed, CONNS_NUMOF);
+    if ((connected != CONNS_NUMOF) || (_accepted_numof != CONNS_NUMOF) ||
+        (echoed != CONNS_NUMOF)) {
+        puts("FAILED");
+        return 1;
+    }
+    puts("SUCCESS");
+
+    return 0;
+}
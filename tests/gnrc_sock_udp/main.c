@@ -421,6 +421,108 @@ static void test_sock_udp_recv__non_blocking(void)
     assert(_check_net());
 }
 
+static void test_sock_udp_recv_buf(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const sock_udp_ep_t local = { .family = AF_INET6,
+                                         .port = _TEST_PORT_LOCAL };
+    sock_udp_ep_t result;
+    void *data = NULL, *ctx = NULL;
+
+    assert(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    assert(_inject_packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE,
+                          _TEST_PORT_LOCAL, "ABCD", sizeof("ABCD"),
+                          _TEST_NETIF));
+    assert(sizeof("ABCD") == sock_udp_recv_buf(&_sock, &data, &ctx, 0,
+                                               &result));
+    assert((data != NULL) && (ctx != NULL));
+    assert(memcmp(data, "ABCD", sizeof("ABCD")) == 0);
+    assert(AF_INET6 == result.family);
+    assert(memcmp(&result.addr, &src_addr, sizeof(result.addr)) == 0);
+    assert(_TEST_PORT_REMOTE == result.port);
+    assert(_TEST_NETIF == result.netif);
+    /* payload is still held by the sock */
+    assert(!_check_net());
+    assert(0 == sock_udp_recv_buf(&_sock, &data, &ctx, 0, NULL));
+    assert((data == NULL) && (ctx == NULL));
+    assert(_check_net());
+}
+
+static void test_sock_udp_recv_batch__EAGAIN(void)
+{
+    static const sock_udp_ep_t local = { .family = AF_INET6,
+                                         .port = _TEST_PORT_LOCAL };
+    sock_udp_msg_t msgs[] = {
+        { .data = _test_buffer, .len = sizeof(_test_buffer) },
+    };
+
+    assert(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    assert(-EAGAIN == sock_udp_recv_batch(&_sock, msgs, 1, 0));
+    assert(_check_net());
+}
+
+static void test_sock_udp_recv_batch__ENOBUFS(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const sock_udp_ep_t local = { .family = AF_INET6,
+                                         .port = _TEST_PORT_LOCAL };
+    sock_udp_msg_t msgs[] = {
+        { .data = &_test_buffer[0], .len = _TEST_BUFFER_SIZE / 2 },
+        { .data = &_test_buffer[_TEST_BUFFER_SIZE / 2], .len = 2 },
+    };
+
+    assert(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    assert(_inject_packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE,
+                          _TEST_PORT_LOCAL, "ABCD", sizeof("ABCD"),
+                          _TEST_NETIF));
+    assert(_inject_packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE,
+                          _TEST_PORT_LOCAL, "EFG", sizeof("EFG"),
+                          _TEST_NETIF));
+    /* the second message does not fit and is left to the next call */
+    assert(1 == sock_udp_recv_batch(&_sock, msgs, 2, SOCK_NO_TIMEOUT));
+    assert(sizeof("ABCD") == msgs[0].len);
+    assert(-ENOBUFS == sock_udp_recv_batch(&_sock, &msgs[1], 1, 0));
+    assert(_check_net());
+}
+
+static void test_sock_udp_recv_batch(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const sock_udp_ep_t local = { .family = AF_INET6,
+                                         .port = _TEST_PORT_LOCAL };
+    sock_udp_ep_t results[2];
+    sock_udp_msg_t msgs[] = {
+        { .data = &_test_buffer[0], .len = _TEST_BUFFER_SIZE / 4,
+          .remote = &results[0] },
+        { .data = &_test_buffer[_TEST_BUFFER_SIZE / 4],
+          .len = _TEST_BUFFER_SIZE / 4, .remote = &results[1] },
+        { .data = &_test_buffer[_TEST_BUFFER_SIZE / 2],
+          .len = _TEST_BUFFER_SIZE / 4 },
+    };
+
+    assert(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    assert(_inject_packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE,
+                          _TEST_PORT_LOCAL, "ABCD", sizeof("ABCD"),
+                          _TEST_NETIF));
+    assert(_inject_packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE + 1,
+                          _TEST_PORT_LOCAL, "EFG", sizeof("EFG"),
+                          _TEST_NETIF));
+    /* only the two waiting messages are received */
+    assert(2 == sock_udp_recv_batch(&_sock, msgs, 3, SOCK_NO_TIMEOUT));
+    assert(sizeof("ABCD") == msgs[0].len);
+    assert(memcmp(msgs[0].data, "ABCD", sizeof("ABCD")) == 0);
+    assert(_TEST_PORT_REMOTE == results[0].port);
+    assert(sizeof("EFG") == msgs[1].len);
+    assert(memcmp(msgs[1].data, "EFG", sizeof("EFG")) == 0);
+    assert((_TEST_PORT_REMOTE + 1) == results[1].port);
+    assert(memcmp(&results[1].addr, &src_addr, sizeof(src_addr)) == 0);
+    assert(_TEST_BUFFER_SIZE / 4 == msgs[2].len);
+    assert(_check_net());
+}
+
 static void test_sock_udp_send__EAFNOSUPPORT(void)
 {
     static const sock_udp_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR_REMOTE },
@@ -693,6 +795,36 @@ static void test_sock_udp_send__no_sock(void)
     assert(_check_net());
 }
 
+static void test_sock_udp_send_batch(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const sock_udp_ep_t local = { .addr = { .ipv6 = _TEST_ADDR_LOCAL },
+                                         .family = AF_INET6,
+                                         .netif = _TEST_NETIF,
+                                         .port = _TEST_PORT_LOCAL };
+    static const sock_udp_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR_REMOTE },
+                                          .family = AF_INET6,
+                                          .port = _TEST_PORT_REMOTE };
+    sock_udp_ep_t other_remote = remote;
+    const sock_udp_msg_t msgs[] = {
+        { .data = "ABCD", .len = sizeof("ABCD") },
+        { .data = "EFG", .len = sizeof("EFG"), .remote = &other_remote },
+    };
+
+    other_remote.port = _TEST_PORT_REMOTE + 1;
+    assert(0 == sock_udp_create(&_sock, &local, &remote, SOCK_FLAGS_REUSE_EP));
+    assert(2 == sock_udp_send_batch(&_sock, msgs, 2));
+    assert(_check_packet(&src_addr, &dst_addr, _TEST_PORT_LOCAL,
+                         _TEST_PORT_REMOTE, "ABCD", sizeof("ABCD"),
+                         _TEST_NETIF, false));
+    assert(_check_packet(&src_addr, &dst_addr, _TEST_PORT_LOCAL,
+                         _TEST_PORT_REMOTE + 1, "EFG", sizeof("EFG"),
+                         _TEST_NETIF, false));
+    xtimer_usleep(1000);    /* let GNRC stack finish */
+    assert(_check_net());
+}
+
 int main(void)
 {
     _net_init();
@@ -724,6 +856,10 @@ int main(void)
     CALL(test_sock_udp_recv__unsocketed_with_remote());
     CALL(test_sock_udp_recv__with_timeout());
     CALL(test_sock_udp_recv__non_blocking());
+    CALL(test_sock_udp_recv_buf());
+    CALL(test_sock_udp_recv_batch__EAGAIN());
+    CALL(test_sock_udp_recv_batch__ENOBUFS());
+    CALL(test_sock_udp_recv_batch());
     _prepare_send_checks();
     CALL(test_sock_udp_send__EAFNOSUPPORT());
     CALL(test_sock_udp_send__EINVAL_addr());
@@ -741,6 +877,7 @@ int main(void)
     CALL(test_sock_udp_send__unsocketed());
     CALL(test_sock_udp_send__no_sock_no_netif());
     CALL(test_sock_udp_send__no_sock());
+    CALL(test_sock_udp_send_batch());
 
     puts("ALL TESTS SUCCESSFUL");
 
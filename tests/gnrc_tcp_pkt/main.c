@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Sends and receives packets with the packet API of gnrc_tcp
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "mutex.h"
+#include "net/af.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/tcp.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define SERVER_PORT         (2000U)
+#define SMALL_NUMOF         (4U)
+#define SMALL_SIZE          (64U)
+/* split into two segments by gnrc_tcp_send_pkt() */
+#define LARGE_SIZE          (GNRC_TCP_MSS + 32U)
+#define TOTAL_SIZE          ((SMALL_NUMOF * SMALL_SIZE) + LARGE_SIZE)
+/* the queued segments and one copy of the rest */
+#define PKTS_NUMOF          (SMALL_NUMOF + 1)
+
+#if GNRC_TCP_RCV_QUEUE_SIZE != SMALL_NUMOF
+#error "The test expects GNRC_TCP_RCV_QUEUE_SIZE to queue the small snips"
+#endif
+
+static gnrc_tcp_tcb_t _cli_tcb;
+static gnrc_tcp_tcb_t _srv_tcb;
+static char _srv_stack[THREAD_STACKSIZE_MAIN];
+static mutex_t _sent = MUTEX_INIT_LOCKED;
+static mutex_t _done = MUTEX_INIT_LOCKED;
+static int _srv_res = 1;
+
+static uint8_t _pattern(size_t off)
+{
+    return (uint8_t)((off * 7) + (off >> 8));
+}
+
+static bool _check_data(const gnrc_pktsnip_t *pkt, size_t off)
+{
+    const uint8_t *data = pkt->data;
+
+    for (size_t i = 0; i < pkt->size; i++) {
+        if (data[i] != _pattern(off + i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* receives all data, holding every packet until the end */
+static int _recv_all(void)
+{
+    gnrc_pktsnip_t *pkts[PKTS_NUMOF];
+    unsigned pkts_numof = 0;
+    size_t rcvd = 0, held = 0;
+    uint16_t wnd = _srv_tcb.rcv_wnd;
+    int res;
+
+    /* read only once all segments arrived */
+    mutex_lock(&_sent);
+    if (_srv_tcb.rcv_wnd != wnd - TOTAL_SIZE) {
+        printf("FAILED: window %u, expected %u\n", (unsigned)_srv_tcb.rcv_wnd,
+               (unsigned)(wnd - TOTAL_SIZE));
+        return 1;
+    }
+    while ((rcvd < TOTAL_SIZE) && (pkts_numof < PKTS_NUMOF)) {
+        gnrc_pktsnip_t *pkt;
+        bool queued;
+
+        res = gnrc_tcp_recv_pkt(&_srv_tcb, &pkt,
+                                GNRC_TCP_CONNECTION_TIMEOUT_DURATION);
+        if (res <= 0) {
+            printf("FAILED: receive failed after %u bytes (%d)\n",
+                   (unsigned)rcvd, res);
+            return 1;
+        }
+        pkts[pkts_numof++] = pkt;
+        /* queued segments are followed by their TCP header */
+        queued = (pkt->next != NULL) && (pkt->next->type == GNRC_NETTYPE_TCP);
+        if (queued) {
+            held += res;
+        }
+        if (!_check_data(pkt, rcvd)) {
+            printf("FAILED: data at %u differs\n", (unsigned)rcvd);
+            return 1;
+        }
+        rcvd += res;
+        printf("received %s of %d bytes, window %u\n",
+               queued ? "segment" : "copy", res, (unsigned)_srv_tcb.rcv_wnd);
+        if (queued != (pkts_numof <= SMALL_NUMOF)) {
+            puts("FAILED: segment not queued");
+            return 1;
+        }
+        /* held and not yet read data both close the window */
+        if (_srv_tcb.rcv_wnd != wnd - (TOTAL_SIZE - rcvd) - held) {
+            printf("FAILED: window expected %u\n",
+                   (unsigned)(wnd - (TOTAL_SIZE - rcvd) - held));
+            return 1;
+        }
+    }
+    if (rcvd != TOTAL_SIZE) {
+        printf("FAILED: received %u of %u bytes\n", (unsigned)rcvd,
+               (unsigned)TOTAL_SIZE);
+        return 1;
+    }
+    for (unsigned i = 0; i < pkts_numof; i++) {
+        gnrc_tcp_recv_pkt_release(&_srv_tcb, pkts[i]);
+    }
+    printf("released all packets, window %u of %u\n",
+           (unsigned)_srv_tcb.rcv_wnd, (unsigned)wnd);
+    return (_srv_tcb.rcv_wnd == wnd) ? 0 : 1;
+}
+
+static void *_server(void *arg)
+{
+    int res;
+
+    (void)arg;
+    gnrc_tcp_tcb_init(&_srv_tcb);
+    res = gnrc_tcp_open_passive(&_srv_tcb, AF_INET6, NULL, SERVER_PORT);
+    if (res < 0) {
+        printf("FAILED: unable to accept connection (%d)\n", res);
+    }
+    else {
+        _srv_res = _recv_all();
+        /* skips TIME-WAIT */
+        gnrc_tcp_abort(&_srv_tcb);
+    }
+    mutex_unlock(&_done);
+    return NULL;
+}
+
+/* builds the payload chain, small snips first */
+static gnrc_pktsnip_t *_build_chain(void)
+{
+    gnrc_pktsnip_t *pkt = NULL;
+    size_t off = TOTAL_SIZE;
+
+    for (unsigned i = 0; i < PKTS_NUMOF; i++) {
+        size_t size = (i == 0) ? LARGE_SIZE : SMALL_SIZE;
+        gnrc_pktsnip_t *snip = gnrc_pktbuf_add(pkt, NULL, size,
+                                               GNRC_NETTYPE_UNDEF);
+
+        if (snip == NULL) {
+            gnrc_pktbuf_release(pkt);
+            return NULL;
+        }
+        off -= size;
+        for (size_t j = 0; j < size; j++) {
+            ((uint8_t *)snip->data)[j] = _pattern(off + j);
+        }
+        pkt = snip;
+    }
+    return pkt;
+}
+
+int main(void)
+{
+    char addr[] = "::1";
+    gnrc_pktsnip_t *pkt;
+    int res;
+
+    puts("gnrc_tcp packet API test");
+    /* runs first, to listen before the client connects */
+    thread_create(_srv_stack, sizeof(_srv_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _server, NULL, "tcp_srv");
+
+    gnrc_tcp_tcb_init(&_cli_tcb);
+    res = gnrc_tcp_open_active(&_cli_tcb, AF_INET6, addr, SERVER_PORT, 0);
+    if (res < 0) {
+        printf("FAILED: unable to connect (%d)\n", res);
+        return 1;
+    }
+    pkt = _build_chain();
+    if (pkt == NULL) {
+        puts("FAILED: unable to allocate payload");
+        return 1;
+    }
+    res = gnrc_tcp_send_pkt(&_cli_tcb, pkt, GNRC_TCP_CONNECTION_TIMEOUT_DURATION);
+    printf("sent %d of %u bytes\n", res, (unsigned)TOTAL_SIZE);
+    if (res != (int)TOTAL_SIZE) {
+        puts("FAILED");
+        return 1;
+    }
+    /* let the last segments arrive before the server reads */
+    xtimer_usleep(100U * US_PER_MS);
+    mutex_unlock(&_sent);
+    mutex_lock(&_done);
+    gnrc_tcp_abort(&_cli_tcb);
+    if (_srv_res != 0) {
+        puts("FAILED");
+        return 1;
+    }
+    puts("SUCCESS");
+
+    return 0;
+}
@@ -0,0 +1,27 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+
+def testfunc(child):
+    child.expect(r"sent (\d+) of (\d+) bytes")
+    assert child.match.group(1) == child.match.group(2)
+    for _ in range(4):
+        child.expect(r"received segment of (\d+) bytes, window (\d+)")
+    child.expect(r"received copy of (\d+) bytes, window (\d+)")
+    child.expect(r"released all packets, window (\d+) of (\d+)")
+    assert child.match.group(1) == child.match.group(2)
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.path.append(os.path.join(os.environ['RIOTTOOLS'], 'testrunner'))
+    from testrunner import run
+    sys.exit(run(testfunc))
@@ -0,0 +1,83 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""Report the goodput of gnrc_tcp for different packet loss rates.
+
+Runs a server instance on tap0 and a client instance on tap1 and drops
+packets on both tap interfaces with netem. Needs two bridged tap interfaces
+(see README.md) and permission to run `tc` via sudo.
+"""
+
+import os
+import subprocess
+import sys
+
+import pexpect
+
+LOSS_RATES = (1, 5, 10)
+BYTES = 65536
+TCP_PORT = 80
+TAPS = ("tap0", "tap1")
+TIMEOUT = 600
+RESULT = r"{ \"bytes\" : (\d+), \"time_us\" : (\d+), " \
+         r"\"bytes_per_s\" : (\d+), \"srtt_us\" : (-?\d+) }"
+
+APPDIR = os.path.dirname(os.path.abspath(__file__))
+
+
+def start_term(tap):
+    child = pexpect.spawnu("make", ["term", "PORT=" + tap], cwd=APPDIR,
+                           timeout=TIMEOUT)
+    child.expect_exact("gnrc_tcp throughput test")
+    return child
+
+
+def link_local(child):
+    child.sendline("ifconfig")
+    child.expect(r"Iface\s+(\d+)")
+    iface = child.match.group(1)
+    child.expect(r"inet6 addr: (fe80:[0-9a-f:]+)")
+    return iface, child.match.group(1)
+
+
+def set_loss(loss):
+    for tap in TAPS:
+        subprocess.check_call(["sudo", "tc", "qdisc", "replace", "dev", tap,
+                               "root", "netem", "loss", "{}%".format(loss)])
+
+
+def clear_loss():
+    for tap in TAPS:
+        subprocess.call(["sudo", "tc", "qdisc", "del", "dev", tap, "root"])
+
+
+def main():
+    subprocess.check_call(["make", "all"], cwd=APPDIR)
+    server = start_term(TAPS[0])
+    client = start_term(TAPS[1])
+    try:
+        _, server_addr = link_local(server)
+        client_iface, _ = link_local(client)
+        for loss in LOSS_RATES:
+            set_loss(loss)
+            server.sendline("tcp_srv {} {}".format(TCP_PORT, BYTES))
+            client.sendline("tcp_cli {}%{} {} {}".format(server_addr,
+                                                         client_iface,
+                                                         TCP_PORT, BYTES))
+            client.expect(RESULT)
+            print("loss {:2}%: {} bytes/s".format(loss, client.match.group(3)))
+            server.expect(RESULT)
+    finally:
+        clear_loss()
+        client.terminate(force=True)
+        server.terminate(force=True)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Bulk transfer throughput of gnrc_tcp
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "net/af.h"
+#include "net/gnrc/tcp.h"
+#include "shell.h"
+#include "xtimer.h"
+
+#define BUF_SIZE        (GNRC_TCP_MSS * GNRC_TCP_MSS_MULTIPLICATOR)
+
+static gnrc_tcp_tcb_t _tcb;
+static uint8_t _buf[BUF_SIZE];
+
+static void _print_result(size_t bytes, uint32_t start)
+{
+    uint32_t time_us = xtimer_now_usec() - start;
+    uint64_t rate = ((uint64_t)bytes * US_PER_SEC) / (time_us ? time_us : 1);
+
+    printf("{ \"bytes\" : %u, \"time_us\" : %lu, \"bytes_per_s\" : %lu, "
+           "\"srtt_us\" : %ld }\n", (unsigned)bytes, (unsigned long)time_us,
+           (unsigned long)rate, (long)_tcb.srtt);
+}
+
+static int _srv_cmd(int argc, char **argv)
+{
+    size_t total, rcvd = 0;
+    uint32_t start;
+    int res;
+
+    if (argc < 3) {
+        printf("usage: %s <port> <bytes>\n", argv[0]);
+        return 1;
+    }
+    total = atoi(argv[2]);
+    gnrc_tcp_tcb_init(&_tcb);
+    if ((res = gnrc_tcp_open_passive(&_tcb, AF_INET6, NULL, atoi(argv[1]))) < 0) {
+        printf("error: unable to accept connection (%d)\n", res);
+        return 1;
+    }
+    start = xtimer_now_usec();
+    while (rcvd < total) {
+        res = gnrc_tcp_recv(&_tcb, _buf, sizeof(_buf),
+                            GNRC_TCP_CONNECTION_TIMEOUT_DURATION);
+        if (res < 0) {
+            printf("error: receive failed after %u bytes (%d)\n", (unsigned)rcvd,
+                   res);
+            gnrc_tcp_abort(&_tcb);
+            return 1;
+        }
+        rcvd += res;
+    }
+    _print_result(rcvd, start);
+    gnrc_tcp_close(&_tcb);
+    return 0;
+}
+
+static int _cli_cmd(int argc, char **argv)
+{
+    size_t total, sent = 0;
+    uint32_t start;
+    int res;
+
+    if (argc < 4) {
+        printf("usage: %s <addr> <port> <bytes>\n", argv[0]);
+        return 1;
+    }
+    total = atoi(argv[3]);
+    memset(_buf, 0xF0, sizeof(_buf));
+    gnrc_tcp_tcb_init(&_tcb);
+    if ((res = gnrc_tcp_open_active(&_tcb, AF_INET6, argv[1], atoi(argv[2]), 0)) < 0) {
+        printf("error: unable to connect (%d)\n", res);
+        return 1;
+    }
+    start = xtimer_now_usec();
+    while (sent < total) {
+        size_t len = ((total - sent) < sizeof(_buf)) ? (total - sent) : sizeof(_buf);
+
+        res = gnrc_tcp_send(&_tcb, _buf, len, 0);
+        if (res < 0) {
+            printf("error: send failed after %u bytes (%d)\n", (unsigned)sent, res);
+            gnrc_tcp_abort(&_tcb);
+            return 1;
+        }
+        sent += res;
+    }
+    /* returns after all data and the FIN were acknowledged */
+    gnrc_tcp_close(&_tcb);
+    _print_result(sent, start);
+    return 0;
+}
+
+static const shell_command_t shell_commands[] = {
+    { "tcp_srv", "receive <bytes> from one client", _srv_cmd },
+    { "tcp_cli", "send <bytes> to a server", _cli_cmd },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+
+    puts("gnrc_tcp throughput test");
+    shell_run(shell_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
+
+    return 0;
+}
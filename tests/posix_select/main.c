@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Serve many UDP sockets from one thread with poll() and select()
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+#include "mutex.h"
+#include "thread.h"
+
+#define SOCKS_NUMOF     (32U)
+#define SERVER_PORT     (61616U)
+#define CLIENT_TIMEOUT  (1U)    /* in seconds */
+
+static char _server_stack[THREAD_STACKSIZE_DEFAULT];
+static struct pollfd _fds[SOCKS_NUMOF];
+static mutex_t _server_ready = MUTEX_INIT_LOCKED;
+
+static void *_server(void *arg)
+{
+    (void)arg;
+
+    for (unsigned i = 0; i < SOCKS_NUMOF; i++) {
+        struct sockaddr_in6 local = { .sin6_family = AF_INET6,
+                                      .sin6_addr = IN6ADDR_ANY_INIT,
+                                      .sin6_port = htons(SERVER_PORT + i) };
+
+        _fds[i].fd = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+        _fds[i].events = POLLIN;
+        if ((_fds[i].fd < 0) ||
+            (bind(_fds[i].fd, (struct sockaddr *)&local, sizeof(local)) < 0)) {
+            printf("FAILED: unable to create server socket %u\n", i);
+            return NULL;
+        }
+    }
+    mutex_unlock(&_server_ready);
+    while (1) {
+        if (poll(_fds, SOCKS_NUMOF, -1) < 0) {
+            puts("FAILED: poll() returned an error");
+            return NULL;
+        }
+        for (unsigned i = 0; i < SOCKS_NUMOF; i++) {
+            struct sockaddr_in6 remote;
+            socklen_t remote_len = sizeof(remote);
+            uint8_t buf[16];
+            ssize_t res;
+
+            if (!(_fds[i].revents & POLLIN)) {
+                continue;
+            }
+            res = recvfrom(_fds[i].fd, buf, sizeof(buf), 0,
+                           (struct sockaddr *)&remote, &remote_len);
+            if (res > 0) {
+                sendto(_fds[i].fd, buf, res, 0, (struct sockaddr *)&remote,
+                       remote_len);
+            }
+        }
+    }
+    return NULL;
+}
+
+int main(void)
+{
+    struct sockaddr_in6 remote = { .sin6_family = AF_INET6,
+                                   .sin6_addr = IN6ADDR_LOOPBACK_INIT };
+    unsigned served = 0;
+    int fd;
+
+    puts("poll()/select() test");
+    thread_create(_server_stack, sizeof(_server_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _server, NULL, "server");
+    mutex_lock(&_server_ready);
+
+    fd = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+    if (fd < 0) {
+        puts("FAILED: unable to create client socket");
+        return 1;
+    }
+    for (unsigned i = 0; i < SOCKS_NUMOF; i++) {
+        struct timeval timeout = { .tv_sec = CLIENT_TIMEOUT };
+        fd_set readfds;
+        unsigned reply;
+
+        remote.sin6_port = htons(SERVER_PORT + i);
+        if (sendto(fd, &i, sizeof(i), 0, (struct sockaddr *)&remote,
+                   sizeof(remote)) < 0) {
+            printf("FAILED: unable to send to port %u\n", SERVER_PORT + i);
+            return 1;
+        }
+        FD_ZERO(&readfds);
+        FD_SET(fd, &readfds);
+        if (select(fd + 1, &readfds, NULL, NULL, &timeout) != 1) {
+            printf("no reply from port %u\n", SERVER_PORT + i);
+            continue;
+        }
+        if ((recv(fd, &reply, sizeof(reply), 0) == sizeof(reply)) &&
+            (reply == i)) {
+            served++;
+        }
+    }
+    printf("served %u of %u datagrams\n", served, SOCKS_NUMOF);
+    printf("one thread: %u bytes\n",
+           (unsigned)(sizeof(_server_stack) + sizeof(_fds)));
+    printf("thread per socket: %u bytes\n",
+           (unsigned)(SOCKS_NUMOF * sizeof(_server_stack)));
+    if (served != SOCKS_NUMOF) {
+        puts("FAILED");
+        return 1;
+    }
+    puts("SUCCESS");
+
+    return 0;
+}
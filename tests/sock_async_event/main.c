@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Serve several UDP clients from one event thread
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "event.h"
+#include "mutex.h"
+#include "net/emcute.h"
+#include "net/gcoap.h"
+#include "net/ipv6/addr.h"
+#include "net/sock/async_event.h"
+#include "net/sock/dns.h"
+#include "net/sock/udp.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define CLIENTS_NUMOF   (3U)
+#define CLIENT_DNS      (2U)    /* runs in the thread that queries */
+#define TIMEOUT         (1U * US_PER_SEC)
+
+static const char *_names[CLIENTS_NUMOF] = { "gcoap", "emcute", "dns" };
+static const uint16_t _ports[CLIENTS_NUMOF] = {
+    GCOAP_PORT, EMCUTE_DEFAULT_PORT, SOCK_DNS_PORT,
+};
+
+static char _event_stack[THREAD_STACKSIZE_DEFAULT];
+static char _client_stacks[CLIENTS_NUMOF - 1][THREAD_STACKSIZE_DEFAULT];
+static event_queue_t _queue;
+static sock_udp_t _clients[CLIENTS_NUMOF];
+static sock_udp_t _servers[CLIENTS_NUMOF];
+static mutex_t _clients_ready = MUTEX_INIT_LOCKED;
+static unsigned _sent = 0;
+static unsigned _replies = 0;
+
+static unsigned _stack_used(char *stack, size_t size)
+{
+    return size - thread_measure_stack_free(stack);
+}
+
+static ssize_t _request(unsigned i)
+{
+    sock_udp_ep_t remote = { .family = AF_INET6, .port = _ports[i] };
+
+    ipv6_addr_set_loopback((ipv6_addr_t *)&remote.addr.ipv6);
+    return sock_udp_send(&_clients[i], &i, sizeof(i), &remote);
+}
+
+static void _serve(unsigned i)
+{
+    sock_udp_ep_t remote;
+    unsigned request;
+
+    if ((sock_udp_recv(&_servers[i], &request, sizeof(request), TIMEOUT,
+                       &remote) == sizeof(request)) &&
+        (sock_udp_send(&_servers[i], &request, sizeof(request),
+                       &remote) < 0)) {
+        printf("FAILED: unable to reply on port %u\n", _ports[i]);
+    }
+}
+
+static void _handler(sock_udp_t *sock, sock_async_flags_t flags, void *arg)
+{
+    unsigned i = (uintptr_t)arg;
+
+    if (flags & SOCK_ASYNC_MSG_SENT) {
+        _sent++;
+    }
+    if (flags & SOCK_ASYNC_MSG_RECV) {
+        unsigned reply;
+
+        while (sock_udp_recv(sock, &reply, sizeof(reply), 0,
+                             NULL) == sizeof(reply)) {
+            if (reply == i) {
+                _replies++;
+            }
+        }
+    }
+}
+
+static void *_event_thread(void *arg)
+{
+    (void)arg;
+
+    event_queue_init(&_queue);
+    for (unsigned i = 0; i < CLIENTS_NUMOF; i++) {
+        sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
+
+        if (sock_udp_create(&_clients[i], &local, NULL, 0) < 0) {
+            printf("FAILED: unable to create client %u\n", i);
+            return NULL;
+        }
+        sock_udp_event_init(&_clients[i], &_queue, _handler, (void *)(uintptr_t)i);
+    }
+    mutex_unlock(&_clients_ready);
+    for (unsigned i = 0; i < CLIENTS_NUMOF; i++) {
+        _request(i);
+    }
+    event_loop(&_queue);
+    return NULL;
+}
+
+/* blocks for the reply, as the clients do in their own threads */
+static void _await(unsigned i)
+{
+    unsigned reply;
+
+    if ((sock_udp_recv(&_clients[i], &reply, sizeof(reply), TIMEOUT,
+                       NULL) == sizeof(reply)) && (reply == i)) {
+        _replies++;
+    }
+}
+
+static void *_client_thread(void *arg)
+{
+    unsigned i = (uintptr_t)arg;
+
+    if (_request(i) >= 0) {
+        _sent++;
+    }
+    _await(i);
+    return NULL;
+}
+
+/* runs the clients in one event thread */
+static unsigned _run_event(void)
+{
+    thread_create(_event_stack, sizeof(_event_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _event_thread, NULL, "event");
+    mutex_lock(&_clients_ready);
+    for (unsigned i = 0; i < CLIENTS_NUMOF; i++) {
+        _serve(i);
+    }
+    /* the event thread has a higher priority, so it handled all replies
+     * that arrived */
+    xtimer_usleep(TIMEOUT / 10);
+    for (unsigned i = 0; i < CLIENTS_NUMOF; i++) {
+        sock_udp_close(&_clients[i]);
+    }
+    return _stack_used(_event_stack, sizeof(_event_stack));
+}
+
+/* runs gcoap and emcute in their own threads, and the DNS client in the
+ * thread that queries, here the main thread */
+static void _run_threads(void)
+{
+    for (unsigned i = 0; i < CLIENTS_NUMOF; i++) {
+        sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
+
+        if (sock_udp_create(&_clients[i], &local, NULL, 0) < 0) {
+            printf("FAILED: unable to create client %u\n", i);
+            return;
+        }
+    }
+    for (unsigned i = 0; i < CLIENT_DNS; i++) {
+        thread_create(_client_stacks[i], sizeof(_client_stacks[i]),
+                      THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                      _client_thread, (void *)(uintptr_t)i, _names[i]);
+    }
+    for (unsigned i = 0; i < CLIENT_DNS; i++) {
+        _serve(i);
+    }
+    if (_request(CLIENT_DNS) >= 0) {
+        _sent++;
+    }
+    _serve(CLIENT_DNS);
+    _await(CLIENT_DNS);
+    xtimer_usleep(TIMEOUT / 10);
+    for (unsigned i = 0; i < CLIENTS_NUMOF; i++) {
+        sock_udp_close(&_clients[i]);
+    }
+}
+
+int main(void)
+{
+    unsigned event_used, threads_used = 0;
+    bool success;
+
+    puts("Asynchronous sock test");
+    for (unsigned i = 0; i < CLIENTS_NUMOF; i++) {
+        sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
+
+        local.port = _ports[i];
+        if (sock_udp_create(&_servers[i], &local, NULL, 0) < 0) {
+            printf("FAILED: unable to create server %u\n", i);
+            return 1;
+        }
+    }
+
+    event_used = _run_event();
+    printf("event thread: sent %u requests, received %u of %u replies\n",
+           _sent, _replies, CLIENTS_NUMOF);
+    success = (_sent == CLIENTS_NUMOF) && (_replies == CLIENTS_NUMOF);
+    printf("event thread: stack %u bytes, %u used, %u bytes of contexts\n",
+           (unsigned)sizeof(_event_stack), event_used,
+           (unsigned)(CLIENTS_NUMOF * sizeof(sock_async_ctx_t)));
+
+    _sent = 0;
+    _replies = 0;
+    _run_threads();
+    printf("thread per client: sent %u requests, received %u of %u replies\n",
+           _sent, _replies, CLIENTS_NUMOF);
+    success = success && (_sent == CLIENTS_NUMOF) &&
+              (_replies == CLIENTS_NUMOF);
+    for (unsigned i = 0; i < CLIENT_DNS; i++) {
+        unsigned used = _stack_used(_client_stacks[i],
+                                    sizeof(_client_stacks[i]));
+
+        printf("%s thread: stack %u bytes, %u used\n", _names[i],
+               (unsigned)sizeof(_client_stacks[i]), used);
+        threads_used += used;
+    }
+    printf("%s: no thread, queries block the caller\n", _names[CLIENT_DNS]);
+    printf("thread per client: stacks %u bytes, %u used\n",
+           (unsigned)sizeof(_client_stacks), threads_used);
+    if (!success) {
+        puts("FAILED");
+        return 1;
+    }
+    puts("SUCCESS");
+
+    return 0;
+}
@@ -0,0 +1,35 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+
+def expect_replies(child, setup):
+    child.expect(r"%s: sent (\d+) requests, received (\d+) of (\d+) "
+                 r"replies" % setup)
+    assert child.match.group(1) == child.match.group(3)
+    assert child.match.group(2) == child.match.group(3)
+
+
+def testfunc(child):
+    expect_replies(child, "event thread")
+    child.expect(r"event thread: stack \d+ bytes, \d+ used, "
+                 r"\d+ bytes of contexts")
+    expect_replies(child, "thread per client")
+    child.expect(r"gcoap thread: stack \d+ bytes, \d+ used")
+    child.expect(r"emcute thread: stack \d+ bytes, \d+ used")
+    child.expect_exact("dns: no thread, queries block the caller")
+    child.expect(r"thread per client: stacks \d+ bytes, \d+ used")
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.path.append(os.path.join(os.environ['RIOTTOOLS'], 'testrunner'))
+    from testrunner import run
+    sys.exit(run(testfunc))
@@ -0,0 +1,227 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compares fixed and adapted trickle parameters in a dense and
+ *              a sparse network
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "random.h"
+#include "thread.h"
+#include "trickle.h"
+
+#define NODES_MAX       (32U)
+#define DENSE_NODES     (32U)
+#define SPARSE_NODES    (8U)
+#define TRICKLE_MSG     (0xfeef)
+/* the defaults of RPL */
+#define TR_IMIN         (8U)
+#define TR_IDOUBLINGS   (20U)
+#define TR_REDCONST     (10U)
+#define STARTUP_MS      (10U * 1000U)
+#define REPAIR_MS       (5U * 60U * 1000U)
+#define END_MS          (10U * 60U * 1000U)
+#define NEVER           (UINT64_MAX)
+#define RANDOM_SEED     (0x7a1c)
+
+typedef struct {
+    trickle_t trickle;
+    uint64_t next;          /* virtual time of the next callback */
+    uint64_t repaired;      /* virtual time the new version arrived */
+    uint8_t version;
+    uint8_t neighbors;      /* neighbors heard */
+    bool heard[NODES_MAX];
+} node_t;
+
+typedef struct {
+    uint32_t dios;
+    uint32_t startup_dios;
+    uint32_t suppressions;
+    uint32_t resets;
+    uint32_t repair_ms;
+} result_t;
+
+static node_t _nodes[NODES_MAX];
+static unsigned _nodes_numof;
+static bool _dense;
+static uint64_t _now;
+
+static bool _linked(unsigned a, unsigned b)
+{
+    if (_dense) {
+        return a != b;
+    }
+    /* line */
+    return (a == (b + 1)) || (b == (a + 1));
+}
+
+/* trickle sets the timer to the end of the interval plus the next t */
+static void _reset(node_t *node)
+{
+    trickle_reset_timer(&node->trickle);
+    node->next = _now + node->trickle.t;
+}
+
+/* receives a DIO like RPL, by the version of the DODAG */
+static void _receive(node_t *node, node_t *sender)
+{
+    unsigned id = sender - _nodes;
+
+    if (!node->heard[id]) {
+        node->heard[id] = true;
+        node->neighbors++;
+    }
+    if (sender->version == node->version) {
+        trickle_increment_counter(&node->trickle);
+    }
+    else if (sender->version > node->version) {
+        node->version = sender->version;
+        node->repaired = _now;
+        _reset(node);
+    }
+    /* the sender needs the new version */
+    else {
+        _reset(node);
+    }
+}
+
+static void _send_dio(void *args)
+{
+    node_t *sender = args;
+    unsigned id = sender - _nodes;
+
+    for (unsigned i = 0; i < _nodes_numof; i++) {
+        if (_linked(id, i)) {
+            _receive(&_nodes[i], sender);
+        }
+    }
+}
+
+static void _run(bool dense, bool adapt, result_t *res)
+{
+    bool repair_started = false;
+    uint32_t startup_tx = 0;
+
+    memset(_nodes, 0, sizeof(_nodes));
+    memset(res, 0, sizeof(*res));
+    _dense = dense;
+    _nodes_numof = dense ? DENSE_NODES : SPARSE_NODES;
+    _now = 0;
+    random_init(RANDOM_SEED);
+
+    /* all nodes join at once */
+    for (unsigned i = 0; i < _nodes_numof; i++) {
+        node_t *node = &_nodes[i];
+
+        node->trickle.callback.func = _send_dio;
+        node->trickle.callback.args = node;
+        trickle_start(thread_getpid(), &node->trickle, TRICKLE_MSG, TR_IMIN,
+                      TR_IDOUBLINGS, TR_REDCONST);
+        node->next = node->trickle.t;
+    }
+
+    while (1) {
+        node_t *node = &_nodes[0];
+        uint32_t I, t;
+
+        for (unsigned i = 1; i < _nodes_numof; i++) {
+            if (_nodes[i].next < node->next) {
+                node = &_nodes[i];
+            }
+        }
+        if (!repair_started && (node->next >= REPAIR_MS)) {
+            /* node 0 starts a global repair */
+            _now = REPAIR_MS;
+            _nodes[0].version++;
+            _nodes[0].repaired = _now;
+            _reset(&_nodes[0]);
+            repair_started = true;
+            continue;
+        }
+        if (node->next >= END_MS) {
+            break;
+        }
+        _now = node->next;
+        if ((_now >= STARTUP_MS) && (startup_tx == 0)) {
+            for (unsigned i = 0; i < _nodes_numof; i++) {
+                startup_tx += _nodes[i].trickle.stats.transmissions;
+            }
+            res->startup_dios = startup_tx;
+        }
+        if (adapt) {
+            trickle_adapt(&node->trickle, TR_IMIN, TR_IDOUBLINGS, TR_REDCONST,
+                          node->neighbors);
+        }
+        I = node->trickle.I;
+        t = node->trickle.t;
+        trickle_callback(&node->trickle);
+        node->next = _now + (I - t) + node->trickle.t;
+    }
+
+    for (unsigned i = 0; i < _nodes_numof; i++) {
+        node_t *node = &_nodes[i];
+
+        trickle_stop(&node->trickle);
+        res->dios += node->trickle.stats.transmissions;
+        res->suppressions += node->trickle.stats.suppressions;
+        res->resets += node->trickle.stats.resets;
+        if (node->version != _nodes[0].version) {
+            res->repair_ms = UINT32_MAX;
+        }
+        else if ((res->repair_ms != UINT32_MAX) &&
+                 ((node->repaired - REPAIR_MS) > res->repair_ms)) {
+            res->repair_ms = node->repaired - REPAIR_MS;
+        }
+    }
+}
+
+static void _print(const char *name, const result_t *res)
+{
+    printf("%s: %" PRIu32 " DIOs, %" PRIu32 " during startup, %" PRIu32
+           " suppressed, %" PRIu32 " resets, repaired in %" PRIu32 " ms\n",
+           name, res->dios, res->startup_dios, res->suppressions, res->resets,
+           res->repair_ms);
+}
+
+int main(void)
+{
+    result_t dense_fixed, dense_adapted, sparse_fixed, sparse_adapted;
+
+    _run(true, false, &dense_fixed);
+    _print("dense, fixed", &dense_fixed);
+    _run(true, true, &dense_adapted);
+    _print("dense, adapted", &dense_adapted);
+    _run(false, false, &sparse_fixed);
+    _print("sparse, fixed", &sparse_fixed);
+    _run(false, true, &sparse_adapted);
+    _print("sparse, adapted", &sparse_adapted);
+
+    if ((dense_fixed.repair_ms == UINT32_MAX) ||
+        (dense_adapted.repair_ms == UINT32_MAX) ||
+        (sparse_fixed.repair_ms == UINT32_MAX) ||
+        (sparse_adapted.repair_ms == UINT32_MAX) ||
+        ((dense_adapted.dios * 2) > dense_fixed.dios) ||
+        (sparse_adapted.repair_ms >= sparse_fixed.repair_ms)) {
+        puts("FAILURE");
+        return 1;
+    }
+    puts("SUCCESS");
+
+    return 0;
+}
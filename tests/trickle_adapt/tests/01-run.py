@@ -0,0 +1,34 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+RESULT = (r"{}: (\d+) DIOs, (\d+) during startup, (\d+) suppressed, "
+          r"(\d+) resets, repaired in (\d+) ms")
+
+
+def expect_result(child, name):
+    child.expect(RESULT.format(name))
+    return [int(x) for x in child.match.groups()]
+
+
+def testfunc(child):
+    dense_fixed = expect_result(child, "dense, fixed")
+    dense_adapted = expect_result(child, "dense, adapted")
+    sparse_fixed = expect_result(child, "sparse, fixed")
+    sparse_adapted = expect_result(child, "sparse, adapted")
+    assert (dense_adapted[0] * 2) <= dense_fixed[0]
+    assert sparse_adapted[4] < sparse_fixed[4]
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.path.append(os.path.join(os.environ['RIOTTOOLS'], 'testrunner'))
+    from testrunner import run
+    sys.exit(run(testfunc))
@@ -49,6 +49,16 @@ static gcoap_listener_t listener_second = {
 
 static const char *resource_list_str = "</act/switch>,</sensor/temp>,</test/info/all>,</second/part>";
 
+static const coap_resource_t resources_subtree[] = {
+    { .path = "/fw", .methods = (COAP_GET | COAP_MATCH_SUBTREE) },
+    { .path = "/fw/info", .methods = (COAP_GET) },
+    { .path = "/fw/info", .methods = (COAP_PUT) },
+    { .path = "/fwx", .methods = (COAP_POST) },
+};
+
+#define RESOURCES_SUBTREE_NUMOF \
+    (sizeof(resources_subtree) / sizeof(resources_subtree[0]))
+
 /*
  * Client GET request success case. Test request generation.
  * Request /time resource from libcoap example
@@ -278,6 +288,45 @@ static void test_gcoap__server_get_resource_list(void)
     TEST_ASSERT_EQUAL_STRING(resource_list_str, (char *)res);
 }
 
+/*
+ * Test lookup of exact paths, methods and subtrees in a resource index
+ */
+static void test_gcoap__resource_index(void)
+{
+    coap_resource_index_t index;
+    const coap_resource_t *resource = NULL;
+
+    coap_resource_index_init(&index);
+    for (unsigned i = 0; i < RESOURCES_SUBTREE_NUMOF; i++) {
+        TEST_ASSERT_EQUAL_INT(0, coap_resource_index_add(&index,
+                                                         &resources_subtree[i]));
+    }
+
+    TEST_ASSERT_EQUAL_INT(0, coap_resource_index_find(&index, "/fw", COAP_GET,
+                                                      &resource));
+    TEST_ASSERT(&resources_subtree[0] == resource);
+    /* shared path, resource chosen by method */
+    TEST_ASSERT_EQUAL_INT(0, coap_resource_index_find(&index, "/fw/info",
+                                                      COAP_PUT, &resource));
+    TEST_ASSERT(&resources_subtree[2] == resource);
+    TEST_ASSERT_EQUAL_INT(-EPERM, coap_resource_index_find(&index, "/fw/info",
+                                                           COAP_POST, &resource));
+    /* below /fw, /fw/info does not match its subtree */
+    TEST_ASSERT_EQUAL_INT(0, coap_resource_index_find(&index, "/fw/img/0",
+                                                      COAP_GET, &resource));
+    TEST_ASSERT(&resources_subtree[0] == resource);
+    TEST_ASSERT_EQUAL_INT(0, coap_resource_index_find(&index, "/fw/info/x",
+                                                      COAP_GET, &resource));
+    TEST_ASSERT(&resources_subtree[0] == resource);
+    /* only full path segments match a subtree */
+    TEST_ASSERT_EQUAL_INT(-EPERM, coap_resource_index_find(&index, "/fwx",
+                                                           COAP_GET, &resource));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, coap_resource_index_find(&index, "/fwy",
+                                                            COAP_GET, &resource));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, coap_resource_index_find(&index, "/",
+                                                            COAP_GET, &resource));
+}
+
 Test *tests_gcoap_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -287,7 +336,8 @@ Test *tests_gcoap_tests(void)
         new_TestFixture(test_gcoap__server_get_resp),
         new_TestFixture(test_gcoap__server_con_req),
         new_TestFixture(test_gcoap__server_con_resp),
-        new_TestFixture(test_gcoap__server_get_resource_list)
+        new_TestFixture(test_gcoap__server_get_resource_list),
+        new_TestFixture(test_gcoap__resource_index),
     };
 
     EMB_UNIT_TESTCALLER(gcoap_tests, NULL, NULL, fixtures);
@@ -13,6 +13,7 @@
  */
 #include <errno.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "embUnit.h"
 
@@ -165,6 +166,79 @@ static void test_inet_csum__empty_app_buffer(void)
     TEST_ASSERT_EQUAL_INT(hdr_expected, pyld_sum);
 }
 
+static uint8_t _buf[1280 + 4];
+
+/* straight-forward byte-wise reference implementation */
+static uint16_t _csum_ref(uint16_t sum, const uint8_t *buf, uint16_t len)
+{
+    uint32_t csum = sum;
+
+    for (unsigned i = 0; i < len; i++) {
+        csum += (i & 1) ? buf[i] : (buf[i] << 8);
+    }
+    while (csum >> 16) {
+        csum = (csum & 0xffff) + (csum >> 16);
+    }
+    return csum;
+}
+
+static void _fill_buf(void)
+{
+    for (unsigned i = 0; i < sizeof(_buf); i++) {
+        _buf[i] = (uint8_t)((i * 151) + (i >> 3));
+    }
+}
+
+static void test_inet_csum__alignment(void)
+{
+    _fill_buf();
+    /* exercises all combinations of buffer alignment and remainders of the
+     * word-wise summation */
+    for (unsigned offset = 0; offset < 4; offset++) {
+        for (unsigned len = 0; len < 72; len++) {
+            TEST_ASSERT_EQUAL_INT(_csum_ref(0x1234, &_buf[offset], len),
+                                  inet_csum(0x1234, &_buf[offset], len));
+        }
+    }
+}
+
+static void test_inet_csum__all_ones(void)
+{
+    /* maximizes carries in the word-wise accumulator */
+    memset(_buf, 0xff, sizeof(_buf));
+    TEST_ASSERT_EQUAL_INT(_csum_ref(0xffff, _buf, 1280),
+                          inet_csum(0xffff, _buf, 1280));
+    TEST_ASSERT_EQUAL_INT(_csum_ref(0xffff, &_buf[1], 1279),
+                          inet_csum(0xffff, &_buf[1], 1279));
+}
+
+static void test_inet_csum__update(void)
+{
+    uint8_t new_data[] = { 0x20, 0x01, 0x0d, 0xb8, 0xab };
+    uint16_t csum;
+
+    _fill_buf();
+    csum = ~inet_csum(0, _buf, 40);
+    for (unsigned len = 1; len <= sizeof(new_data); len++) {
+        uint8_t old_data[sizeof(new_data)];
+
+        memcpy(old_data, &_buf[8], len);
+        memcpy(&_buf[8], new_data, len);
+        csum = inet_csum_update(csum, old_data, &_buf[8], len);
+        TEST_ASSERT_EQUAL_INT((uint16_t)~inet_csum(0, _buf, 40), csum);
+        /* revert to original data */
+        csum = inet_csum_update(csum, &_buf[8], old_data, len);
+        memcpy(&_buf[8], old_data, len);
+        TEST_ASSERT_EQUAL_INT((uint16_t)~inet_csum(0, _buf, 40), csum);
+    }
+}
+
+static void test_inet_csum__update16(void)
+{
+    /* source: https://tools.ietf.org/html/rfc1624#section-4 */
+    TEST_ASSERT_EQUAL_INT(0x0000, inet_csum_update16(0xdd2f, 0x5555, 0x3285));
+}
+
 Test *tests_inet_csum_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -176,6 +250,10 @@ Test *tests_inet_csum_tests(void)
         new_TestFixture(test_inet_csum__odd_len),
         new_TestFixture(test_inet_csum__two_app_snips),
         new_TestFixture(test_inet_csum__empty_app_buffer),
+        new_TestFixture(test_inet_csum__alignment),
+        new_TestFixture(test_inet_csum__all_ones),
+        new_TestFixture(test_inet_csum__update),
+        new_TestFixture(test_inet_csum__update16),
     };
 
     EMB_UNIT_TESTCALLER(inet_csum_tests, NULL, NULL, fixtures);
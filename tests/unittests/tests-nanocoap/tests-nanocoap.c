@@ -22,6 +22,8 @@
 #include "unittests-constants.h"
 #include "tests-nanocoap.h"
 
+#define OPT_SIZE1           (60U)   /* beyond the indexed option numbers */
+
 /*
  * Validates encoded message ID byte order and put/get URI option.
  */
@@ -219,6 +221,87 @@ static void test_nanocoap__get_path_too_long(void)
     TEST_ASSERT_EQUAL_INT(-ENOSPC, get_len);
 }
 
+/*
+ * Builds a typical request with Uri-Path x3, Content-Format, Observe, Block2
+ * and Size1 into buf; returns its length.
+ */
+static size_t _build_opt_req(uint8_t *buf, size_t len)
+{
+    coap_pkt_t pkt;
+    uint8_t token[2] = {0xDA, 0xEC};
+    size_t hdr_len = coap_build_hdr((coap_hdr_t *)buf, COAP_TYPE_CON,
+                                    &token[0], 2, COAP_METHOD_PUT, 0xABCD);
+
+    coap_pkt_init(&pkt, buf, len, hdr_len);
+    coap_opt_add_uint(&pkt, COAP_OPT_OBSERVE, 0);
+    coap_opt_add_string(&pkt, COAP_OPT_URI_PATH, "/node/sensor/temp", '/');
+    coap_opt_add_uint(&pkt, COAP_OPT_CONTENT_FORMAT, COAP_FORMAT_CBOR);
+    /* block 3, size 64, no more */
+    coap_opt_add_uint(&pkt, COAP_OPT_BLOCK2, (3 << 4) | 2);
+    coap_opt_add_uint(&pkt, OPT_SIZE1, 1000);
+    return coap_opt_finish(&pkt, COAP_OPT_FINISH_NONE);
+}
+
+/*
+ * Looks up options of a parsed request through the option index.
+ */
+static void test_nanocoap__option_index(void)
+{
+    uint8_t buf[128];
+    coap_pkt_t pkt;
+    coap_block1_t block2;
+    uint32_t value;
+    char uri[NANOCOAP_URI_MAX] = {0};
+    size_t len = _build_opt_req(buf, sizeof(buf));
+
+    TEST_ASSERT_EQUAL_INT(0, coap_parse(&pkt, buf, len));
+    /* one entry per option number */
+    TEST_ASSERT_EQUAL_INT(5, pkt.options_len);
+
+    TEST_ASSERT_EQUAL_INT(0, coap_get_option_uint(&pkt, COAP_OPT_OBSERVE,
+                                                  &value));
+    TEST_ASSERT_EQUAL_INT(0, value);
+    TEST_ASSERT_EQUAL_INT(COAP_FORMAT_CBOR, coap_get_content_type(&pkt));
+    TEST_ASSERT_EQUAL_INT(0, coap_get_option_uint(&pkt, OPT_SIZE1, &value));
+    TEST_ASSERT_EQUAL_INT(1000, value);
+
+    TEST_ASSERT(coap_get_block2(&pkt, &block2));
+    TEST_ASSERT_EQUAL_INT(3, block2.blknum);
+    TEST_ASSERT_EQUAL_INT(2, block2.szx);
+    TEST_ASSERT_EQUAL_INT(0, block2.more);
+    TEST_ASSERT_EQUAL_INT(3 * 64, block2.offset);
+
+    TEST_ASSERT(coap_get_uri(&pkt, (uint8_t *)uri) > 0);
+    TEST_ASSERT_EQUAL_STRING("/node/sensor/temp", (char *)uri);
+
+    TEST_ASSERT_NULL(coap_find_option(&pkt, COAP_OPT_URI_HOST));
+    TEST_ASSERT_NULL(coap_find_option(&pkt, COAP_OPT_BLOCK1));
+    TEST_ASSERT_NULL(coap_find_option(&pkt, OPT_SIZE1 + 1));
+}
+
+/*
+ * Rejects a request with more option numbers than the option index holds.
+ */
+static void test_nanocoap__option_index_full(void)
+{
+    uint8_t buf[128];
+    coap_pkt_t pkt;
+    size_t len = coap_build_hdr((coap_hdr_t *)buf, COAP_TYPE_NON, NULL, 0,
+                                COAP_METHOD_GET, 0xABCD);
+
+    coap_pkt_init(&pkt, buf, sizeof(buf), len);
+    for (unsigned i = 0; i < NANOCOAP_NOPTS_MAX; i++) {
+        coap_opt_add_uint(&pkt, 1000 + (2 * i), 0);
+    }
+    len = coap_opt_finish(&pkt, COAP_OPT_FINISH_NONE);
+    TEST_ASSERT_EQUAL_INT(0, coap_parse(&pkt, buf, len));
+
+    /* one more option number, written raw past the builder's assert */
+    len += coap_put_option(buf + len, 1000 + (2 * (NANOCOAP_NOPTS_MAX - 1)),
+                           2000, NULL, 0);
+    TEST_ASSERT_EQUAL_INT(-ENOMEM, coap_parse(&pkt, buf, len));
+}
+
 Test *tests_nanocoap_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -229,6 +312,8 @@ Test *tests_nanocoap_tests(void)
         new_TestFixture(test_nanocoap__get_root_path),
         new_TestFixture(test_nanocoap__get_max_path),
         new_TestFixture(test_nanocoap__get_path_too_long),
+        new_TestFixture(test_nanocoap__option_index),
+        new_TestFixture(test_nanocoap__option_index_full),
     };
 
     EMB_UNIT_TESTCALLER(nanocoap_tests, NULL, NULL, fixtures);
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/netstats/neighbor.h"
+
+#include "tests-netstats_neighbor.h"
+
+#define ETX(x)  ((x) * NETSTATS_NB_ETX_DIVISOR)
+
+static netstats_nb_table_t _table;
+static const uint8_t _addr1[] = { 0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x01 };
+static const uint8_t _addr2[] = { 0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x02 };
+
+static void set_up(void)
+{
+    netstats_nb_init(&_table);
+}
+
+static void test_netstats_nb_get__empty(void)
+{
+    TEST_ASSERT_NULL(netstats_nb_get(&_table, _addr1, sizeof(_addr1)));
+    TEST_ASSERT_NULL(netstats_nb_update_tx(&_table, NETSTATS_NB_SUCCESS, 0));
+}
+
+static void test_netstats_nb_record__broadcast(void)
+{
+    netstats_nb_record(&_table, NULL, 0);
+    TEST_ASSERT_NULL(netstats_nb_update_tx(&_table, NETSTATS_NB_SUCCESS, 0));
+    TEST_ASSERT_NULL(netstats_nb_get(&_table, _addr1, sizeof(_addr1)));
+}
+
+static void test_netstats_nb_update_tx__first(void)
+{
+    netstats_nb_t *nb;
+
+    netstats_nb_record(&_table, _addr1, sizeof(_addr1));
+    nb = netstats_nb_get(&_table, _addr1, sizeof(_addr1));
+    TEST_ASSERT_NOT_NULL(nb);
+    TEST_ASSERT_EQUAL_INT(NETSTATS_NB_ETX_INIT, nb->etx);
+    TEST_ASSERT(nb == netstats_nb_update_tx(&_table, NETSTATS_NB_SUCCESS, 2));
+    TEST_ASSERT_EQUAL_INT(ETX(3), nb->etx);
+    TEST_ASSERT_EQUAL_INT(1, nb->tx_count);
+    TEST_ASSERT_EQUAL_INT(0, nb->tx_failed);
+    /* the result is only counted once */
+    TEST_ASSERT_NULL(netstats_nb_update_tx(&_table, NETSTATS_NB_SUCCESS, 0));
+}
+
+static void test_netstats_nb_update_tx__ewma(void)
+{
+    netstats_nb_t *nb;
+
+    netstats_nb_record(&_table, _addr1, sizeof(_addr1));
+    nb = netstats_nb_update_tx(&_table, NETSTATS_NB_SUCCESS, 0);
+    TEST_ASSERT_EQUAL_INT(ETX(1), nb->etx);
+    netstats_nb_record(&_table, _addr1, sizeof(_addr1));
+    netstats_nb_update_tx(&_table, NETSTATS_NB_SUCCESS, 1);
+    TEST_ASSERT_EQUAL_INT(((NETSTATS_NB_EWMA_ALPHA * ETX(2)) +
+                           ((100 - NETSTATS_NB_EWMA_ALPHA) * ETX(1))) / 100,
+                          nb->etx);
+    TEST_ASSERT_EQUAL_INT(2, nb->tx_count);
+}
+
+static void test_netstats_nb_update_tx__noack(void)
+{
+    netstats_nb_t *nb;
+
+    netstats_nb_record(&_table, _addr1, sizeof(_addr1));
+    nb = netstats_nb_update_tx(&_table, NETSTATS_NB_NOACK, 3);
+    TEST_ASSERT_EQUAL_INT(NETSTATS_NB_ETX_NOACK_PENALTY, nb->etx);
+    TEST_ASSERT_EQUAL_INT(1, nb->tx_count);
+    TEST_ASSERT_EQUAL_INT(1, nb->tx_failed);
+}
+
+static void test_netstats_nb_update_tx__busy(void)
+{
+    netstats_nb_t *nb;
+
+    netstats_nb_record(&_table, _addr1, sizeof(_addr1));
+    nb = netstats_nb_update_tx(&_table, NETSTATS_NB_BUSY, 0);
+    TEST_ASSERT_NOT_NULL(nb);
+    TEST_ASSERT_EQUAL_INT(NETSTATS_NB_ETX_INIT, nb->etx);
+    TEST_ASSERT_EQUAL_INT(0, nb->tx_count);
+}
+
+static void test_netstats_nb_update_rx__lqi(void)
+{
+    netstats_nb_t *nb;
+
+    nb = netstats_nb_update_rx(&_table, _addr1, sizeof(_addr1), -70, 255);
+    TEST_ASSERT_EQUAL_INT(ETX(1), nb->etx);
+    TEST_ASSERT_EQUAL_INT(-70, nb->rssi);
+    TEST_ASSERT_EQUAL_INT(1, nb->rx_count);
+    netstats_nb_update_rx(&_table, _addr1, sizeof(_addr1), -90, 51);
+    TEST_ASSERT_EQUAL_INT(ETX(5), nb->etx);
+    /* no LQI keeps the estimate */
+    netstats_nb_update_rx(&_table, _addr1, sizeof(_addr1), -90, 0);
+    TEST_ASSERT_EQUAL_INT(ETX(5), nb->etx);
+    /* transmissions replace the estimate for good */
+    netstats_nb_record(&_table, _addr1, sizeof(_addr1));
+    netstats_nb_update_tx(&_table, NETSTATS_NB_SUCCESS, 0);
+    netstats_nb_update_rx(&_table, _addr1, sizeof(_addr1), -90, 51);
+    TEST_ASSERT_EQUAL_INT(ETX(1), nb->etx);
+    TEST_ASSERT_EQUAL_INT(4, nb->rx_count);
+}
+
+static void test_netstats_nb_record__lru(void)
+{
+    uint8_t addr[sizeof(_addr2)];
+
+    netstats_nb_update_rx(&_table, _addr1, sizeof(_addr1), -70, 0);
+    memcpy(addr, _addr2, sizeof(addr));
+    for (unsigned i = 0; i < NETSTATS_NB_SIZE - 1; i++) {
+        addr[7] = 0x10 + i;
+        netstats_nb_record(&_table, addr, sizeof(addr));
+    }
+    /* use the first neighbor again, so the second is the oldest */
+    netstats_nb_record(&_table, _addr1, sizeof(_addr1));
+    netstats_nb_record(&_table, _addr2, sizeof(_addr2));
+    TEST_ASSERT_NOT_NULL(netstats_nb_get(&_table, _addr1, sizeof(_addr1)));
+    TEST_ASSERT_NOT_NULL(netstats_nb_get(&_table, _addr2, sizeof(_addr2)));
+    addr[7] = 0x10;
+    TEST_ASSERT_NULL(netstats_nb_get(&_table, addr, sizeof(addr)));
+}
+
+Test *tests_netstats_neighbor_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_netstats_nb_get__empty),
+        new_TestFixture(test_netstats_nb_record__broadcast),
+        new_TestFixture(test_netstats_nb_update_tx__first),
+        new_TestFixture(test_netstats_nb_update_tx__ewma),
+        new_TestFixture(test_netstats_nb_update_tx__noack),
+        new_TestFixture(test_netstats_nb_update_tx__busy),
+        new_TestFixture(test_netstats_nb_update_rx__lqi),
+        new_TestFixture(test_netstats_nb_record__lru),
+    };
+
+    EMB_UNIT_TESTCALLER(netstats_neighbor_tests, set_up, NULL, fixtures);
+
+    return (Test *)&netstats_neighbor_tests;
+}
+
+void tests_netstats_neighbor(void)
+{
+    TESTS_RUN(tests_netstats_neighbor_tests());
+}
+/** @} */
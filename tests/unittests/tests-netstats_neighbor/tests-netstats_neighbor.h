@@ -0,0 +1,35 @@
+/*
+ * Copyright (C) 2026 The RIOT developers <devel@riot-os.org>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  unittests
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the ``netstats_neighbor`` module
+ */
+#ifndef TESTS_NETSTATS_NEIGHBOR_H
+#define TESTS_NETSTATS_NEIGHBOR_H
+
+#include "embUnit.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   The entry point of this test suite.
+ */
+void tests_netstats_neighbor(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TESTS_NETSTATS_NEIGHBOR_H */
+/** @} */
@@ -21,7 +21,16 @@
 
 #include "unittests-constants.h"
 
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan/ctx.h"
+#include "net/gnrc/sixlowpan/iphc.h"
+#include "net/ieee802154.h"
+#include "net/ipv6/addr.h"
+#include "net/ipv6/hdr.h"
+#include "net/protnum.h"
 #include "net/sixlowpan.h"
+#include "net/udp.h"
 
 #define NALP_0  (0x00) /* 00 00 00 00 */
 #define NALP_1  (0x01) /* 00 00 00 01 */
@@ -45,6 +54,36 @@
 #define FRAG1_DISP      (0xC5)  /* 11 00 01 01 */
 #define FRAGN_DISP      (0xE5)  /* 11 10 01 01 */
 
+#define IPHC_PAYLOAD_SIZE   (16U)
+
+typedef struct {
+    const char *name;
+    const char *src;    /* NULL: link-local address derived from L2 address */
+    const char *dst;    /* NULL: link-local address derived from L2 address */
+    uint32_t fl;
+    uint16_t src_port;
+    uint16_t dst_port;
+    uint8_t tc;
+    uint8_t hl;
+} _iphc_case_t;
+
+static const uint8_t _src_l2[] = { 0x3e, 0xe6, 0xb5, 0x0f, 0x19, 0x22, 0x00, 0x01 };
+static const uint8_t _dst_l2[] = { 0x3e, 0xe6, 0xb5, 0x0f, 0x19, 0x22, 0x00, 0x02 };
+
+static const _iphc_case_t _iphc_cases[] = {
+    { "link-local L2", NULL, NULL, 0, 0xf0b1, 0xf0b2, 0, 64 },
+    { "link-local 16 bit", "fe80::ff:fe00:1", "fe80::ff:fe00:2",
+      0, 0xf001, 5683, 0, 255 },
+    { "context 0 64 bit", "2001:db8::1", "2001:db8::2", 0, 5683, 0xf002, 0, 1 },
+    { "context 1 L2", "2001:db8:1::3ce6:b50f:1922:1",
+      "2001:db8:1::3ce6:b50f:1922:2", 0, 5683, 5683, 0xb8, 64 },
+    { "multicast 8 bit", NULL, "ff02::1", 0x12345, 0xf0b1, 0xf0b2, 0, 64 },
+    { "inline", "2001:db8:ffff::1", "2001:db8:fffe::1", 0xabcde, 1234, 5678,
+      0xb8, 42 },
+};
+
+#define IPHC_CASES_NUMOF    (sizeof(_iphc_cases) / sizeof(_iphc_cases[0]))
+
 
 /* Test with 6LoWPAN dispatch byte indicating a none-LoWPAN frame (NALP = Not a
  * LoWPAN frame)
@@ -147,6 +186,201 @@ static void test_sixlowpan_nalp_is_6lowpan_frame_12(void)
     TEST_ASSERT(!sixlowpan_nalp(FRAGN_DISP));
 }
 
+static void set_up_iphc(void)
+{
+    ipv6_addr_t prefix = IPV6_ADDR_UNSPECIFIED;
+
+    gnrc_pktbuf_init();
+    gnrc_sixlowpan_ctx_reset();
+    prefix.u16[0] = byteorder_htons(0x2001);
+    prefix.u16[1] = byteorder_htons(0x0db8);
+    gnrc_sixlowpan_ctx_update(0, &prefix, 64, UINT16_MAX, true);
+    prefix.u16[2] = byteorder_htons(0x0001);
+    gnrc_sixlowpan_ctx_update(1, &prefix, 64, UINT16_MAX, true);
+}
+
+static void tear_down_iphc(void)
+{
+    gnrc_sixlowpan_ctx_reset();
+}
+
+static void _init_addr(ipv6_addr_t *addr, const char *str, const uint8_t *l2)
+{
+    if (str == NULL) {
+        ipv6_addr_set_link_local_prefix(addr);
+        ieee802154_get_iid((eui64_t *)&addr->u64[1], l2, IEEE802154_LONG_ADDRESS_LEN);
+    }
+    else {
+        TEST_ASSERT_NOT_NULL(ipv6_addr_from_str(addr, str));
+    }
+}
+
+static gnrc_pktsnip_t *_netif_hdr_build(void)
+{
+    return gnrc_netif_hdr_build((uint8_t *)_src_l2, sizeof(_src_l2),
+                                (uint8_t *)_dst_l2, sizeof(_dst_l2));
+}
+
+/* builds [netif][IPv6][UDP][payload] as handed down to 6LoWPAN */
+static gnrc_pktsnip_t *_build_pkt(const _iphc_case_t *c)
+{
+    gnrc_pktsnip_t *payload, *udp, *ipv6, *netif;
+    udp_hdr_t *udp_hdr;
+    ipv6_hdr_t *ipv6_hdr;
+
+    payload = gnrc_pktbuf_add(NULL, NULL, IPHC_PAYLOAD_SIZE, GNRC_NETTYPE_UNDEF);
+    if (payload == NULL) {
+        return NULL;
+    }
+    memset(payload->data, 0xa5, IPHC_PAYLOAD_SIZE);
+    udp = gnrc_pktbuf_add(payload, NULL, sizeof(udp_hdr_t), GNRC_NETTYPE_UDP);
+    if (udp == NULL) {
+        gnrc_pktbuf_release(payload);
+        return NULL;
+    }
+    udp_hdr = udp->data;
+    udp_hdr->src_port = byteorder_htons(c->src_port);
+    udp_hdr->dst_port = byteorder_htons(c->dst_port);
+    udp_hdr->length = byteorder_htons(sizeof(udp_hdr_t) + IPHC_PAYLOAD_SIZE);
+    udp_hdr->checksum = byteorder_htons(0xabcd);
+    ipv6 = gnrc_pktbuf_add(udp, NULL, sizeof(ipv6_hdr_t), GNRC_NETTYPE_IPV6);
+    if (ipv6 == NULL) {
+        gnrc_pktbuf_release(udp);
+        return NULL;
+    }
+    ipv6_hdr = ipv6->data;
+    memset(ipv6_hdr, 0, sizeof(ipv6_hdr_t));
+    ipv6_hdr_set_version(ipv6_hdr);
+    ipv6_hdr_set_tc(ipv6_hdr, c->tc);
+    ipv6_hdr_set_fl(ipv6_hdr, c->fl);
+    ipv6_hdr->len = udp_hdr->length;
+    ipv6_hdr->nh = PROTNUM_UDP;
+    ipv6_hdr->hl = c->hl;
+    _init_addr(&ipv6_hdr->src, c->src, _src_l2);
+    _init_addr(&ipv6_hdr->dst, c->dst, _dst_l2);
+    if ((netif = _netif_hdr_build()) == NULL) {
+        gnrc_pktbuf_release(ipv6);
+        return NULL;
+    }
+    netif->next = ipv6;
+    return netif;
+}
+
+/* flattens an encoded packet into a received frame: [frame][netif] */
+static gnrc_pktsnip_t *_to_frame(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *netif = _netif_hdr_build(), *frame;
+    size_t offset = 0;
+
+    if (netif == NULL) {
+        return NULL;
+    }
+    frame = gnrc_pktbuf_add(netif, NULL, gnrc_pkt_len(pkt->next),
+                            GNRC_NETTYPE_SIXLOWPAN);
+    if (frame == NULL) {
+        gnrc_pktbuf_release(netif);
+        return NULL;
+    }
+    for (gnrc_pktsnip_t *snip = pkt->next; snip != NULL; snip = snip->next) {
+        memcpy((uint8_t *)frame->data + offset, snip->data, snip->size);
+        offset += snip->size;
+    }
+    return frame;
+}
+
+static void _check_decoded(const _iphc_case_t *c, gnrc_pktsnip_t *dec_hdr)
+{
+    gnrc_pktsnip_t *exp = _build_pkt(c);
+
+    TEST_ASSERT_NOT_NULL(exp);
+    /* UDP header was decompressed into the space reserved for it */
+    TEST_ASSERT_EQUAL_INT(GNRC_NETTYPE_UDP, dec_hdr->type);
+    TEST_ASSERT_EQUAL_INT(sizeof(udp_hdr_t), dec_hdr->size);
+    TEST_ASSERT_NOT_NULL(dec_hdr->next);
+    TEST_ASSERT_EQUAL_INT(GNRC_NETTYPE_IPV6, dec_hdr->next->type);
+    TEST_ASSERT_EQUAL_INT(sizeof(ipv6_hdr_t), dec_hdr->next->size);
+    TEST_ASSERT_NULL(dec_hdr->next->next);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(exp->next->data, dec_hdr->next->data,
+                                    sizeof(ipv6_hdr_t)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(exp->next->next->data, dec_hdr->data,
+                                    sizeof(udp_hdr_t)));
+    gnrc_pktbuf_release(exp);
+}
+
+static gnrc_pktsnip_t *_decode(gnrc_pktsnip_t *frame, size_t *disp_len)
+{
+    gnrc_pktsnip_t *dec_hdr = gnrc_pktbuf_add(NULL, NULL,
+                                              sizeof(ipv6_hdr_t) + sizeof(udp_hdr_t),
+                                              GNRC_NETTYPE_IPV6);
+    size_t nh_len = 0;
+
+    if (dec_hdr != NULL) {
+        *disp_len = gnrc_sixlowpan_iphc_decode(&dec_hdr, frame, 0, 0, &nh_len);
+    }
+    return dec_hdr;
+}
+
+static void test_sixlowpan_iphc_encode_in_place(void)
+{
+    for (unsigned i = 0; i < IPHC_CASES_NUMOF; i++) {
+        gnrc_pktsnip_t *pkt = _build_pkt(&_iphc_cases[i]), *ipv6;
+
+        TEST_ASSERT_NOT_NULL(pkt);
+        ipv6 = pkt->next;
+        TEST_ASSERT(gnrc_sixlowpan_iphc_encode(pkt));
+        /* IPv6 header snip was reused for the dispatch */
+        TEST_ASSERT(ipv6 == pkt->next);
+        TEST_ASSERT_EQUAL_INT(GNRC_NETTYPE_SIXLOWPAN, pkt->next->type);
+        TEST_ASSERT(sixlowpan_iphc_is(pkt->next->data));
+        TEST_ASSERT(pkt->next->size <= sizeof(ipv6_hdr_t));
+        gnrc_pktbuf_release(pkt);
+    }
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_sixlowpan_iphc_encode_shared(void)
+{
+    gnrc_pktsnip_t *pkt = _build_pkt(&_iphc_cases[0]), *ipv6;
+    ipv6_hdr_t orig;
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    ipv6 = pkt->next;
+    memcpy(&orig, ipv6->data, sizeof(orig));
+    gnrc_pktbuf_hold(ipv6, 1);
+    TEST_ASSERT(gnrc_sixlowpan_iphc_encode(pkt));
+    /* held IPv6 header is left untouched */
+    TEST_ASSERT(ipv6 != pkt->next);
+    TEST_ASSERT_EQUAL_INT(GNRC_NETTYPE_IPV6, ipv6->type);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&orig, ipv6->data, sizeof(orig)));
+    TEST_ASSERT(sixlowpan_iphc_is(pkt->next->data));
+    gnrc_pktbuf_release(pkt);
+    gnrc_pktbuf_release(ipv6);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_sixlowpan_iphc_decode_reserved(void)
+{
+    for (unsigned i = 0; i < IPHC_CASES_NUMOF; i++) {
+        gnrc_pktsnip_t *pkt = _build_pkt(&_iphc_cases[i]);
+        gnrc_pktsnip_t *frame, *dec_hdr;
+        size_t disp_len;
+
+        TEST_ASSERT_NOT_NULL(pkt);
+        TEST_ASSERT(gnrc_sixlowpan_iphc_encode(pkt));
+        frame = _to_frame(pkt);
+        gnrc_pktbuf_release(pkt);
+        TEST_ASSERT_NOT_NULL(frame);
+        dec_hdr = _decode(frame, &disp_len);
+        TEST_ASSERT_NOT_NULL(dec_hdr);
+        TEST_ASSERT(disp_len > 0);
+        TEST_ASSERT_EQUAL_INT(IPHC_PAYLOAD_SIZE, frame->size - disp_len);
+        _check_decoded(&_iphc_cases[i], dec_hdr);
+        gnrc_pktbuf_release(dec_hdr);
+        gnrc_pktbuf_release(frame);
+    }
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
 Test *test_sixlowpan_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -177,8 +411,23 @@ Test *test_sixlowpan_tests(void)
     return (Test *)&test_sixlowpan_tests_caller;
 }
 
+Test *test_sixlowpan_iphc_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_sixlowpan_iphc_encode_in_place),
+        new_TestFixture(test_sixlowpan_iphc_encode_shared),
+        new_TestFixture(test_sixlowpan_iphc_decode_reserved),
+    };
+
+    EMB_UNIT_TESTCALLER(test_sixlowpan_iphc_tests_caller, set_up_iphc,
+                        tear_down_iphc, fixtures);
+
+    return (Test *)&test_sixlowpan_iphc_tests_caller;
+}
+
 void tests_sixlowpan(void)
 {
     TESTS_RUN(test_sixlowpan_tests());
+    TESTS_RUN(test_sixlowpan_iphc_tests());
 }
 /** @} */